@@ -0,0 +1,133 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include <DPsim.h>
+
+namespace DPsim {
+namespace Benchmarks {
+
+	using Clock = std::chrono::steady_clock;
+
+	/// Duration in milliseconds
+	template <typename Duration>
+	Real toMs(Duration d) {
+		return std::chrono::duration<Real, std::milli>(d).count();
+	}
+
+	/// Duration in microseconds
+	template <typename Duration>
+	Real toUs(Duration d) {
+		return std::chrono::duration<Real, std::micro>(d).count();
+	}
+
+	/// Milliseconds since the given time point
+	inline Real elapsedMs(Clock::time_point start) {
+		return toMs(Clock::now() - start);
+	}
+
+	/// Numeric command line option "-o name=value" or the default value
+	template <typename T>
+	T option(CommandLineArgs& args, const String& name, T defaultValue) {
+		auto it = args.options.find(name);
+		return it == args.options.end() ? defaultValue : static_cast<T>(it->second);
+	}
+
+	/// Relative deviation of a value from its reference
+	inline Real relativeDeviation(Complex value, Complex reference) {
+		return std::abs(value - reference) / std::abs(reference);
+	}
+
+	/// Parameters of meshedGrid
+	struct MeshedGridParameters {
+		Real capacitance = 1e-6;
+		Real loadResistance = 1000;
+		Real branchResistance = 0.5;
+		Real branchInductance = 0.002;
+		Complex voltage = 10000;
+	};
+
+	/// Square DP grid of RL branches with capacitive and resistive shunts at
+	/// every node, fed by a voltage source at the first node. Each branch is
+	/// a resistor and an inductor in series with a node in between. Returns
+	/// the grid nodes in row-major order.
+	inline CPS::SystemTopology meshedGrid(UInt size, const MeshedGridParameters& params,
+		std::vector<CPS::DP::SimNode::Ptr>& grid) {
+		using namespace CPS::DP;
+		using namespace CPS::DP::Ph1;
+		SystemNodeList nodes;
+		SystemComponentList comps;
+
+		grid.clear();
+		for (UInt row = 0; row < size; ++row) {
+			for (UInt col = 0; col < size; ++col) {
+				String id = std::to_string(row) + "_" + std::to_string(col);
+				auto n = SimNode::make("n" + id);
+				grid.push_back(n);
+				nodes.push_back(n);
+
+				auto c = Capacitor::make("c_" + id, CPS::Logger::Level::off);
+				c->setParameters(params.capacitance);
+				c->connect({ n, SimNode::GND });
+				auto load = Resistor::make("load_" + id, CPS::Logger::Level::off);
+				load->setParameters(params.loadResistance);
+				load->connect({ n, SimNode::GND });
+				comps.push_back(c);
+				comps.push_back(load);
+			}
+		}
+
+		auto branch = [&](const String& id, SimNode::Ptr from, SimNode::Ptr to) {
+			auto nMid = SimNode::make("n" + id + "_m");
+			nodes.push_back(nMid);
+			auto r = Resistor::make("r_" + id, CPS::Logger::Level::off);
+			r->setParameters(params.branchResistance);
+			r->connect({ from, nMid });
+			auto l = Inductor::make("l_" + id, CPS::Logger::Level::off);
+			l->setParameters(params.branchInductance);
+			l->connect({ nMid, to });
+			comps.push_back(r);
+			comps.push_back(l);
+		};
+		for (UInt row = 0; row < size; ++row) {
+			for (UInt col = 0; col < size; ++col) {
+				String id = std::to_string(row) + "_" + std::to_string(col);
+				if (col + 1 < size)
+					branch("h" + id, grid[row * size + col], grid[row * size + col + 1]);
+				if (row + 1 < size)
+					branch("v" + id, grid[row * size + col], grid[(row + 1) * size + col]);
+			}
+		}
+
+		auto vs = VoltageSource::make("vs", CPS::Logger::Level::off);
+		vs->setParameters(params.voltage);
+		vs->connect({ SimNode::GND, grid[0] });
+		comps.push_back(vs);
+
+		return CPS::SystemTopology(50, nodes, comps);
+	}
+
+	/// Merges the given number of copies of a topology into one system.
+	/// The copies keep their names, so name lookups find the first copy.
+	inline CPS::SystemTopology multipliedTopology(std::function<CPS::SystemTopology()> load, UInt copies, Real frequency) {
+		CPS::SystemTopology system(frequency);
+		for (UInt c = 0; c < copies; ++c) {
+			CPS::SystemTopology copy = load();
+			system.mNodes.insert(system.mNodes.end(), copy.mNodes.begin(), copy.mNodes.end());
+			system.mComponents.insert(system.mComponents.end(), copy.mComponents.begin(), copy.mComponents.end());
+			system.mComponentsAtNode.insert(copy.mComponentsAtNode.begin(), copy.mComponentsAtNode.end());
+		}
+		system.rebuildIndices();
+		return system;
+	}
+}
+}
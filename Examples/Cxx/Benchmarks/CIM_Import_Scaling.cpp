@@ -0,0 +1,188 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <cps/CIM/Reader.h>
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+/// Prefixes all local RDF identifiers and references, so that several
+/// copies of a model can be parsed into one model
+static String renameIdentifiers(const String& xml, const String& prefix) {
+	String out;
+	out.reserve(xml.size() + xml.size() / 8);
+	std::size_t pos = 0;
+	while (true) {
+		std::size_t next = String::npos;
+		std::size_t length = 0;
+		for (const String key : { "rdf:ID=\"", "rdf:about=\"", "rdf:resource=\"" }) {
+			std::size_t found = xml.find(key, pos);
+			if (found < next) {
+				next = found;
+				length = key.size();
+			}
+		}
+		if (next == String::npos)
+			break;
+
+		std::size_t value = next + length;
+		if (value < xml.size() && xml[value] == '#')
+			++value;
+		out.append(xml, pos, value - pos);
+		// External references like enumeration values stay unchanged
+		if (xml.compare(value, 4, "http") != 0)
+			out += prefix;
+		pos = value;
+	}
+	out.append(xml, pos, String::npos);
+	return out;
+}
+
+/// Writes the given number of renamed copies of the CIM files
+static std::list<fs::path> multipliedFiles(const std::list<fs::path>& filenames, UInt copies, const fs::path& dir) {
+	std::list<fs::path> files;
+	for (auto filename : filenames) {
+		std::ifstream in(filename);
+		std::stringstream xml;
+		xml << in.rdbuf();
+		for (UInt c = 0; c < copies; ++c) {
+			fs::path file = dir / (std::to_string(c) + "_" + filename.filename().string());
+			std::ofstream out(file);
+			out << renameIdentifiers(xml.str(), "c" + std::to_string(c) + "_");
+			files.push_back(file);
+		}
+	}
+	return files;
+}
+
+/// Nodes and components of a topology with their connections and initial
+/// power flow data, for the comparison of imports
+static String topologySignature(const SystemTopology& system) {
+	std::ostringstream out;
+	out << std::setprecision(17);
+	for (auto node : system.mNodes)
+		out << node->uid() << ' ' << node->name() << ' ' << node->initialSingleVoltage() << '\n';
+	for (auto comp : system.mComponents) {
+		out << comp->type() << ' ' << comp->uid() << ' ' << comp->name();
+		if (auto powerComp = std::dynamic_pointer_cast<TopologicalPowerComp>(comp)) {
+			for (auto terminal : powerComp->topologicalTerminals())
+				out << ' ' << terminal->uid() << ' ' << terminal->topologicalNodes()->uid() << ' ' << terminal->power();
+		}
+		out << '\n';
+	}
+	return out.str();
+}
+
+/// Node voltages after a power flow of the topology
+static std::vector<Complex> powerflowVoltages(const String& name, SystemTopology& system) {
+	Simulation sim(name, system, 1, 1, Domain::SP, Solver::Type::NRP, Logger::Level::off);
+	sim.run();
+
+	std::vector<Complex> voltages;
+	for (auto node : system.mNodes)
+		voltages.push_back(std::dynamic_pointer_cast<SimNode<Complex>>(node)->singleVoltage());
+	return voltages;
+}
+
+static Bool CIM_Import_Scaling(const String& model, const std::list<fs::path>& filenames, UInt maxCopies, Domain domain) {
+	fs::path dir = fs::temp_directory_path() / ("CIM_Import_Scaling_" + model);
+	Bool identical = true;
+	for (UInt copies = 1; copies <= maxCopies; copies *= 2) {
+		fs::remove_all(dir);
+		fs::create_directories(dir);
+		auto files = multipliedFiles(filenames, copies, dir);
+
+		// Sequential mapping and mapping with several threads, which must
+		// give the same topology
+		String signature;
+		SystemTopology parsed;
+		for (UInt threads : { 1, 4, 0 }) {
+			auto start = Clock::now();
+			CIM::Reader reader("CIM_Import_Scaling", Logger::Level::off, Logger::Level::off);
+			reader.setNumThreads(threads);
+			SystemTopology system = reader.loadCIM(50, files, domain);
+			auto end = Clock::now();
+
+			std::cout << model << "," << copies << "," << (threads == 0 ? "all" : std::to_string(threads)) << ","
+				<< system.mNodes.size() << "," << system.mComponents.size() << ","
+				<< toMs(end - start) << std::endl;
+
+			if (threads == 1) {
+				signature = topologySignature(system);
+				parsed = system;
+			}
+			else if (topologySignature(system) != signature)
+				identical = false;
+		}
+
+		// Import which writes the topology cache and import from the cache,
+		// which must give the same topology as the parsed files
+		SystemTopology cached;
+		for (String mode : { "cache_write", "cache_read" }) {
+			auto start = Clock::now();
+			CIM::Reader reader("CIM_Import_Scaling", Logger::Level::off, Logger::Level::off);
+			reader.setCacheDirectory(dir / "cache");
+			SystemTopology system = reader.loadCIM(50, files, domain);
+			auto end = Clock::now();
+
+			std::cout << model << "," << copies << "," << mode << ","
+				<< system.mNodes.size() << "," << system.mComponents.size() << ","
+				<< toMs(end - start) << std::endl;
+
+			if (topologySignature(system) != signature)
+				identical = false;
+			cached = system;
+		}
+
+		// The components of the cached topology must also have the same
+		// parameters, which a power flow of a single copy shows
+		if (copies == 1 && domain == Domain::SP
+			&& powerflowVoltages("CIM_Import_Scaling_Parsed", parsed) != powerflowVoltages("CIM_Import_Scaling_Cached", cached))
+			identical = false;
+	}
+	fs::remove_all(dir);
+
+	if (!identical)
+		std::cout << model << ": imports with different numbers of threads or from the cache differ" << std::endl;
+	return identical;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "CIM_Import_Scaling");
+
+	UInt maxCopies = option<UInt>(args, "copies", 16);
+
+	std::cout << "model,copies,mode,nodes,components,import_ms" << std::endl;
+	if (!args.positional.empty())
+		return CIM_Import_Scaling("custom", args.positionalPaths(), maxCopies, Domain::SP) ? 0 : 1;
+
+	Bool identical = CIM_Import_Scaling("CIGRE_MV", DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_06J16h_DI.xml",
+		"Rootnet_FULL_NE_06J16h_EQ.xml",
+		"Rootnet_FULL_NE_06J16h_SV.xml",
+		"Rootnet_FULL_NE_06J16h_TP.xml"
+	}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH"),
+		maxCopies, Domain::SP);
+
+	identical &= CIM_Import_Scaling("IEEE_EU_LV", DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_13J16h_DI.xml",
+		"Rootnet_FULL_NE_13J16h_EQ.xml",
+		"Rootnet_FULL_NE_13J16h_SV.xml",
+		"Rootnet_FULL_NE_13J16h_TP.xml"
+	}, "build/_deps/cim-data-src/IEEE_EU_LV/IEEE_EU_LV_reduced", "CIMPATH"),
+		maxCopies, Domain::SP);
+	return identical ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Chain of resistors between a voltage source and ground
+static SystemTopology chainSystem(UInt sections) {
+	SystemTopology sys(50);
+	auto n0 = SimNode::make("n0");
+	auto vs = VoltageSource::make("vs", CPS::Logger::Level::off);
+	vs->setParameters(Complex(10, 0));
+	vs->connect({ SimNode::GND, n0 });
+	sys.addNode(n0);
+	sys.addComponent(vs);
+
+	auto prev = n0;
+	for (UInt s = 1; s <= sections; ++s) {
+		auto node = SimNode::make("n" + std::to_string(s));
+		auto res = Resistor::make("r" + std::to_string(s), CPS::Logger::Level::off);
+		res->setParameters(1);
+		res->connect({ prev, node });
+		sys.addNode(node);
+		sys.addComponent(res);
+		prev = node;
+	}
+	auto rload = Resistor::make("rload", CPS::Logger::Level::off);
+	rload->setParameters(1);
+	rload->connect({ prev, SimNode::GND });
+	sys.addComponent(rload);
+	return sys;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_Attribute_Wiring");
+
+	UInt sections = option<UInt>(args, "sections", 5000);
+
+	Simulation sim(args.name, CPS::Logger::Level::off);
+	sim.setSystem(chainSystem(sections));
+	auto logger = DataLogger::make(args.name, false);
+	sim.addLogger(logger);
+
+	// One attribute per node and one per component, looked up by name
+	auto start = Clock::now();
+	for (UInt s = 1; s <= sections; ++s) {
+		sim.logIdObjAttr("n" + std::to_string(s), "v");
+		sim.logIdObjAttr("r" + std::to_string(s), "i_intf");
+	}
+	auto wired = Clock::now();
+
+	Real sum = 0;
+	for (UInt s = 1; s <= sections; ++s)
+		sum += sim.getRealIdObjAttr("r" + std::to_string(s), "R");
+	auto read = Clock::now();
+
+	std::cout << "sections: " << sections << ", logged attributes: " << 2 * sections << std::endl;
+	std::cout << "wire / read [ms]: "
+		<< toMs(wired - start) << " / "
+		<< toMs(read - wired) << std::endl;
+
+	// The lookups follow changes of the topology
+	auto sys = chainSystem(3);
+	Bool ok = sum == sections
+		&& sys.component<Resistor>("r2") && !sys.component<Capacitor>("r2")
+		&& sys.node<SimNode>("n3") && sys.componentByUID<Resistor>("r1")
+		&& !sys.component<Resistor>("r9");
+
+	auto replaced = SimNode::make("m1");
+	sys.addNodeAt(replaced, 1);
+	ok = ok && sys.node<SimNode>("m1") == replaced && !sys.node<SimNode>("n1");
+
+	auto appended = SimNode::make("m9");
+	UInt end = static_cast<UInt>(sys.mNodes.size());
+	sys.addNodeAt(appended, end + 1);
+	ok = ok && sys.node<SimNode>("m9") == appended && sys.mNodes.size() == end + 2
+		&& sys.node<SimNode>("n3");
+
+	ok = ok && sys.removeComponent("r2") && !sys.component<Resistor>("r2")
+		&& !sys.removeComponent("r2") && sys.component<Resistor>("r3");
+
+	sys.mComponents.erase(sys.mComponents.begin());
+	sys.rebuildIndices();
+	ok = ok && !sys.component<VoltageSource>("vs") && sys.component<Resistor>("rload");
+
+	auto added = Resistor::make("r2", CPS::Logger::Level::off);
+	sys.addComponent(added);
+	ok = ok && sys.component<Resistor>("r2") == added;
+
+	std::cout << "lookups after changes: " << ok << std::endl;
+	if (!ok)
+		return 1;
+}
@@ -0,0 +1,123 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <functional>
+#include <iostream>
+
+#include <cps/CIM/Reader.h>
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+/// Reports the factorization time and size and the time per step of the
+/// sparse LU implementation. Returns the node voltages after the last step.
+static MatrixComp DP_CIM_Sparse_LU(String gridName, std::function<SystemTopology()> load,
+	String luName, MnaSolverFactory::MnaSolverImpl impl, UInt steps, Real timeStep) {
+	String simName = "DP_CIM_Sparse_LU_" + gridName + "_" + luName;
+	Logger::setLogDir("logs/" + simName);
+
+	// Stamping and factorization of the system matrix
+	auto statSys = load();
+	auto solver = MnaSolverFactory::factory<Complex>(simName + "_Statistics",
+		Domain::DP, Logger::Level::off, impl);
+	solver->setTimeStep(timeStep);
+	solver->setSystem(statSys);
+	auto start = Clock::now();
+	solver->initialize();
+	auto end = Clock::now();
+	Real initTime = toMs(end - start);
+
+	auto sys = load();
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(steps * timeStep);
+	sim.setMnaSolverImplementation(impl);
+	sim.initialize();
+	start = Clock::now();
+	for (UInt step = 0; step < steps; ++step)
+		sim.next();
+	end = Clock::now();
+
+	std::cout << gridName << ","
+		<< luName << ","
+		<< sys.mNodes.size() << ","
+		<< initTime << ","
+		<< solver->attribute<Int>("lu_nonzeros")->get() << ","
+		<< toUs(end - start) / steps << std::endl;
+
+	MatrixComp voltages(sys.mNodes.size(), 1);
+	for (UInt i = 0; i < sys.mNodes.size(); ++i)
+		voltages(i, 0) = std::dynamic_pointer_cast<DP::SimNode>(sys.mNodes[i])->singleVoltage();
+	return voltages;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_CIM_Sparse_LU", 0.0001, 0.1);
+
+	UInt copies = option<UInt>(args, "copies", 16);
+	UInt steps = static_cast<UInt>(args.duration / args.timeStep);
+
+	auto wsccFiles = DPsim::Utils::findFiles({
+		"WSCC-09_RX_DI.xml",
+		"WSCC-09_RX_EQ.xml",
+		"WSCC-09_RX_SV.xml",
+		"WSCC-09_RX_TP.xml"
+	}, "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", "CIMPATH");
+	auto wscc = [&]() {
+		return multipliedTopology([&]() {
+			CIM::Reader reader("DP_CIM_Sparse_LU", Logger::Level::off, Logger::Level::off);
+			return reader.loadCIM(60, wsccFiles, Domain::DP);
+		}, copies, 60);
+	};
+
+	auto cigreFiles = DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_06J16h_DI.xml",
+		"Rootnet_FULL_NE_06J16h_EQ.xml",
+		"Rootnet_FULL_NE_06J16h_SV.xml",
+		"Rootnet_FULL_NE_06J16h_TP.xml"
+	}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH");
+
+	// The dynamic CIGRE system is initialized from a powerflow solution
+	CIM::Reader readerPF("DP_CIM_Sparse_LU_Powerflow", Logger::Level::off, Logger::Level::off);
+	SystemTopology systemPF = readerPF.loadCIM(50, cigreFiles, Domain::SP);
+	Simulation simPF("DP_CIM_Sparse_LU_Powerflow", systemPF, 1, 2, Domain::SP, Solver::Type::NRP, Logger::Level::off, true);
+	simPF.run();
+	auto cigre = [&]() {
+		return multipliedTopology([&]() {
+			CIM::Reader reader("DP_CIM_Sparse_LU", Logger::Level::off, Logger::Level::off);
+			SystemTopology system = reader.loadCIM(50, cigreFiles, Domain::DP);
+			reader.initDynamicSystemTopologyWithPowerflow(systemPF, system);
+			return system;
+		}, copies, 50);
+	};
+
+	std::cout << "grid,lu,nodes,init_ms,lu_nonzeros,step_us" << std::endl;
+	Real maxDeviation = 0;
+	std::vector<std::pair<String, std::function<SystemTopology()>>> grids = {
+		{ "WSCC-9bus", wscc },
+		{ "CIGRE-MV", cigre }
+	};
+	for (auto& grid : grids) {
+		auto vEigen = DP_CIM_Sparse_LU(grid.first, grid.second,
+			"EigenSparse", MnaSolverFactory::EigenSparse, steps, args.timeStep);
+		auto vCircuit = DP_CIM_Sparse_LU(grid.first, grid.second,
+			"CircuitSparse", MnaSolverFactory::CircuitSparse, steps, args.timeStep);
+		maxDeviation = std::max(maxDeviation,
+			(vEigen - vCircuit).cwiseAbs().maxCoeff() / vEigen.cwiseAbs().maxCoeff());
+	}
+
+	// Both factorizations have to yield the same solution
+	std::cout << "max relative deviation: " << maxDeviation << std::endl;
+	if (maxDeviation > 1e-6)
+		return 1;
+}
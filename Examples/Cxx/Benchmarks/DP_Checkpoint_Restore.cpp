@@ -0,0 +1,121 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <sstream>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Source feeding a pi line, a decoupling line with its delay buffers and
+/// a resistive load, which has internal states besides the attributes
+static SystemTopology lineSystem(SimNode::Ptr& probe) {
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+
+	auto vs = VoltageSource::make("vs", Logger::Level::off);
+	vs->setParameters(CPS::Math::polar(100000, 0));
+	auto piLine = PiLine::make("pi_line", Logger::Level::off);
+	piLine->setParameters(2, 0.05, 1e-6);
+	auto dline = CPS::Signal::DecouplingLine::make("dec_line", Logger::Level::off);
+	dline->setParameters(n2, n3, 5, 0.16, 1e-6);
+	auto load = Resistor::make("load", Logger::Level::off);
+	load->setParameters(10000);
+
+	vs->connect({ SimNode::GND, n1 });
+	piLine->connect({ n1, n2 });
+	load->connect({ n3, SimNode::GND });
+
+	auto sys = SystemTopology(50,
+		SystemNodeList{ n1, n2, n3 },
+		SystemComponentList{ vs, piLine, dline, load });
+	sys.addComponents(dline->getLineComponents());
+
+	probe = n3;
+	return sys;
+}
+
+static void setup(Simulation& sim, const SystemTopology& sys, Real timeStep, Real finalTime) {
+	sim.setSystem(sys);
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(finalTime);
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_Checkpoint_Restore", 0.00005, 0.02);
+	String simName = args.name;
+	Logger::setLogDir("logs/" + simName);
+
+	UInt steps = static_cast<UInt>(args.duration / args.timeStep);
+	UInt checkpointStep = steps / 2;
+
+	// Reference run, which writes a checkpoint halfway
+	SimNode::Ptr probe;
+	Simulation sim(simName, Logger::Level::off);
+	setup(sim, lineSystem(probe), args.timeStep, args.duration);
+	sim.initialize();
+
+	auto start = Clock::now();
+	for (UInt step = 0; step < checkpointStep; ++step)
+		sim.next();
+	auto end = Clock::now();
+	Real prefixTime = toMs(end - start);
+
+	std::stringstream checkpoint;
+	start = Clock::now();
+	sim.writeCheckpoint(checkpoint);
+	end = Clock::now();
+	Real writeTime = toMs(end - start);
+	String data = checkpoint.str();
+
+	while (sim.time() < args.duration - args.timeStep / 2)
+		sim.next();
+	Complex reference = probe->singleVoltage();
+
+	// Restore into a fresh simulation of a separately built system
+	SimNode::Ptr freshProbe;
+	Simulation fresh(simName + "_Fresh", Logger::Level::off);
+	setup(fresh, lineSystem(freshProbe), args.timeStep, args.duration);
+	std::istringstream in(data);
+	start = Clock::now();
+	fresh.readCheckpoint(in);
+	end = Clock::now();
+	Real readTime = toMs(end - start);
+	while (fresh.time() < args.duration - args.timeStep / 2)
+		fresh.next();
+	Complex restored = freshProbe->singleVoltage();
+
+	// Rewind the reference simulation to the checkpoint
+	std::istringstream rewind(data);
+	sim.readCheckpoint(rewind);
+	if (sim.timeStepCount() != static_cast<Int>(checkpointStep))
+		return 1;
+	while (sim.time() < args.duration - args.timeStep / 2)
+		sim.next();
+	Complex rewound = probe->singleVoltage();
+
+	std::cout << "checkpoint bytes: " << data.size() << std::endl;
+	std::cout << "simulate to checkpoint [ms]: " << prefixTime << std::endl;
+	std::cout << "write checkpoint [ms]: " << writeTime << std::endl;
+	std::cout << "read checkpoint [ms]: " << readTime << std::endl;
+
+	// The continued runs must reproduce the reference exactly
+	Real freshDeviation = relativeDeviation(restored, reference);
+	Real rewindDeviation = relativeDeviation(rewound, reference);
+	std::cout << "relative deviation fresh: " << freshDeviation << std::endl;
+	std::cout << "relative deviation rewind: " << rewindDeviation << std::endl;
+	if (freshDeviation > 1e-12 || rewindDeviation > 1e-12)
+		return 1;
+}
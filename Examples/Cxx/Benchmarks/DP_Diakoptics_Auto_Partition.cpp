@@ -0,0 +1,134 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Square mesh of inductive branches with a resistive load at every node
+/// and a voltage source behind a resistor at every corner.
+static SystemTopology mesh(UInt size, SimNode::Ptr& probe) {
+	SystemTopology sys(50, SystemNodeList{}, SystemComponentList{});
+	std::vector<SimNode::Ptr> nodes;
+
+	for (UInt row = 0; row < size; ++row) {
+		for (UInt col = 0; col < size; ++col) {
+			String id = std::to_string(row) + "_" + std::to_string(col);
+			auto node = SimNode::make("n" + id);
+			sys.addNode(node);
+			nodes.push_back(node);
+
+			auto load = Resistor::make("r_load_" + id, Logger::Level::off);
+			load->setParameters(500);
+			load->connect({ node, SimNode::GND });
+			sys.addComponent(load);
+
+			if (col > 0) {
+				auto line = Inductor::make("l_h_" + id, Logger::Level::off);
+				line->setParameters(0.001);
+				line->connect({ nodes[row * size + col - 1], node });
+				sys.addComponent(line);
+			}
+			if (row > 0) {
+				auto line = Inductor::make("l_v_" + id, Logger::Level::off);
+				line->setParameters(0.001);
+				line->connect({ nodes[(row - 1) * size + col], node });
+				sys.addComponent(line);
+			}
+		}
+	}
+
+	UInt corners[] = { 0, size - 1, size * (size - 1), size * size - 1 };
+	for (UInt idx = 0; idx < 4; ++idx) {
+		String id = std::to_string(idx);
+		auto nSource = SimNode::make("n_vs_" + id);
+		sys.addNode(nSource);
+		auto vs = VoltageSource::make("vs_" + id, Logger::Level::off);
+		vs->setParameters(Complex(10000, 1000. * idx));
+		vs->connect({ SimNode::GND, nSource });
+		sys.addComponent(vs);
+		auto rs = Resistor::make("r_vs_" + id, Logger::Level::off);
+		rs->setParameters(1);
+		rs->connect({ nSource, nodes[corners[idx]] });
+		sys.addComponent(rs);
+	}
+	probe = nodes[size * size / 2];
+
+	return sys;
+}
+
+/// Partitions the mesh automatically, reports the partition quality and
+/// compares the time per step and the result with the untorn system.
+static void DP_Diakoptics_Auto_Partition(UInt size, UInt parts, UInt steps, Real timeStep) {
+	String simName = "DP_Diakoptics_Auto_Partition";
+
+	SimNode::Ptr refProbe;
+	auto refSys = mesh(size, refProbe);
+	Simulation ref(simName + "_Reference", Logger::Level::off);
+	ref.setSystem(refSys);
+	ref.setTimeStep(timeStep);
+	ref.setFinalTime(steps * timeStep);
+	ref.initialize();
+	auto refStart = Clock::now();
+	for (UInt step = 0; step < steps; ++step)
+		ref.next();
+	auto refEnd = Clock::now();
+
+	SimNode::Ptr probe;
+	auto sys = mesh(size, probe);
+	auto start = Clock::now();
+	TopologyPartitioner partitioner(parts, Logger::Level::off);
+	auto partition = partitioner.partition<Complex>(sys);
+	auto partitioned = Clock::now();
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(steps * timeStep);
+	sim.setTearingComponents(sys.mTearComponents);
+	sim.initialize();
+	auto simStart = Clock::now();
+	for (UInt step = 0; step < steps; ++step)
+		sim.next();
+	auto simEnd = Clock::now();
+
+	Real error = std::abs(probe->singleVoltage() - refProbe->singleVoltage());
+
+	std::cout << size * size << ","
+		<< parts << ","
+		<< partition.tearComponents.size() << ","
+		<< partition.imbalance << ","
+		<< partition.predictedSpeedup << ","
+		<< toMs(partitioned - start) << ","
+		<< toMs(refEnd - refStart) * 1000 / steps << ","
+		<< toMs(simEnd - simStart) * 1000 / steps << ","
+		<< error << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt size = option<UInt>(args, "size", 24);
+
+	UInt maxParts = option<UInt>(args, "parts", 16);
+
+	UInt steps = option<UInt>(args, "steps", 100);
+
+	Logger::setLogDir("logs/DP_Diakoptics_Auto_Partition");
+
+	std::cout << "nodes,parts,tear_components,imbalance,predicted_speedup,partition_ms,"
+		<< "mna_step_us,diakoptics_step_us,voltage_error" << std::endl;
+	for (UInt parts = 2; parts <= maxParts; parts *= 2)
+		DP_Diakoptics_Auto_Partition(size, parts, steps, args.timeStep);
+}
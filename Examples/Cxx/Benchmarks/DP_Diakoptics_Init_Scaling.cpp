@@ -0,0 +1,144 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/WorkStealingScheduler.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Chain of subnets, each a ladder of RL sections fed by a voltage source.
+/// Neighbouring subnets are connected by a line which is torn if tear is
+/// set, so the network is split into one subnet per ladder.
+static SystemTopology chain(UInt subnets, UInt sections, Bool tear, SimNode::Ptr& probe) {
+	SystemNodeList nodes;
+	SystemComponentList comps;
+	SystemTopology sys(50, nodes, comps);
+
+	SimNode::Ptr prevEnd;
+	for (UInt net = 0; net < subnets; ++net) {
+		String netId = std::to_string(net);
+		auto n0 = SimNode::make("n" + netId);
+		sys.addNode(n0);
+
+		auto vs = VoltageSource::make("vs_" + netId, Logger::Level::off);
+		vs->setParameters(Complex(10000, 100. * net));
+		vs->connect({ SimNode::GND, n0 });
+		sys.addComponent(vs);
+
+		auto prev = n0;
+		for (UInt s = 0; s < sections; ++s) {
+			String id = netId + "_" + std::to_string(s);
+			auto nMid = SimNode::make("n" + id + "_m");
+			auto nEnd = SimNode::make("n" + id + "_e");
+
+			auto r = Resistor::make("r_" + id, Logger::Level::off);
+			r->setParameters(0.1);
+			r->connect({ prev, nMid });
+			auto l = Inductor::make("l_" + id, Logger::Level::off);
+			l->setParameters(0.001);
+			l->connect({ nMid, nEnd });
+			auto rs = Resistor::make("rs_" + id, Logger::Level::off);
+			rs->setParameters(1000);
+			rs->connect({ nEnd, SimNode::GND });
+
+			sys.addNode(nMid);
+			sys.addNode(nEnd);
+			sys.addComponent(r);
+			sys.addComponent(l);
+			sys.addComponent(rs);
+			prev = nEnd;
+		}
+
+		if (prevEnd) {
+			auto line = Resistor::make("line_" + netId, Logger::Level::off);
+			line->setParameters(1);
+			line->connect({ prevEnd, prev });
+			if (tear)
+				sys.addTearComponent(line);
+			else
+				sys.addComponent(line);
+		}
+		prevEnd = prev;
+	}
+	probe = prevEnd;
+
+	return sys;
+}
+
+/// Measures the initialization time of the diakoptics solver and the
+/// time per step, and compares the result with the unsplit system.
+/// The subnet tasks are executed by threads if threads is not zero.
+static void DP_Diakoptics_Init_Scaling(UInt subnets, UInt sections, UInt steps, Real timeStep, UInt threads) {
+	String simName = "DP_Diakoptics_Init_Scaling";
+
+	SimNode::Ptr probe;
+	auto sys = chain(subnets, sections, true, probe);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(steps * timeStep);
+	sim.setTearingComponents(sys.mTearComponents);
+	if (threads > 0)
+		sim.setScheduler(std::make_shared<WorkStealingScheduler>(threads));
+
+	auto start = Clock::now();
+	sim.initialize();
+	auto initialized = Clock::now();
+	for (UInt step = 0; step < steps; ++step)
+		sim.next();
+	auto finished = Clock::now();
+
+	// Reference solution without tearing
+	SimNode::Ptr refProbe;
+	auto refSys = chain(subnets, sections, false, refProbe);
+	Simulation ref(simName + "_Reference", Logger::Level::off);
+	ref.setSystem(refSys);
+	ref.setTimeStep(timeStep);
+	ref.setFinalTime(steps * timeStep);
+	ref.initialize();
+	for (UInt step = 0; step < steps; ++step)
+		ref.next();
+
+	Real error = std::abs(probe->singleVoltage() - refProbe->singleVoltage());
+
+	std::cout << threads << ","
+		<< subnets << ","
+		<< sys.mNodes.size() << ","
+		<< toMs(initialized - start) << ","
+		<< toMs(finished - initialized) * 1000 / steps << ","
+		<< error << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt maxSubnets = option<UInt>(args, "subnets", 64);
+
+	UInt sections = option<UInt>(args, "sections", 10);
+
+	UInt steps = option<UInt>(args, "steps", 100);
+
+	// Thread counts up to the given one are compared, zero runs the
+	// tasks sequentially
+	UInt maxThreads = option<UInt>(args, "threads", 0);
+
+	Logger::setLogDir("logs/DP_Diakoptics_Init_Scaling");
+
+	std::cout << "threads,subnets,nodes,init_ms,step_us,voltage_error" << std::endl;
+	for (UInt threads = 0; threads <= maxThreads; threads = (threads == 0) ? 1 : 2 * threads) {
+		for (UInt subnets = 2; subnets <= maxSubnets; subnets *= 2)
+			DP_Diakoptics_Init_Scaling(subnets, sections, steps, args.timeStep, threads);
+	}
+}
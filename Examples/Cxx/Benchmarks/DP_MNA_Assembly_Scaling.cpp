@@ -0,0 +1,120 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Ladder network of RL sections with a shunt resistor at the end of each
+/// section. The number of non-zeros in the system matrix grows linearly with
+/// the number of sections, while the dense matrix grows quadratically.
+static SystemTopology ladder(UInt sections) {
+	SystemNodeList nodes;
+	SystemComponentList comps;
+
+	auto n0 = SimNode::make("n0");
+	nodes.push_back(n0);
+
+	auto vs = VoltageSource::make("vs", Logger::Level::off);
+	vs->setParameters(Complex(10000, 0));
+	vs->connect({ SimNode::GND, n0 });
+	comps.push_back(vs);
+
+	auto prev = n0;
+	for (UInt s = 0; s < sections; ++s) {
+		String id = std::to_string(s);
+		auto nMid = SimNode::make("n" + id + "_m");
+		auto nEnd = SimNode::make("n" + id + "_e");
+
+		auto r = Resistor::make("r_" + id, Logger::Level::off);
+		r->setParameters(0.1);
+		r->connect({ prev, nMid });
+		auto l = Inductor::make("l_" + id, Logger::Level::off);
+		l->setParameters(0.001);
+		l->connect({ nMid, nEnd });
+		auto rs = Resistor::make("rs_" + id, Logger::Level::off);
+		rs->setParameters(1000);
+		rs->connect({ nEnd, SimNode::GND });
+
+		nodes.push_back(nMid);
+		nodes.push_back(nEnd);
+		comps.push_back(r);
+		comps.push_back(l);
+		comps.push_back(rs);
+		prev = nEnd;
+	}
+
+	return SystemTopology(50, nodes, comps);
+}
+
+/// Measures the time to stamp the system matrix of the ladder network
+/// natively into a sparse matrix and the additional cost of converting it
+/// to the dense matrix used by the EigenDense solver.
+static void DP_MNA_Assembly_Scaling(UInt sections, Real timeStep, UInt repetitions) {
+	auto sys = ladder(sections);
+
+	// Let the solver initialize the components and assign matrix indices
+	auto solver = MnaSolverFactory::factory<Complex>("DP_MNA_Assembly_Scaling",
+		Domain::DP, Logger::Level::off);
+	solver->setTimeStep(timeStep);
+	solver->setSystem(sys);
+	solver->initialize();
+
+	CPS::MNAInterface::List mnaComps;
+	for (auto comp : sys.mComponents) {
+		auto mnaComp = std::dynamic_pointer_cast<CPS::MNAInterface>(comp);
+		if (mnaComp)
+			mnaComps.push_back(mnaComp);
+	}
+
+	// Real equivalent system with real and imaginary parts of all nodes
+	Int dim = solver->attribute<Matrix>("left_vector")->get().rows();
+
+	auto sparseTime = Clock::duration::zero();
+	auto denseTime = Clock::duration::zero();
+	Int nnz = 0;
+
+	for (UInt rep = 0; rep < repetitions; ++rep) {
+		auto start = Clock::now();
+		SparseMatrix sparseSys(dim, dim);
+		for (auto comp : mnaComps)
+			comp->mnaApplySystemMatrixStamp(sparseSys);
+		sparseSys.makeCompressed();
+		auto stamped = Clock::now();
+		Matrix denseSys = Matrix(sparseSys);
+		auto converted = Clock::now();
+
+		sparseTime += stamped - start;
+		denseTime += converted - start;
+		nnz = sparseSys.nonZeros();
+	}
+
+	std::cout << sections << ","
+		<< dim << ","
+		<< nnz << ","
+		<< toMs(sparseTime) / repetitions << ","
+		<< toMs(denseTime) / repetitions << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt maxSections = option<UInt>(args, "sections", 1600);
+
+	UInt repetitions = option<UInt>(args, "repetitions", 10);
+
+	std::cout << "sections,dimension,nnz,sparse_assembly_ms,dense_assembly_ms" << std::endl;
+	for (UInt sections = 25; sections <= maxSections; sections *= 2)
+		DP_MNA_Assembly_Scaling(sections, args.timeStep, repetitions);
+}
@@ -0,0 +1,211 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <limits>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Meshed grid with the set point of the voltage source of a scenario
+static SystemTopology scenarioGrid(UInt size, UInt scenario, SimNode::Ptr& probe) {
+	MeshedGridParameters params;
+	params.voltage = std::polar(10000. * (1 + 0.05 * scenario), 0.1 * scenario);
+	std::vector<SimNode::Ptr> grid;
+	auto sys = meshedGrid(size, params, grid);
+	probe = grid.back();
+	return sys;
+}
+
+/// Initialization and step time of a mode. The steps are timed in blocks
+/// and the fastest block is reported, which is less sensitive to other load
+/// on the machine.
+struct Timing {
+	Real initMs = 0;
+	Real stepUs = 0;
+};
+
+/// Simulation of a scenario without the batched solver
+static std::shared_ptr<Simulation> scenarioSimulation(const String& simName, const SystemTopology& sys,
+	SimNode::Ptr probe, UInt steps, UInt blocks, Real timeStep) {
+	Logger::setLogDir("logs/" + simName);
+	auto sim = std::make_shared<Simulation>(simName, Logger::Level::off);
+	sim->setSystem(sys);
+	sim->setDomain(Domain::DP);
+	sim->setTimeStep(timeStep);
+	sim->setFinalTime(blocks * steps * timeStep);
+	sim->setMnaSolverImplementation(MnaSolverFactory::EigenSparse);
+
+	auto logger = DataLogger::make(simName);
+	logger->addAttribute("v_probe", probe->attribute("v"));
+	sim->addLogger(logger);
+	return sim;
+}
+
+/// Simulates the scenarios one after another with separate simulations.
+/// Returns the time per step of all scenarios together.
+static Timing separateScenarios(UInt scenarios, UInt size, UInt steps, UInt blocks, Real timeStep, std::vector<Complex>& results) {
+	Timing timing;
+	for (UInt k = 0; k < scenarios; ++k) {
+		SimNode::Ptr probe;
+		auto sys = scenarioGrid(size, k, probe);
+		auto sim = scenarioSimulation("DP_MNA_Batched_Scenarios_Separate_" + std::to_string(k),
+			sys, probe, steps, blocks, timeStep);
+
+		auto start = Clock::now();
+		sim->initialize();
+		timing.initMs += elapsedMs(start);
+
+		Real stepUs = std::numeric_limits<Real>::max();
+		for (UInt block = 0; block < blocks; ++block) {
+			start = Clock::now();
+			for (UInt step = 0; step < steps; ++step)
+				sim->next();
+			stepUs = std::min(stepUs, toUs(Clock::now() - start) / steps);
+		}
+		timing.stepUs += stepUs;
+		results.push_back(probe->singleVoltage());
+	}
+	return timing;
+}
+
+/// Simulates the scenarios with separate simulations that advance together
+/// step by step, like the scenarios of the batched solver
+static Timing lockstepScenarios(UInt scenarios, UInt size, UInt steps, UInt blocks, Real timeStep, std::vector<Complex>& results) {
+	std::vector<SimNode::Ptr> probes(scenarios);
+	std::vector<SystemTopology> systems;
+	for (UInt k = 0; k < scenarios; ++k)
+		systems.push_back(scenarioGrid(size, k, probes[k]));
+
+	Timing timing;
+	std::vector<std::shared_ptr<Simulation>> sims;
+	auto start = Clock::now();
+	for (UInt k = 0; k < scenarios; ++k) {
+		sims.push_back(scenarioSimulation("DP_MNA_Batched_Scenarios_Lockstep_" + std::to_string(k),
+			systems[k], probes[k], steps, blocks, timeStep));
+		sims.back()->initialize();
+	}
+	timing.initMs = elapsedMs(start);
+
+	timing.stepUs = std::numeric_limits<Real>::max();
+	for (UInt block = 0; block < blocks; ++block) {
+		start = Clock::now();
+		for (UInt step = 0; step < steps; ++step) {
+			for (auto sim : sims)
+				sim->next();
+		}
+		timing.stepUs = std::min(timing.stepUs, toUs(Clock::now() - start) / steps);
+	}
+	for (auto probe : probes)
+		results.push_back(probe->singleVoltage());
+	return timing;
+}
+
+/// Simulates the scenarios together with one factorization of the system
+/// matrix. Returns the time per step of all scenarios together.
+static Timing batchedScenarios(UInt scenarios, UInt size, UInt steps, UInt blocks, Real timeStep, std::vector<Complex>& results) {
+	String simName = "DP_MNA_Batched_Scenarios_Batched";
+	Logger::setLogDir("logs/" + simName);
+
+	std::vector<SimNode::Ptr> probes(scenarios);
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(scenarioGrid(size, 0, probes[0]));
+	for (UInt k = 1; k < scenarios; ++k)
+		sim.addScenario(scenarioGrid(size, k, probes[k]));
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(blocks * steps * timeStep);
+	sim.setMnaSolverImplementation(MnaSolverFactory::EigenSparse);
+
+	// Every scenario has its own logger
+	for (UInt k = 0; k < scenarios; ++k) {
+		auto logger = DataLogger::make(simName + "_" + std::to_string(k));
+		logger->addAttribute("v_probe", probes[k]->attribute("v"));
+		sim.addLogger(logger);
+	}
+
+	Timing timing;
+	auto start = Clock::now();
+	sim.initialize();
+	timing.initMs = elapsedMs(start);
+
+	timing.stepUs = std::numeric_limits<Real>::max();
+	for (UInt block = 0; block < blocks; ++block) {
+		start = Clock::now();
+		for (UInt step = 0; step < steps; ++step)
+			sim.next();
+		timing.stepUs = std::min(timing.stepUs, toUs(Clock::now() - start) / steps);
+	}
+	for (auto probe : probes)
+		results.push_back(probe->singleVoltage());
+	return timing;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_MNA_Batched_Scenarios", 0.0001, 0.01);
+
+	UInt blocks = option<UInt>(args, "blocks", 5);
+	UInt steps = static_cast<UInt>(args.duration / args.timeStep);
+
+	// Grid sizes and numbers of scenarios, or the one given on the command line
+	std::vector<std::pair<UInt, UInt>> configs = {
+		{ 4, 2 }, { 4, 4 }, { 4, 8 }, { 4, 16 }, { 8, 2 }, { 8, 4 }, { 12, 2 }, { 12, 8 }
+	};
+	if (args.options.count("size") || args.options.count("scenarios"))
+		configs = { { option<UInt>(args, "size", 4), option<UInt>(args, "scenarios", 8) } };
+
+	// The batched solver saves the factorizations of all but one scenario and
+	// solves the right sides of all scenarios at once. Scenarios that advance
+	// together touch the component data of all scenarios in every step,
+	// while separate runs keep the data of one scenario in cache. Batching
+	// pays off as long as the component data of all scenarios fits into the
+	// cache, which the lockstep runs of separate simulations show as well.
+	std::cout << "size,scenarios,separate_init_ms,batched_init_ms,separate_step_us,lockstep_step_us,batched_step_us,step_speedup" << std::endl;
+	Real maxDeviation = 0;
+	for (auto& config : configs) {
+		UInt size = config.first, scenarios = config.second;
+		std::vector<Complex> separate, lockstep, batched;
+		Timing separateTime = separateScenarios(scenarios, size, steps, blocks, args.timeStep, separate);
+		Timing lockstepTime = lockstepScenarios(scenarios, size, steps, blocks, args.timeStep, lockstep);
+		Timing batchedTime = batchedScenarios(scenarios, size, steps, blocks, args.timeStep, batched);
+		std::cout << size << "," << scenarios << "," << separateTime.initMs << "," << batchedTime.initMs << ","
+			<< separateTime.stepUs << "," << lockstepTime.stepUs << "," << batchedTime.stepUs << ","
+			<< separateTime.stepUs / batchedTime.stepUs << std::endl;
+
+		// Batching must not change the results of the scenarios
+		for (UInt k = 0; k < scenarios; ++k) {
+			maxDeviation = std::max(maxDeviation, relativeDeviation(batched[k], separate[k]));
+			maxDeviation = std::max(maxDeviation, relativeDeviation(lockstep[k], separate[k]));
+		}
+	}
+	std::cout << "max relative deviation: " << maxDeviation << std::endl;
+	if (maxDeviation > 1e-9)
+		return 1;
+
+	// Torn components would be solved in separate subsystems per scenario,
+	// which the batched solver does not support
+	SimNode::Ptr probe;
+	auto sys = scenarioGrid(2, 0, probe);
+	Simulation torn("DP_MNA_Batched_Scenarios_Torn", Logger::Level::off);
+	torn.setSystem(sys);
+	torn.addScenario(scenarioGrid(2, 1, probe));
+	torn.setDomain(Domain::DP);
+	torn.setTimeStep(args.timeStep);
+	torn.setFinalTime(args.timeStep);
+	torn.setTearingComponents({ sys.component<Inductor>("l_h0_0") });
+	try {
+		torn.initialize();
+		std::cout << "batched scenarios with tear components were accepted" << std::endl;
+		return 1;
+	} catch (const CPS::SystemError&) { }
+}
@@ -0,0 +1,120 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <limits>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Time per step of converting the right side vector to a complex vector
+/// and the solution back to its real expansion, which the complex system
+/// adds to every step
+static Real conversionUs(UInt dimension) {
+	Matrix rhs = Matrix::Random(2 * dimension, 1);
+	Matrix lhs(2 * dimension, 1);
+	MatrixComp complexRhs(dimension, 1);
+	UInt repetitions = 1000;
+	Real best = std::numeric_limits<Real>::max();
+	for (UInt block = 0; block < 5; ++block) {
+		auto start = Clock::now();
+		for (UInt k = 0; k < repetitions; ++k) {
+			CPS::Math::complexFromRealExpansion(rhs, complexRhs);
+			CPS::Math::realExpansionFromComplex(complexRhs, lhs);
+		}
+		best = std::min(best, toUs(Clock::now() - start) / repetitions);
+	}
+	return best;
+}
+
+/// Reports the memory of the LU factors and the time per step of the real
+/// expanded and the complex system matrix for a dense or sparse solver.
+/// The steps are timed in blocks and the fastest block is reported, which
+/// is less sensitive to other load on the machine.
+static Complex DP_MNA_Complex_Native(String implName, MnaSolverFactory::MnaSolverImpl impl,
+	Bool complexNative, UInt size, UInt steps, UInt blocks, Real timeStep) {
+	String simName = "DP_MNA_Complex_Native_" + implName + (complexNative ? "_Complex" : "_Real");
+	Logger::setLogDir("logs/" + simName);
+
+	std::vector<SimNode::Ptr> grid;
+	auto sys = meshedGrid(size, MeshedGridParameters(), grid);
+	SimNode::Ptr probe = grid.back();
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(blocks * steps * timeStep);
+	sim.setMnaSolverImplementation(impl);
+	sim.doComplexNativeSystem(complexNative);
+	sim.initialize();
+	Real stepUs = std::numeric_limits<Real>::max();
+	for (UInt block = 0; block < blocks; ++block) {
+		auto start = Clock::now();
+		for (UInt step = 0; step < steps; ++step)
+			sim.next();
+		stepUs = std::min(stepUs, toUs(Clock::now() - start) / steps);
+	}
+
+	auto solver = MnaSolverFactory::factory<Complex>(simName + "_Statistics",
+		Domain::DP, Logger::Level::off, impl);
+	solver->setTimeStep(timeStep);
+	solver->setSystem(meshedGrid(size, MeshedGridParameters(), grid));
+	solver->doComplexNativeSystem(complexNative);
+	solver->initialize();
+
+	// The real expansion has twice the dimension with real entries,
+	// the complex matrix has complex entries
+	Real dimension = static_cast<Real>(solver->leftSideVector().rows());
+	if (complexNative)
+		dimension /= 2;
+	Real entryBytes = complexNative ? sizeof(Complex) : sizeof(Real);
+	Real luBytes;
+	if (impl == MnaSolverFactory::EigenDense)
+		luBytes = dimension * dimension * entryBytes;
+	else
+		luBytes = solver->attribute<Int>("lu_nonzeros")->get() * entryBytes;
+
+	std::cout << implName << ","
+		<< (complexNative ? "complex" : "real") << ","
+		<< static_cast<Int>(dimension) << ","
+		<< luBytes / 1024 << ","
+		<< stepUs << ","
+		<< (complexNative ? conversionUs(static_cast<UInt>(dimension)) : 0) << std::endl;
+
+	return probe->singleVoltage();
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_MNA_Complex_Native", 0.0001, 0.01);
+
+	UInt size = option<UInt>(args, "size", 12);
+	UInt steps = static_cast<UInt>(args.duration / args.timeStep);
+	UInt blocks = option<UInt>(args, "blocks", 5);
+
+	std::cout << "impl,system,dimension,lu_kib,step_us,conversion_us" << std::endl;
+	Real maxDeviation = 0;
+	std::vector<std::pair<String, MnaSolverFactory::MnaSolverImpl>> impls = {
+		{ "EigenDense", MnaSolverFactory::EigenDense },
+		{ "EigenSparse", MnaSolverFactory::EigenSparse }
+	};
+	for (auto& impl : impls) {
+		auto vReal = DP_MNA_Complex_Native(impl.first, impl.second, false, size, steps, blocks, args.timeStep);
+		auto vComplex = DP_MNA_Complex_Native(impl.first, impl.second, true, size, steps, blocks, args.timeStep);
+		maxDeviation = std::max(maxDeviation, relativeDeviation(vComplex, vReal));
+	}
+
+	// The complex factorization must not change the solution
+	std::cout << "max relative deviation: " << maxDeviation << std::endl;
+	if (maxDeviation > 1e-9)
+		return 1;
+}
@@ -0,0 +1,134 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Radial feeder with a trunk of RL sections and a lateral of RL sections
+/// with a resistive load at every node. The nodes are listed in a random
+/// order, like they can appear in a CIM file.
+static SystemTopology radialFeeder(UInt laterals, UInt sections, SimNode::Ptr& probe) {
+	SystemNodeList nodes;
+	SystemComponentList comps;
+
+	auto n0 = SimNode::make("n0");
+	nodes.push_back(n0);
+	auto vs = VoltageSource::make("vs", Logger::Level::off);
+	vs->setParameters(Complex(10000, 0));
+	vs->connect({ SimNode::GND, n0 });
+	comps.push_back(vs);
+
+	auto section = [&](String id, SimNode::Ptr from) {
+		auto nMid = SimNode::make("n" + id + "_m");
+		auto nEnd = SimNode::make("n" + id + "_e");
+		auto r = Resistor::make("r_" + id, Logger::Level::off);
+		r->setParameters(0.1);
+		r->connect({ from, nMid });
+		auto l = Inductor::make("l_" + id, Logger::Level::off);
+		l->setParameters(0.001);
+		l->connect({ nMid, nEnd });
+		auto load = Resistor::make("load_" + id, Logger::Level::off);
+		load->setParameters(5000);
+		load->connect({ nEnd, SimNode::GND });
+		nodes.push_back(nMid);
+		nodes.push_back(nEnd);
+		comps.push_back(r);
+		comps.push_back(l);
+		comps.push_back(load);
+		return nEnd;
+	};
+
+	auto trunk = n0;
+	for (UInt lat = 0; lat < laterals; ++lat) {
+		String latId = std::to_string(lat);
+		trunk = section("t" + latId, trunk);
+		auto prev = trunk;
+		for (UInt s = 0; s < sections; ++s)
+			prev = section(latId + "_" + std::to_string(s), prev);
+		if (lat == laterals / 2)
+			probe = prev;
+	}
+
+	std::mt19937 rng(42);
+	std::shuffle(nodes.begin(), nodes.end(), rng);
+
+	return SystemTopology(50, nodes, comps);
+}
+
+/// Reports the node bandwidth, the non-zeros of the sparse LU factors and the
+/// time per step of the radial feeder for the given node ordering.
+static Complex DP_MNA_Node_Ordering(String orderingName, MnaNodeOrdering ordering,
+	UInt laterals, UInt sections, UInt steps, CommandLineArgs& args) {
+	String simName = "DP_MNA_Node_Ordering_" + orderingName;
+
+	SimNode::Ptr probe;
+	auto statSys = radialFeeder(laterals, sections, probe);
+	auto solver = MnaSolverFactory::factory<Complex>(simName + "_Statistics",
+		Domain::DP, Logger::Level::off, MnaSolverFactory::EigenSparse);
+	solver->setTimeStep(args.timeStep);
+	solver->setSystem(statSys);
+	solver->setNodeOrdering(ordering);
+	solver->initialize();
+
+	auto sys = radialFeeder(laterals, sections, probe);
+	Simulation sim(simName, args);
+	sim.setSystem(sys);
+	sim.setFinalTime(steps * args.timeStep);
+	sim.setNodeOrdering(ordering);
+	sim.initialize();
+	auto start = Clock::now();
+	for (UInt step = 0; step < steps; ++step)
+		sim.next();
+	auto end = Clock::now();
+
+	std::cout << orderingName << ","
+		<< sys.mNodes.size() << ","
+		<< solver->attribute<Int>("node_bandwidth")->get() << ","
+		<< solver->attribute<Int>("lu_nonzeros")->get() << ","
+		<< toUs(end - start) / steps << std::endl;
+
+	return probe->singleVoltage();
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt laterals = option<UInt>(args, "laterals", 50);
+
+	UInt sections = option<UInt>(args, "sections", 20);
+
+	UInt steps = option<UInt>(args, "steps", 1000);
+
+	// The orderings are meant for sparse factorizations
+	if (args.mnaImpl == MnaSolverFactory::Undef)
+		args.mnaImpl = MnaSolverFactory::EigenSparse;
+	args.logLevel = Logger::Level::off;
+
+	Logger::setLogDir("logs/DP_MNA_Node_Ordering");
+
+	std::cout << "ordering,nodes,node_bandwidth,lu_nonzeros,step_us" << std::endl;
+	auto vNatural = DP_MNA_Node_Ordering("Natural", MnaNodeOrdering::Natural, laterals, sections, steps, args);
+	auto vRcm = DP_MNA_Node_Ordering("RCM", MnaNodeOrdering::RCM, laterals, sections, steps, args);
+	auto vAmd = DP_MNA_Node_Ordering("AMD", MnaNodeOrdering::AMD, laterals, sections, steps, args);
+	auto vColamd = DP_MNA_Node_Ordering("COLAMD", MnaNodeOrdering::COLAMD, laterals, sections, steps, args);
+
+	// The ordering must not change the solution
+	Real deviation = std::max({ std::abs(vRcm - vNatural), std::abs(vAmd - vNatural), std::abs(vColamd - vNatural) });
+	std::cout << "max deviation: " << deviation << std::endl;
+	if (deviation > 1e-6 * std::abs(vNatural))
+		return 1;
+}
@@ -0,0 +1,184 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Voltage source behind a resistor feeding a node with a resistive load and
+/// inductive loads that are connected by switches
+static SystemTopology switchedLoads(UInt switches, std::vector<std::shared_ptr<Ph1::Switch>>& sws, SimNode::Ptr& probe) {
+	auto n0 = SimNode::make("n0");
+	auto nSrc = SimNode::make("n_src");
+	SystemNodeList nodes = { nSrc, n0 };
+	SystemComponentList comps;
+
+	auto vs = VoltageSource::make("vs", CPS::Logger::Level::off);
+	vs->setParameters(10000);
+	vs->connect({ SimNode::GND, nSrc });
+	auto r = Resistor::make("r_src", CPS::Logger::Level::off);
+	r->setParameters(1);
+	r->connect({ nSrc, n0 });
+	auto load = Resistor::make("load", CPS::Logger::Level::off);
+	load->setParameters(1000);
+	load->connect({ n0, SimNode::GND });
+	comps = { vs, r, load };
+
+	sws.clear();
+	for (UInt k = 0; k < switches; ++k) {
+		auto n = SimNode::make("n_sw" + std::to_string(k));
+		nodes.push_back(n);
+		auto sw = Ph1::Switch::make("sw" + std::to_string(k), CPS::Logger::Level::off);
+		sw->setParameters(1e9, 0.01, false);
+		sw->connect({ n0, n });
+		auto l = Inductor::make("l_sw" + std::to_string(k), CPS::Logger::Level::off);
+		l->setParameters(0.01 * (k + 1));
+		l->connect({ n, SimNode::GND });
+		sws.push_back(sw);
+		comps.push_back(sw);
+		comps.push_back(l);
+	}
+	probe = n0;
+	return SystemTopology(50, nodes, comps);
+}
+
+/// Events which close the first switches one after another and then open
+/// them in the same order, which visits 2 * cycled configurations per cycle
+static std::vector<Event::Ptr> cyclicEvents(std::vector<std::shared_ptr<Ph1::Switch>>& sws, UInt cycled, UInt cycles, UInt interval, Real timeStep) {
+	std::vector<Event::Ptr> events;
+	UInt step = interval;
+	for (UInt cycle = 0; cycle < cycles; ++cycle) {
+		for (Bool closed : { true, false }) {
+			for (UInt k = 0; k < cycled; ++k) {
+				events.push_back(SwitchEvent::make(step * timeStep, sws[k], closed));
+				step += interval;
+			}
+		}
+	}
+	return events;
+}
+
+/// Switch cache configuration of a run
+struct CacheMode {
+	String name;
+	Bool lazy;
+	UInt cacheSize;
+	Bool prewarm;
+};
+
+/// Result of a run
+struct CacheRun {
+	Real initMs = 0;
+	Int hits = 0;
+	Int misses = 0;
+	std::vector<Complex> voltages;
+};
+
+/// Simulates the switch events with the MNA solver on its own and executes
+/// the events before the steps they are scheduled for
+static CacheRun simulate(const CacheMode& mode, UInt switches, UInt cycled, UInt cycles, UInt interval, Real timeStep) {
+	std::vector<std::shared_ptr<Ph1::Switch>> sws;
+	SimNode::Ptr probe;
+	auto sys = switchedLoads(switches, sws, probe);
+	auto events = cyclicEvents(sws, cycled, cycles, interval, timeStep);
+
+	auto solver = MnaSolverFactory::factory<Complex>("DP_MNA_Switch_Cache_" + mode.name,
+		Domain::DP, Logger::Level::off);
+	solver->setTimeStep(timeStep);
+	solver->doLazySwitchedMatrices(mode.lazy);
+	solver->setSwitchedMatrixCacheSize(mode.cacheSize);
+	if (mode.prewarm)
+		solver->setSwitchedMatrixPrewarmEvents(events);
+	solver->setSystem(sys);
+
+	CacheRun run;
+	auto start = Clock::now();
+	solver->initialize();
+	run.initMs = toMs(Clock::now() - start);
+
+	auto tasks = solver->getTasks();
+	SequentialScheduler scheduler;
+	Scheduler::Edges inEdges, outEdges;
+	scheduler.resolveDeps(tasks, inEdges, outEdges);
+	scheduler.createSchedule(tasks, inEdges, outEdges);
+
+	UInt steps = (events.size() + 1) * interval;
+	UInt nextEvent = 0;
+	for (UInt step = 0; step < steps; ++step) {
+		for (; nextEvent < events.size() && nextEvent * interval + interval == step; ++nextEvent)
+			events[nextEvent]->execute();
+		scheduler.step(step * timeStep, step);
+		run.voltages.push_back(probe->singleVoltage());
+	}
+
+	run.hits = solver->attribute<Int>("lu_cache_hits")->get();
+	run.misses = solver->attribute<Int>("lu_cache_misses")->get();
+	return run;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_MNA_Switch_Cache", 0.0001, 0);
+	Logger::setLogDir("logs/" + args.name);
+
+	UInt switches = option<UInt>(args, "switches", 8);
+	UInt cycled = option<UInt>(args, "cycled", 3);
+	UInt cycles = option<UInt>(args, "cycles", 3);
+	UInt interval = option<UInt>(args, "interval", 20);
+
+	// Every event changes the switch configuration. After the initial
+	// configuration, the others are factorized on their first use unless
+	// they are pre-warmed. A cache smaller than the cycle evicts every
+	// configuration before it is used again.
+	UInt configurations = 2 * cycled;
+	Int changes = static_cast<Int>(configurations * cycles);
+	struct Expected { CacheMode mode; Int hits; Int misses; };
+	std::vector<Expected> expected = {
+		{ { "Lazy", true, configurations, false }, changes - Int(configurations) + 1, Int(configurations) - 1 },
+		{ { "Evicting", true, configurations - 1, false }, 0, changes },
+		{ { "Prewarmed", true, configurations, true }, changes, 0 },
+	};
+
+	auto eager = simulate({ "Eager", false, 0, false }, switches, cycled, cycles, interval, args.timeStep);
+
+	Bool ok = true;
+	std::cout << "mode,cache_size,init_ms,hits,misses,expected_hits,expected_misses,max_relative_deviation" << std::endl;
+	std::cout << "eager,-," << eager.initMs << ",-,-,-,-,0" << std::endl;
+	for (auto& e : expected) {
+		auto run = simulate(e.mode, switches, cycled, cycles, interval, args.timeStep);
+		Real deviation = 0;
+		for (UInt step = 0; step < run.voltages.size(); ++step)
+			deviation = std::max(deviation, relativeDeviation(run.voltages[step], eager.voltages[step]));
+		std::cout << e.mode.name << "," << e.mode.cacheSize << "," << run.initMs << ","
+			<< run.hits << "," << run.misses << "," << e.hits << "," << e.misses << ","
+			<< deviation << std::endl;
+		ok = ok && run.hits == e.hits && run.misses == e.misses && deviation <= 1e-12;
+	}
+
+	// Initialization time for many switches, which the eager path can only
+	// handle for few of them since it factorizes 2^N configurations
+	std::cout << "switches,eager_init_ms,prewarmed_init_ms" << std::endl;
+	for (UInt n : { 4, 8, 12, 24, 48 }) {
+		CacheMode prewarmed = { "Prewarmed_" + std::to_string(n), true, 0, true };
+		auto lazy = simulate(prewarmed, n, cycled, 1, 1, args.timeStep);
+		std::cout << n << ",";
+		if (n <= 12)
+			std::cout << simulate({ "Eager_" + std::to_string(n), false, 0, false }, n, cycled, 1, 1, args.timeStep).initMs;
+		else
+			std::cout << "-";
+		std::cout << "," << lazy.initMs << std::endl;
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/AndersonAcceleration.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Meshed grid of weakly damped RL branches, whose inductive loops decay
+/// with a time constant of seconds
+static SystemTopology weaklyDampedGrid(UInt size, std::vector<SimNode::Ptr>& grid) {
+	MeshedGridParameters params;
+	params.branchResistance = 0.05;
+	params.branchInductance = 0.5;
+	return meshedGrid(size, params, grid);
+}
+
+struct InitResult {
+	Int steps;
+	Real time;
+	MatrixComp voltages;
+};
+
+static InitResult steadyStateInit(UInt size, Real timeStep, UInt depth, Real accuracy, Real timeLimit) {
+	std::vector<SimNode::Ptr> grid;
+	auto sys = weaklyDampedGrid(size, grid);
+
+	auto solver = MnaSolverFactory::factory<Complex>("DP_SteadyState_Init_Acceleration",
+		Domain::DP, Logger::Level::off);
+	solver->setTimeStep(timeStep);
+	solver->setSystem(sys);
+	solver->doSteadyStateInit(true);
+	solver->setSteadStIniAccLimit(accuracy);
+	solver->setSteadStIniTimeLimit(timeLimit);
+	solver->setSteadStIniAccelerationDepth(depth);
+	solver->initialize();
+
+	InitResult result;
+	result.steps = solver->attribute<Int>("steady_state_steps")->get();
+	result.time = solver->attribute<Real>("steady_state_time")->get();
+	result.voltages = MatrixComp(grid.size(), 1);
+	for (UInt i = 0; i < grid.size(); ++i)
+		result.voltages(i, 0) = grid[i]->singleVoltage();
+	return result;
+}
+
+/// Runs a short simulation with a measurement file on a scheduler which is
+/// also used by the steady-state initialization. Returns the measured task
+/// names, or an empty map if the file was written before the simulation.
+/// The task names contain the simulation name, so both runs use the same
+/// simulation name and only the measurement files differ.
+static std::unordered_map<String, Scheduler::TaskTime::rep> measuredTasks(const String& name,
+	UInt size, Real timeStep, Bool init) {
+	std::vector<SimNode::Ptr> grid;
+	String file = Logger::logDir() + "/" + name + (init ? "_Init" : "_NoInit") + "_measurements.csv";
+	std::remove(file.c_str());
+
+	Simulation sim(name, Logger::Level::off);
+	sim.setSystem(weaklyDampedGrid(size, grid));
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(20 * timeStep);
+	sim.setScheduler(std::make_shared<ThreadLevelScheduler>(2, file));
+	sim.doSteadyStateInit(init);
+	sim.setSteadStIniTimeLimit(0.1);
+
+	std::unordered_map<String, Scheduler::TaskTime::rep> measurements;
+	sim.initialize();
+	if (std::ifstream(file).good())
+		return measurements;
+	sim.run();
+	Scheduler::readMeasurements(file, measurements);
+	return measurements;
+}
+
+/// Accelerated iteration of an affine map, which is disturbed by a far
+/// iterate once it has converged, so that the acceleration restarts.
+/// Returns the largest distance from the fixed point after the iteration
+/// has reached it again, which has to stay small once the history from
+/// before the restart is dropped.
+static Real restartedIteration(UInt& restarts) {
+	Matrix a(2, 2), b(2, 1);
+	a << 0.5, 0.2, 0.1, 0.6;
+	b << 1, 1;
+	Matrix fixedPoint = (Matrix::Identity(2, 2) - a).lu().solve(b);
+
+	AndersonAcceleration acceleration(5);
+	acceleration.reset(2);
+	Matrix x = Matrix::Zero(2, 1);
+	Matrix gx(2, 1);
+	Bool converged = false;
+	Real maxError = 0;
+	for (UInt k = 0; k < 30; ++k) {
+		if (k == 3)
+			x *= 1e6;
+		gx = a * x + b;
+		acceleration.next(x, gx, x);
+
+		Real error = (x - fixedPoint).norm() / fixedPoint.norm();
+		if (k > 3 && error < 1e-9)
+			converged = true;
+		if (converged)
+			maxError = std::max(maxError, error);
+	}
+	restarts = acceleration.restarts();
+	return converged ? maxError : 1;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_SteadyState_Init_Acceleration", 0.0001, 0);
+	Logger::setLogDir("logs/" + args.name);
+
+	UInt size = option<UInt>(args, "size", 6);
+	UInt depth = option<UInt>(args, "depth", 10);
+	Real timeLimit = 10;
+
+	// The fixed point of the step reached with a tight accuracy limit
+	auto reference = steadyStateInit(size, args.timeStep, depth, 1e-12, timeLimit);
+	// The trapezoidal steps of the weakly damped branches ring around the
+	// fixed point, so that the plain initialization hardly meets the limit
+	auto plain = steadyStateInit(size, args.timeStep, 0, 1e-4, timeLimit);
+	auto accelerated = steadyStateInit(size, args.timeStep, depth, 1e-4, timeLimit);
+	auto acceleratedTight = steadyStateInit(size, args.timeStep, depth, 1e-8, timeLimit);
+
+	auto error = [&](const InitResult& result) {
+		return (result.voltages - reference.voltages).cwiseAbs().maxCoeff()
+			/ reference.voltages.cwiseAbs().maxCoeff();
+	};
+
+	std::cout << "mode,accuracy_limit,steps,time_s,relative_error" << std::endl;
+	std::cout << "reference,1e-12," << reference.steps << "," << reference.time << ",0" << std::endl;
+	std::cout << "plain,1e-4," << plain.steps << "," << plain.time << "," << error(plain) << std::endl;
+	std::cout << "accelerated,1e-4," << accelerated.steps << "," << accelerated.time << "," << error(accelerated) << std::endl;
+	std::cout << "accelerated,1e-8," << acceleratedTight.steps << "," << acceleratedTight.time << "," << error(acceleratedTight) << std::endl;
+
+	// The measurement file has to contain the tasks of the simulation only,
+	// as without the initialization
+	auto measuredInit = measuredTasks(args.name, size, args.timeStep, true);
+	auto measuredNoInit = measuredTasks(args.name, size, args.timeStep, false);
+	Bool sameTasks = !measuredInit.empty() && measuredInit.size() == measuredNoInit.size();
+	for (auto& task : measuredNoInit)
+		sameTasks = sameTasks && measuredInit.count(task.first) == 1;
+	std::cout << "measured tasks with / without initialization: " << measuredInit.size()
+		<< " / " << measuredNoInit.size() << std::endl;
+
+	UInt restarts;
+	Real restartedError = restartedIteration(restarts);
+	std::cout << "restarts: " << restarts << ", max relative error after the restart: "
+		<< restartedError << std::endl;
+
+	// Even with the tight limit the accelerated initialization has to reach
+	// the steady state in fewer steps than the plain one
+	if (error(acceleratedTight) > 1e-5 || acceleratedTight.steps >= plain.steps || !sameTasks
+		|| restarts != 1 || restartedError > 1e-9)
+		return 1;
+}
@@ -0,0 +1,172 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <iostream>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Resistor that requests a recomputation of the system matrix whenever
+/// its resistance attribute is changed (e.g. by an AttributeEvent)
+class VariableResistor :
+	public Resistor,
+	public CPS::MNAVariableCompInterface,
+	public SharedFactory<VariableResistor> {
+public:
+	using SharedFactory<VariableResistor>::make;
+
+	VariableResistor(String name) : Resistor(name) { }
+
+	void mnaApplySystemMatrixStamp(CPS::SparseMatrixRow& systemMatrix) override {
+		mStampedResistance = mResistance;
+		Resistor::mnaApplySystemMatrixStamp(systemMatrix);
+	}
+
+	Bool hasParameterChanged() override {
+		return mResistance != mStampedResistance;
+	}
+
+private:
+	Real mStampedResistance = 0;
+};
+
+/// Simulates a ladder network in which a few shunt loads change periodically
+/// and reports the step times for the selected recomputation mode and
+/// sparse LU implementation.
+static MatrixComp DP_SysRecomp_Update_Timing(String modeName, MnaRecomputationMode mode,
+	String luName, MnaSolverFactory::MnaSolverImpl impl,
+	UInt sections, UInt numVariable, CommandLineArgs& args) {
+	String simName = "DP_SysRecomp_Update_Timing_" + modeName + "_" + luName;
+	Logger::setLogDir("logs/" + simName);
+
+	SystemNodeList nodes;
+	SystemComponentList comps;
+
+	auto n0 = SimNode::make("n0");
+	nodes.push_back(n0);
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10000, 0));
+	vs->connect({ SimNode::GND, n0 });
+	comps.push_back(vs);
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(args.timeStep);
+	sim.setFinalTime(args.duration);
+	sim.doSystemMatrixRecomputation(true);
+	sim.setSystemMatrixRecomputationMode(mode);
+	sim.setMnaSolverImplementation(impl);
+
+	UInt spacing = std::max<UInt>(1, sections / numVariable);
+	auto prev = n0;
+	for (UInt s = 0; s < sections; ++s) {
+		String id = std::to_string(s);
+		auto nMid = SimNode::make("n" + id + "_m");
+		auto n = SimNode::make("n" + id);
+		auto r = Resistor::make("r_" + id);
+		r->setParameters(0.1);
+		r->connect({ prev, nMid });
+		auto l = Inductor::make("l_" + id);
+		l->setParameters(0.001);
+		l->connect({ nMid, n });
+		nodes.push_back(nMid);
+		nodes.push_back(n);
+		comps.push_back(r);
+		comps.push_back(l);
+
+		if (s % spacing == 0) {
+			auto load = VariableResistor::make("load_" + id);
+			load->setParameters(1000);
+			load->connect({ n, SimNode::GND });
+			comps.push_back(load);
+
+			// Toggle the load every 10 time steps
+			Real period = 10 * args.timeStep;
+			for (Real t = period; t < args.duration; t += period) {
+				Real value = (static_cast<Int>(t / period) % 2) ? 500 : 1000;
+				sim.addEvent(AttributeEvent<Real>::make(t + 0.5 * args.timeStep,
+					load->attribute<Real>("R"), value));
+			}
+		}
+		else {
+			auto load = Resistor::make("load_" + id);
+			load->setParameters(1000);
+			load->connect({ n, SimNode::GND });
+			comps.push_back(load);
+		}
+		prev = n;
+	}
+
+	sim.setSystem(SystemTopology(50, nodes, comps));
+	sim.initialize();
+
+	std::vector<Real> stepTimes;
+	Real time = 0;
+	while (time < args.duration) {
+		auto start = Clock::now();
+		time = sim.step();
+		auto end = Clock::now();
+		stepTimes.push_back(toUs(end - start));
+	}
+
+	Real mean = 0;
+	for (auto t : stepTimes)
+		mean += t;
+	mean /= stepTimes.size();
+	std::sort(stepTimes.begin(), stepTimes.end());
+
+	std::cout << modeName << ","
+		<< luName << ","
+		<< mean << ","
+		<< stepTimes[stepTimes.size() * 99 / 100] << ","
+		<< stepTimes.back() << std::endl;
+
+	return prev->attribute<MatrixComp>("v")->get();
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_SysRecomp_Update_Timing", 0.0001, 0.1);
+
+	UInt sections = option<UInt>(args, "sections", 400);
+
+	UInt numVariable = option<UInt>(args, "variable", 4);
+
+	std::cout << "mode,lu,mean_step_us,p99_step_us,max_step_us" << std::endl;
+	std::vector<std::pair<String, MnaRecomputationMode>> modes = {
+		{ "Full", MnaRecomputationMode::Full },
+		{ "ReuseSymbolic", MnaRecomputationMode::ReuseSymbolic },
+		{ "LowRankUpdate", MnaRecomputationMode::LowRankUpdate }
+	};
+	std::vector<std::pair<String, MnaSolverFactory::MnaSolverImpl>> impls = {
+		{ "EigenSparse", MnaSolverFactory::EigenSparse },
+		{ "CircuitSparse", MnaSolverFactory::CircuitSparse }
+	};
+
+	// All strategies have to yield the same solution
+	MatrixComp vRef;
+	Real maxDeviation = 0;
+	for (auto& impl : impls) {
+		for (auto& mode : modes) {
+			auto v = DP_SysRecomp_Update_Timing(mode.first, mode.second,
+				impl.first, impl.second, sections, numVariable, args);
+			if (vRef.size() == 0)
+				vRef = v;
+			maxDeviation = std::max(maxDeviation, (vRef - v).cwiseAbs().maxCoeff());
+		}
+	}
+	std::cout << "max deviation: " << maxDeviation << std::endl;
+
+	if (maxDeviation > 1e-6 * vRef.cwiseAbs().maxCoeff())
+		return 1;
+}
@@ -0,0 +1,144 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <sstream>
+
+#include <DPsim.h>
+#include <cps/TopologyCache.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+/// Connects a terminal with the given power flow like the CIM reader
+static void connect(TopologicalPowerComp::Ptr comp, UInt position, SimNode<Complex>::Ptr node,
+	Complex power, SystemTopology& sys) {
+	auto powerComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp);
+	auto term = SimTerminal<Complex>::make(comp->uid() + "_t" + std::to_string(position));
+	term->setNode(node);
+	term->setPower(power);
+	powerComp->setTerminalAt(term, position);
+	sys.mComponentsAtNode[node].push_back(comp);
+}
+
+/// Feeders of an injection, a line, a transformer and a load, which are
+/// created from descriptions like the ones of the CIM reader
+static SystemTopology feederSystem(UInt feeders, TopologyCache& cache) {
+	SystemTopology sys(50);
+	for (UInt f = 0; f < feeders; ++f) {
+		String id = "f" + std::to_string(f) + "_";
+		UInt index = static_cast<UInt>(sys.mNodes.size());
+		std::vector<SimNode<Complex>::Ptr> nodes;
+		for (UInt n = 0; n < 3; ++n) {
+			nodes.push_back(SimNode<Complex>::make(id + "n" + std::to_string(n), id + "N" + std::to_string(n),
+				index + n, PhaseType::Single));
+			sys.addNode(nodes.back());
+		}
+		nodes[0]->setInitialVoltage(Complex(20000, 0));
+		nodes[1]->setInitialVoltage(std::polar(19800., -0.01));
+		nodes[2]->setInitialVoltage(std::polar(396., -0.05));
+
+		std::vector<TopologyCache::Component> descs = {
+			{ "DP::Ph1::NetworkInjection", id + "grid", id + "Grid", {} },
+			{ "DP::Ph1::PiLine", id + "line", id + "Line", { 0.5 + 0.01 * f, 0.005, 1e-7, 1e-6 } },
+			{ "DP::Ph1::Transformer", id + "trafo", id + "Trafo", { 20000, 400, 50, 0, 0.1, 0.002 } },
+			{ "DP::Ph1::RXLoad", id + "load", id + "Load", {} }
+		};
+		std::vector<TopologicalPowerComp::Ptr> comps;
+		for (auto& desc : descs) {
+			cache.addComponent(desc);
+			comps.push_back(TopologyCache::createComponent(desc, Logger::Level::off));
+			sys.addComponent(comps.back());
+		}
+		connect(comps[0], 0, nodes[0], Complex(-1e5, -2e4), sys);
+		connect(comps[1], 0, nodes[0], Complex(1e5, 2e4), sys);
+		connect(comps[1], 1, nodes[1], Complex(-1e5, -2e4), sys);
+		connect(comps[2], 0, nodes[1], Complex(1e5, 2e4), sys);
+		connect(comps[2], 1, nodes[2], Complex(-1e5, -2e4), sys);
+		connect(comps[3], 0, nodes[2], Complex(1e5 + 1e3 * f, 2e4), sys);
+	}
+	return sys;
+}
+
+/// Voltages of all nodes after a short simulation
+static MatrixComp simulate(const String& name, SystemTopology& sys) {
+	for (auto comp : sys.mComponents) {
+		if (auto grid = std::dynamic_pointer_cast<DP::Ph1::NetworkInjection>(comp))
+			grid->setParameters(Complex(20000, 0));
+	}
+
+	Simulation sim(name, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setDomain(Domain::DP);
+	sim.setTimeStep(1e-4);
+	sim.setFinalTime(0.01);
+	sim.run();
+
+	MatrixComp voltages(sys.mNodes.size(), 1);
+	for (UInt i = 0; i < sys.mNodes.size(); ++i)
+		voltages(i, 0) = std::dynamic_pointer_cast<SimNode<Complex>>(sys.mNodes[i])->singleVoltage();
+	return voltages;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "DP_Topology_Cache");
+
+	UInt feeders = option<UInt>(args, "feeders", 1000);
+
+	// Round trip of a large topology
+	auto start = Clock::now();
+	TopologyCache cache;
+	auto sys = feederSystem(feeders, cache);
+	auto built = Clock::now();
+
+	std::stringstream file;
+	cache.write(file, 42, sys);
+	auto written = Clock::now();
+
+	TopologyCache readCache;
+	SystemTopology cached;
+	Bool ok = readCache.read(file, 42, cached, Logger::Level::off);
+	auto read = Clock::now();
+
+	// Writing the rebuilt topology again gives the same file
+	std::stringstream rewritten;
+	readCache.write(rewritten, 42, cached);
+	Bool identical = ok && rewritten.str() == file.str();
+
+	// Files of other input or format are rejected
+	file.seekg(0);
+	SystemTopology other;
+	Bool rejected = !readCache.read(file, 43, other, Logger::Level::off) && other.mNodes.empty();
+
+	std::cout << "feeders: " << feeders << ", nodes: " << cached.mNodes.size()
+		<< ", components: " << cached.mComponents.size() << std::endl;
+	std::cout << "file size [kB]: " << file.str().size() / 1024 << std::endl;
+	std::cout << "build / write / read [ms]: "
+		<< toMs(built - start) << " / "
+		<< toMs(written - built) << " / "
+		<< toMs(read - written) << std::endl;
+	std::cout << "identical rewrite: " << identical << ", other key rejected: " << rejected << std::endl;
+
+	// The rebuilt topology simulates exactly like the original one
+	TopologyCache smallCache;
+	auto small = feederSystem(3, smallCache);
+	std::stringstream smallFile;
+	smallCache.write(smallFile, 1, small);
+	SystemTopology smallCached;
+	smallCache.read(smallFile, 1, smallCached, Logger::Level::off);
+
+	MatrixComp original = simulate(args.name + "_Original", small);
+	Real deviation = (original - simulate(args.name + "_Cached", smallCached)).cwiseAbs().maxCoeff();
+	std::cout << "max voltage deviation after simulation: " << deviation << std::endl;
+
+	if (!identical || !rejected || cached.mComponents.size() != 4 * feeders
+		|| deviation != 0 || original.cwiseAbs().minCoeff() == 0)
+		return 1;
+}
@@ -0,0 +1,137 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+/// Logs a complex node vector of the given size, like the left vector of a
+/// DP simulation, after busy waiting for the given time to emulate the
+/// solver. Reports the mean and maximum time spent in the logger on the
+/// simulation thread and the total time including draining the logger.
+static void measure(String name, DataLogger::Ptr logger, MatrixComp &vector,
+	UInt steps, Real workUs) {
+	vector.setConstant(Complex(1, 1));
+
+	Real logUs = 0, maxLogUs = 0;
+	auto start = Clock::now();
+	for (UInt s = 0; s < steps; s++) {
+		auto workEnd = Clock::now() + std::chrono::duration<Real, std::micro>(workUs);
+		while (Clock::now() < workEnd);
+		vector(s % vector.rows(), 0) += Complex(1e-3, -1e-3);
+
+		auto logStart = Clock::now();
+		logger->log(s * 1e-4, s);
+		Real us = toUs(Clock::now() - logStart);
+		logUs += us;
+		maxLogUs = std::max(maxLogUs, us);
+	}
+	logger->close();
+	auto end = Clock::now();
+
+	Real totalMs = toMs(end - start);
+	std::cout << name << "," << vector.rows() << "," << logUs / steps << "," << maxLogUs << ","
+		<< totalMs << "," << logger->attribute<Int>("overflows")->get() << ","
+		<< logger->attribute<Int>("dropped_rows")->get() << std::endl;
+}
+
+/// Exposes the value line functions, which the node value loggers use
+class LineLogger : public DataLogger {
+public:
+	using DataLogger::DataLogger;
+	using DataLogger::logDataLine;
+};
+
+static String readFile(const String& name) {
+	std::ifstream file(Logger::logDir() + "/" + name + ".csv");
+	std::stringstream content;
+	content << file.rdbuf();
+	return content.str();
+}
+
+/// Lines of real and complex values have to be written by the writer thread
+/// in asynchronous mode and give the same file as in synchronous mode
+static Bool checkValueLines(const String& simName) {
+	MatrixComp values(3, 1);
+	Bool ok = true;
+	for (Bool complex : { false, true }) {
+		String name = simName + (complex ? "_complex" : "_real");
+		LineLogger sync(name + "_sync");
+		LineLogger async(name + "_async");
+		async.setAsync(4, DataLogger::OverflowPolicy::block);
+		for (UInt s = 0; s < 100; s++) {
+			values << Complex(s, -1. * s), Complex(0.5 * s, 1), Complex(1e3, 1e-3 * s);
+			for (LineLogger* logger : { &sync, &async }) {
+				if (complex)
+					logger->logDataLine(s * 1e-4, values);
+				else
+					logger->logDataLine(s * 1e-4, values(0, 0).real());
+			}
+		}
+		sync.close();
+		async.close();
+		Bool same = readFile(name + "_sync") == readFile(name + "_async");
+		std::cout << name << " async matches sync: " << same << std::endl;
+		ok = ok && same;
+	}
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt nodes = option<UInt>(args, "nodes", 1000);
+	UInt steps = option<UInt>(args, "steps", 10000);
+	UInt capacity = option<UInt>(args, "capacity", 1024);
+	Real workUs = option<Real>(args, "work", 0);
+
+	String simName = "Logger_Binary_Throughput";
+	Logger::setLogDir("logs/" + simName);
+
+	MatrixComp vector(nodes, 1);
+	AttributeBase::Ptr attr = Attribute<MatrixComp>::make(&vector, Flags::read);
+
+	auto text = DataLogger::make(simName + "_text");
+	text->addAttribute("v", attr);
+	auto binary = BinaryDataLogger::make(simName + "_binary");
+	binary->addAttribute("v", attr);
+
+	auto textAsync = DataLogger::make(simName + "_text_async");
+	textAsync->addAttribute("v", attr);
+	textAsync->setAsync(capacity, DataLogger::OverflowPolicy::block);
+	auto binaryAsync = BinaryDataLogger::make(simName + "_binary_async");
+	binaryAsync->addAttribute("v", attr);
+	binaryAsync->setAsync(capacity, DataLogger::OverflowPolicy::block);
+	auto textDrop = DataLogger::make(simName + "_text_drop");
+	textDrop->addAttribute("v", attr);
+	textDrop->setAsync(capacity, DataLogger::OverflowPolicy::dropOldest);
+
+	std::cout << "logger,columns,mean_log_us,max_log_us,total_ms,overflows,dropped_rows" << std::endl;
+	measure("text", text, vector, steps, workUs);
+	measure("binary", binary, vector, steps, workUs);
+	measure("text_async", textAsync, vector, steps, workUs);
+	measure("binary_async", binaryAsync, vector, steps, workUs);
+	measure("text_async_drop_oldest", textDrop, vector, steps, workUs);
+
+	BinaryDataLogger::convertToCsv(Logger::logDir() + "/" + simName + "_binary.bin",
+		Logger::logDir() + "/" + simName + "_binary.csv");
+
+	if (!checkValueLines(simName))
+		return 1;
+
+	return 0;
+}
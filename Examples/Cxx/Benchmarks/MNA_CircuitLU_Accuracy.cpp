@@ -0,0 +1,135 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <random>
+
+#include <DPsim.h>
+#include <dpsim/CircuitLU.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+
+/// Real expansion of a random DP-like MNA matrix. The nodes are connected by
+/// a random tree and additional branches with admittances g + jb, some have
+/// an admittance to ground and the last nodes are fed by ideal voltage
+/// sources, which add rows with a zero diagonal.
+static SparseMatrix randomMnaMatrix(std::mt19937& rng, UInt nodes, UInt sources) {
+	std::uniform_real_distribution<Real> conductance(0.1, 10);
+	std::uniform_real_distribution<Real> susceptance(-20, -1);
+	UInt size = nodes + sources;
+	std::vector<Eigen::Triplet<Real>> entries;
+
+	// Real part in the first rows, imaginary part in the second half
+	auto add = [&](UInt row, UInt col, Complex value) {
+		entries.emplace_back(row, col, value.real());
+		entries.emplace_back(row, col + size, -value.imag());
+		entries.emplace_back(row + size, col, value.imag());
+		entries.emplace_back(row + size, col + size, value.real());
+	};
+	auto branch = [&](UInt a, UInt b) {
+		Complex y(conductance(rng), susceptance(rng));
+		add(a, a, y);
+		add(b, b, y);
+		add(a, b, -y);
+		add(b, a, -y);
+	};
+
+	for (UInt node = 1; node < nodes; ++node)
+		branch(node, rng() % node);
+	for (UInt extra = 0; extra < nodes / 2; ++extra) {
+		UInt a = rng() % nodes, b = rng() % nodes;
+		if (a != b)
+			branch(a, b);
+	}
+	for (UInt node = 0; node < nodes; node += 3)
+		add(node, node, Complex(conductance(rng) * 1e-3, 0));
+	for (UInt source = 0; source < sources; ++source) {
+		UInt node = nodes - 1 - source;
+		add(node, nodes + source, 1);
+		add(nodes + source, node, 1);
+	}
+
+	SparseMatrix matrix(2 * size, 2 * size);
+	matrix.setFromTriplets(entries.begin(), entries.end());
+	matrix.makeCompressed();
+	return matrix;
+}
+
+/// Relative deviation of the CircuitLU solution from the one of Eigen::SparseLU
+static Real deviation(CircuitLU& lu, const SparseMatrix& matrix, const Matrix& rhs) {
+	CPS::SparseMatrix colMajor = matrix;
+	CPS::LUFactorizedSparse reference;
+	reference.analyzePattern(colMajor);
+	reference.factorize(colMajor);
+	Matrix expected = reference.solve(rhs);
+
+	Matrix x(rhs.rows(), rhs.cols());
+	lu.solve(rhs, x);
+	return (x - expected).norm() / expected.norm();
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "MNA_CircuitLU_Accuracy");
+
+	UInt trials = option<UInt>(args, "trials", 50);
+
+	std::mt19937 rng(1);
+	std::uniform_real_distribution<Real> change(0.5, 2);
+	Real maxFactorize = 0, maxRefactorize = 0, maxFallback = 0;
+	UInt refactorized = 0, failed = 0;
+
+	for (UInt trial = 0; trial < trials; ++trial) {
+		UInt nodes = 5 + rng() % 200;
+		UInt sources = 1 + rng() % 3;
+		SparseMatrix matrix = randomMnaMatrix(rng, nodes, sources);
+		Matrix rhs = Matrix::Random(matrix.rows(), 2);
+
+		CircuitLU lu;
+		lu.analyzePattern(matrix);
+		lu.factorize(matrix);
+		maxFactorize = std::max(maxFactorize, deviation(lu, matrix, rhs));
+
+		// Changed values with the same pattern reuse the pivot sequence
+		for (Eigen::Index k = 0; k < matrix.nonZeros(); ++k)
+			matrix.valuePtr()[k] *= change(rng);
+		if (lu.refactorize(matrix)) {
+			++refactorized;
+			maxRefactorize = std::max(maxRefactorize, deviation(lu, matrix, rhs));
+		} else {
+			lu.factorize(matrix);
+			maxFallback = std::max(maxFallback, deviation(lu, matrix, rhs));
+		}
+
+		// A pivot that becomes negligible against its column fails the
+		// refactorization, which is recovered by a new factorization
+		SparseMatrix shrunk = matrix;
+		for (Eigen::Index row = 0; row < shrunk.outerSize(); ++row) {
+			for (SparseMatrix::InnerIterator it(shrunk, row); it; ++it) {
+				if (it.col() == row && row < static_cast<Eigen::Index>(nodes))
+					it.valueRef() *= 1e-9;
+			}
+		}
+		if (!lu.refactorize(shrunk)) {
+			++failed;
+			lu.factorize(shrunk);
+		}
+		maxFallback = std::max(maxFallback, deviation(lu, shrunk, rhs));
+	}
+
+	std::cout << "trials: " << trials << ", refactorized: " << refactorized
+		<< ", pivot failures: " << failed << std::endl;
+	std::cout << "max relative deviation factorize / refactorize / fallback: "
+		<< maxFactorize << " / " << maxRefactorize << " / " << maxFallback << std::endl;
+
+	// Solutions match Eigen::SparseLU and both paths have been taken
+	if (maxFactorize > 1e-9 || maxRefactorize > 1e-9 || maxFallback > 1e-9
+		|| refactorized == 0 || failed == 0)
+		return 1;
+}
@@ -0,0 +1,161 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+/// Slack behind a line feeding two inverters with PLL and power controller
+/// and RL loads
+static SystemTopology dpInverterGrid() {
+	Real Vnom = 3300;
+	auto n1 = DP::SimNode::make("n1");
+	auto n2 = DP::SimNode::make("n2");
+	auto n3 = DP::SimNode::make("n3");
+	auto n4 = DP::SimNode::make("n4");
+
+	auto vs = DP::Ph1::VoltageSource::make("vs", Logger::Level::off);
+	vs->setParameters(Complex(Vnom, 0));
+	auto line = DP::Ph1::PiLine::make("line", Logger::Level::off);
+	line->setParameters(0.04, 0.928e-4, 789.3e-6);
+	auto rline = DP::Ph1::Resistor::make("rline", Logger::Level::off);
+	rline->setParameters(0.04);
+	auto rload = DP::Ph1::Resistor::make("rload", Logger::Level::off);
+	rload->setParameters(47.6568);
+	auto lload = DP::Ph1::Inductor::make("lload", Logger::Level::off);
+	lload->setParameters(0.01516);
+	auto cshunt = DP::Ph1::Capacitor::make("cshunt", Logger::Level::off);
+	cshunt->setParameters(1e-6);
+
+	SystemComponentList comps{ vs, line, rline, rload, lload, cshunt };
+	SimNode<Complex>::List vsiNodes{ n1, n2 };
+	for (UInt k = 0; k < 2; ++k) {
+		String name = "vsi" + std::to_string(k + 1);
+		auto vsi = DP::Ph1::AvVoltageSourceInverterDQ::make(name, name, Logger::Level::off, true);
+		vsi->setParameters(2 * PI * 50, Vnom, 30000 + 10000 * k, 200);
+		vsi->setControllerParameters(0.25, 2, 0.001, 0.08, 3.77, 1400, 2 * PI * 50);
+		vsi->setFilterParameters(0.928e-3, 789.3e-6, 0.01, 0.5);
+		vsi->setTransformerParameters(Vnom, 400, Vnom / 400, 0, 0.5, 1e-4);
+		vsi->connect({ vsiNodes[k] });
+		comps.push_back(vsi);
+	}
+
+	vs->connect({ DP::SimNode::GND, n4 });
+	line->connect({ n4, n1 });
+	rline->connect({ n1, n2 });
+	rload->connect({ n2, n3 });
+	lload->connect({ n3, DP::SimNode::GND });
+	cshunt->connect({ n2, DP::SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1, n2, n3, n4 }, comps);
+	for (auto node : sys.mNodes)
+		node->setInitialVoltage(Complex(Vnom, 0));
+	return sys;
+}
+
+// Machine parameters of the synchronous generator examples
+static Real nomPower = 555e6, nomPhPhVoltRMS = 24e3, nomFreq = 60, nomFieldCurr = 1300;
+static Int poleNum = 2;
+static Real H = 3.7, Rs = 0.003, Ll = 0.15, Lmd = 1.6599, Lmq = 1.61, Rfd = 0.0006, Llfd = 0.1648,
+	Rkd = 0.0284, Llkd = 0.1713, Rkq1 = 0.0062, Llkq1 = 0.7252, Rkq2 = 0.0237, Llkq2 = 0.125;
+static Real initActivePower = 300e6, initReactivePower = 0, initMechPower = 300e6,
+	initTerminalVolt = 24000 / sqrt(3) * sqrt(2), initVoltAngle = -PI / 2, fieldVoltage = 7.0821;
+
+static std::vector<Complex> initialMachineVoltage() {
+	return {
+		std::polar(initTerminalVolt, initVoltAngle),
+		std::polar(initTerminalVolt, initVoltAngle - 2 * PI / 3),
+		std::polar(initTerminalVolt, initVoltAngle + 2 * PI / 3) };
+}
+
+/// Synchronous generator with dq0 model feeding a resistive load
+template <typename Generator, typename Load, typename Node>
+static SystemTopology machineWithLoad() {
+	auto n1 = Node::make("n1", PhaseType::ABC, initialMachineVoltage());
+	auto gen = Generator::make("gen", Logger::Level::off);
+	gen->setParametersFundamentalPerUnit(nomPower, nomPhPhVoltRMS, nomFreq, poleNum, nomFieldCurr,
+		Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H,
+		initActivePower, initReactivePower, initTerminalVolt, initVoltAngle, fieldVoltage, initMechPower);
+	auto load = Load::make("load", Logger::Level::off);
+	load->setParameters(1.92);
+
+	gen->connect({ n1 });
+	load->connect({ Node::GND, n1 });
+	return SystemTopology(60, SystemNodeList{ n1 }, SystemComponentList{ gen, load });
+}
+
+/// Three phase slack behind a line and a transformer feeding RLC loads
+static SystemTopology emtGrid() {
+	auto n1 = EMT::SimNode::make("n1", PhaseType::ABC);
+	auto n2 = EMT::SimNode::make("n2", PhaseType::ABC);
+	auto n3 = EMT::SimNode::make("n3", PhaseType::ABC);
+	auto n4 = EMT::SimNode::make("n4", PhaseType::ABC);
+
+	auto vs = EMT::Ph3::VoltageSource::make("vs", Logger::Level::off);
+	vs->setParameters(Math::singlePhaseVariableToThreePhase(Complex(20e3, 0)), 50);
+	auto line = EMT::Ph3::PiLine::make("line", Logger::Level::off);
+	line->setParameters(Math::singlePhaseParameterToThreePhase(0.4),
+		Math::singlePhaseParameterToThreePhase(0.01), Math::singlePhaseParameterToThreePhase(1e-6));
+	auto trafo = EMT::Ph3::Transformer::make("trafo", Logger::Level::off);
+	trafo->setParameters(20e3, 400, 20e3 / 400, 0,
+		Math::singlePhaseParameterToThreePhase(0.1), Math::singlePhaseParameterToThreePhase(1e-3));
+	auto rload = EMT::Ph3::Resistor::make("rload", Logger::Level::off);
+	rload->setParameters(Math::singlePhaseParameterToThreePhase(10));
+	auto lload = EMT::Ph3::Inductor::make("lload", Logger::Level::off);
+	lload->setParameters(Math::singlePhaseParameterToThreePhase(0.01));
+	auto cshunt = EMT::Ph3::Capacitor::make("cshunt", Logger::Level::off);
+	cshunt->setParameters(Math::singlePhaseParameterToThreePhase(1e-6));
+
+	vs->connect({ EMT::SimNode::GND, n1 });
+	line->connect({ n1, n2 });
+	trafo->connect({ n2, n3 });
+	rload->connect({ n3, n4 });
+	lload->connect({ n4, EMT::SimNode::GND });
+	cshunt->connect({ n3, EMT::SimNode::GND });
+
+	return SystemTopology(50, SystemNodeList{ n1, n2, n3, n4 },
+		SystemComponentList{ vs, line, trafo, rload, lload, cshunt });
+}
+
+/// Runs the system and fails if a step allocates heap memory
+static Bool checkSteps(const String& name, const SystemTopology& sys, Domain domain, Real timeStep) {
+	Simulation sim(name, Logger::Level::off);
+	sim.setSystem(sys);
+	sim.setDomain(domain);
+	sim.setTimeStep(timeStep);
+	sim.setFinalTime(200 * timeStep);
+	sim.doCheckStepAllocations(true);
+	try {
+		sim.run();
+	}
+	catch (const SystemError& e) {
+		std::cout << name << ": " << e.descr() << std::endl;
+		return false;
+	}
+	std::cout << name << ": no allocations" << std::endl;
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "MNA_Step_Allocations");
+
+	Bool ok = checkSteps("DP_Inverter_Grid", dpInverterGrid(), Domain::DP, 1e-4);
+	ok = checkSteps("DP_SynGen_Load",
+		machineWithLoad<DP::Ph3::SynchronGeneratorDQTrapez, DP::Ph3::SeriesResistor, DP::SimNode>(),
+		Domain::DP, 50e-6) && ok;
+	ok = checkSteps("EMT_SynGen_Load",
+		machineWithLoad<EMT::Ph3::SynchronGeneratorDQTrapez, EMT::Ph3::SeriesResistor, EMT::SimNode>(),
+		Domain::EMT, 50e-6) && ok;
+	ok = checkSteps("EMT_Grid", emtGrid(), Domain::EMT, 1e-4) && ok;
+
+	if (!ok)
+		return 1;
+}
@@ -0,0 +1,139 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/ODEintSolver.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Damped oscillator x'' + 2 d x' + w^2 x = 0 as signal component, which
+/// stands in for the mechanical equations of a machine
+class DampedOscillator :
+	public CPS::SimSignalComp,
+	public CPS::ODEintInterface,
+	public SharedFactory<DampedOscillator> {
+protected:
+	Real mDamping;
+	Real mOmega;
+	Real mState[2] = { 1, 0 };
+
+public:
+	DampedOscillator(String name, Real damping, Real omega) :
+		SimSignalComp(name), mDamping(damping), mOmega(omega) {
+		addAttribute<Real>("x", &mState[0], CPS::Flags::read);
+	}
+
+	/// Analytical solution for the initial state (1, 0)
+	Real solution(Real t) const {
+		Real omegaD = std::sqrt(mOmega * mOmega - mDamping * mDamping);
+		return std::exp(-mDamping * t) * (std::cos(omegaD * t) + mDamping / omegaD * std::sin(omegaD * t));
+	}
+
+	int num_states() const { return 2; }
+	void odeint(const double y[], double ydot[], double t) {
+		ydot[0] = y[1];
+		ydot[1] = -2 * mDamping * y[1] - mOmega * mOmega * y[0];
+	}
+	void pre_step() { }
+	void post_step() { }
+	double* state_vector() { return mState; }
+	void set_state_vector(const double y[]) {
+		mState[0] = y[0];
+		mState[1] = y[1];
+	}
+};
+
+/// Small network for the MNA solver and the oscillators
+static SystemTopology oscillatorSystem(const String& name, UInt count, Real omega,
+	std::vector<std::shared_ptr<DampedOscillator>>& oscillators) {
+	auto n1 = SimNode::make(name + "_n1");
+	auto vs = VoltageSource::make(name + "_vs", Logger::Level::off);
+	vs->setParameters(10);
+	vs->connect({ SimNode::GND, n1 });
+	auto load = Resistor::make(name + "_load", Logger::Level::off);
+	load->setParameters(10);
+	load->connect({ n1, SimNode::GND });
+
+	auto sys = SystemTopology(50, SystemNodeList{ n1 }, SystemComponentList{ vs, load });
+	oscillators.clear();
+	for (UInt i = 0; i < count; ++i) {
+		auto osc = DampedOscillator::make(name + "_osc" + std::to_string(i), 0.5 + 0.01 * i, omega);
+		oscillators.push_back(osc);
+		sys.addComponent(osc);
+	}
+	return sys;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "ODEint_Many_Components", 0.001, 2);
+	Logger::setLogDir("logs/" + args.name);
+
+	UInt count = option<UInt>(args, "count", 50);
+
+	// Two simulations in one process, stepped alternately
+	std::vector<std::shared_ptr<DampedOscillator>> oscillators1, oscillators2;
+	Simulation sim1(args.name + "_1", Logger::Level::off);
+	sim1.setSystem(oscillatorSystem("a", count, 2 * PI, oscillators1));
+	sim1.setTimeStep(args.timeStep);
+	sim1.setFinalTime(args.duration);
+	Simulation sim2(args.name + "_2", Logger::Level::off);
+	sim2.setSystem(oscillatorSystem("b", count, 4 * PI, oscillators2));
+	sim2.setTimeStep(args.timeStep);
+	sim2.setFinalTime(args.duration);
+	sim1.initialize();
+	sim2.initialize();
+
+	auto start = Clock::now();
+	while (sim1.time() < args.duration - args.timeStep / 2) {
+		sim1.next();
+		sim2.next();
+	}
+	auto end = Clock::now();
+	Real stepTime = toUs(end - start)
+		/ (args.duration / args.timeStep);
+
+	Real maxError = 0;
+	for (auto osc : oscillators1)
+		maxError = std::max(maxError, std::abs(osc->attribute<Real>("x")->get() - osc->solution(sim1.time())));
+	for (auto osc : oscillators2)
+		maxError = std::max(maxError, std::abs(osc->attribute<Real>("x")->get() - osc->solution(sim2.time())));
+
+	// Bounded history of a standalone solver
+	std::vector<std::shared_ptr<DampedOscillator>> oscillators3;
+	oscillatorSystem("c", count, 2 * PI, oscillators3);
+	ODEintSolver solver(args.name + "_Standalone", args.timeStep, Logger::Level::off);
+	for (auto osc : oscillators3)
+		solver.addComponent(osc);
+	solver.setHistoryLength(100);
+	solver.initialize();
+	Real time = 0;
+	while (time < args.duration - args.timeStep / 2)
+		time = solver.step(time);
+
+	std::vector<Real> row(solver.history()->rowSize());
+	UInt rows = 0;
+	Real lastTime = 0;
+	while (solver.history()->pop(row.data())) {
+		lastTime = row[0];
+		++rows;
+	}
+
+	std::cout << "components per simulation: " << count << std::endl;
+	std::cout << "two simulation steps [us]: " << stepTime << std::endl;
+	std::cout << "max deviation from analytical solution: " << maxError << std::endl;
+	std::cout << "history rows: " << rows << " up to " << lastTime << std::endl;
+
+	if (maxError > 1e-6 || rows != solver.history()->capacity() || std::abs(lastTime - time) > 1e-12)
+		return 1;
+}
@@ -0,0 +1,74 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <cps/CIM/Reader.h>
+#include <DPsim.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+/// Measures the mean time of a powerflow time step, i.e. the Newton-Raphson
+/// iterations including the Jacobian assembly and factorization.
+static void PF_CIM_Scaling(const std::list<fs::path>& filenames, UInt copies, UInt steps) {
+	// Every copy keeps its own slack bus, so the system consists of
+	// independent feeders whose Jacobian has the same sparsity per bus as
+	// the original grid
+	auto system = multipliedTopology([&]() {
+		CIM::Reader reader("PF_CIM_Scaling", Logger::Level::off, Logger::Level::off);
+		return reader.loadCIM(50, filenames, Domain::SP);
+	}, copies, 50);
+
+	Simulation sim("PF_CIM_Scaling", Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(steps);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.initialize();
+
+	Real time = 0;
+	Real total = 0;
+	UInt count = 0;
+	while (time < steps) {
+		auto start = Clock::now();
+		time = sim.step();
+		auto end = Clock::now();
+		total += toMs(end - start);
+		count++;
+	}
+
+	std::cout << copies << "," << system.mNodes.size() << "," << total / count << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "PF_CIM_Scaling", 1, 10);
+
+	std::list<fs::path> filenames;
+	if (args.positional.empty()) {
+		filenames = DPsim::Utils::findFiles({
+			"Rootnet_FULL_NE_06J16h_DI.xml",
+			"Rootnet_FULL_NE_06J16h_EQ.xml",
+			"Rootnet_FULL_NE_06J16h_SV.xml",
+			"Rootnet_FULL_NE_06J16h_TP.xml"
+		}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH");
+	}
+	else {
+		filenames = args.positionalPaths();
+	}
+
+	UInt maxCopies = option<UInt>(args, "copies", 64);
+
+	std::cout << "copies,buses,mean_step_ms" << std::endl;
+	for (UInt copies = 1; copies <= maxCopies; copies *= 2)
+		PF_CIM_Scaling(filenames, copies, static_cast<UInt>(args.duration));
+}
@@ -0,0 +1,157 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include <DPsim.h>
+#include <cps/CSVReader.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+namespace fs = std::experimental::filesystem;
+
+/// Maximum deviation of a profile from the linear interpolation of the
+/// rows of the file, accessing all steps in order
+static Real deviation(LoadProfile& profile, const std::vector<PQData>& rows, Real rowStep) {
+	Real maxDev = 0;
+	for (UInt k = 0; k < profile.numSteps(); ++k) {
+		Real time = k * profile.timeStep();
+		UInt row = std::min(static_cast<UInt>(time / rowStep), static_cast<UInt>(rows.size()) - 2);
+		Real delta = (time - row * rowStep) / rowStep;
+		PQData pq = profile.pq(k);
+		maxDev = std::max(maxDev, std::abs(pq.p - (rows[row].p + delta * (rows[row + 1].p - rows[row].p))));
+		maxDev = std::max(maxDev, std::abs(pq.q - (rows[row].q + delta * (rows[row + 1].q - rows[row].q))));
+	}
+	return maxDev;
+}
+
+/// Checks interpolation, clamping and window reloads against a small
+/// profile with known values. Its first row is after the start time.
+static Bool checkKnownProfile(const fs::path& dir, CSVReader& reader) {
+	fs::path file = dir / "Known.csv";
+	{
+		std::ofstream csv(file);
+		csv << "time,P,Q\n10,1,10\n20,3,30\n30,2,20\n40,4,40\n";
+	}
+	// Steps of 5 s from 0 to 50 s, in kW
+	std::vector<Real> expected = { 1, 1, 1, 2, 3, 2.5, 2, 3, 4, 4, 4 };
+
+	Bool ok = true;
+	LoadProfile profile(file, 0, 5, 50, LoadProfile::DataFormat::SECONDS, 3);
+	ok = ok && profile.numSteps() == expected.size() && profile.window() == 3;
+	for (UInt k = 0; k < profile.numSteps(); ++k) {
+		PQData pq = profile.pq(k);
+		ok = ok && std::abs(pq.p - expected[k] * 1000) < 1e-9
+			&& std::abs(pq.q - expected[k] * 10000) < 1e-9;
+	}
+	// Four windows cover the grid, an earlier step reloads the file
+	ok = ok && profile.numLoads() == 4;
+	ok = ok && profile.pq(3).p == 2000 && profile.numLoads() == 5;
+	// Times off the grid map to the nearest step within the grid
+	ok = ok && profile.step(-10) == 0 && profile.step(12.4) == 2
+		&& profile.step(1000) == profile.numSteps() - 1;
+
+	// The map based reader keeps all rows
+	PowerProfile map = reader.readLoadProfile(file, 0, 5, 50);
+	ok = ok && map.pqData.size() == expected.size();
+	for (UInt k = 0; k < expected.size() && ok; ++k)
+		ok = map.pqData.count(k * 5.) && std::abs(map.pqData[k * 5.].p - expected[k] * 1000) < 1e-9;
+
+	std::cout << "known profile matches: " << ok << std::endl;
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv, "PF_Load_Profile_Streaming");
+
+	// Year long profile with a resolution of 15 minutes, resampled onto
+	// steps of one minute
+	Real days = option<Real>(args, "days", 365), timeStep = 60;
+	UInt window = option<UInt>(args, "window", 1440);
+	Real endTime = days * 86400;
+
+	fs::path dir = fs::temp_directory_path() / args.name;
+	fs::create_directories(dir);
+	fs::path file = dir / "Load1.csv";
+	std::vector<PQData> rows;
+	{
+		std::ofstream csv(file);
+		csv.precision(17);
+		csv << "time,P,Q\n";
+		for (Real t = 0; t <= endTime; t += 900) {
+			rows.push_back({ 100 + 50 * std::sin(t / 86400 * 2 * PI), 20 + 10 * std::cos(t / 3600) });
+			csv << t << "," << rows.back().p << "," << rows.back().q << "\n";
+			rows.back().p *= 1000;
+			rows.back().q *= 1000;
+		}
+	}
+
+	CSVReader reader(args.name, std::list<fs::path>{ file }, Logger::Level::off);
+
+	auto start = Clock::now();
+	PowerProfile reference = reader.readLoadProfile(file, 0, timeStep, endTime);
+	Real mapReadMs = elapsedMs(start);
+	start = Clock::now();
+	Real sum = 0;
+	for (Real t = 0; t <= endTime; t += timeStep)
+		sum += reference.pqData.find(t)->second.p;
+	Real mapAccessMs = elapsedMs(start);
+
+	start = Clock::now();
+	LoadProfile full(file, 0, timeStep, endTime);
+	Real fullReadMs = elapsedMs(start);
+	start = Clock::now();
+	Real fullSum = 0;
+	for (UInt k = 0; k < full.numSteps(); ++k)
+		fullSum += full.pq(k).p;
+	Real fullAccessMs = elapsedMs(start);
+
+	start = Clock::now();
+	LoadProfile streamed(file, 0, timeStep, endTime, LoadProfile::DataFormat::SECONDS, window);
+	Real streamedSum = 0;
+	for (UInt k = 0; k < streamed.numSteps(); ++k)
+		streamedSum += streamed.pq(k).p;
+	Real streamedMs = elapsedMs(start);
+
+	std::cout << "steps: " << full.numSteps() << ", window: " << streamed.window()
+		<< ", windows loaded: " << streamed.numLoads() << std::endl;
+	// The deprecated map based reader is the baseline
+	std::cout << "map read / access [ms]: " << mapReadMs << " / " << mapAccessMs << std::endl;
+	std::cout << "resampled read / access [ms]: " << fullReadMs << " / " << fullAccessMs << std::endl;
+	std::cout << "streamed read and access [ms]: " << streamedMs << std::endl;
+
+	Real fullDev = deviation(full, rows, 900);
+	Real streamedDev = deviation(streamed, rows, 900);
+	std::cout << "max deviation from rows [W]: " << fullDev << " / " << streamedDev << std::endl;
+
+	// Earlier steps rewind the file, the load looks its profile up by time
+	PQData late = streamed.pq(streamed.numSteps() - 1);
+	PQData early = streamed.pq(10);
+	Bool ok = fullDev < 1e-6 && streamedDev < 1e-6 && fullSum == streamedSum && sum != 0
+		&& late.p == full.pq(full.numSteps() - 1).p && early.p == full.pq(10).p;
+
+	SystemTopology sys(50);
+	auto load = SP::Ph1::Load::make("Load1", Logger::Level::off);
+	sys.addComponent(load);
+	reader.setProfileWindow(window);
+	reader.assignLoadProfile(sys, 0, timeStep, endTime);
+	load->updatePQ(3600 * 30);
+	ok = ok && load->use_profile && load->mLoadProfile->window() == window
+		&& load->attribute<Real>("P")->get() == full.pq(30 * 60).p;
+
+	std::cout << "streamed profile matches: " << ok << std::endl;
+	ok = checkKnownProfile(dir, reader) && ok;
+	fs::remove_all(dir);
+	if (!ok)
+		return 1;
+}
@@ -0,0 +1,110 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+#include "Benchmarks.h"
+
+using namespace DPsim;
+using namespace DPsim::Benchmarks;
+using namespace CPS;
+
+/// Task without any work so that the measured step time is the
+/// scheduling overhead only
+class EmptyTask : public Task {
+public:
+	EmptyTask(String name) : Task(name),
+		mOutput(Attribute<Real>::make(&mValue, Flags::read)) {
+		mModifiedAttributes.push_back(mOutput);
+	}
+
+	void dependOn(const std::shared_ptr<EmptyTask>& other) {
+		mAttributeDependencies.push_back(other->mOutput);
+	}
+
+	void markExternal() {
+		mModifiedAttributes.push_back(Scheduler::external);
+	}
+
+	void execute(Real time, Int timeStepCount) {
+		mValue = time;
+	}
+
+private:
+	Real mValue = 0;
+	AttributeBase::Ptr mOutput;
+};
+
+/// Creates a layered task graph in which every task depends on two tasks
+/// of the previous layer, similar to the pre-step / solve / post-step
+/// structure of a decoupled network
+static Task::List createTaskGraph(UInt layers, UInt width) {
+	Task::List tasks;
+	std::vector<std::shared_ptr<EmptyTask>> previous;
+	for (UInt l = 0; l < layers; l++) {
+		std::vector<std::shared_ptr<EmptyTask>> current;
+		for (UInt w = 0; w < width; w++) {
+			auto task = std::make_shared<EmptyTask>("task_" + std::to_string(l) + "_" + std::to_string(w));
+			if (!previous.empty()) {
+				task->dependOn(previous[w]);
+				task->dependOn(previous[(w + 1) % width]);
+			}
+			if (l == layers - 1)
+				task->markExternal();
+			current.push_back(task);
+			tasks.push_back(task);
+		}
+		previous = current;
+	}
+	return tasks;
+}
+
+static void measure(String name, std::shared_ptr<Scheduler> scheduler,
+	UInt layers, UInt width, UInt steps) {
+	Task::List tasks = createTaskGraph(layers, width);
+	Scheduler::Edges inEdges, outEdges;
+	scheduler->resolveDeps(tasks, inEdges, outEdges);
+	scheduler->createSchedule(tasks, inEdges, outEdges);
+
+	// warm up caches and wake up all threads
+	for (UInt s = 0; s < 100; s++)
+		scheduler->step(s, s);
+
+	auto start = Clock::now();
+	for (UInt s = 100; s < steps + 100; s++)
+		scheduler->step(s, s);
+	auto end = Clock::now();
+	scheduler->stop();
+
+	Real stepNs = std::chrono::duration<Real, std::nano>(end - start).count() / steps;
+	std::cout << name << "," << layers * width << ","
+		<< stepNs / 1000 << "," << stepNs / (layers * width) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	UInt layers = option<UInt>(args, "layers", 8);
+	UInt width = option<UInt>(args, "width", 8);
+	UInt steps = option<UInt>(args, "steps", 20000);
+	Int threads = option<Int>(args, "threads", 2);
+
+	std::cout << "scheduler,tasks,step_us,overhead_ns_per_task" << std::endl;
+	measure("sequential", std::make_shared<SequentialScheduler>(), layers, width, steps);
+	measure("thread_level", std::make_shared<ThreadLevelScheduler>(threads), layers, width, steps);
+	measure("thread_list", std::make_shared<ThreadListScheduler>(threads), layers, width, steps);
+	measure("work_stealing", std::make_shared<WorkStealingScheduler>(threads), layers, width, steps);
+
+	return 0;
+}
@@ -74,12 +74,12 @@ int main(int argc, char* argv[]) {
                                     Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H,
                                     initActivePower, initReactivePower, initTerminalVolt, initVoltAngle, fieldVoltage, mechPower);
 
-    ODEintSolver sim(simName, gen, timeStep, timeStep);
+    ODEintSolver sim(simName, gen, timeStep);
 
     while (curTime < finalTime){
 
         curTime = sim.step(curTime);
-        for (auto sol : sim.curSolution)
+        for (auto sol : sim.states())
             std::cout<< sol<<std::endl;
 
     }
@@ -0,0 +1,37 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+
+#include <dpsim/BinaryDataLogger.h>
+
+using namespace DPsim;
+
+int main(int argc, char *argv[]) {
+	if (argc < 2 || argc > 3) {
+		std::cerr << "Usage: " << argv[0] << " LOG.bin [LOG.csv]" << std::endl;
+		return -1;
+	}
+
+	fs::path binFilename = argv[1];
+	fs::path csvFilename = binFilename;
+	if (argc == 3)
+		csvFilename = argv[2];
+	else
+		csvFilename.replace_extension(".csv");
+
+	try {
+		BinaryDataLogger::convertToCsv(binFilename, csvFilename);
+	}
+	catch (const CPS::SystemError &e) {
+		std::cerr << e.descr() << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
@@ -9,6 +9,8 @@
 #include <dpsim/Config.h>
 #include <dpsim/Utils.h>
 #include <dpsim/Simulation.h>
+#include <dpsim/BinaryDataLogger.h>
+#include <dpsim/TopologyPartitioner.h>
 
 #ifndef _MSC_VER
   #include <dpsim/RealTimeSimulation.h>
@@ -0,0 +1,28 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace DPsim {
+	/// \brief Counts heap allocations of all threads while armed.
+	///
+	/// The global operator new is replaced by a counting version when DPsim
+	/// is built with WITH_ALLOCATION_GUARD. This is meant for debugging
+	/// real-time setups, which must not allocate memory during a step.
+	class AllocationGuard {
+	public:
+		/// Starts counting allocations
+		static void arm();
+		/// Stops counting and returns the number of allocations since arm()
+		static std::size_t disarm();
+		/// Size in bytes of the first allocation after arm()
+		static std::size_t firstAllocationSize();
+	};
+}
@@ -0,0 +1,64 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// \brief Anderson acceleration of a fixed-point iteration x = g(x).
+	///
+	/// Instead of continuing with g(x), the next iterate combines the images
+	/// of the last iterates such that the combination of their residuals
+	/// g(x) - x becomes minimal. For an affine g, like a time step of a
+	/// linear network, this is equivalent to GMRES on the linear system
+	/// of the fixed point. The history is allocated once by reset.
+	class AndersonAcceleration {
+	public:
+		/// Upper limit of the depth, which keeps the least squares
+		/// problem in fixed size matrices
+		static const UInt MaxDepth = 16;
+
+		/// Combines at most depth previous iterates
+		AndersonAcceleration(UInt depth = 5);
+
+		/// Allocates the history for iterates of the given size and clears it
+		void reset(UInt size);
+		/// Computes the next iterate from the iterate x and its image g(x).
+		/// The next iterate may be stored in x.
+		void next(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& gx, Eigen::Ref<Matrix> next);
+		/// Number of previous iterates combined in the last call of next
+		UInt usedDepth() const { return mCount; }
+		/// Number of times the history was dropped because the residual grew
+		UInt restarts() const { return mRestarts; }
+
+	private:
+		typedef Eigen::Matrix<Real, Eigen::Dynamic, Eigen::Dynamic, 0, MaxDepth, MaxDepth> SmallMatrix;
+		typedef Eigen::Matrix<Real, Eigen::Dynamic, 1, 0, MaxDepth, 1> SmallVector;
+
+		UInt mDepth;
+		/// Differences of the residuals of consecutive iterates as columns
+		Matrix mResidualDiffs;
+		/// Differences of the images of consecutive iterates as columns
+		Matrix mImageDiffs;
+		/// Inner products of the residual differences, which are updated
+		/// for the new column only
+		SmallMatrix mNormal;
+		Matrix mResidual;
+		Matrix mPrevResidual;
+		Matrix mPrevImage;
+		/// Column of the history that is overwritten next
+		UInt mColumn = 0;
+		/// Number of valid columns in the history
+		UInt mCount = 0;
+		Bool mHasPrevious = false;
+		/// Smallest residual norm since the last restart
+		Real mBestResidualNorm = 0;
+		UInt mRestarts = 0;
+	};
+}
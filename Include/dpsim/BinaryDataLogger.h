@@ -0,0 +1,120 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <dpsim/DataLogger.h>
+
+namespace DPsim {
+
+	/// Data logger writing raw binary rows instead of formatted text.
+	///
+	/// The file starts with a header which lists the column names and types:
+	///
+	///     char[8]  magic "DPSIMBIN"
+	///     uint32   format version
+	///     uint32   number of columns
+	///     per column: uint8 type (0 = real, 1 = complex),
+	///                 uint32 name length, name characters
+	///
+	/// It is followed by one row per logged time step consisting of the
+	/// time and the column values as little-endian doubles. Complex
+	/// columns take two doubles (real and imaginary part), integer
+	/// attributes are stored as doubles.
+	///
+	/// The value pointers of all attributes are resolved once before the
+	/// first row is written, so logging a step only copies doubles into a
+	/// large write buffer which is flushed when it is full. In asynchronous
+	/// mode, the rows go through the ring buffer and the writer thread
+	/// fills the write buffer.
+	class BinaryDataLogger :
+		public DataLogger,
+		public SharedFactory<BinaryDataLogger> {
+
+	public:
+		enum class ColumnType : std::uint8_t { Real = 0, Complex = 1 };
+
+		static constexpr std::uint32_t FormatVersion = 1;
+
+	protected:
+		enum class Source { Int, Real, Complex, MatrixReal, MatrixComp };
+
+		struct Column {
+			String name;
+			ColumnType type;
+			Source source;
+			CPS::AttributeBase::Ptr attribute;
+			UInt row;
+			UInt col;
+			/// Address of the value, nullptr for getter attributes
+			const void* value;
+		};
+
+		/// Columns sorted by name as registered by addAttribute
+		std::map<String, Column> mColumns;
+		/// Columns in file order with resolved value pointers
+		std::vector<Column> mResolvedColumns;
+		/// True once the pointers are resolved
+		Bool mResolved = false;
+		/// True once the header is in the write buffer
+		Bool mHeaderWritten = false;
+		/// Number of reals per row including the time
+		UInt mRowSize = 1;
+		/// Row of a synchronous logger
+		std::vector<Real> mRow;
+
+		std::vector<char> mBuffer;
+		std::size_t mBufferPos = 0;
+
+		void addColumn(const String &name, ColumnType type, Source source,
+			CPS::AttributeBase::Ptr attr, UInt row = 0, UInt col = 0);
+		void resolveColumns();
+		void writeHeader();
+		void flush();
+
+		void append(const void* data, std::size_t size) {
+			if (mBufferPos + size > mBuffer.size())
+				flush();
+			std::memcpy(mBuffer.data() + mBufferPos, data, size);
+			mBufferPos += size;
+		}
+		void appendReal(Real value);
+		void writeRow(const Real* row, UInt size) override;
+
+	public:
+		typedef std::shared_ptr<BinaryDataLogger> Ptr;
+
+		using SharedFactory<BinaryDataLogger>::make;
+		using DataLogger::addAttribute;
+
+		/// The log is written to <logDir>/<name>.bin
+		BinaryDataLogger(String name, Bool enabled = true, UInt downsampling = 1,
+			std::size_t bufferSize = 4 << 20);
+		~BinaryDataLogger();
+
+		void open() override;
+		void close() override;
+
+		void addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr) override;
+		void addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr) override;
+		void addAttribute(const String &name, CPS::Attribute<Complex>::Ptr attr) override;
+		void addAttribute(const String &name, CPS::MatrixRealAttribute::Ptr attr) override;
+		void addAttribute(const String &name, CPS::MatrixCompAttribute::Ptr attr, UInt rowsMax = 0, UInt colsMax = 0) override;
+		void addAttribute(const std::vector<String> &name, CPS::MatrixRealAttribute::Ptr attr) override;
+
+		void log(Real time, Int timeStepCount) override;
+
+		/// Converts a binary log into the CSV format of DataLogger.
+		/// Complex columns are split into <name>.re and <name>.im.
+		static void convertToCsv(const fs::path &binFilename, const fs::path &csvFilename);
+	};
+}
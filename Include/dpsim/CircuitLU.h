@@ -0,0 +1,96 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Sparse LU factorization for circuit matrices in the style of KLU.
+	///
+	/// The symbolic analysis permutes the matrix to block upper triangular
+	/// form, using a maximum transversal for a zero-free diagonal and the
+	/// strongly connected components as diagonal blocks, and orders every
+	/// block by exact minimum degree of its symmetrized pattern. Unlike the
+	/// approximate minimum degree (AMD) ordering of KLU, the degrees are
+	/// updated exactly, which makes the analysis slower. The numeric
+	/// factorization is a left-looking Gilbert-Peierls LU with threshold
+	/// partial pivoting that prefers the diagonal. A refactorization reuses
+	/// the pivot sequence and the patterns of L and U of the last
+	/// factorization and only repeats the floating point operations.
+	class CircuitLU {
+	public:
+		/// Computes the permutations for the pattern of the matrix
+		void analyzePattern(const SparseMatrix& matrix);
+		/// Numeric factorization with pivot search.
+		/// The matrix must have the analyzed pattern.
+		void factorize(const SparseMatrix& matrix);
+		/// Numeric factorization with the pivot sequence of the last call of
+		/// factorize. Returns false, leaving the factors invalid, if a pivot
+		/// became too small, in which case factorize has to be called.
+		Bool refactorize(const SparseMatrix& matrix);
+		/// Solves matrix * x = rhs column by column without allocating
+		void solve(const Matrix& rhs, Matrix& x);
+		///
+		Matrix solve(const Matrix& rhs) {
+			Matrix x(rhs.rows(), rhs.cols());
+			solve(rhs, x);
+			return x;
+		}
+
+		/// Non-zeros of L including the unit diagonal
+		Int nnzL() const { return static_cast<Int>(mLi.size()); }
+		/// Non-zeros of U including the diagonal
+		Int nnzU() const { return static_cast<Int>(mUi.size()); }
+		/// Number of diagonal blocks of the block triangular form
+		Int numBlocks() const { return static_cast<Int>(mBlockStarts.size()) - 1; }
+		/// Relative size of the diagonal entry to the largest entry of a column
+		/// down to which the diagonal is kept as pivot
+		void setPivotTolerance(Real tolerance) { mPivotTolerance = tolerance; }
+		/// Relative size of a pivot to the largest entry of its column below
+		/// which a refactorization fails
+		void setRefactorTolerance(Real tolerance) { mRefactorTolerance = tolerance; }
+
+	private:
+		/// Order of the nodes of a symmetric graph by minimum degree
+		static std::vector<Int> minimumDegreeOrder(std::vector<std::vector<Int>>& adjacency);
+
+		Real mPivotTolerance = 0.1;
+		Real mRefactorTolerance = 1e-3;
+		Int mSize = 0;
+		/// Row of the analyzed matrix for each row of the permuted matrix
+		std::vector<Int> mRowPerm;
+		/// Column of the analyzed matrix for each column of the permuted matrix
+		std::vector<Int> mColPerm;
+		/// First column of each diagonal block and the size as last entry
+		std::vector<Int> mBlockStarts;
+
+		/// Permuted matrix in compressed column format
+		std::vector<Int> mCp, mCi;
+		std::vector<Real> mCx;
+		/// Position in mCx of each value of the row major input matrix
+		std::vector<Int> mValueMap;
+
+		/// Unit lower triangular factor by columns, diagonal first
+		std::vector<Int> mLp, mLi;
+		std::vector<Real> mLx;
+		/// Upper triangular factor by columns in elimination order, diagonal last
+		std::vector<Int> mUp, mUi;
+		std::vector<Real> mUx;
+		/// Pivot position of each row of the permuted matrix
+		std::vector<Int> mPinv;
+		/// Row of the analyzed matrix for each pivot position
+		std::vector<Int> mPivotRowSource;
+
+		/// Workspaces
+		std::vector<Real> mX;
+		std::vector<Int> mStack, mMark;
+	};
+}
@@ -0,0 +1,73 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <atomic>
+#include <vector>
+
+namespace DPsim {
+	/// Flat representation of a schedule that is created once after
+	/// Scheduler::createSchedule and used by the threads in every step.
+	/// Tasks are referred to by their index in the schedule. The predecessor
+	/// and successor lists are stored in compressed sparse row format and
+	/// every task has a completion counter on its own cache line, so executing
+	/// a step needs neither shared pointers nor hash map lookups and threads
+	/// signalling different tasks do not invalidate each other's cache lines.
+	class CompiledSchedule {
+	public:
+		/// Assumed size of a cache line in bytes
+		static constexpr size_t CacheLineSize = 64;
+
+		CompiledSchedule() = default;
+		CompiledSchedule(const CompiledSchedule&) = delete;
+		CompiledSchedule& operator=(const CompiledSchedule&) = delete;
+		~CompiledSchedule();
+
+		/// Flattens the given tasks in the given order. Dependencies on tasks
+		/// that are not part of the list (e.g. the root task or dropped tasks)
+		/// are ignored.
+		void compile(const CPS::Task::List& tasks, const Scheduler::Edges& inEdges);
+
+		/// Number of tasks in the schedule
+		Int size() const { return static_cast<Int>(mTasks.size()); }
+		/// Task at the given index
+		CPS::Task* task(Int idx) const { return mTasks[idx]; }
+		/// Number of predecessors of a task inside the schedule
+		Int inDegree(Int idx) const { return mPredOffsets[idx+1] - mPredOffsets[idx]; }
+
+		const Int* predecessorsBegin(Int idx) const { return mPredIndices.data() + mPredOffsets[idx]; }
+		const Int* predecessorsEnd(Int idx) const { return mPredIndices.data() + mPredOffsets[idx+1]; }
+		const Int* successorsBegin(Int idx) const { return mSuccIndices.data() + mSuccOffsets[idx]; }
+		const Int* successorsEnd(Int idx) const { return mSuccIndices.data() + mSuccOffsets[idx+1]; }
+
+		/// Completion counter of a task. The meaning of the value is up
+		/// to the scheduler, e.g. finished steps or pending predecessors.
+		std::atomic<Int>& counter(Int idx) const { return mCounters[idx].value; }
+
+	private:
+		struct PaddedCounter {
+			std::atomic<Int> value;
+			char padding[CacheLineSize - sizeof(std::atomic<Int>)];
+		};
+
+		void freeCounters();
+
+		std::vector<CPS::Task*> mTasks;
+		std::vector<Int> mPredOffsets;
+		std::vector<Int> mPredIndices;
+		std::vector<Int> mSuccOffsets;
+		std::vector<Int> mSuccIndices;
+
+		/// Cache line aligned counter array inside mCounterStorage
+		PaddedCounter* mCounters = nullptr;
+		char* mCounterStorage = nullptr;
+	};
+}
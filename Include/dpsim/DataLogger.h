@@ -11,21 +11,43 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <thread>
 #include <experimental/filesystem>
 namespace fs = std::experimental::filesystem;
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/LogRingBuffer.h>
 #include <cps/PtrFactory.h>
 #include <cps/Attribute.h>
+#include <cps/AttributeList.h>
 #include <cps/SimNode.h>
 #include <cps/Task.h>
 
 namespace DPsim {
 
-	class DataLogger : public SharedFactory<DataLogger> {
+	class DataLogger :
+		public SharedFactory<DataLogger>,
+		public CPS::AttributeList {
+
+	public:
+		/// Behavior of an asynchronous logger if its ring buffer is full
+		enum class OverflowPolicy {
+			/// Wait until the writer thread has made room
+			block,
+			/// Overwrite the oldest row which was not written yet
+			dropOldest,
+			/// Skip rows and double the downsampling factor on every
+			/// overflow, halve it again once the buffer has drained
+			downsample
+		};
 
 	protected:
+		/// Layout of the rows passed to writeRow. Rows of complex values
+		/// hold the real and imaginary parts one after the other.
+		enum class RowFormat { Attributes, Values, ComplexValues };
+
 		std::ofstream mLogFile;
 		String mName;
 		Bool mEnabled;
@@ -34,6 +56,44 @@ namespace DPsim {
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
+		/// Column names written as header before the first row
+		std::vector<String> mColumnNames;
+		RowFormat mRowFormat = RowFormat::Values;
+		/// Logged attributes in column order, used for asynchronous logging
+		std::vector<CPS::AttributeBase::Ptr> mRowAttributes;
+		/// True for columns of integer attributes
+		std::vector<Bool> mIntegerColumns;
+
+		// #### Asynchronous logging ####
+		/// Ring buffer capacity in rows, 0 if logging is synchronous
+		UInt mAsyncCapacity = 0;
+		OverflowPolicy mOverflowPolicy = OverflowPolicy::block;
+		/// Allocated when the first row is logged and its size is known
+		std::unique_ptr<LogRingBuffer> mQueue;
+		/// Drains mQueue to the log file
+		std::thread mWriter;
+		std::atomic<bool> mWriterStop;
+		/// Number of rows which found the ring buffer full
+		Int mOverflows = 0;
+		/// Number of rows which were discarded because of overflows
+		Int mDroppedRows = 0;
+		/// Current downsampling factor of OverflowPolicy::downsample
+		UInt mOverflowDownsampling = 1;
+		UInt mQueuedRowCount = 0;
+
+		/// Returns a row of the ring buffer to be filled and committed
+		/// or nullptr if the row is dropped according to the overflow policy.
+		/// Starts the writer thread on first use.
+		Real* reserveRow(UInt size);
+		void writerLoop();
+		void stopWriter();
+		/// Writes the column names if nothing was written yet
+		void writeColumnNames();
+		/// Formats a row of time and values in the log file
+		virtual void writeRow(const Real* row, UInt size);
+		/// Queues a row of time and values for the writer thread
+		void queueRow(Real time, const Real* values, UInt size, RowFormat format);
+
 		void logDataLine(Real time, Real data);
 		void logDataLine(Real time, const Matrix& data);
 		void logDataLine(Real time, const MatrixComp& data);
@@ -44,9 +104,10 @@ namespace DPsim {
 
 		DataLogger(Bool enabled = true);
 		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		virtual ~DataLogger();
 
-		void open();
-		void close();
+		virtual void open();
+		virtual void close();
 		void reopen() {
 			close();
 			open();
@@ -57,22 +118,29 @@ namespace DPsim {
 
 		void setColumnNames(std::vector<String> names);
 
+		/// Decouples file output from the simulation. Logged rows are copied
+		/// into a ring buffer with the given capacity which is drained by
+		/// a background thread. The number of overflows and dropped rows
+		/// are available as attributes "overflows" and "dropped_rows".
+		void setAsync(UInt capacity = 1024, OverflowPolicy policy = OverflowPolicy::block);
+		Bool isAsync() const { return mAsyncCapacity > 0; }
+
 		void addAttribute(const String &name, CPS::AttributeBase::Ptr attr);
-		void addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr);
-		void addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr);
-		void addAttribute(const String &name, CPS::Attribute<Complex>::Ptr attr);
-		void addAttribute(const String &name, CPS::MatrixRealAttribute::Ptr attr);
-		void addAttribute(const String &name, CPS::MatrixCompAttribute::Ptr attr, UInt rowsMax = 0, UInt colsMax = 0);
+		virtual void addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr);
+		virtual void addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr);
+		virtual void addAttribute(const String &name, CPS::Attribute<Complex>::Ptr attr);
+		virtual void addAttribute(const String &name, CPS::MatrixRealAttribute::Ptr attr);
+		virtual void addAttribute(const String &name, CPS::MatrixCompAttribute::Ptr attr, UInt rowsMax = 0, UInt colsMax = 0);
 		void addAttribute(const String &name, const String &attr, CPS::IdentifiedObject::Ptr obj);
 		void addAttribute(const std::vector<String> &name, CPS::AttributeBase::Ptr attr);
-		void addAttribute(const std::vector<String> &name, CPS::MatrixRealAttribute::Ptr attr);
+		virtual void addAttribute(const std::vector<String> &name, CPS::MatrixRealAttribute::Ptr attr);
 
 		template<typename VarType>
 		void addNode(typename CPS::SimNode<VarType>::Ptr node) {
 			addAttribute(node->name() + ".voltage", node->attributeMatrix("voltage"));
 		}
 
-		void log(Real time, Int timeStepCount);
+		virtual void log(Real time, Int timeStepCount);
 
 		CPS::Task::Ptr getTask();
 
@@ -14,6 +14,7 @@
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
 
+#include <functional>
 #include <unordered_map>
 
 namespace DPsim {
@@ -37,6 +38,16 @@ namespace DPsim {
 			UInt sysOff;
 			/// Factorization of the subnet's block
 			CPS::LUFactorized luFactorization;
+			/// Columns of the tear topology with entries in this subnet
+			std::vector<UInt> tearColumns;
+			/// Tear topology restricted to the subnet's block and tear columns
+			SparseMatrix tearTopology;
+			/// Contribution C_k^T * Y_k^-1 * C_k to the total tear impedance
+			Matrix tearImpedance;
+			/// Tear currents of the tear columns
+			Matrix tearCurrents;
+			/// Contribution C_k^T * v_k of the subnet to the tear voltages
+			Matrix tearVoltages;
 			/// List of all right side vector contributions
 			std::vector<const Matrix*> rightVectorStamps;
 			/// Left-side vector of the subnet AFTER complete step
@@ -60,14 +71,10 @@ namespace DPsim {
 
 		Matrix mRightSideVector;
 		Matrix mLeftSideVector;
-		/// Complete matrix in block form
-		Matrix mSystemMatrix;
-		/// Inverse of the complete system matrix (only used for initialization)
-		Matrix mSystemInverse;
 		/// Solutions of the split systems
 		Matrix mOrigLeftSideVector;
 		/// Topology of the network removal
-		Matrix mTearTopology;
+		SparseMatrix mTearTopology;
 		/// Impedance of the removed network
 		Matrix mTearImpedance;
 		/// (Factorization of the) impedance matrix for the removed network, including
@@ -94,8 +101,12 @@ namespace DPsim {
 
 		void initComponents();
 
+		/// Calls func for all subnets, in parallel if OpenMP is available
+		void forEachSubnet(const std::function<void(Subnet&)>& func);
+
 		void initMatrices();
-		void applyTearComponentStamp(UInt compIdx);
+		void applyTearComponentStamp(UInt compIdx, std::vector<Eigen::Triplet<Real>>& topology);
+		void initSubnetTearMatrices(Subnet& net);
 
 		void log(Real time);
 
@@ -104,6 +115,12 @@ namespace DPsim {
 
 		CPS::Task::List getTasks();
 
+		/// Write the left and right side vector logs from a background thread
+		void setAsyncLogging(UInt capacity, DataLogger::OverflowPolicy policy) override {
+			mLeftVectorLog->setAsync(capacity, policy);
+			mRightVectorLog->setAsync(capacity, policy);
+		}
+
 		class SubnetSolveTask : public CPS::Task {
 		public:
 			SubnetSolveTask(DiakopticsSolver<VarType>& solver, UInt net) :
@@ -129,7 +146,7 @@ namespace DPsim {
 			PreSolveTask(DiakopticsSolver<VarType>& solver) :
 				Task(solver.mName + ".PreSolve"), mSolver(solver) {
 				mAttributeDependencies.push_back(solver.attribute("old_left_vector"));
-				mModifiedAttributes.push_back(solver.attribute("mapped_tear_currents"));
+				mModifiedAttributes.push_back(solver.attribute("tear_currents"));
 			}
 
 			void execute(Real time, Int timeStepCount);
@@ -142,7 +159,10 @@ namespace DPsim {
 		public:
 			SolveTask(DiakopticsSolver<VarType>& solver, UInt net) :
 				Task(solver.mName + ".Solve_" + std::to_string(net)), mSolver(solver), mSubnet(solver.mSubnets[net]) {
-				mAttributeDependencies.push_back(solver.attribute("mapped_tear_currents"));
+				mAttributeDependencies.push_back(solver.attribute("tear_currents"));
+				for (UInt node = 0; node < mSubnet.mRealNetNodeNum; ++node) {
+					mModifiedAttributes.push_back(mSubnet.nodes[node]->attribute("v"));
+				}
 				mModifiedAttributes.push_back(mSubnet.leftVector);
 			}
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <deque>
+#include <vector>
 #include <queue>
 
 #include <dpsim/Config.h>
@@ -42,6 +43,9 @@ namespace DPsim {
 		{ }
 
 		virtual ~Event() {}
+
+		///
+		CPS::Real time() const { return mTime; }
 	};
 
 	class EventComparator {
@@ -90,6 +94,11 @@ namespace DPsim {
 			else
 				mSwitch->open();
 		}
+
+		///
+		const std::shared_ptr<CPS::Base::Ph1::Switch>& target() const { return mSwitch; }
+		///
+		CPS::Bool newState() const { return mNewState; }
 	};
 
 	class SwitchEvent3Ph : public Event, public SharedFactory<SwitchEvent3Ph> {
@@ -113,6 +122,11 @@ namespace DPsim {
 			else
 				mSwitch->openSwitch();
 		}
+
+		///
+		const std::shared_ptr<CPS::Base::Ph3::Switch>& target() const { return mSwitch; }
+		///
+		CPS::Bool newState() const { return mNewState; }
 	};
 
 
@@ -126,6 +140,8 @@ namespace DPsim {
 		void addEvent(Event::Ptr e);
 		///
 		void handleEvents(CPS::Real currentTime);
+		/// Returns the pending events ordered by their time
+		std::vector<Event::Ptr> events() const;
 	};
 }
 
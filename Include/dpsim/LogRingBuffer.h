@@ -0,0 +1,102 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+	/// Lock-free single-producer single-consumer ring buffer of rows with
+	/// a fixed number of reals.
+	///
+	/// The producer writes a row in place between reserve() and commit().
+	/// Besides taking rows, the producer may also drop the oldest row
+	/// when the buffer is full. For this, the consumer copies a row first
+	/// and only then claims it by advancing the tail. If the producer
+	/// dropped the row in the meantime, the claim fails and the possibly
+	/// overwritten copy is discarded.
+	class LogRingBuffer {
+	public:
+		/// The capacity is rounded up to a power of two
+		LogRingBuffer(UInt capacity, UInt rowSize) :
+			mRowSize(rowSize), mHead(0), mTail(0) {
+			mCapacity = 1;
+			while (mCapacity < capacity)
+				mCapacity <<= 1;
+			mData.resize(static_cast<std::size_t>(mCapacity) * mRowSize);
+		}
+
+		UInt capacity() const { return mCapacity; }
+		UInt rowSize() const { return mRowSize; }
+
+		/// Number of rows in the buffer
+		UInt size() const {
+			return static_cast<UInt>(mHead.load(std::memory_order_acquire)
+				- mTail.load(std::memory_order_acquire));
+		}
+
+		/// Returns the next free row or nullptr if the buffer is full.
+		/// Must be called by the producer only.
+		Real* reserve() {
+			std::uint64_t head = mHead.load(std::memory_order_relaxed);
+			if (head - mTail.load(std::memory_order_acquire) >= mCapacity)
+				return nullptr;
+			return row(head);
+		}
+
+		/// Publishes the row returned by the last reserve()
+		void commit() {
+			mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/// Drops the oldest row of a full buffer. Returns false if the
+		/// consumer took the row in the meantime.
+		/// Must be called by the producer only.
+		bool dropOldest() {
+			std::uint64_t tail = mHead.load(std::memory_order_relaxed) - mCapacity;
+			return mTail.compare_exchange_strong(tail, tail + 1,
+				std::memory_order_acq_rel, std::memory_order_acquire);
+		}
+
+		/// Copies the oldest row to values and removes it from the buffer.
+		/// Returns false if the buffer is empty.
+		/// Must be called by the consumer only.
+		bool pop(Real* values) {
+			std::uint64_t tail = mTail.load(std::memory_order_acquire);
+			while (tail != mHead.load(std::memory_order_acquire)) {
+				std::memcpy(values, row(tail), mRowSize * sizeof(Real));
+				if (mTail.compare_exchange_weak(tail, tail + 1,
+					std::memory_order_acq_rel, std::memory_order_acquire))
+					return true;
+			}
+			return false;
+		}
+
+	private:
+		Real* row(std::uint64_t index) {
+			return mData.data() + (index & (mCapacity - 1)) * mRowSize;
+		}
+
+		UInt mCapacity;
+		UInt mRowSize;
+		std::vector<Real> mData;
+
+		/// Producer and consumer indices on separate cache lines
+		char mPad0[64];
+		std::atomic<std::uint64_t> mHead;
+		char mPad1[64];
+		std::atomic<std::uint64_t> mTail;
+		char mPad2[64];
+	};
+}
@@ -17,6 +17,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/Event.h>
 #include <cps/AttributeList.h>
 #include <cps/Solver/MNASwitchInterface.h>
 #include <cps/Solver/MNAVariableCompInterface.h>
@@ -32,6 +33,31 @@
 #define SWITCH_NUM sizeof(std::size_t)*8
 
 namespace DPsim {
+	/// Strategies to update the system matrix factorization after variable
+	/// elements (MNAVariableCompInterface) changed their parameters
+	enum class MnaRecomputationMode {
+		/// Symbolic analysis and numeric factorization on every change (default)
+		Full,
+		/// Symbolic analysis once, numeric refactorization on every change
+		ReuseSymbolic,
+		/// Keep the factorization and apply a Sherman-Morrison-Woodbury
+		/// correction for low-rank changes, refactorize otherwise
+		LowRankUpdate
+	};
+
+	/// Orderings of the matrix node indices. The order determines the
+	/// bandwidth of the system matrix and the fill-in of its factorization.
+	enum class MnaNodeOrdering {
+		/// Order of the nodes in the system topology, virtual nodes last
+		Natural,
+		/// Reverse Cuthill-McKee, reduces the bandwidth
+		RCM,
+		/// Approximate minimum degree
+		AMD,
+		/// Column approximate minimum degree
+		COLAMD
+	};
+
 	/// Solver class using Modified Nodal Analysis (MNA).
 	template <typename VarType>
 	class MnaSolver : public Solver, public CPS::AttributeList {
@@ -81,6 +107,11 @@ namespace DPsim {
 		std::vector<Matrix> mRightSideVectorHarm;
 		/// List of all right side vector contributions
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Rows each right side vector contribution can be non-zero in,
+		/// stored consecutively in the order of mRightVectorStamps
+		std::vector<UInt> mRightVectorStampRows;
+		/// Offsets of the rows of each contribution in mRightVectorStampRows
+		std::vector<UInt> mRightVectorStampRowOffsets = { 0 };
 		/// Solution vector of unknown quantities
 		Matrix mLeftSideVector;
 		std::vector<Matrix> mLeftSideVectorHarm;
@@ -97,6 +128,52 @@ namespace DPsim {
 		/// Collects the status of switches to select correct system matrix
 		void updateSwitchStatus();
 
+		// #### Attributes related to the switched matrix cache ####
+		/// Stamp and factorize the system matrix of a switch configuration
+		/// when it occurs for the first time instead of precomputing all
+		/// 2^N configurations during initialization
+		Bool mLazySwitchedMatrices = false;
+		/// Maximum number of cached switch configurations (0 = unlimited)
+		UInt mSwitchedMatrixCacheSize = 0;
+		/// Cached switch configurations, most recently used first
+		std::list< std::bitset<SWITCH_NUM> > mSwitchedMatrixLru;
+		/// Position of each cached switch configuration in the LRU list
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::list< std::bitset<SWITCH_NUM> >::iterator > mSwitchedMatrixLruPos;
+		/// Number of switch configuration changes served from the cache
+		Int mSwitchedMatrixCacheHits = 0;
+		/// Number of switch configuration changes that required a new factorization
+		Int mSwitchedMatrixCacheMisses = 0;
+		/// Switch events from which the configurations for pre-warming the cache are derived
+		std::vector<Event::Ptr> mSwitchedMatrixPrewarmEvents;
+		/// Makes the system matrix and LU factorization of a switch configuration
+		/// available, evicting the least recently used one if the cache is full
+		void requestSwitchedMatrix(const std::bitset<SWITCH_NUM>& status);
+		/// Factorizes the switch configurations resulting from the pre-warm events
+		void prewarmSwitchedMatrices();
+		/// Removes all cached switch configurations
+		void clearSwitchedMatrixCache();
+
+		// #### Attributes related to the node ordering ####
+		/// Ordering of the matrix node indices
+		MnaNodeOrdering mNodeOrdering = MnaNodeOrdering::Natural;
+		/// Maximum distance of coupled nodes in the node ordering
+		Int mNodeBandwidth = 0;
+
+		// #### Attributes related to the complex system ####
+		/// Factorize the system matrices of complex domains as complex matrices
+		/// of half the size instead of their real expansion
+		Bool mComplexNativeSystem = false;
+		/// Right side vector as complex vector
+		MatrixComp mComplexRightSideVector;
+		/// Solution vector as complex vector
+		MatrixComp mComplexLeftSideVector;
+		/// Returns true if the system matrices are factorized as complex matrices,
+		/// which requires a complex domain without harmonics
+		Bool useComplexNativeSystem() const;
+		/// Disables the complex factorization after a system matrix turned out
+		/// not to be the real expansion of a complex matrix
+		void rejectComplexNativeSystem();
+
 		// #### Attributes related to logging ####
 		/// Last simulation time step when log was updated
 		Int mLastLogTimeStep = 0;
@@ -120,15 +197,31 @@ namespace DPsim {
 		void initializeSystemWithPrecomputedMatrices();
 		/// Identify Nodes and SimPowerComps and SimSignalComps
 		void identifyTopologyObjects();
-		/// Assign simulation node index according to index in the vector.
+		/// Assign simulation node indices in the order of orderMatrixNodes.
 		void assignMatrixNodeIndices();
+		/// Computes the position of each node in the system matrix from the
+		/// connectivity of the components. Switches are included regardless
+		/// of their state, so the order is the same for all switch states.
+		std::vector<UInt> orderMatrixNodes();
 		/// Collects virtual nodes inside components.
 		/// The MNA algorithm handles these nodes in the same way as network nodes.
 		void collectVirtualNodes();
-		// TODO: check if this works with AC sources
+		/// Steps the system until the solution does not change anymore. In the
+		/// phasor domains the fixed point of the step is approached by Anderson
+		/// acceleration on the states of all nodes and components.
 		void steadyStateInitialization();
+		/// Collects where the real values of the states of all nodes and
+		/// components and of the solution are stored, see
+		/// CPS::CheckpointVectorReader. Returns the hash of the other values.
+		std::uint64_t collectStateLocations(std::vector<Real*>& locations);
 		/// Create left and right side vector
 		void createEmptyVectors();
+		/// Registers the right side vector contribution of a component
+		/// together with the rows it can be non-zero in
+		void addRightVectorStamp(const std::shared_ptr<CPS::MNAInterface>& comp);
+		/// Sums up the right side vector contributions by only visiting
+		/// their non-zero rows instead of adding full-length vectors
+		void assembleRightSideVector();
 		/// Logging of system matrices and source vector
 		virtual void logSystemMatrices() = 0;
 		/// Sets all entries in the matrix with the given switch index to zero
@@ -137,6 +230,8 @@ namespace DPsim {
 		virtual void createEmptySystemMatrix() = 0;
 		/// Applies a component stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) = 0;
+		/// Releases the matrix and LU factorization with the given switch index
+		virtual void switchedMatrixErase(std::size_t index) = 0;
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createSolveTask() = 0;
 		/// Create a solve task for this solver implementation
@@ -167,8 +262,32 @@ namespace DPsim {
 		Matrix& leftSideVector() { return mLeftSideVector; }
 		///
 		Matrix& rightSideVector() { return mRightSideVector; }
+		/// Factorize switched system matrices on first use instead of precomputing all of them
+		void doLazySwitchedMatrices(Bool value) { mLazySwitchedMatrices = value; }
+		/// Limit the number of cached switched system matrices (0 = unlimited)
+		void setSwitchedMatrixCacheSize(UInt size) { mSwitchedMatrixCacheSize = size; }
+		/// Set switch events whose resulting configurations are factorized during initialization
+		void setSwitchedMatrixPrewarmEvents(const std::vector<Event::Ptr>& events) { mSwitchedMatrixPrewarmEvents = events; }
+		/// Select the ordering of the matrix node indices
+		void setNodeOrdering(MnaNodeOrdering ordering) { mNodeOrdering = ordering; }
+		/// Factorize the system matrices of DP and SP simulations as complex matrices
+		void doComplexNativeSystem(Bool value) { mComplexNativeSystem = value; }
+		/// Write the left and right side vector logs from a background thread
+		void setAsyncLogging(UInt capacity, DataLogger::OverflowPolicy policy) override {
+			mLeftVectorLog->setAsync(capacity, policy);
+			mRightVectorLog->setAsync(capacity, policy);
+		}
+		///
+		Int switchedMatrixCacheHits() const { return mSwitchedMatrixCacheHits; }
+		///
+		Int switchedMatrixCacheMisses() const { return mSwitchedMatrixCacheMisses; }
 		///
 		virtual CPS::Task::List getTasks() override;
+		/// Writes the solution and source vectors and the switch status
+		virtual void writeCheckpoint(CPS::CheckpointWriter& writer) override;
+		/// Restores the vectors and the switch status and activates the
+		/// system matrix of the restored switch status
+		virtual void readCheckpoint(CPS::CheckpointReader& reader, Real time) override;
 
 	};
 }
@@ -0,0 +1,170 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/MNASolverEigenSparse.h>
+
+namespace DPsim {
+	/// MNA solver that simulates several scenarios of the same network at once.
+	///
+	/// The scenarios are separate copies of a system topology which may differ
+	/// in the set points of their sources and in their initial states, but must
+	/// lead to the same system matrix. Each scenario keeps its own nodes,
+	/// components and vectors. The system matrix is factorized once and the
+	/// right side vectors of all scenarios are solved as columns of one
+	/// multi-RHS solve in every step.
+	///
+	/// All scenarios advance in every step, so batching is faster than
+	/// separate simulations as long as the component data of all scenarios
+	/// fits into the cache. Large studies are better split into several
+	/// batched simulations.
+	///
+	/// The component tasks of a scenario that run before the solve and the
+	/// ones that run after it are grouped into one task each, so that the
+	/// scheduler handles two tasks per scenario and step instead of the
+	/// tasks of all components.
+	template <typename VarType>
+	class MnaSolverBatched : public MnaSolverEigenSparse<VarType> {
+	protected:
+		/// Solvers of the scenarios besides the first one, whose system is the one of this solver
+		std::vector<std::shared_ptr<MnaSolverBatched<VarType>>> mScenarios;
+		/// True for the solver of an additional scenario, which stamps its
+		/// system matrix only to compare it with the one of the first scenario
+		Bool mIsScenario = false;
+		/// Right side vectors of all scenarios as columns. The rows are stored
+		/// contiguously, so that the solve updates a row of all scenarios at once.
+		CPS::MatrixRow mRightSideVectors;
+		/// Solution vectors of all scenarios as columns, stored row by row
+		CPS::MatrixRow mLeftSideVectors;
+		/// Component tasks of the scenario that do not depend on the solution
+		/// of the step, in the order of their dependencies
+		CPS::Task::List mPreSolveTasks;
+		/// Component tasks of the scenario that depend on the solution of the
+		/// step, in the order of their dependencies
+		CPS::Task::List mPostSolveTasks;
+
+		using MnaSolverEigenSparse<VarType>::mSwitchedMatrices;
+		using MnaSolverEigenSparse<VarType>::mSwitches;
+		using MnaSolverEigenSparse<VarType>::mRightSideVector;
+		using MnaSolverEigenSparse<VarType>::mLeftSideVector;
+		using MnaSolverEigenSparse<VarType>::mCurrentSwitchStatus;
+		using MnaSolverEigenSparse<VarType>::mNumNetNodes;
+		using MnaSolverEigenSparse<VarType>::mNodes;
+		using MnaSolverEigenSparse<VarType>::mSLog;
+		using MnaSolverEigenSparse<VarType>::mFrequencyParallel;
+		using MnaSolverEigenSparse<VarType>::mSteadyStateInit;
+		using MnaSolverEigenSparse<VarType>::mCircuitLU;
+
+		/// Applies the component stamps and factorizes the matrix, unless this
+		/// is the solver of an additional scenario
+		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Solves the right side vectors of all scenarios with one multi-RHS
+		/// solve and copies the solutions into the left vectors of the scenarios
+		virtual void solve(Real time, Int timeStepCount) override;
+		/// Logs the left and right side vectors of all scenarios
+		virtual void log(Real time, Int timeStepCount) override;
+		/// Appends the tasks of the components and nodes of the scenario
+		void appendComponentTasks(CPS::Task::List& tasks);
+		/// Attributes of the scenario written by the solve
+		std::vector<CPS::AttributeBase::Ptr> solvedAttributes();
+		/// Splits the component tasks of the scenario into the ones before and after the solve
+		void partitionComponentTasks();
+		/// Solver of a scenario, scenario 0 is this solver
+		MnaSolverBatched<VarType>& batchedScenario(UInt index) {
+			return index == 0 ? *this : *mScenarios[index - 1];
+		}
+		/// Runs the component tasks of a scenario before the solve and
+		/// writes its right side vector into its column
+		void preSolveScenario(UInt index, Real time, Int timeStepCount);
+		/// Updates the node voltages of a scenario and runs its component
+		/// tasks after the solve
+		void postSolveScenario(UInt index, Real time, Int timeStepCount);
+
+	public:
+		/// Constructor should not be called by users but by Simulation
+		MnaSolverBatched(String name,
+			CPS::Domain domain = CPS::Domain::DP,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+		///
+		virtual ~MnaSolverBatched() { };
+
+		/// Adds a scenario with its own copy of the system topology.
+		/// The system set by setSystem is the first scenario.
+		void addScenario(const CPS::SystemTopology& system);
+		/// Number of scenarios including the first one
+		UInt numScenarios() const { return static_cast<UInt>(mScenarios.size()) + 1; }
+		/// Solver of a scenario, whose "left_vector" attribute is the
+		/// solution of the scenario. Scenario 0 is this solver.
+		MnaSolver<VarType>& scenario(UInt index);
+		///
+		virtual void initialize() override;
+		///
+		virtual CPS::Task::List getTasks() override;
+		///
+		void setAsyncLogging(UInt capacity, DataLogger::OverflowPolicy policy) override;
+		/// Writes the vectors of all scenarios
+		virtual void writeCheckpoint(CPS::CheckpointWriter& writer) override;
+		/// Restores the vectors of all scenarios
+		virtual void readCheckpoint(CPS::CheckpointReader& reader, Real time) override;
+
+		// #### MNA Solver Tasks ####
+		/// Runs the component tasks of a scenario before or after the solve.
+		/// The task takes over the dependencies of the component tasks on
+		/// attributes outside of the group.
+		class ScenarioTask : public CPS::Task {
+		public:
+			ScenarioTask(MnaSolverBatched<VarType>& solver, UInt index, Bool postSolve);
+
+			void execute(Real time, Int timeStepCount) {
+				if (mPostSolve)
+					mSolver.postSolveScenario(mIndex, time, timeStepCount);
+				else
+					mSolver.preSolveScenario(mIndex, time, timeStepCount);
+			}
+
+		private:
+			MnaSolverBatched<VarType>& mSolver;
+			UInt mIndex;
+			Bool mPostSolve;
+		};
+
+		///
+		class SolveTask : public CPS::Task {
+		public:
+			SolveTask(MnaSolverBatched<VarType>& solver) :
+				Task(solver.mName + ".Solve"), mSolver(solver) {
+				for (UInt k = 0; k < solver.numScenarios(); ++k) {
+					mAttributeDependencies.push_back(solver.batchedScenario(k).attribute("right_vector"));
+					mModifiedAttributes.push_back(solver.batchedScenario(k).attribute("left_vector"));
+				}
+			}
+
+			void execute(Real time, Int timeStepCount) { mSolver.solve(time, timeStepCount); }
+
+		private:
+			MnaSolverBatched<VarType>& mSolver;
+		};
+
+		///
+		class LogTask : public CPS::Task {
+		public:
+			LogTask(MnaSolverBatched<VarType>& solver) :
+				Task(solver.mName + ".Log"), mSolver(solver) {
+				for (UInt k = 0; k < solver.numScenarios(); ++k)
+					mAttributeDependencies.push_back(solver.batchedScenario(k).attribute("left_vector"));
+				mModifiedAttributes.push_back(Scheduler::external);
+			}
+
+			void execute(Real time, Int timeStepCount) { mSolver.log(time, timeStepCount); }
+
+		private:
+			MnaSolverBatched<VarType>& mSolver;
+		};
+	};
+}
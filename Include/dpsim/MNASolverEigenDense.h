@@ -31,12 +31,15 @@ namespace DPsim {
 	template <typename VarType>
 	class MnaSolverEigenDense : public MnaSolver<VarType> {
 	protected:
-		/// Base matrix that includes all static MNA elements to speed up recomputation
-		Matrix mBaseSystemMatrix;
-		/// Map of system matrices where the key is the bitset describing the switch states
+		/// Number of rows and columns of the real system matrices
+		Matrix::Index mSystemSize = 0;
+		/// Map of system matrices where the key is the bitset describing the switch states.
+		/// Matrices factorized as complex matrices are not kept and have size zero.
 		std::unordered_map< std::bitset<SWITCH_NUM>, Matrix > mSwitchedMatrices;
 		/// Map of LU factorizations related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorized > mLuFactorizations;
+		/// Map of LU factorizations of the system matrices as complex matrices
+		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorizedComp > mComplexLuFactorizations;
 		using MnaSolver<VarType>::mSwitches;
 		using MnaSolver<VarType>::mRightSideVector;
 		using MnaSolver<VarType>::mLeftSideVector;
@@ -51,6 +54,9 @@ namespace DPsim {
 		using MnaSolver<VarType>::mFrequencyParallel;
 		using MnaSolver<VarType>::mSwitchedMatricesHarm;
 		using MnaSolver<VarType>::mSLog;
+		using MnaSolver<VarType>::mLazySwitchedMatrices;
+		using MnaSolver<VarType>::mComplexRightSideVector;
+		using MnaSolver<VarType>::mComplexLeftSideVector;
 
 		/// Sets all entries in the matrix with the given switch index to zero
 		virtual void switchedMatrixEmpty(std::size_t index) override;
@@ -58,6 +64,8 @@ namespace DPsim {
 		virtual void createEmptySystemMatrix() override;
 		/// Applies a component stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Releases the matrix and LU factorization with the given switch index
+		virtual void switchedMatrixErase(std::size_t index) override;
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createSolveTask() override;
 		/// Create a solve task for this solver implementation
@@ -24,6 +24,7 @@
 #include <cps/SimSignalComp.h>
 #include <cps/SimPowerComp.h>
 #include <dpsim/MNASolver.h>
+#include <dpsim/CircuitLU.h>
 
 
 namespace DPsim {
@@ -38,6 +39,27 @@ namespace DPsim {
 		std::unordered_map< std::bitset<SWITCH_NUM>, SparseMatrix > mSwitchedMatrices;
 		/// Map of LU factorizations related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorizedSparse > mLuFactorizations;
+		/// Factorize the system matrices with CircuitLU instead of Eigen::SparseLU
+		Bool mCircuitLU = false;
+		/// Map of CircuitLU factorizations related to the system matrices
+		std::unordered_map< std::bitset<SWITCH_NUM>, CircuitLU > mCircuitLuFactorizations;
+		/// Map of LU factorizations of the system matrices as complex matrices
+		std::unordered_map< std::bitset<SWITCH_NUM>, CPS::LUFactorizedSparseComp > mComplexLuFactorizations;
+		/// Complex system matrix of the last factorization
+		CPS::SparseMatrixComp mComplexSystemMatrix;
+		/// Preallocated workspace of the triangular solves
+		Matrix mSolveWorkspace;
+		/// Preallocated workspace of the complex triangular solves
+		MatrixComp mComplexSolveWorkspace;
+		/// Preallocated workspace of the triangular solves of right sides
+		/// that are stored row by row
+		CPS::MatrixRow mSolveWorkspaceRows;
+		/// Column-major copies of right sides and solutions that are stored
+		/// row by row, for the factorizations that only solve column-major
+		Matrix mRightSideColumns;
+		Matrix mLeftSideColumns;
+		/// Non-zeros of the L and U factors of the last analyzed system matrix
+		Int mFactorNonZeros = 0;
 		using MnaSolver<VarType>::mSwitches;
 		using MnaSolver<VarType>::mRightSideVector;
 		using MnaSolver<VarType>::mLeftSideVector;
@@ -52,6 +74,9 @@ namespace DPsim {
 		using MnaSolver<VarType>::mFrequencyParallel;
 		using MnaSolver<VarType>::mSwitchedMatricesHarm;
 		using MnaSolver<VarType>::mSLog;
+		using MnaSolver<VarType>::mLazySwitchedMatrices;
+		using MnaSolver<VarType>::mComplexRightSideVector;
+		using MnaSolver<VarType>::mComplexLeftSideVector;
 
 
 		/// Sets all entries in the matrix with the given switch index to zero
@@ -60,6 +85,8 @@ namespace DPsim {
 		virtual void createEmptySystemMatrix() override;
 		/// Applies a component stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Releases the matrix and LU factorization with the given switch index
+		virtual void switchedMatrixErase(std::size_t index) override;
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createSolveTask() override;
 		/// Create a solve task for this solver implementation
@@ -68,6 +95,35 @@ namespace DPsim {
 		virtual std::shared_ptr<CPS::Task> createSolveTaskHarm(UInt freqIdx) override;
 		/// Logging of system matrices and source vector
 		virtual void logSystemMatrices() override;
+		/// Logs the non-zeros and fill-in of a factorized system matrix
+		void logFactorizationStatistics(const std::bitset<SWITCH_NUM>& status, const SparseMatrix& systemMatrix);
+		/// Solves lu * x = rhs for all columns of rhs. Allocates no temporaries
+		/// with the Eigen versions whose supernodal factor layout is known.
+		/// Right sides stored row by row are updated a whole row at a time.
+		template <typename Scalar, typename Dense>
+		void solveInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>& lu, const Dense& rhs,
+			Dense& x, Dense& workspace);
+		/// Backward substitution with the U factor
+		template <typename Scalar>
+		static void solveUpperInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>& lu, CPS::MatrixVar<Scalar>& x);
+		/// Backward substitution with the U factor for right sides stored row
+		/// by row, which Eigen only supports for column-major right sides
+		template <typename Scalar>
+		static void solveUpperInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>& lu,
+			Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& x);
+		/// Factorizes the system matrix of a switch configuration. Without a
+		/// new symbolic analysis, CircuitLU reuses the last pivot sequence.
+		/// Complex system matrices are factorized as such unless CircuitLU,
+		/// which is real-valued, is used.
+		void factorizeSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, Bool analyzePattern);
+		/// Solves the system of a switch configuration without allocating temporaries
+		void solveSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, const Matrix& rhs, Matrix& x);
+		/// Solves the system of a switch configuration for many right sides,
+		/// which are stored row by row so that the substitutions update the
+		/// entries of all right sides in a row together
+		void solveSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, const CPS::MatrixRow& rhs, CPS::MatrixRow& x);
+		/// Solves the system of a switch configuration
+		Matrix solveSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, const Matrix& rhs);
 
 		// #### Scheduler Task Methods ####
 		/// Solves system for single frequency
@@ -85,6 +141,10 @@ namespace DPsim {
 		/// Destructor
 		virtual ~MnaSolverEigenSparse() { };
 
+		/// Factorize the system matrices with CircuitLU, which is faster to
+		/// refactorize than Eigen::SparseLU
+		void doCircuitLU(Bool value) { mCircuitLU = value; }
+
 		// #### MNA Solver Tasks ####
 		///
 		class SolveTask : public CPS::Task {
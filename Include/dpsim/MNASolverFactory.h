@@ -33,6 +33,8 @@ class MnaSolverFactory {
 		EigenSparse,
 		CUDADense,
 		CUDASparse,
+		/// MnaSolverEigenSparse with the CircuitLU factorization
+		CircuitSparse,
 	};
 
 	/// MNA implementations supported by this compilation
@@ -40,6 +42,7 @@ class MnaSolverFactory {
 		static std::vector<MnaSolverImpl> ret = {
 			EigenDense,
 #ifdef WITH_SPARSE
+			CircuitSparse,
 			EigenSparse,
 #endif //WITH_SPARSE
 #ifdef WITH_CUDA
@@ -74,6 +77,12 @@ class MnaSolverFactory {
 		case MnaSolverImpl::EigenSparse:
 			log->info("creating EigenSparse solver implementation");
 			return std::make_shared<MnaSolverEigenSparse<VarType>>(name, domain, logLevel);
+		case MnaSolverImpl::CircuitSparse: {
+			log->info("creating CircuitSparse solver implementation");
+			auto solver = std::make_shared<MnaSolverEigenSparse<VarType>>(name, domain, logLevel);
+			solver->doCircuitLU(true);
+			return solver;
+		}
 #endif
 #ifdef WITH_CUDA
 		case MnaSolverImpl::CUDADense:
@@ -23,12 +23,54 @@ namespace DPsim {
 		// #### Dynamic matrix recomputation ####
 		/// Flag that initiates recomputation of system matrix
 		Bool mUpdateSysMatrix;
+		/// Strategy to update the factorization after a parameter change
+		MnaRecomputationMode mRecomputationMode = MnaRecomputationMode::Full;
 		/// Recomputes systems matrix
 		void updateSystemMatrix(Real time);
 		/// Collects the status of variable MNA elements to decide if system matrix has to be recomputed
 		void updateVariableCompStatus();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithDynamicMatrix();
+		/// Numeric factorization of the system matrix. The symbolic analysis
+		/// is only repeated if the sparsity pattern changed or if requested.
+		void factorizeSystemMatrix(Bool analyzePattern);
+		/// Returns true if the pattern of the system matrix differs from the analyzed one
+		Bool patternChanged(const SparseMatrix& systemMatrix);
+
+		// #### Symbolic factorization reuse ####
+		/// Outer index array of the analyzed system matrix
+		std::vector<SparseMatrix::StorageIndex> mAnalyzedOuterIndices;
+		/// Inner index array of the analyzed system matrix
+		std::vector<SparseMatrix::StorageIndex> mAnalyzedInnerIndices;
+		/// Number of symbolic analyses
+		Int mNumSymbolicAnalyses = 0;
+		/// Number of numeric factorizations
+		Int mNumFactorizations = 0;
+
+		// #### Low-rank (Sherman-Morrison-Woodbury) updates ####
+		/// Maximum rank of a change that is applied as low-rank update
+		UInt mLowRankMaxRank = 8;
+		/// Number of applied low-rank updates
+		Int mNumLowRankUpdates = 0;
+		/// System matrix A0 of the current factorization
+		SparseMatrix mFactorizedSystemMatrix;
+		/// True if the solution has to be corrected by the low-rank update
+		Bool mLowRankActive = false;
+		/// Columns c of the change dA = U * E_c^T
+		std::vector<UInt> mLowRankColumns;
+		/// Z = A0^-1 * U
+		Matrix mLowRankZ;
+		/// LU factorization of the capacitance matrix I + E_c^T * Z
+		CPS::LUFactorized mLowRankCapacitance;
+		/// Workspace for the solution entries E_c^T * y
+		Matrix mLowRankSelection;
+		/// Workspace for the correction coefficients
+		Matrix mLowRankCoefficients;
+		/// Tries to express the change of the system matrix as low-rank update
+		/// of the current factorization. Returns false if the rank is too high.
+		Bool updateLowRank(const SparseMatrix& systemMatrix);
+		/// Applies the low-rank correction to the solution vector
+		void applyLowRankCorrection();
 
 	public:
 		///
@@ -39,6 +81,13 @@ namespace DPsim {
 		virtual ~MnaSolverSysRecomp() { };
 		///
 		virtual CPS::Task::List getTasks() override;
+		/// Selects how the factorization is updated after a parameter change
+		void setRecomputationMode(MnaRecomputationMode mode) { mRecomputationMode = mode; }
+		/// Sets the maximum rank of a change handled by a low-rank update
+		void setLowRankMaxRank(UInt rank) { mLowRankMaxRank = rank; }
+		/// Restores the checkpoint and refactorizes the system matrix for the
+		/// restored parameters of the variable components
+		virtual void readCheckpoint(CPS::CheckpointReader& reader, Real time) override;
 
 		// #### MNA Solver Tasks ####
 		///
@@ -51,6 +100,10 @@ namespace DPsim {
 					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
 						mAttributeDependencies.push_back(it->attribute("right_vector"));
 				}
+				for (auto it : solver.mMNAIntfVariableComps) {
+					if (it->template attribute<Matrix>("right_vector")->get().size() != 0)
+						mAttributeDependencies.push_back(it->attribute("right_vector"));
+				}
 				for (auto node : solver.mNodes) {
 					mModifiedAttributes.push_back(node->attribute("v"));
 				}
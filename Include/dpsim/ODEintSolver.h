@@ -8,56 +8,98 @@
 
 #pragma once
 
-#include <iostream>
+#include <memory>
 #include <vector>
-#include <list>
 
 #include <dpsim/Solver.h>
+#include <dpsim/LogRingBuffer.h>
 #include <cps/SystemTopology.h>
 #include <cps/Solver/ODEintInterface.h>
 
 #include <boost/numeric/odeint/stepper/runge_kutta4.hpp> //ODEInt Runge-Kutta stepper
-#include <boost/numeric/odeint/integrate/integrate_const.hpp>//ODEInt Integrator with constant time step
 
 namespace DPsim {
-    /// Solver class which uses ODE systems
-    class ODEintSolver : public Solver {
-
-    protected:
-        /// Pointer to current Component
-        CPS::ODEintInterface::Ptr mComponent;
-        /// Constant time step
-        Real mTimestep;
-        ///Problem Size
-        int ProbDim;
-        /// Stepper needed by ODEint
-        boost::numeric::odeint::runge_kutta4<std::vector<Real>> stepper;
-        /// Vector containing the solution at every timestep
-        std::vector<std::vector<Real>> solution;
-        /// Vector containing all timesteps
-        std::vector<Real> times;
-        ///ODE of Component
-        std::vector<CPS::ODEintInterface::stateFnc> system;
-
-    private:
-        ///static pointer to current object; only one instance currently allowed
-        inline static ODEintSolver *self = nullptr;
-        /// State space of the System and corresponding static wrapper
-        static void StateSpaceWrapper( const std::vector<double> &y, std::vector<double> ydot, double t);
-
-
-    public:
-        /// Current solution vector
-        std::vector<Real> curSolution;
-        /// Create solve object with given parameters
-        ODEintSolver(String name,CPS::ODEintInterface::Ptr comp, Real dt, Real t0);
-
-        /// Solve system for the current time
-        Real step(Real time);
-
-        /// Deallocate all memory
-        ~ODEintSolver();
-    };
+	/// Solver class which integrates the ODE systems of several components
+	/// with ODEint.
+	///
+	/// The states of all components are stacked into one contiguous vector,
+	/// which is integrated by a single stepper per solver. The solver holds
+	/// no static state, so that several solvers and simulations can exist
+	/// in one process.
+	class ODEintSolver : public Solver {
+	public:
+		typedef std::shared_ptr<ODEintSolver> Ptr;
 
-}
+	protected:
+		/// Components whose states are integrated
+		std::vector<CPS::ODEintInterface::Ptr> mComponents;
+		/// Offsets of the states of the components in the state vector.
+		/// The last entry is the number of states.
+		std::vector<UInt> mOffsets;
+		/// Stacked states of all components
+		std::vector<Real> mStates;
+		/// Stepper needed by ODEint, which keeps its temporaries between steps
+		boost::numeric::odeint::runge_kutta4<std::vector<Real>> mStepper;
+		/// Rows of time and states of the last steps, only if requested
+		std::unique_ptr<LogRingBuffer> mHistory;
+		/// Number of rows of the history
+		UInt mHistoryLength = 0;
+
+		/// Evaluates the ODE systems of all components on the stacked states
+		struct System {
+			ODEintSolver& mSolver;
+			void operator()(const std::vector<Real>& y, std::vector<Real>& ydot, Real t) const;
+		};
+
+	public:
+		/// Creates a solver without components, see addComponent
+		ODEintSolver(String name, Real timeStep,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+		/// Creates a solver for a single component
+		ODEintSolver(String name, CPS::ODEintInterface::Ptr comp, Real timeStep,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Adds a component, whose states are appended to the state vector
+		void addComponent(CPS::ODEintInterface::Ptr comp);
+		/// Number of integrated components
+		UInt numComponents() const { return static_cast<UInt>(mComponents.size()); }
+		/// Stacked states after the last step
+		const std::vector<Real>& states() const { return mStates; }
+		/// States of a component after the last step
+		const Real* states(UInt index) const { return mStates.data() + mOffsets[index]; }
+
+		/// Keeps the time and the states of the last steps in a ring buffer
+		/// with at least the given number of rows. Zero disables the history.
+		void setHistoryLength(UInt length);
+		/// Rows of the time and the stacked states of the last steps, from
+		/// which the oldest rows are dropped. Null if there is no history.
+		LogRingBuffer* history() { return mHistory.get(); }
 
+		/// Allocates the state vector and the history
+		void initialize();
+		/// Solve system for the current time
+		Real step(Real time);
+
+		class SolveTask : public CPS::Task {
+		public:
+			SolveTask(ODEintSolver& solver) :
+				Task(solver.mName + ".Solve"), mSolver(solver) {
+				// The states are integrated from the ones of the previous step
+				for (auto comp : solver.mComponents) {
+					mAttributeDependencies.push_back(comp->attribute("ode_pre_state"));
+					mPrevStepDependencies.push_back(comp->attribute("ode_post_state"));
+					mModifiedAttributes.push_back(comp->attribute("ode_post_state"));
+				}
+			}
+
+			void execute(Real time, Int timeStepCount) { mSolver.step(time); }
+
+		private:
+			ODEintSolver& mSolver;
+		};
+
+		virtual CPS::Task::List getTasks() {
+			return CPS::Task::List{std::make_shared<SolveTask>(*this)};
+		}
+	};
+}
@@ -46,8 +46,10 @@ namespace DPsim {
         /// Admittance matrix
         CPS::SparseMatrixCompRow mY;
 
-        /// Jacobian matrix
-        CPS::Matrix mJ;
+        /// Jacobian matrix, its sparsity pattern is fixed after initialization
+        CPS::SparseMatrix mJ;
+        /// LU factorization of the Jacobian, the pattern is only analyzed once
+        CPS::LUFactorizedSparse mJLU;
         /// Solution vector
         CPS::Vector mX;
 	    /// Vector of mismatch values
@@ -91,6 +93,8 @@ namespace DPsim {
         virtual void generateInitialSolution(Real time, bool keep_last_solution = false) = 0;
         /// Calculate mismatch
         virtual void calculateMismatch() = 0;
+        /// Set up the sparsity pattern of the Jacobian
+        virtual void initializeJacobian() = 0;
         /// Calculate the Jacobian
         virtual void calculateJacobian() = 0;
         /// Update solution in each iteration
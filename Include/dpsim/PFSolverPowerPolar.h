@@ -30,9 +30,27 @@ namespace DPsim {
         CPS::Vector Pesp;
         CPS::Vector Qesp;
 
+        /// Admittance matrix entry (k,j) between two PQ or PV buses together
+        /// with the positions of the dependent Jacobian entries in the value
+        /// array of mJ. A position is -1 if the entry is not part of the Jacobian.
+        struct JacobianEntry {
+            CPS::UInt k;
+            CPS::UInt j;
+            /// Position of the admittance in the value array of mY or -1 if zero
+            CPS::Int y;
+            /// dP/dD, dP/dV, dQ/dD and dQ/dV
+            CPS::Int pd, pv, qd, qv;
+        };
+        /// Diagonal entries of the Jacobian, one per PQ or PV bus
+        std::vector<JacobianEntry> mJacobianDiagonal;
+        /// Off-diagonal entries of the Jacobian
+        std::vector<JacobianEntry> mJacobianOffDiagonal;
+
         // Core methods
         /// Generate initial solution for current time step
         void generateInitialSolution(Real time, bool keep_last_solution = false);
+        /// Set up the sparsity pattern of the Jacobian from the admittance matrix
+        void initializeJacobian();
         /// Calculate the Jacobian
         void calculateJacobian();
         /// Update solution in each iteration
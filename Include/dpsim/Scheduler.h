@@ -65,6 +65,9 @@ namespace DPsim {
 		TaskTime getAveragedMeasurement(CPS::Task::Ptr task) {
 			return getAveragedMeasurement(task.get());
 		}
+		/// Discards the task time measurements, so that stop() does not
+		/// write them, e.g. after a run before the actual simulation
+		void clearMeasurements() { mMeasurements.clear(); }
 
 		/// Root task that has a dependency on the external attribute
 		/// which means that it should not be removed from the task graph
@@ -79,6 +82,9 @@ namespace DPsim {
 			}
 		};
 
+		/// Read measurement data from file to use it for the scheduling
+		static void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
+
 	protected:
 		/// Simple topological sort, filtering out tasks that do not need to be executed.
 		void topologicalSort(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, CPS::Task::List& sortedTasks);
@@ -86,14 +92,13 @@ namespace DPsim {
 		/// executed in parallel
 		static void levelSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges, std::vector<CPS::Task::List>& levels);
 
+		/// Discards the measurements of a previous schedule and adds the tasks
 		void initMeasurements(const CPS::Task::List& tasks);
 		/// Not thread-safe for multiple calls with same task, but should only
 		/// be called once for each task in each step anyway
 		void updateMeasurement(CPS::Task* task, TaskTime time);
-		/// Write measurement data to file
+		/// Write measurement data to file, if there are any
 		void writeMeasurements(CPS::String filename);
-		/// Read measurement data from file to use it for the scheduling
-		void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
 		///
 		TaskTime getAveragedMeasurement(CPS::Task* task);
 
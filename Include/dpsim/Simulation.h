@@ -50,12 +50,20 @@ namespace DPsim {
 		EventQueue mEvents;
 		/// System list
 		CPS::SystemTopology mSystem;
+		/// Further scenarios of the system which are solved together with it
+		std::vector<CPS::SystemTopology> mScenarios;
 
 		// #### Logging ####
 		/// Simulation log level
 		CPS::Logger::Level mLogLevel;
 		/// (Real) time needed for the timesteps
 		std::vector<Real> mStepTimes;
+		/// Fail steps that allocate heap memory (requires WITH_ALLOCATION_GUARD)
+		Bool mCheckStepAllocations = false;
+		/// Ring buffer capacity of asynchronous logging (0 = synchronous)
+		UInt mAsyncLogCapacity = 0;
+		/// Overflow policy of asynchronous logging
+		DataLogger::OverflowPolicy mAsyncLogPolicy = DataLogger::OverflowPolicy::block;
 
 		// #### Solver Settings ####
 		///
@@ -70,6 +78,17 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Strategy to update the system matrix factorization after recomputation
+		MnaRecomputationMode mRecomputationMode = MnaRecomputationMode::Full;
+		/// Stamp and factorize system matrices of switch configurations on
+		/// first use instead of precomputing all of them
+		Bool mLazySwitchedMatrices = false;
+		/// Maximum number of cached switched system matrices (0 = unlimited)
+		UInt mSwitchedMatrixCacheSize = 0;
+		/// Ordering of the matrix node indices of the MNA solvers
+		MnaNodeOrdering mNodeOrdering = MnaNodeOrdering::Natural;
+		/// Factorize the system matrices of DP and SP simulations as complex matrices
+		Bool mComplexNativeSystem = false;
 
 		/// Determines if the network should be split
 		/// into subnetworks at decoupling lines.
@@ -79,6 +98,12 @@ namespace DPsim {
 		/// If tearing components exist, the Diakoptics
 		/// solver is selected automatically.
 		CPS::IdentifiedObject::List mTearComponents = CPS::IdentifiedObject::List();
+		/// Number of parts for the automatic selection of
+		/// tear components, disabled if smaller than two
+		UInt mTearingParts = 0;
+		/// Scheduler measurement file with the component
+		/// costs for the automatic selection of tear components
+		String mTearingCostFile;
 		/// Determines if the system matrix is split into
 		/// several smaller matrices, one for each frequency.
 		/// This can only be done if the network is composed
@@ -93,6 +118,8 @@ namespace DPsim {
 		Real mSteadStIniTimeLimit = 10;
 		/// steady state initialization accuracy limit
 		Real mSteadStIniAccLimit = 0.0001;
+		/// depth of the Anderson acceleration of the steady state initialization
+		UInt mSteadStIniAccelerationDepth = 10;
 		/// Determines if steady-state initialization
 		/// should be executed prior to the simulation.
 		/// By default the initialization is disabled.
@@ -176,6 +203,9 @@ namespace DPsim {
 		void setDomain(CPS::Domain domain = CPS::Domain::DP) { mDomain = domain; }
 		///
 		void setSolverType(Solver::Type solverType = Solver::Type::MNA) { mSolverType = solverType; }
+		/// Select the MNA solver implementation. With system matrix recomputation,
+		/// CircuitSparse selects the CircuitLU factorization.
+		void setMnaSolverImplementation(MnaSolverFactory::MnaSolverImpl mnaImpl) { mMnaImpl = mnaImpl; }
 		///
 		void doInitFromNodesAndTerminals(Bool f = true) { mInitFromNodesAndTerminals = f; }
 		///
@@ -184,6 +214,12 @@ namespace DPsim {
 		void setTearingComponents(CPS::IdentifiedObject::List tearComponents = CPS::IdentifiedObject::List()) {
 			mTearComponents = tearComponents;
 		}
+		/// Select tear components automatically to split the system into the given number of parts.
+		/// The components can be weighted by the task times of a scheduler measurement file.
+		void setAutoTearing(UInt parts, String measurementFile = String()) {
+			mTearingParts = parts;
+			mTearingCostFile = measurementFile;
+		}
 		/// Set the scheduling method
 		void setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
 			mScheduler = scheduler;
@@ -192,6 +228,27 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		/// Selects how the factorization is updated when the system matrix is
+		/// recomputed. ReuseSymbolic and LowRankUpdate are opt-in.
+		void setSystemMatrixRecomputationMode(MnaRecomputationMode mode) { mRecomputationMode = mode; }
+		/// Factorize switched system matrices on first use, pre-warmed from the switch events
+		void doLazySwitchedMatrices(Bool value) { mLazySwitchedMatrices = value; }
+		/// Limit the number of cached switched system matrices (0 = unlimited)
+		void setSwitchedMatrixCacheSize(UInt size) { mSwitchedMatrixCacheSize = size; }
+		/// Select the ordering of the matrix node indices, which determines the fill-in of sparse factorizations
+		void setNodeOrdering(MnaNodeOrdering ordering) { mNodeOrdering = ordering; }
+		/// Factorize the system matrices of DP and SP simulations as complex matrices
+		/// of half the size instead of their real expansion
+		void doComplexNativeSystem(Bool value) { mComplexNativeSystem = value; }
+		/// Add a scenario of the system, i.e. a separate copy of its topology
+		/// with other source set points or initial states but the same system
+		/// matrix. All scenarios share one factorization and are solved by one
+		/// multi-RHS solve per step. Requires WITH_SPARSE.
+		void addScenario(const CPS::SystemTopology& system) { mScenarios.push_back(system); }
+		/// Number of scenarios including the system set by setSystem
+		UInt numScenarios() const { return static_cast<UInt>(mScenarios.size()) + 1; }
+		/// System of a scenario, scenario 0 is the system set by setSystem
+		CPS::SystemTopology& scenarioSystem(UInt scenario);
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -200,6 +257,20 @@ namespace DPsim {
 		void setSteadStIniTimeLimit(Real v) { mSteadStIniTimeLimit = v; }
 		/// set steady state initialization accuracy limit
 		void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
+		/// set depth of the Anderson acceleration of the steady state
+		/// initialization in the phasor domains, 0 disables it.
+		/// The initialization runs on the scheduler set by setScheduler.
+		void setSteadStIniAccelerationDepth(UInt depth) { mSteadStIniAccelerationDepth = depth; }
+		/// Throw an exception if a step allocates heap memory after initialization.
+		/// Requires a build with WITH_ALLOCATION_GUARD.
+		void doCheckStepAllocations(Bool value) { mCheckStepAllocations = value; }
+		/// Move the file output of the solver logs and of all loggers which
+		/// are not asynchronous yet to background threads
+		void setAsyncLogging(UInt capacity = 1024,
+			DataLogger::OverflowPolicy policy = DataLogger::OverflowPolicy::block) {
+			mAsyncLogCapacity = capacity;
+			mAsyncLogPolicy = policy;
+		}
 
 		// #### Simulation Control ####
 		/// Create solver instances etc.
@@ -221,6 +292,20 @@ namespace DPsim {
 		/// Reset internal state of simulation
 		void reset();
 
+		// #### Checkpoints ####
+		/// Write the time, the states of all nodes and components and the
+		/// vectors of all solvers to a binary checkpoint. Initializes the
+		/// simulation if necessary.
+		void writeCheckpoint(std::ostream& out);
+		///
+		void writeCheckpoint(const String& filename);
+		/// Restore a checkpoint written by a simulation of the same system.
+		/// An uninitialized simulation is initialized without steady-state
+		/// initialization before. Events are not part of the checkpoint.
+		void readCheckpoint(std::istream& in);
+		///
+		void readCheckpoint(const String& filename);
+
 		/// Schedule an event in the simulation
 		void addEvent(Event::Ptr e) {
 			mEvents.addEvent(e);
@@ -259,11 +344,14 @@ namespace DPsim {
 		void setIdObjAttr(const String &comp, const String &attr, Complex value);
 
 		// #### Get component attributes during simulation ####
-		Real getRealIdObjAttr(const String &comp, const String &attr, UInt row = 0, UInt col = 0);
-		Complex getComplexIdObjAttr(const String &comp, const String &attr, UInt row = 0, UInt col = 0);
+		/// The component or node is looked up in the system of the scenario
+		Real getRealIdObjAttr(const String &comp, const String &attr, UInt row = 0, UInt col = 0, UInt scenario = 0);
+		Complex getComplexIdObjAttr(const String &comp, const String &attr, UInt row = 0, UInt col = 0, UInt scenario = 0);
 
 		void exportIdObjAttr(const String &comp, const String &attr, UInt idx, CPS::AttributeBase::Modifier mod = CPS::AttributeBase::Modifier::real, UInt row = 0, UInt col = 0);
 		void importIdObjAttr(const String &comp, const String &attr, UInt idx);
-		void logIdObjAttr(const String &comp, const String &attr);
+		/// Logs the attribute with the first logger. Attributes of further
+		/// scenarios are logged as "scenario<index>.<comp>.<attr>".
+		void logIdObjAttr(const String &comp, const String &attr, UInt scenario = 0);
 	};
 }
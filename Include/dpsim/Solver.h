@@ -14,6 +14,9 @@
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Config.h>
+#include <dpsim/DataLogger.h>
+#include <dpsim/Scheduler.h>
+#include <cps/Checkpoint.h>
 #include <cps/Logger.h>
 #include <cps/SystemTopology.h>
 #include <cps/Task.h>
@@ -44,6 +47,16 @@ namespace DPsim {
 		Real mSteadStIniTimeLimit = 10;
 		/// steady state initialization accuracy limit
 		Real mSteadStIniAccLimit = 0.0001;
+		/// Depth of the Anderson acceleration of the steady state initialization,
+		/// which is disabled by zero
+		UInt mSteadStIniAccelerationDepth = 10;
+		/// Scheduler executing the steps of the steady state initialization,
+		/// a sequential one is used if none is set
+		std::shared_ptr<Scheduler> mSteadStIniScheduler;
+		/// Steps of the last steady state initialization
+		Int mSteadStIniSteps = 0;
+		/// Wall clock time of the last steady state initialization [s]
+		Real mSteadStIniWallTime = 0;
 		/// Activates steady state initialization
 		Bool mSteadyStateInit = false;
 		/// Determines if solver is in initialization phase, which requires different behavior
@@ -76,6 +89,8 @@ namespace DPsim {
 		void doFrequencyParallelization(Bool freqParallel) {
 			mFrequencyParallel = freqParallel;
 		}
+		/// Write the solver logs from a background thread, see DataLogger::setAsync
+		virtual void setAsyncLogging(UInt capacity, DataLogger::OverflowPolicy policy) { }
 		///
 		virtual void setSystem(const CPS::SystemTopology &system) {}
 
@@ -88,6 +103,14 @@ namespace DPsim {
 		void setSteadStIniTimeLimit(Real v) { mSteadStIniTimeLimit = v; }
 		/// set steady state initialization accuracy limit
 		void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
+		/// set depth of the Anderson acceleration of the steady state initialization, 0 disables it
+		void setSteadStIniAccelerationDepth(UInt depth) { mSteadStIniAccelerationDepth = depth; }
+		/// set scheduler for the steps of the steady state initialization
+		void setSteadStIniScheduler(std::shared_ptr<Scheduler> scheduler) { mSteadStIniScheduler = scheduler; }
+		/// steps of the last steady state initialization
+		Int steadStIniSteps() const { return mSteadStIniSteps; }
+		/// wall clock time of the last steady state initialization [s]
+		Real steadStIniWallTime() const { return mSteadStIniWallTime; }
 		/// activate powerflow initialization
 		void doInitFromNodesAndTerminals(Bool f) { mInitFromNodesAndTerminals = f; }
 
@@ -96,5 +119,11 @@ namespace DPsim {
 		virtual CPS::Task::List getTasks() = 0;
 		/// Log results
 		virtual void log(Real time, Int timeStepCount) { };
+
+		// #### Checkpoints ####
+		/// Writes the states of the solver which are not stored in the components
+		virtual void writeCheckpoint(CPS::CheckpointWriter& writer) { }
+		/// Restores the states written by writeCheckpoint at the given time
+		virtual void readCheckpoint(CPS::CheckpointReader& reader, Real time) { }
 	};
 }
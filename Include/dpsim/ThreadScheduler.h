@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <dpsim/CompiledSchedule.h>
 #include <dpsim/Scheduler.h>
 
 #include <thread>
@@ -29,7 +30,11 @@ namespace DPsim {
 		Int mNumThreads;
 
 	private:
+		/// Stops the helper threads, which are started again by finishSchedule
+		void joinThreads();
 		void doStep(Int scheduleIdx);
+		/// Busy waits until the task has been finished in the current step
+		void waitForCounter(Int idx);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
 
 		String mOutMeasurementFile;
@@ -38,15 +43,18 @@ namespace DPsim {
 		std::vector<std::thread> mThreads;
 
 		std::vector<CPS::Task::List> mTempSchedules;
-		struct ScheduleEntry {
-			CPS::Task* task;
-			Counter endCounter;
-			std::vector<Counter*> reqCounters;
-		};
-		std::vector<ScheduleEntry*> mSchedules;
+		/// Tasks of all threads, the counters count the steps in which
+		/// the task has been finished
+		CompiledSchedule mSchedule;
+		/// Tasks of a thread are stored contiguously in mSchedule
+		/// beginning at mThreadOffsets[thread]
+		std::vector<Int> mThreadOffsets;
 
 		Bool mJoining = false;
 		Real mTime = 0;
 		Int mTimeStepCount = 0;
+		/// Steps since the schedule was created, which the task counters
+		/// count independently of the step number passed by the simulation
+		Int mStepCount = 0;
 	};
 }
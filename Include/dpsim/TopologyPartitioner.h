@@ -0,0 +1,92 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cps/Logger.h>
+#include <cps/SystemTopology.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+	/// Selects the tear components for the Diakoptics solver.
+	///
+	/// The network nodes form a graph whose edges are the power components
+	/// between them. Nodes connected by components which cannot be torn,
+	/// i.e. which do not implement MNATearInterface, are merged first. The
+	/// remaining graph is split by recursive bisection. One half is grown
+	/// from a start node until it holds its share of the component costs
+	/// and then improved by Fiduccia-Mattheyses passes, which move nodes to
+	/// the other half to reduce the number of cut components without
+	/// violating the balance. The best of several start nodes is kept. The
+	/// cut components become the tear components.
+	class TopologyPartitioner {
+	public:
+		/// Result and quality of a partitioning
+		struct Partition {
+			/// Components to tear
+			CPS::IdentifiedObject::List tearComponents;
+			/// Summed up component costs of each part
+			std::vector<Real> partCosts;
+			/// Cost of the most expensive part relative to the mean
+			Real imbalance = 1;
+			/// Total cost divided by the cost of the most expensive part, i.e. the
+			/// speedup of the subnet solves if all parts are solved in parallel.
+			/// The solution of the tear system is neglected.
+			Real predictedSpeedup = 1;
+		};
+
+		/// The system is split into the given number of parts
+		TopologyPartitioner(UInt parts, CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Sets the costs of components by name.
+		/// Components without a cost get the mean of the given costs.
+		void setComponentCosts(const std::unordered_map<String, Real>& costs) { mCosts = costs; }
+		/// Reads the component costs from a measurement file written by a scheduler.
+		/// The times of all tasks of a component are summed up.
+		void readComponentCosts(const String& measurementFile);
+		/// Allowed deviation of a bisection from its target cost relative to
+		/// the cost of the bisected graph
+		void setImbalanceTolerance(Real tolerance) { mTolerance = tolerance; }
+
+		/// Selects the tear components and moves them from the components of the
+		/// system to its tear components
+		template <typename VarType>
+		Partition partition(CPS::SystemTopology& system);
+
+	private:
+		/// Merged nodes with their cost and the tear candidates between them
+		struct Graph {
+			std::vector<Real> weights;
+			/// Neighbour and candidate index per vertex
+			std::vector<std::vector<std::pair<UInt, UInt>>> edges;
+		};
+
+		/// Splits vertices into parts numbered from firstPart
+		void bisect(const Graph& graph, const std::vector<UInt>& vertices,
+			UInt parts, UInt firstPart, std::vector<UInt>& partOf);
+		/// Grows side 0 from the start vertex up to the target weight
+		Real grow(const Graph& graph, const std::vector<UInt>& vertices, UInt start, Real target);
+		/// Moves boundary vertices between the sides if this reduces the cut
+		void refine(const Graph& graph, const std::vector<UInt>& vertices,
+			Real target, Real weight0);
+		/// Breadth-first search restricted to the current vertices.
+		/// Returns the last vertex reached.
+		UInt distances(const Graph& graph, UInt start, std::unordered_map<UInt, UInt>& distance);
+
+		UInt mParts;
+		Real mTolerance = 0.03;
+		std::unordered_map<String, Real> mCosts;
+		/// Side of each vertex in the current bisection, -1 if not bisected
+		std::vector<Int> mSide;
+		CPS::Logger::Log mSLog;
+	};
+}
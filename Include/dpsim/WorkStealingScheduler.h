@@ -0,0 +1,84 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/CompiledSchedule.h>
+#include <dpsim/Scheduler.h>
+
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Dynamic scheduler that executes every task as soon as all of its
+	/// predecessors have finished. Ready tasks are pushed to the deque of the
+	/// thread that released them, idle threads steal from the other deques.
+	/// In contrast to the level and list schedulers, no thread assignment is
+	/// fixed at scheduling time, so tasks with varying cost do not leave
+	/// threads idle behind a barrier.
+	class WorkStealingScheduler : public Scheduler {
+	public:
+		/// Idle workers spin for spinCount iterations between steps
+		/// before they park on a condition variable.
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String(), Int spinCount = 10000);
+		virtual ~WorkStealingScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+	private:
+		/// Bounded deque of ready task indices. The owning thread pushes
+		/// and pops at the bottom, other threads steal from the top.
+		/// Every task becomes ready at most once per step, so a capacity
+		/// of the number of tasks is sufficient.
+		struct WorkerQueue {
+			std::mutex mutex;
+			std::vector<Int> tasks;
+			Int top = 0;
+			Int bottom = 0;
+		};
+
+		void push(Int thread, Int task);
+		Bool pop(Int thread, Int& task);
+		Bool steal(Int thread, Int& task);
+		/// Executes a task and returns a released successor that should be
+		/// executed next by the same thread or -1
+		Int execute(Int thread, Int task);
+		/// Execute and steal tasks until all tasks of the current step are finished
+		void doStep(Int thread);
+		/// Stops the worker threads, which are started again by createSchedule
+		void joinThreads();
+		static void threadFunction(WorkStealingScheduler* sched, Int idx);
+
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		Int mSpinCount;
+
+		/// The counters hold the number of predecessors of a task that
+		/// still have to finish in the current step
+		CompiledSchedule mSchedule;
+		/// Tasks without predecessors which are distributed at the start of each step
+		std::vector<Int> mSourceTasks;
+		std::vector<WorkerQueue> mQueues;
+		std::vector<std::thread> mThreads;
+
+		/// Number of tasks that are not finished in the current step
+		std::atomic<Int> mRemaining;
+		/// Incremented by the main thread to start a step
+		std::atomic<Int> mGeneration;
+		/// Number of worker threads waiting on mCondition
+		std::atomic<Int> mParked;
+		std::mutex mParkMutex;
+		std::condition_variable mCondition;
+
+		std::atomic<Bool> mJoining;
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
@@ -0,0 +1,110 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <dpsim/AllocationGuard.h>
+
+using namespace DPsim;
+
+static std::atomic<bool> sArmed(false);
+static std::atomic<std::size_t> sAllocations(0);
+static std::atomic<std::size_t> sFirstAllocationSize(0);
+
+static void countAllocation(std::size_t size) {
+	if (sArmed.load(std::memory_order_relaxed)) {
+		if (sAllocations.fetch_add(1, std::memory_order_relaxed) == 0)
+			sFirstAllocationSize.store(size, std::memory_order_relaxed);
+	}
+}
+
+void AllocationGuard::arm() {
+	sAllocations.store(0);
+	sFirstAllocationSize.store(0);
+	sArmed.store(true);
+}
+
+std::size_t AllocationGuard::disarm() {
+	sArmed.store(false);
+	return sAllocations.load();
+}
+
+std::size_t AllocationGuard::firstAllocationSize() {
+	return sFirstAllocationSize.load();
+}
+
+#ifdef __GLIBC__
+// Eigen allocates its matrices with malloc, so the C allocation functions are
+// interposed. On glibc, the default operator new also ends up here.
+extern "C" {
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t num, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+
+	void* malloc(std::size_t size) noexcept {
+		countAllocation(size);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(std::size_t num, std::size_t size) noexcept {
+		countAllocation(num * size);
+		return __libc_calloc(num, size);
+	}
+
+	void* realloc(void* ptr, std::size_t size) noexcept {
+		countAllocation(size);
+		return __libc_realloc(ptr, size);
+	}
+}
+#else
+// Only allocations of C++ objects can be detected
+static void* countedAllocation(std::size_t size) {
+	countAllocation(size);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new(std::size_t size) {
+	void* ptr = countedAllocation(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new[](std::size_t size) {
+	void* ptr = countedAllocation(size);
+	if (!ptr)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocation(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	return countedAllocation(size);
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	std::free(ptr);
+}
+#endif
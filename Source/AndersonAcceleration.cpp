@@ -0,0 +1,81 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include <dpsim/AndersonAcceleration.h>
+
+using namespace DPsim;
+
+AndersonAcceleration::AndersonAcceleration(UInt depth) :
+	mDepth(std::max<UInt>(1, std::min(depth, MaxDepth))) { }
+
+void AndersonAcceleration::reset(UInt size) {
+	mResidualDiffs.resize(size, mDepth);
+	mImageDiffs.resize(size, mDepth);
+	mNormal.resize(mDepth, mDepth);
+	mResidual.resize(size, 1);
+	mPrevResidual.resize(size, 1);
+	mPrevImage.resize(size, 1);
+	mColumn = 0;
+	mCount = 0;
+	mHasPrevious = false;
+	mRestarts = 0;
+}
+
+void AndersonAcceleration::next(const Eigen::Ref<const Matrix>& x, const Eigen::Ref<const Matrix>& gx, Eigen::Ref<Matrix> next) {
+	mResidual = gx - x;
+	Real residualNorm = mResidual.norm();
+
+	if (!mHasPrevious || residualNorm < mBestResidualNorm)
+		mBestResidualNorm = residualNorm;
+	if (mHasPrevious && residualNorm > 1e3 * mBestResidualNorm) {
+		// The combination diverges, e.g. for strongly nonlinear components,
+		// so drop the history and continue with the plain iteration from
+		// here. The divergent iterate is still an evaluation of g and
+		// starts the new history.
+		mColumn = 0;
+		mCount = 0;
+		mHasPrevious = false;
+		mBestResidualNorm = residualNorm;
+		++mRestarts;
+	}
+
+	if (mHasPrevious) {
+		mResidualDiffs.col(mColumn) = mResidual - mPrevResidual;
+		mImageDiffs.col(mColumn) = gx - mPrevImage;
+		mCount = std::min(mCount + 1, mDepth);
+		SmallVector products(mCount);
+		products.noalias() = mResidualDiffs.leftCols(mCount).transpose() * mResidualDiffs.col(mColumn);
+		mNormal.block(0, mColumn, mCount, 1) = products;
+		mNormal.block(mColumn, 0, 1, mCount) = products.transpose();
+		mColumn = (mColumn + 1) % mDepth;
+	}
+	mPrevResidual = mResidual;
+	mPrevImage = gx;
+	mHasPrevious = true;
+
+	if (mCount == 0) {
+		next = gx;
+		return;
+	}
+
+	// Minimize the combined residual by the normal equations, which only
+	// have the size of the history. The regularization keeps them solvable
+	// when the residuals become linearly dependent close to the fixed point.
+	auto residualDiffs = mResidualDiffs.leftCols(mCount);
+	SmallMatrix normal = mNormal.topLeftCorner(mCount, mCount);
+	SmallVector rhs(mCount);
+	rhs.noalias() = residualDiffs.transpose() * mResidual;
+	normal.diagonal().array() += 1e-12 * normal.diagonal().maxCoeff() + std::numeric_limits<Real>::min();
+	SmallVector gamma = normal.ldlt().solve(rhs);
+
+	next = gx;
+	next.noalias() -= mImageDiffs.leftCols(mCount) * gamma;
+}
@@ -0,0 +1,352 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <iomanip>
+
+#include <dpsim/BinaryDataLogger.h>
+#include <cps/Logger.h>
+
+using namespace DPsim;
+
+constexpr std::uint32_t BinaryDataLogger::FormatVersion;
+
+static const char magic[8] = { 'D', 'P', 'S', 'I', 'M', 'B', 'I', 'N' };
+
+static bool isLittleEndian() {
+	const std::uint16_t probe = 1;
+	return *reinterpret_cast<const char*>(&probe) == 1;
+}
+
+/// Converts between host and little-endian byte order in place
+template<typename T>
+static void toLittleEndian(T &value) {
+	if (isLittleEndian())
+		return;
+	char *bytes = reinterpret_cast<char*>(&value);
+	std::reverse(bytes, bytes + sizeof(T));
+}
+
+BinaryDataLogger::BinaryDataLogger(String name, Bool enabled, UInt downsampling, std::size_t bufferSize) :
+	DataLogger(enabled),
+	mBuffer(bufferSize) {
+	mName = name;
+	mDownsampling = downsampling;
+	if (!mEnabled)
+		return;
+
+	mFilename = CPS::Logger::logDir() + "/" + name + ".bin";
+
+	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
+		fs::create_directory(mFilename.parent_path());
+
+	open();
+}
+
+BinaryDataLogger::~BinaryDataLogger() {
+	close();
+}
+
+void BinaryDataLogger::open() {
+	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc|std::ios_base::binary);
+	if (!mLogFile.is_open()) {
+		std::cerr << "Cannot open log file " << mFilename << std::endl;
+		mEnabled = false;
+	}
+	mBufferPos = 0;
+	mResolved = false;
+	mHeaderWritten = false;
+}
+
+void BinaryDataLogger::close() {
+	stopWriter();
+	if (!mLogFile.is_open())
+		return;
+
+	flush();
+	mLogFile.close();
+}
+
+void BinaryDataLogger::flush() {
+	mLogFile.write(mBuffer.data(), mBufferPos);
+	mBufferPos = 0;
+}
+
+void BinaryDataLogger::appendReal(Real value) {
+	toLittleEndian(value);
+	append(&value, sizeof(value));
+}
+
+void BinaryDataLogger::addColumn(const String &name, ColumnType type, Source source,
+	CPS::AttributeBase::Ptr attr, UInt row, UInt col) {
+	mColumns[name] = { name, type, source, attr, row, col, nullptr };
+}
+
+void BinaryDataLogger::resolveColumns() {
+	mResolvedColumns.clear();
+	mRowSize = 1;
+	for (auto it : mColumns) {
+		Column &column = it.second;
+		column.value = nullptr;
+		mRowSize += column.type == ColumnType::Complex ? 2 : 1;
+
+		// Getter attributes have no storage, they are evaluated on each step
+		if (column.attribute->flags() & CPS::Flags::getter) {
+			mResolvedColumns.push_back(column);
+			continue;
+		}
+
+		switch (column.source) {
+		case Source::Int:
+			column.value = &std::static_pointer_cast<CPS::Attribute<Int>>(column.attribute)->get();
+			break;
+		case Source::Real:
+			column.value = &std::static_pointer_cast<CPS::Attribute<Real>>(column.attribute)->get();
+			break;
+		case Source::Complex:
+			column.value = &std::static_pointer_cast<CPS::Attribute<Complex>>(column.attribute)->get();
+			break;
+		case Source::MatrixReal:
+			column.value = &std::static_pointer_cast<CPS::MatrixRealAttribute>(column.attribute)->get()(column.row, column.col);
+			break;
+		case Source::MatrixComp:
+			column.value = &std::static_pointer_cast<CPS::MatrixCompAttribute>(column.attribute)->get()(column.row, column.col);
+			break;
+		}
+		mResolvedColumns.push_back(column);
+	}
+	mRow.resize(mRowSize);
+	mResolved = true;
+}
+
+void BinaryDataLogger::writeHeader() {
+	append(magic, sizeof(magic));
+
+	std::uint32_t version = FormatVersion;
+	toLittleEndian(version);
+	append(&version, sizeof(version));
+
+	std::uint32_t count = static_cast<std::uint32_t>(mResolvedColumns.size());
+	toLittleEndian(count);
+	append(&count, sizeof(count));
+
+	for (auto &column : mResolvedColumns) {
+		std::uint8_t type = static_cast<std::uint8_t>(column.type);
+		append(&type, sizeof(type));
+
+		std::uint32_t length = static_cast<std::uint32_t>(column.name.size());
+		toLittleEndian(length);
+		append(&length, sizeof(length));
+		append(column.name.data(), column.name.size());
+	}
+}
+
+void BinaryDataLogger::log(Real time, Int timeStepCount) {
+	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
+		return;
+
+	if (!mResolved)
+		resolveColumns();
+
+	Real* row = isAsync() ? reserveRow(mRowSize) : mRow.data();
+	if (!row)
+		return;
+
+	*row++ = time;
+	for (auto &column : mResolvedColumns) {
+		switch (column.source) {
+		case Source::Int:
+			*row++ = column.value
+				? static_cast<Real>(*static_cast<const Int*>(column.value))
+				: static_cast<Real>(std::static_pointer_cast<CPS::Attribute<Int>>(column.attribute)->getByValue());
+			break;
+		case Source::Real:
+			*row++ = column.value
+				? *static_cast<const Real*>(column.value)
+				: std::static_pointer_cast<CPS::Attribute<Real>>(column.attribute)->getByValue();
+			break;
+		case Source::Complex: {
+			Complex value = column.value
+				? *static_cast<const Complex*>(column.value)
+				: std::static_pointer_cast<CPS::Attribute<Complex>>(column.attribute)->getByValue();
+			*row++ = value.real();
+			*row++ = value.imag();
+			break;
+		}
+		case Source::MatrixReal:
+			*row++ = column.value
+				? *static_cast<const Real*>(column.value)
+				: std::static_pointer_cast<CPS::MatrixRealAttribute>(column.attribute)->getByValue()(column.row, column.col);
+			break;
+		case Source::MatrixComp: {
+			Complex value = column.value
+				? *static_cast<const Complex*>(column.value)
+				: std::static_pointer_cast<CPS::MatrixCompAttribute>(column.attribute)->getByValue()(column.row, column.col);
+			*row++ = value.real();
+			*row++ = value.imag();
+			break;
+		}
+		}
+	}
+
+	if (isAsync())
+		mQueue->commit();
+	else
+		writeRow(mRow.data(), mRowSize);
+}
+
+void BinaryDataLogger::writeRow(const Real* row, UInt size) {
+	if (!mHeaderWritten) {
+		writeHeader();
+		mHeaderWritten = true;
+	}
+
+	for (UInt i = 0; i < size; ++i)
+		appendReal(row[i]);
+}
+
+void BinaryDataLogger::addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr) {
+	mAttributes[name] = attr;
+	addColumn(name, ColumnType::Real, Source::Int, attr);
+}
+
+void BinaryDataLogger::addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr) {
+	mAttributes[name] = attr;
+	addColumn(name, ColumnType::Real, Source::Real, attr);
+}
+
+void BinaryDataLogger::addAttribute(const String &name, CPS::Attribute<Complex>::Ptr attr) {
+	mAttributes[name] = attr;
+	addColumn(name, ColumnType::Complex, Source::Complex, attr);
+}
+
+void BinaryDataLogger::addAttribute(const std::vector<String> &name, CPS::MatrixRealAttribute::Ptr attr) {
+	const Matrix &m = attr->get();
+
+	for (UInt k = 0; k < m.rows(); ++k) {
+		for (UInt l = 0; l < m.cols(); ++l) {
+			mAttributes[name[k*m.cols()+l]] = attr;
+			addColumn(name[k*m.cols()+l], ColumnType::Real, Source::MatrixReal, attr, k, l);
+		}
+	}
+}
+
+void BinaryDataLogger::addAttribute(const String &name, CPS::MatrixRealAttribute::Ptr attr) {
+	const Matrix &m = attr->get();
+	mAttributes[name] = attr;
+
+	if (m.rows() == 1 && m.cols() == 1) {
+		addColumn(name, ColumnType::Real, Source::MatrixReal, attr, 0, 0);
+	}
+	else if (m.cols() == 1) {
+		for (UInt k = 0; k < m.rows(); ++k) {
+			addColumn(name + "_" + std::to_string(k),
+				ColumnType::Real, Source::MatrixReal, attr, k, 0);
+		}
+	}
+	else {
+		for (UInt k = 0; k < m.rows(); ++k) {
+			for (UInt l = 0; l < m.cols(); ++l) {
+				addColumn(name + "_" + std::to_string(k) + "_" + std::to_string(l) + "_",
+					ColumnType::Real, Source::MatrixReal, attr, k, l);
+			}
+		}
+	}
+}
+
+void BinaryDataLogger::addAttribute(const String &name, CPS::MatrixCompAttribute::Ptr attr, UInt rowsMax, UInt colsMax) {
+	const MatrixComp &m = attr->get();
+	if (rowsMax == 0 || rowsMax > m.rows()) rowsMax = static_cast<UInt>(m.rows());
+	if (colsMax == 0 || colsMax > m.cols()) colsMax = static_cast<UInt>(m.cols());
+	mAttributes[name] = attr;
+
+	if (m.rows() == 1 && m.cols() == 1) {
+		addColumn(name, ColumnType::Complex, Source::MatrixComp, attr, 0, 0);
+	}
+	else if (m.cols() == 1) {
+		for (UInt k = 0; k < rowsMax; ++k) {
+			addColumn(name + "_" + std::to_string(k),
+				ColumnType::Complex, Source::MatrixComp, attr, k, 0);
+		}
+	}
+	else {
+		for (UInt k = 0; k < rowsMax; ++k) {
+			for (UInt l = 0; l < colsMax; ++l) {
+				addColumn(name + "_" + std::to_string(k) + "_" + std::to_string(l),
+					ColumnType::Complex, Source::MatrixComp, attr, k, l);
+			}
+		}
+	}
+}
+
+/// Reads a little-endian value from the stream
+template<typename T>
+static T readValue(std::istream &in) {
+	T value;
+	in.read(reinterpret_cast<char*>(&value), sizeof(T));
+	toLittleEndian(value);
+	return value;
+}
+
+void BinaryDataLogger::convertToCsv(const fs::path &binFilename, const fs::path &csvFilename) {
+	std::ifstream in(binFilename, std::ios_base::in|std::ios_base::binary);
+	if (!in.is_open())
+		throw CPS::SystemError("Cannot open binary log " + binFilename.string());
+
+	char fileMagic[sizeof(magic)];
+	in.read(fileMagic, sizeof(fileMagic));
+	if (!in || !std::equal(magic, magic + sizeof(magic), fileMagic))
+		throw CPS::SystemError("Not a binary log " + binFilename.string(), 0);
+
+	auto version = readValue<std::uint32_t>(in);
+	if (version != FormatVersion)
+		throw CPS::SystemError("Unsupported binary log version " + std::to_string(version), 0);
+
+	auto count = readValue<std::uint32_t>(in);
+	std::vector<String> names;
+	std::vector<ColumnType> types;
+	UInt rowSize = 1;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		auto type = static_cast<ColumnType>(readValue<std::uint8_t>(in));
+		auto length = readValue<std::uint32_t>(in);
+		String name(length, '\0');
+		in.read(&name[0], length);
+
+		names.push_back(name);
+		types.push_back(type);
+		rowSize += type == ColumnType::Complex ? 2 : 1;
+	}
+	if (!in)
+		throw CPS::SystemError("Truncated header in binary log " + binFilename.string(), 0);
+
+	std::ofstream out(csvFilename, std::ios_base::out|std::ios_base::trunc);
+	if (!out.is_open())
+		throw CPS::SystemError("Cannot open log file " + csvFilename.string());
+
+	out << std::right << std::setw(14) << "time";
+	for (UInt i = 0; i < names.size(); ++i) {
+		if (types[i] == ColumnType::Complex) {
+			out << ", " << std::right << std::setw(13) << names[i] + ".re";
+			out << ", " << std::right << std::setw(13) << names[i] + ".im";
+		}
+		else
+			out << ", " << std::right << std::setw(13) << names[i];
+	}
+	out << '\n';
+
+	std::vector<Real> row(rowSize);
+	while (in.read(reinterpret_cast<char*>(row.data()), rowSize * sizeof(Real))) {
+		for (auto &value : row)
+			toLittleEndian(value);
+
+		out << std::scientific << std::right << std::setw(14) << row[0];
+		for (UInt i = 1; i < rowSize; ++i)
+			out << ", " << std::right << std::setw(13) << row[i];
+		out << '\n';
+	}
+}
@@ -0,0 +1,454 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+
+#include <dpsim/CircuitLU.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+std::vector<Int> CircuitLU::minimumDegreeOrder(std::vector<std::vector<Int>>& adjacency) {
+	Int size = static_cast<Int>(adjacency.size());
+	for (auto& neighbours : adjacency) {
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+	}
+
+	// Min-heap of degrees, entries are stale if the degree has changed since
+	typedef std::pair<Int, Int> Entry;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+	for (Int node = 0; node < size; ++node)
+		heap.push(Entry(static_cast<Int>(adjacency[node].size()), node));
+
+	// Eliminating a node connects all of its neighbours
+	std::vector<Int> order;
+	std::vector<Bool> eliminated(size, false);
+	std::vector<Int> merged;
+	while (!heap.empty()) {
+		Entry top = heap.top();
+		heap.pop();
+		Int node = top.second;
+		if (eliminated[node] || top.first != static_cast<Int>(adjacency[node].size()))
+			continue;
+
+		eliminated[node] = true;
+		order.push_back(node);
+		auto& clique = adjacency[node];
+		for (auto neighbour : clique) {
+			merged.clear();
+			std::set_union(adjacency[neighbour].begin(), adjacency[neighbour].end(),
+				clique.begin(), clique.end(), std::back_inserter(merged));
+			merged.erase(std::remove_if(merged.begin(), merged.end(),
+				[&](Int other) { return other == neighbour || other == node; }), merged.end());
+			adjacency[neighbour].swap(merged);
+			heap.push(Entry(static_cast<Int>(adjacency[neighbour].size()), neighbour));
+		}
+		clique.clear();
+	}
+	return order;
+}
+
+void CircuitLU::analyzePattern(const SparseMatrix& matrix) {
+	if (matrix.rows() != matrix.cols())
+		throw SystemError("Circuit LU requires a square matrix");
+	if (!matrix.isCompressed())
+		throw SystemError("Circuit LU requires a compressed matrix");
+
+	mSize = static_cast<Int>(matrix.rows());
+	Int n = mSize;
+	const auto* rowPtr = matrix.outerIndexPtr();
+	const auto* colIdx = matrix.innerIndexPtr();
+	Int nnz = static_cast<Int>(matrix.nonZeros());
+
+	// Column structure of the row major input
+	std::vector<Int> colPtr(n + 1, 0), colRows(nnz);
+	for (Int p = 0; p < nnz; ++p)
+		++colPtr[colIdx[p] + 1];
+	for (Int col = 0; col < n; ++col)
+		colPtr[col + 1] += colPtr[col];
+	{
+		std::vector<Int> next(colPtr.begin(), colPtr.end() - 1);
+		for (Int row = 0; row < n; ++row) {
+			for (Int p = rowPtr[row]; p < rowPtr[row + 1]; ++p)
+				colRows[next[colIdx[p]]++] = row;
+		}
+	}
+
+	// Maximum transversal: match every column with a row by augmenting
+	// paths, so that the row permuted matrix has a zero-free diagonal.
+	// Voltage sources stamp rows without a diagonal entry.
+	std::vector<Int> rowMatch(n, -1), colMatch(n, -1);
+	for (Int col = 0; col < n; ++col) {
+		for (Int p = colPtr[col]; p < colPtr[col + 1]; ++p) {
+			if (rowMatch[colRows[p]] < 0) {
+				rowMatch[colRows[p]] = col;
+				colMatch[col] = colRows[p];
+				break;
+			}
+		}
+	}
+	{
+		std::vector<Int> visited(n, -1), colStack, rowPath, position(n);
+		for (Int start = 0; start < n; ++start) {
+			if (colMatch[start] >= 0)
+				continue;
+
+			colStack.assign(1, start);
+			rowPath.clear();
+			position[start] = colPtr[start];
+			Int freeRow = -1;
+			while (!colStack.empty() && freeRow < 0) {
+				Int col = colStack.back();
+				Int& p = position[col];
+				for (; p < colPtr[col + 1]; ++p) {
+					Int row = colRows[p];
+					if (visited[row] == start)
+						continue;
+					visited[row] = start;
+					if (rowMatch[row] < 0) {
+						freeRow = row;
+					}
+					else {
+						rowPath.push_back(row);
+						colStack.push_back(rowMatch[row]);
+						position[rowMatch[row]] = colPtr[rowMatch[row]];
+					}
+					++p;
+					break;
+				}
+				if (freeRow < 0 && colStack.back() == col && p >= colPtr[col + 1]) {
+					colStack.pop_back();
+					if (!rowPath.empty())
+						rowPath.pop_back();
+				}
+			}
+			if (freeRow < 0)
+				throw SystemError("System matrix is structurally singular");
+
+			// Shift the matching along the augmenting path
+			rowPath.push_back(freeRow);
+			for (UInt level = 0; level < colStack.size(); ++level) {
+				rowMatch[rowPath[level]] = colStack[level];
+				colMatch[colStack[level]] = rowPath[level];
+			}
+		}
+	}
+
+	// Row k of the matched matrix B is row colMatch[k] of the input, so
+	// B(k, j) != 0 for every column j in that row. Its strongly connected
+	// components in topological order form the diagonal blocks of the
+	// block upper triangular form (Tarjan's algorithm without recursion).
+	std::vector<Int> index(n, -1), lowLink(n, 0), component(n, -1), tarjanStack, callStack, edgePos(n);
+	std::vector<std::vector<Int>> components;
+	Int counter = 0;
+	for (Int root = 0; root < n; ++root) {
+		if (index[root] >= 0)
+			continue;
+		callStack.push_back(root);
+		while (!callStack.empty()) {
+			Int node = callStack.back();
+			Int row = colMatch[node];
+			if (index[node] < 0) {
+				index[node] = lowLink[node] = counter++;
+				edgePos[node] = rowPtr[row];
+				tarjanStack.push_back(node);
+			}
+			Bool descended = false;
+			for (Int& p = edgePos[node]; p < rowPtr[row + 1]; ++p) {
+				Int next = colIdx[p];
+				if (index[next] < 0) {
+					callStack.push_back(next);
+					descended = true;
+					break;
+				}
+				if (component[next] < 0)
+					lowLink[node] = std::min(lowLink[node], index[next]);
+			}
+			if (descended)
+				continue;
+
+			callStack.pop_back();
+			if (!callStack.empty())
+				lowLink[callStack.back()] = std::min(lowLink[callStack.back()], lowLink[node]);
+			if (lowLink[node] == index[node]) {
+				components.emplace_back();
+				Int member;
+				do {
+					member = tarjanStack.back();
+					tarjanStack.pop_back();
+					component[member] = static_cast<Int>(components.size()) - 1;
+					components.back().push_back(member);
+				} while (member != node);
+			}
+		}
+	}
+	// Tarjan's algorithm finds the components in reverse topological order
+	std::reverse(components.begin(), components.end());
+
+	// Order every block by minimum degree of the pattern of B + B^T
+	std::vector<Int> local(n);
+	mColPerm.clear();
+	mBlockStarts.clear();
+	for (auto& members : components) {
+		mBlockStarts.push_back(static_cast<Int>(mColPerm.size()));
+		if (members.size() == 1) {
+			mColPerm.push_back(members[0]);
+			continue;
+		}
+
+		for (UInt i = 0; i < members.size(); ++i)
+			local[members[i]] = i;
+		Int block = component[members[0]];
+		std::vector<std::vector<Int>> adjacency(members.size());
+		for (UInt i = 0; i < members.size(); ++i) {
+			Int node = members[i];
+			Int row = colMatch[node];
+			for (Int p = rowPtr[row]; p < rowPtr[row + 1]; ++p) {
+				Int col = colIdx[p];
+				if (col != node && component[col] == block) {
+					adjacency[i].push_back(local[col]);
+					adjacency[local[col]].push_back(i);
+				}
+			}
+		}
+		for (auto i : minimumDegreeOrder(adjacency))
+			mColPerm.push_back(members[i]);
+	}
+	mBlockStarts.push_back(n);
+
+	mRowPerm.resize(n);
+	std::vector<Int> rowPos(n), colPos(n);
+	for (Int k = 0; k < n; ++k) {
+		mRowPerm[k] = colMatch[mColPerm[k]];
+		rowPos[mRowPerm[k]] = k;
+		colPos[mColPerm[k]] = k;
+	}
+
+	// Permuted matrix by columns and the position of every input value in it
+	mCp.assign(n + 1, 0);
+	for (Int col = 0; col < n; ++col)
+		mCp[colPos[col] + 1] = colPtr[col + 1] - colPtr[col];
+	for (Int k = 0; k < n; ++k)
+		mCp[k + 1] += mCp[k];
+	mCi.resize(nnz);
+	mCx.assign(nnz, 0);
+	mValueMap.resize(nnz);
+	std::vector<Int> next(mCp.begin(), mCp.end() - 1);
+	for (Int row = 0; row < n; ++row) {
+		for (Int p = rowPtr[row]; p < rowPtr[row + 1]; ++p) {
+			Int q = next[colPos[colIdx[p]]]++;
+			mCi[q] = rowPos[row];
+			mValueMap[p] = q;
+		}
+	}
+
+	mX.assign(n, 0);
+	mStack.assign(2 * n, 0);
+	mMark.assign(n, -1);
+	mLp.clear();
+	mUp.clear();
+	mPinv.clear();
+}
+
+void CircuitLU::factorize(const SparseMatrix& matrix) {
+	Int n = mSize;
+	if (matrix.rows() != n || static_cast<Int>(matrix.nonZeros()) != static_cast<Int>(mValueMap.size()))
+		throw SystemError("Circuit LU: pattern differs from the analyzed one");
+
+	const Real* values = matrix.valuePtr();
+	for (UInt p = 0; p < mValueMap.size(); ++p)
+		mCx[mValueMap[p]] = values[p];
+
+	mLp.assign(n + 1, 0);
+	mUp.assign(n + 1, 0);
+	mLi.clear();
+	mLx.clear();
+	mUi.clear();
+	mUx.clear();
+	mPinv.assign(n, -1);
+	std::fill(mMark.begin(), mMark.end(), -1);
+	Int* xi = mStack.data();
+	Int* pstack = mStack.data() + n;
+
+	for (Int k = 0; k < n; ++k) {
+		mLp[k] = static_cast<Int>(mLi.size());
+		mUp[k] = static_cast<Int>(mUi.size());
+
+		// Rows reachable from the pattern of column k in the graph of L,
+		// written to xi[top..n) in topological order
+		Int top = n;
+		for (Int p = mCp[k]; p < mCp[k + 1]; ++p) {
+			if (mMark[mCi[p]] == k)
+				continue;
+			Int head = 0;
+			xi[0] = mCi[p];
+			while (head >= 0) {
+				Int row = xi[head];
+				Int col = mPinv[row];
+				if (mMark[row] != k) {
+					mMark[row] = k;
+					pstack[head] = col < 0 ? 0 : mLp[col];
+				}
+				Bool done = true;
+				Int end = col < 0 ? 0 : mLp[col + 1];
+				for (Int q = pstack[head]; q < end; ++q) {
+					if (mMark[mLi[q]] == k)
+						continue;
+					pstack[head] = q;
+					xi[++head] = mLi[q];
+					done = false;
+					break;
+				}
+				if (done) {
+					--head;
+					xi[--top] = row;
+				}
+			}
+		}
+
+		// Sparse triangular solve x = L \ C(:, k)
+		for (Int p = mCp[k]; p < mCp[k + 1]; ++p)
+			mX[mCi[p]] = mCx[p];
+		for (Int px = top; px < n; ++px) {
+			Int row = xi[px];
+			Int col = mPinv[row];
+			if (col < 0)
+				continue;
+			for (Int q = mLp[col] + 1; q < mLp[col + 1]; ++q)
+				mX[mLi[q]] -= mLx[q] * mX[row];
+		}
+
+		// Largest candidate as pivot unless the diagonal is large enough
+		Int pivotRow = -1;
+		Real largest = -1;
+		for (Int px = top; px < n; ++px) {
+			Int row = xi[px];
+			if (mPinv[row] < 0) {
+				if (std::abs(mX[row]) > largest) {
+					largest = std::abs(mX[row]);
+					pivotRow = row;
+				}
+			}
+			else {
+				mUi.push_back(mPinv[row]);
+				mUx.push_back(mX[row]);
+			}
+		}
+		if (pivotRow < 0 || largest <= 0)
+			throw SystemError("System matrix is singular");
+		if (mPinv[k] < 0 && mMark[k] == k && std::abs(mX[k]) >= mPivotTolerance * largest)
+			pivotRow = k;
+
+		Real pivot = mX[pivotRow];
+		mUi.push_back(k);
+		mUx.push_back(pivot);
+		mPinv[pivotRow] = k;
+		mLi.push_back(pivotRow);
+		mLx.push_back(1);
+		for (Int px = top; px < n; ++px) {
+			Int row = xi[px];
+			if (mPinv[row] < 0) {
+				mLi.push_back(row);
+				mLx.push_back(mX[row] / pivot);
+			}
+			mX[row] = 0;
+		}
+	}
+	mLp[n] = static_cast<Int>(mLi.size());
+	mUp[n] = static_cast<Int>(mUi.size());
+
+	// Rows of L by pivot position
+	for (auto& row : mLi)
+		row = mPinv[row];
+	mPivotRowSource.resize(n);
+	for (Int row = 0; row < n; ++row)
+		mPivotRowSource[mPinv[row]] = mRowPerm[row];
+}
+
+Bool CircuitLU::refactorize(const SparseMatrix& matrix) {
+	Int n = mSize;
+	if (static_cast<Int>(mPinv.size()) != n || matrix.rows() != n
+		|| static_cast<Int>(matrix.nonZeros()) != static_cast<Int>(mValueMap.size()))
+		return false;
+
+	const Real* values = matrix.valuePtr();
+	for (UInt p = 0; p < mValueMap.size(); ++p)
+		mCx[mValueMap[p]] = values[p];
+
+	// Same elimination as in factorize, but in pivot positions and along
+	// the stored patterns, so no graph traversal and no pivot search
+	for (Int k = 0; k < n; ++k) {
+		for (Int p = mCp[k]; p < mCp[k + 1]; ++p)
+			mX[mPinv[mCi[p]]] = mCx[p];
+
+		Int diag = mUp[k + 1] - 1;
+		for (Int p = mUp[k]; p < diag; ++p) {
+			Int col = mUi[p];
+			Real value = mX[col];
+			mUx[p] = value;
+			mX[col] = 0;
+			for (Int q = mLp[col] + 1; q < mLp[col + 1]; ++q)
+				mX[mLi[q]] -= mLx[q] * value;
+		}
+
+		Real pivot = mX[k];
+		mX[k] = 0;
+		Real largest = std::abs(pivot);
+		for (Int q = mLp[k] + 1; q < mLp[k + 1]; ++q)
+			largest = std::max(largest, std::abs(mX[mLi[q]]));
+		if (pivot == 0 || std::abs(pivot) < mRefactorTolerance * largest) {
+			std::fill(mX.begin(), mX.end(), 0);
+			mPinv.clear();
+			return false;
+		}
+
+		mUx[diag] = pivot;
+		for (Int q = mLp[k] + 1; q < mLp[k + 1]; ++q) {
+			mLx[q] = mX[mLi[q]] / pivot;
+			mX[mLi[q]] = 0;
+		}
+	}
+	return true;
+}
+
+void CircuitLU::solve(const Matrix& rhs, Matrix& x) {
+	Int n = mSize;
+	for (Eigen::Index c = 0; c < rhs.cols(); ++c) {
+		for (Int k = 0; k < n; ++k)
+			mX[k] = rhs(mPivotRowSource[k], c);
+
+		// Forward substitution with the unit lower triangular L
+		for (Int k = 0; k < n; ++k) {
+			Real value = mX[k];
+			if (value == 0)
+				continue;
+			for (Int q = mLp[k] + 1; q < mLp[k + 1]; ++q)
+				mX[mLi[q]] -= mLx[q] * value;
+		}
+
+		// Backward substitution with U, the diagonal is the last entry
+		for (Int k = n - 1; k >= 0; --k) {
+			Int diag = mUp[k + 1] - 1;
+			mX[k] /= mUx[diag];
+			Real value = mX[k];
+			if (value == 0)
+				continue;
+			for (Int p = mUp[k]; p < diag; ++p)
+				mX[mUi[p]] -= mUx[p] * value;
+		}
+
+		for (Int k = 0; k < n; ++k) {
+			x(mColPerm[k], c) = mX[k];
+			mX[k] = 0;
+		}
+	}
+}
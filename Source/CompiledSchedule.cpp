@@ -0,0 +1,80 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/CompiledSchedule.h>
+
+#include <cstdint>
+#include <new>
+
+using namespace CPS;
+using namespace DPsim;
+
+constexpr size_t CompiledSchedule::CacheLineSize;
+
+CompiledSchedule::~CompiledSchedule() {
+	freeCounters();
+}
+
+void CompiledSchedule::freeCounters() {
+	for (Int i = 0; mCounters && i < size(); i++)
+		mCounters[i].~PaddedCounter();
+	delete[] mCounterStorage;
+	mCounterStorage = nullptr;
+	mCounters = nullptr;
+}
+
+void CompiledSchedule::compile(const Task::List& tasks, const Scheduler::Edges& inEdges) {
+	freeCounters();
+
+	std::unordered_map<Task*, Int> indices;
+	mTasks.clear();
+	for (auto& task : tasks) {
+		indices[task.get()] = static_cast<Int>(mTasks.size());
+		mTasks.push_back(task.get());
+	}
+
+	// Predecessors in CSR format
+	mPredOffsets.assign(1, 0);
+	mPredIndices.clear();
+	std::vector<Int> numSuccessors(tasks.size(), 0);
+	for (auto& task : tasks) {
+		auto edges = inEdges.find(task);
+		if (edges != inEdges.end()) {
+			for (auto& before : edges->second) {
+				auto it = indices.find(before.get());
+				if (it == indices.end())
+					continue;
+				mPredIndices.push_back(it->second);
+				numSuccessors[it->second]++;
+			}
+		}
+		mPredOffsets.push_back(static_cast<Int>(mPredIndices.size()));
+	}
+
+	// Successors by transposing the predecessor lists
+	mSuccOffsets.assign(tasks.size() + 1, 0);
+	for (size_t i = 0; i < tasks.size(); i++)
+		mSuccOffsets[i+1] = mSuccOffsets[i] + numSuccessors[i];
+	mSuccIndices.resize(mPredIndices.size());
+	std::vector<Int> fill(mSuccOffsets.begin(), mSuccOffsets.end() - 1);
+	for (Int i = 0; i < size(); i++) {
+		for (const Int* pred = predecessorsBegin(i); pred != predecessorsEnd(i); ++pred)
+			mSuccIndices[fill[*pred]++] = i;
+	}
+
+	// std::allocator does not guarantee cache line alignment in C++11,
+	// so the counters are placed into an over-allocated buffer
+	mCounterStorage = new char[(tasks.size() + 1) * sizeof(PaddedCounter)];
+	uintptr_t addr = reinterpret_cast<uintptr_t>(mCounterStorage);
+	addr = (addr + CacheLineSize - 1) & ~static_cast<uintptr_t>(CacheLineSize - 1);
+	mCounters = reinterpret_cast<PaddedCounter*>(addr);
+	for (Int i = 0; i < size(); i++) {
+		new (&mCounters[i]) PaddedCounter();
+		mCounters[i].value.store(0, std::memory_order_relaxed);
+	}
+}
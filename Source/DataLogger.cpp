@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
 
 #include <dpsim/DataLogger.h>
@@ -16,14 +18,22 @@ using namespace DPsim;
 DataLogger::DataLogger(Bool enabled) :
 	mLogFile(),
 	mEnabled(enabled),
-	mDownsampling(1) {
+	mDownsampling(1),
+	mWriterStop(false) {
 	mLogFile.setstate(std::ios_base::badbit);
+
+	CPS::AttributeList::addAttribute<Int>("overflows", &mOverflows, CPS::Flags::read);
+	CPS::AttributeList::addAttribute<Int>("dropped_rows", &mDroppedRows, CPS::Flags::read);
 }
 
 DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
 	mName(name),
 	mEnabled(enabled),
-	mDownsampling(downsampling) {
+	mDownsampling(downsampling),
+	mWriterStop(false) {
+	CPS::AttributeList::addAttribute<Int>("overflows", &mOverflows, CPS::Flags::read);
+	CPS::AttributeList::addAttribute<Int>("dropped_rows", &mDroppedRows, CPS::Flags::read);
+
 	if (!mEnabled)
 		return;
 
@@ -44,24 +54,152 @@ void DataLogger::open() {
 	}
 }
 
+DataLogger::~DataLogger() {
+	stopWriter();
+}
+
 void DataLogger::close() {
+	stopWriter();
 	mLogFile.close();
 }
 
 void DataLogger::setColumnNames(std::vector<String> names) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	mColumnNames = names;
+	// The writer thread adds the header together with the first row
+	if (!isAsync())
+		writeColumnNames();
+}
+
+void DataLogger::writeColumnNames() {
+	if (mLogFile.tellp() == std::ofstream::pos_type(0) && !mColumnNames.empty()) {
 		mLogFile << std::right << std::setw(14) << "time";
-		for (auto name : names) {
+		for (auto name : mColumnNames) {
 			mLogFile << ", " << std::right << std::setw(13) << name;
 		}
 		mLogFile << '\n';
 	}
 }
 
+void DataLogger::setAsync(UInt capacity, OverflowPolicy policy) {
+	stopWriter();
+	mAsyncCapacity = capacity;
+	mOverflowPolicy = policy;
+}
+
+Real* DataLogger::reserveRow(UInt size) {
+	if (!mQueue) {
+		mQueue = std::unique_ptr<LogRingBuffer>(new LogRingBuffer(mAsyncCapacity, size));
+		mOverflowDownsampling = 1;
+		mQueuedRowCount = 0;
+		mWriterStop = false;
+		mWriter = std::thread(&DataLogger::writerLoop, this);
+	}
+	if (size != mQueue->rowSize())
+		throw CPS::SystemError("Row size of asynchronous logger " + mName + " changed", 0);
+
+	++mQueuedRowCount;
+	if (mOverflowPolicy == OverflowPolicy::downsample && mOverflowDownsampling > 1) {
+		if (mQueue->size() <= mQueue->capacity() / 4)
+			mOverflowDownsampling /= 2;
+		if (mQueuedRowCount % mOverflowDownsampling != 0) {
+			++mDroppedRows;
+			return nullptr;
+		}
+	}
+
+	Real* row = mQueue->reserve();
+	if (row)
+		return row;
+
+	++mOverflows;
+	switch (mOverflowPolicy) {
+	case OverflowPolicy::block:
+		while (!(row = mQueue->reserve()))
+			std::this_thread::yield();
+		return row;
+	case OverflowPolicy::dropOldest:
+		if (mQueue->dropOldest())
+			++mDroppedRows;
+		return mQueue->reserve();
+	case OverflowPolicy::downsample:
+	default:
+		mOverflowDownsampling = std::min(2 * mOverflowDownsampling, mQueue->capacity());
+		++mDroppedRows;
+		return nullptr;
+	}
+}
+
+void DataLogger::writerLoop() {
+	std::vector<Real> row(mQueue->rowSize());
+	while (true) {
+		// Read the stop request first so that all rows committed
+		// before it are drained below
+		Bool stop = mWriterStop.load(std::memory_order_acquire);
+		while (mQueue->pop(row.data()))
+			writeRow(row.data(), mQueue->rowSize());
+		if (stop)
+			break;
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+}
+
+void DataLogger::stopWriter() {
+	if (!mWriter.joinable())
+		return;
+
+	mWriterStop.store(true, std::memory_order_release);
+	mWriter.join();
+	mQueue.reset();
+}
+
+void DataLogger::writeRow(const Real* row, UInt size) {
+	writeColumnNames();
+
+	mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+	if (mRowFormat == RowFormat::ComplexValues) {
+		for (UInt i = 1; i + 1 < size; i += 2)
+			mLogFile << ", " << std::right << std::setw(13) << Complex(row[i], row[i + 1]);
+		mLogFile << '\n';
+		return;
+	}
+	for (UInt i = 1; i < size; ++i) {
+		mLogFile << ", " << std::right << std::setw(13);
+		if (mRowFormat == RowFormat::Values)
+			mLogFile << row[i];
+		else if (mIntegerColumns[i - 1])
+			mLogFile << std::to_string(static_cast<Int>(row[i]));
+		else
+			mLogFile << std::to_string(row[i]);
+	}
+	mLogFile << '\n';
+}
+
+void DataLogger::queueRow(Real time, const Real* values, UInt size, RowFormat format) {
+	// The format is fixed by the first row, like the row size
+	if (!mQueue)
+		mRowFormat = format;
+	else if (format != mRowFormat)
+		throw CPS::SystemError("Row format of asynchronous logger " + mName + " changed", 0);
+
+	Real* row = reserveRow(size + 1);
+	if (!row)
+		return;
+	row[0] = time;
+	std::copy(values, values + size, row + 1);
+	mQueue->commit();
+}
+
 void DataLogger::logDataLine(Real time, Real data) {
 	if (!mEnabled)
 		return;
 
+	// The writer thread owns the file in asynchronous mode
+	if (isAsync()) {
+		queueRow(time, &data, 1, RowFormat::Values);
+		return;
+	}
+
+	writeColumnNames();
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	mLogFile << ", " << std::right << std::setw(13) << data;
 	mLogFile << '\n';
@@ -71,6 +209,12 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 	if (!mEnabled)
 		return;
 
+	if (isAsync()) {
+		queueRow(time, data.data(), static_cast<UInt>(data.rows()), RowFormat::Values);
+		return;
+	}
+
+	writeColumnNames();
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -81,6 +225,14 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 	if (!mEnabled)
 		return;
+
+	if (isAsync()) {
+		queueRow(time, reinterpret_cast<const Real*>(data.data()), 2 * static_cast<UInt>(data.rows()),
+			RowFormat::ComplexValues);
+		return;
+	}
+
+	writeColumnNames();
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -89,7 +241,7 @@ void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 }
 
 void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (mColumnNames.empty()) {
 		std::vector<String> names;
 
 		Int harmonicOffset = data.rows() / freqNum;
@@ -115,7 +267,7 @@ void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum)
 }
 
 void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (mColumnNames.empty()) {
 		std::vector<String> names;
 		for (Int i = 0; i < data.rows(); ++i) {
 			std::stringstream name;
@@ -131,6 +283,34 @@ void DataLogger::log(Real time, Int timeStepCount) {
 	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
 		return;
 
+	if (isAsync()) {
+		if (mRowAttributes.size() != mAttributes.size()) {
+			// The writer thread must not see the columns change
+			stopWriter();
+			mRowFormat = RowFormat::Attributes;
+			mRowAttributes.clear();
+			mIntegerColumns.clear();
+			mColumnNames.clear();
+			for (auto it : mAttributes) {
+				mColumnNames.push_back(it.first);
+				mRowAttributes.push_back(it.second);
+				mIntegerColumns.push_back(!!std::dynamic_pointer_cast<CPS::Attribute<Int>>(it.second));
+			}
+		}
+
+		Real* row = reserveRow(static_cast<UInt>(mRowAttributes.size()) + 1);
+		if (!row)
+			return;
+		row[0] = time;
+		for (UInt i = 0; i < mRowAttributes.size(); ++i) {
+			row[i + 1] = mIntegerColumns[i]
+				? std::static_pointer_cast<CPS::Attribute<Int>>(mRowAttributes[i])->getByValue()
+				: std::static_pointer_cast<CPS::Attribute<Real>>(mRowAttributes[i])->getByValue();
+		}
+		mQueue->commit();
+		return;
+	}
+
 	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
 		for (auto it : mAttributes)
@@ -8,10 +8,12 @@
 
 #include <dpsim/DiakopticsSolver.h>
 
+#include <exception>
 #include <iomanip>
 
 #include <cps/MathUtils.h>
 #include <cps/Solver/MNATearInterface.h>
+#include <dpsim/Config.h>
 #include <dpsim/Definitions.h>
 
 using namespace CPS;
@@ -205,15 +207,13 @@ void DiakopticsSolver<Complex>::setLogColumns() {
 template <typename VarType>
 void DiakopticsSolver<VarType>::createMatrices() {
 	UInt totalSize = mSubnets.back().sysOff + mSubnets.back().sysSize;
-	mSystemMatrix = Matrix::Zero(totalSize, totalSize);
-	mSystemInverse = Matrix::Zero(totalSize, totalSize);
-
 	mRightSideVector = Matrix::Zero(totalSize, 1);
 	mLeftSideVector = Matrix::Zero(totalSize, 1);
 	mOrigLeftSideVector = Matrix::Zero(totalSize, 1);
 	addAttribute<Matrix>("old_left_vector", &mOrigLeftSideVector, Flags::read);
 	mMappedTearCurrents = Matrix::Zero(totalSize, 1);
 	addAttribute<Matrix>("mapped_tear_currents", &mMappedTearCurrents, Flags::read);
+	addAttribute<Matrix>("tear_currents", &mTearCurrents, Flags::read);
 
 	for (auto& net : mSubnets) {
 		// The subnets' components expect to be passed a left-side vector matching
@@ -228,7 +228,7 @@ void DiakopticsSolver<VarType>::createMatrices() {
 
 template <>
 void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
-	mTearTopology = Matrix::Zero(totalSize, mTearComponents.size());
+	mTearTopology = SparseMatrix(totalSize, mTearComponents.size());
 	mTearImpedance = Matrix::Zero(mTearComponents.size(), mTearComponents.size());
 	mTearCurrents = Matrix::Zero(mTearComponents.size(), 1);
 	mTearVoltages = Matrix::Zero(mTearComponents.size(), 1);
@@ -236,30 +236,58 @@ void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
 
 template <>
 void DiakopticsSolver<Complex>::createTearMatrices(UInt totalSize) {
-	mTearTopology = Matrix::Zero(totalSize, 2*mTearComponents.size());
+	mTearTopology = SparseMatrix(totalSize, 2*mTearComponents.size());
 	mTearImpedance = Matrix::Zero(2*mTearComponents.size(), 2*mTearComponents.size());
 	mTearCurrents = Matrix::Zero(2*mTearComponents.size(), 1);
 	mTearVoltages = Matrix::Zero(2*mTearComponents.size(), 1);
 }
 
+template <typename VarType>
+void DiakopticsSolver<VarType>::forEachSubnet(const std::function<void(Subnet&)>& func) {
+#ifdef WITH_OPENMP
+	// Exceptions must not leave the parallel region, so the first one is
+	// rethrown afterwards.
+	std::vector<std::exception_ptr> errors(mSubnets.size());
+
+	#pragma omp parallel for schedule(dynamic)
+	for (Int net = 0; net < static_cast<Int>(mSubnets.size()); ++net) {
+		try {
+			func(mSubnets[net]);
+		} catch (...) {
+			errors[net] = std::current_exception();
+		}
+	}
+
+	for (auto& error : errors) {
+		if (error)
+			std::rethrow_exception(error);
+	}
+#else
+	for (auto& net : mSubnets)
+		func(net);
+#endif
+}
+
 template <typename VarType>
 void DiakopticsSolver<VarType>::initComponents() {
-	for (UInt net = 0; net < mSubnets.size(); ++net) {
-		for (auto comp : mSubnets[net].components) {
+	// The subnets share no components or nodes, so they are initialized
+	// concurrently.
+	forEachSubnet([this](Subnet& net) {
+		for (auto comp : net.components) {
 			auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
 			if (!pComp) continue;
 			pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
 		}
 
 		// Initialize MNA specific parts of components.
-		for (auto comp : mSubnets[net].components) {
-			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mSubnets[net].leftVector);
+		for (auto comp : net.components) {
+			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, net.leftVector);
 			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
 			if (stamp.size() != 0) {
-				mSubnets[net].rightVectorStamps.push_back(&stamp);
+				net.rightVectorStamps.push_back(&stamp);
 			}
 		}
-	}
+	});
 	// Initialize signal components.
 	for (auto comp : mSimSignalComps)
 		comp->initialize(mSystem.mSystemOmega, mTimeStep);
@@ -267,34 +295,39 @@ void DiakopticsSolver<VarType>::initComponents() {
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::initMatrices() {
-	for (auto& net : mSubnets) {
-		// We can't directly pass the block reference to mnaApplySystemMatrixStamp,
-		// because it expects a concrete Matrix. It can't be changed to accept some common
-		// base class like DenseBase because that would make it a template function (as
-		// Eigen uses CRTP for polymorphism), which is impossible for virtual functions.
-		Matrix partSys = Matrix::Zero(net.sysSize, net.sysSize);
+	// initialize tear topology matrix and impedance matrix of removed network
+	std::vector<Eigen::Triplet<Real>> topology;
+	for (UInt compIdx = 0; compIdx < mTearComponents.size(); ++compIdx) {
+		applyTearComponentStamp(compIdx, topology);
+	}
+	mTearTopology.setFromTriplets(topology.begin(), topology.end());
+	mSLog->info("Topology matrix has {} nonzero entries", mTearTopology.nonZeros());
+	mSLog->info("Removed impedance matrix: \n{}", mTearImpedance);
+
+	forEachSubnet([this](Subnet& net) {
+		// The complete system matrix is block diagonal, so only the blocks
+		// of the subnets are stamped and factorized.
+		SparseMatrix partSysSparse(net.sysSize, net.sysSize);
 		for (auto comp : net.components) {
-			comp->mnaApplySystemMatrixStamp(partSys);
+			comp->mnaApplySystemMatrixStamp(partSysSparse);
 		}
-		auto block = mSystemMatrix.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize);
-		block = partSys;
-		mSLog->info("Block: \n{}", block);
+		Matrix partSys = Matrix(partSysSparse);
+		mSLog->info("Block: \n{}", partSys);
 		net.luFactorization = Eigen::PartialPivLU<Matrix>(partSys);
 		mSLog->info("Factorization: \n{}", net.luFactorization.matrixLU());
-	}
-	mSLog->info("Complete system matrix: \n{}", mSystemMatrix);
 
-	// initialize tear topology matrix and impedance matrix of removed network
-	for (UInt compIdx = 0; compIdx < mTearComponents.size(); ++compIdx) {
-		applyTearComponentStamp(compIdx);
-	}
-	mSLog->info("Topology matrix: \n{}", mTearTopology);
-	mSLog->info("Removed impedance matrix: \n{}", mTearImpedance);
-	// TODO this can be sped up as well by using the block diagonal form of Yinv
+		initSubnetTearMatrices(net);
+	});
+
+	// Z' = Z + C^T * Y^-1 * C, accumulated block by block
+	Matrix totalTearImpedance = mTearImpedance;
 	for (auto& net : mSubnets) {
-		mSystemInverse.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize) = net.luFactorization.inverse();
+		for (UInt i = 0; i < net.tearColumns.size(); ++i) {
+			for (UInt j = 0; j < net.tearColumns.size(); ++j)
+				totalTearImpedance(net.tearColumns[i], net.tearColumns[j]) += net.tearImpedance(i, j);
+		}
 	}
-	mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(mTearImpedance + mTearTopology.transpose() * mSystemInverse * mTearTopology);
+	mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(totalTearImpedance);
 	mSLog->info("Total removed impedance matrix LU decomposition: \n{}", mTotalTearImpedance.matrixLU());
 
 	// Compute subnet right side (source) vectors for debugging
@@ -308,27 +341,64 @@ void DiakopticsSolver<VarType>::initMatrices() {
 	}
 }
 
+template <typename VarType>
+void DiakopticsSolver<VarType>::initSubnetTearMatrices(Subnet& net) {
+	UInt numColumns = static_cast<UInt>(net.tearColumns.size());
+
+	// Columns of C belonging to the torn components connected to this subnet
+	std::unordered_map<UInt, UInt> localColumns;
+	for (UInt idx = 0; idx < numColumns; ++idx)
+		localColumns[net.tearColumns[idx]] = idx;
+
+	Matrix netTopology = Matrix::Zero(net.sysSize, numColumns);
+	for (UInt row = 0; row < net.sysSize; ++row) {
+		for (SparseMatrix::InnerIterator it(mTearTopology, net.sysOff + row); it; ++it)
+			netTopology(row, localColumns[static_cast<UInt>(it.col())]) = it.value();
+	}
+	net.tearTopology = netTopology.sparseView();
+
+	// Solve Y_k * X = C_k instead of inverting Y_k
+	net.tearImpedance = netTopology.transpose() * net.luFactorization.solve(netTopology);
+	net.tearCurrents = Matrix::Zero(numColumns, 1);
+	net.tearVoltages = Matrix::Zero(numColumns, 1);
+}
+
 template <>
-void DiakopticsSolver<Real>::applyTearComponentStamp(UInt compIdx) {
+void DiakopticsSolver<Real>::applyTearComponentStamp(UInt compIdx, std::vector<Eigen::Triplet<Real>>& topology) {
 	auto comp = mTearComponents[compIdx];
-	mTearTopology(mNodeSubnetMap[comp->node(0)]->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-	mTearTopology(mNodeSubnetMap[comp->node(1)]->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
+
+	auto net1 = mNodeSubnetMap[comp->node(0)];
+	auto net2 = mNodeSubnetMap[comp->node(1)];
+
+	topology.push_back(Eigen::Triplet<Real>(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx, 1));
+	topology.push_back(Eigen::Triplet<Real>(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx, -1));
+	net1->tearColumns.push_back(compIdx);
+	if (net2 != net1)
+		net2->tearColumns.push_back(compIdx);
 
 	auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 	tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
 }
 
 template <>
-void DiakopticsSolver<Complex>::applyTearComponentStamp(UInt compIdx) {
+void DiakopticsSolver<Complex>::applyTearComponentStamp(UInt compIdx, std::vector<Eigen::Triplet<Real>>& topology) {
 	auto comp = mTearComponents[compIdx];
 
 	auto net1 = mNodeSubnetMap[comp->node(0)];
 	auto net2 = mNodeSubnetMap[comp->node(1)];
 
-	mTearTopology(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-	mTearTopology(net1->sysOff + net1->mCmplOff + comp->node(0)->matrixNodeIndex(), mTearComponents.size() + compIdx) = 1;
-	mTearTopology(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
-	mTearTopology(net2->sysOff + net2->mCmplOff + comp->node(1)->matrixNodeIndex(), mTearComponents.size() + compIdx) = -1;
+	UInt imagIdx = static_cast<UInt>(mTearComponents.size()) + compIdx;
+
+	topology.push_back(Eigen::Triplet<Real>(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx, 1));
+	topology.push_back(Eigen::Triplet<Real>(net1->sysOff + net1->mCmplOff + comp->node(0)->matrixNodeIndex(), imagIdx, 1));
+	topology.push_back(Eigen::Triplet<Real>(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx, -1));
+	topology.push_back(Eigen::Triplet<Real>(net2->sysOff + net2->mCmplOff + comp->node(1)->matrixNodeIndex(), imagIdx, -1));
+	net1->tearColumns.push_back(compIdx);
+	net1->tearColumns.push_back(imagIdx);
+	if (net2 != net1) {
+		net2->tearColumns.push_back(compIdx);
+		net2->tearColumns.push_back(imagIdx);
+	}
 
 	auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 	tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
@@ -376,6 +446,8 @@ void DiakopticsSolver<VarType>::SubnetSolveTask::execute(Real time, Int timeStep
 	auto lBlock = mSolver.mOrigLeftSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	// Solve Y' * v' = I
 	lBlock = mSubnet.luFactorization.solve(rBlock);
+	// C^T * v' of this subnet
+	mSubnet.tearVoltages.noalias() = mSubnet.tearTopology.transpose() * lBlock;
 }
 
 template <typename VarType>
@@ -385,29 +457,45 @@ void DiakopticsSolver<VarType>::PreSolveTask::execute(Real time, Int timeStepCou
 		auto tComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
 		tComp->mnaTearApplyVoltageStamp(mSolver.mTearVoltages);
 	}
-	// -C^T * v'
-	mSolver.mTearVoltages -= mSolver.mTearTopology.transpose() * mSolver.mOrigLeftSideVector;
+	// -C^T * v', gathered from the subnets
+	for (auto& net : mSolver.mSubnets) {
+		for (UInt idx = 0; idx < net.tearColumns.size(); ++idx)
+			mSolver.mTearVoltages(net.tearColumns[idx], 0) -= net.tearVoltages(idx, 0);
+	}
 	// Solve Z' * i = E - C^T * v'
 	mSolver.mTearCurrents = mSolver.mTotalTearImpedance.solve(mSolver.mTearVoltages);
-	// C * i
-	mSolver.mMappedTearCurrents = mSolver.mTearTopology * mSolver.mTearCurrents;
-	mSolver.mLeftSideVector = mSolver.mOrigLeftSideVector;
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::SolveTask::execute(Real time, Int timeStepCount) {
+	for (UInt idx = 0; idx < mSubnet.tearColumns.size(); ++idx)
+		mSubnet.tearCurrents(idx, 0) = mSolver.mTearCurrents(mSubnet.tearColumns[idx], 0);
+
 	auto lBlock = mSolver.mLeftSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	auto rBlock = mSolver.mMappedTearCurrents.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
+	// C * i
+	rBlock.noalias() = mSubnet.tearTopology * mSubnet.tearCurrents;
 	// Solve Y' * x = C * i
 	// v = v' + x
+	lBlock = mSolver.mOrigLeftSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
 	lBlock += mSubnet.luFactorization.solve(rBlock);
 	*mSubnet.leftVector = lBlock;
+	// C^T * v of this subnet
+	mSubnet.tearVoltages.noalias() = mSubnet.tearTopology.transpose() * lBlock;
+
+	for (UInt node = 0; node < mSubnet.mRealNetNodeNum; ++node) {
+		mSubnet.nodes[node]->mnaUpdateVoltage(*mSubnet.leftVector);
+	}
 }
 
 template <typename VarType>
 void DiakopticsSolver<VarType>::PostSolveTask::execute(Real time, Int timeStepCount) {
 	// pass the voltages and current of the solution to the torn components
-	mSolver.mTearVoltages = -mSolver.mTearTopology.transpose() * mSolver.mLeftSideVector;
+	mSolver.mTearVoltages.setZero();
+	for (auto& net : mSolver.mSubnets) {
+		for (UInt idx = 0; idx < net.tearColumns.size(); ++idx)
+			mSolver.mTearVoltages(net.tearColumns[idx], 0) -= net.tearVoltages(idx, 0);
+	}
 	for (UInt compIdx = 0; compIdx < mSolver.mTearComponents.size(); ++compIdx) {
 		auto comp = mSolver.mTearComponents[compIdx];
 		auto tComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
@@ -415,13 +503,6 @@ void DiakopticsSolver<VarType>::PostSolveTask::execute(Real time, Int timeStepCo
 		Complex current = Math::complexFromVectorElement(mSolver.mTearCurrents, compIdx);
 		tComp->mnaTearPostStep(voltage, current);
 	}
-
-	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt net = 0; net < mSolver.mSubnets.size(); ++net) {
-		for (UInt node = 0; node < mSolver.mSubnets[net].mRealNetNodeNum; ++node) {
-			mSolver.mSubnets[net].nodes[node]->mnaUpdateVoltage(*(mSolver.mSubnets[net].leftVector));
-		}
-	}
 }
 
 template <>
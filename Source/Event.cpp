@@ -31,3 +31,15 @@ void EventQueue::handleEvents(Real currentTime) {
 		}
 	}
 }
+
+std::vector<Event::Ptr> EventQueue::events() const {
+	std::vector<Event::Ptr> list;
+	auto queue = mEvents;
+
+	while (!queue.empty()) {
+		list.push_back(queue.top());
+		queue.pop();
+	}
+
+	return list;
+}
@@ -9,7 +9,15 @@
 
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/AndersonAcceleration.h>
 #include <memory>
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <numeric>
+#include <type_traits>
+
+#include <Eigen/OrderingMethods>
 
 using namespace DPsim;
 using namespace CPS;
@@ -24,6 +32,12 @@ MnaSolver<VarType>::MnaSolver(String name, CPS::Domain domain, CPS::Logger::Leve
 	// Raw source and solution vector logging
 	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel != CPS::Logger::Level::off);
 	mRightVectorLog = std::make_shared<DataLogger>(name + "_RightVector", logLevel != CPS::Logger::Level::off);
+
+	addAttribute<Int>("lu_cache_hits", &mSwitchedMatrixCacheHits, Flags::read);
+	addAttribute<Int>("lu_cache_misses", &mSwitchedMatrixCacheMisses, Flags::read);
+	addAttribute<Int>("node_bandwidth", &mNodeBandwidth, Flags::read);
+	addAttribute<Int>("steady_state_steps", &mSteadStIniSteps, Flags::read);
+	addAttribute<Real>("steady_state_time", &mSteadStIniWallTime, Flags::read);
 }
 
 template <typename VarType>
@@ -105,6 +119,12 @@ void MnaSolver<Real>::initializeComponents() {
 		pComp->checkForUnconnectedTerminals();
 		pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
 	}
+	for (auto comp : mMNAIntfVariableComps) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<Real>>(comp);
+		if (!pComp)	continue;
+		pComp->checkForUnconnectedTerminals();
+		pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
+	}
 
 	// Initialize signal components.
 	for (auto comp : mSimSignalComps)
@@ -113,13 +133,14 @@ void MnaSolver<Real>::initializeComponents() {
 	// Initialize MNA specific parts of components.
 	for (auto comp : mMNAComponents) {
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-		const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
+		addRightVectorStamp(comp);
 	}
 	for (auto comp : mSwitches)
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+	for (auto comp : mMNAIntfVariableComps) {
+		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+		addRightVectorStamp(comp);
+	}
 }
 
 template <>
@@ -133,6 +154,12 @@ void MnaSolver<Complex>::initializeComponents() {
 		pComp->checkForUnconnectedTerminals();
 		pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
 	}
+	for (auto comp : mMNAIntfVariableComps) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp);
+		if (!pComp)	continue;
+		pComp->checkForUnconnectedTerminals();
+		pComp->initializeFromNodesAndTerminals(mSystem.mSystemFrequency);
+	}
 
 	// Initialize signal components.
 	for (auto comp : mSimSignalComps)
@@ -156,13 +183,50 @@ void MnaSolver<Complex>::initializeComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mMNAComponents) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
+			addRightVectorStamp(comp);
 		}
 		for (auto comp : mSwitches)
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+		for (auto comp : mMNAIntfVariableComps) {
+			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+			addRightVectorStamp(comp);
+		}
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::addRightVectorStamp(const std::shared_ptr<CPS::MNAInterface>& comp) {
+	const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
+	if (stamp.size() == 0)
+		return;
+
+	mRightVectorStamps.push_back(&stamp);
+
+	// Components only stamp into the rows of the nodes they are connected to.
+	// If the nodes are unknown, the full vector has to be considered.
+	auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+	if (pComp) {
+		auto rows = pComp->rightVectorRows(static_cast<UInt>(stamp.rows()),
+			static_cast<UInt>(mSystem.mFrequencies.size()));
+		mRightVectorStampRows.insert(mRightVectorStampRows.end(), rows.begin(), rows.end());
+	}
+	else {
+		for (UInt row = 0; row < stamp.rows(); ++row)
+			mRightVectorStampRows.push_back(row);
+	}
+	mRightVectorStampRowOffsets.push_back(static_cast<UInt>(mRightVectorStampRows.size()));
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::assembleRightSideVector() {
+	mRightSideVector.setZero();
+
+	for (UInt stampIdx = 0; stampIdx < mRightVectorStamps.size(); ++stampIdx) {
+		const Matrix& stamp = *mRightVectorStamps[stampIdx];
+		for (UInt k = mRightVectorStampRowOffsets[stampIdx]; k < mRightVectorStampRowOffsets[stampIdx + 1]; ++k) {
+			UInt row = mRightVectorStampRows[k];
+			mRightSideVector(row, 0) += stamp(row, 0);
+		}
 	}
 }
 
@@ -208,20 +272,31 @@ void MnaSolver<VarType>::initializeSystemWithParallelFrequencies() {
 
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
-	// iterate over all possible switch state combinations
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		switchedMatrixEmpty(i);
-	}
-
-	if (mSwitches.size() < 1) {
-		switchedMatrixStamp(0, mMNAComponents);
+	if (mLazySwitchedMatrices && mSwitches.size() > 0) {
+		// Matrices might have been stamped with a different component
+		// behaviour during steady-state initialization
+		clearSwitchedMatrixCache();
+		prewarmSwitchedMatrices();
+		updateSwitchStatus();
+		mSwitchedMatrixCacheHits = 0;
+		mSwitchedMatrixCacheMisses = 0;
 	}
 	else {
-		// Generate switching state dependent system matrices
+		// iterate over all possible switch state combinations
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-			switchedMatrixStamp(i, mMNAComponents);
+			switchedMatrixEmpty(i);
+		}
+
+		if (mSwitches.size() < 1) {
+			switchedMatrixStamp(0, mMNAComponents);
+		}
+		else {
+			// Generate switching state dependent system matrices
+			for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+				switchedMatrixStamp(i, mMNAComponents);
+			}
+			updateSwitchStatus();
 		}
-		updateSwitchStatus();
 	}
 
 	// Initialize source vector for debugging
@@ -243,6 +318,93 @@ void MnaSolver<VarType>::updateSwitchStatus() {
 	for (UInt i = 0; i < mSwitches.size(); ++i) {
 		mCurrentSwitchStatus.set(i, mSwitches[i]->mnaIsClosed());
 	}
+
+	if (mLazySwitchedMatrices && (mSwitchedMatrixLru.empty() || mSwitchedMatrixLru.front() != mCurrentSwitchStatus))
+		requestSwitchedMatrix(mCurrentSwitchStatus);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::requestSwitchedMatrix(const std::bitset<SWITCH_NUM>& status) {
+	auto cached = mSwitchedMatrixLruPos.find(status);
+	if (cached != mSwitchedMatrixLruPos.end()) {
+		++mSwitchedMatrixCacheHits;
+		mSwitchedMatrixLru.splice(mSwitchedMatrixLru.begin(), mSwitchedMatrixLru, cached->second);
+		return;
+	}
+
+	++mSwitchedMatrixCacheMisses;
+	if (mSwitchedMatrixCacheSize > 0 && mSwitchedMatrixLru.size() >= mSwitchedMatrixCacheSize) {
+		auto evicted = mSwitchedMatrixLru.back();
+		mSLog->debug("Evicting system matrix for switch status {:s}", evicted.to_string());
+		switchedMatrixErase(evicted.to_ullong());
+		mSwitchedMatrixLruPos.erase(evicted);
+		mSwitchedMatrixLru.pop_back();
+	}
+
+	mSLog->debug("Factorizing system matrix for switch status {:s}", status.to_string());
+	switchedMatrixEmpty(status.to_ullong());
+	switchedMatrixStamp(status.to_ullong(), mMNAComponents);
+	mSwitchedMatrixLru.push_front(status);
+	mSwitchedMatrixLruPos[status] = mSwitchedMatrixLru.begin();
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::clearSwitchedMatrixCache() {
+	for (auto status : mSwitchedMatrixLru)
+		switchedMatrixErase(status.to_ullong());
+	mSwitchedMatrixLru.clear();
+	mSwitchedMatrixLruPos.clear();
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::prewarmSwitchedMatrices() {
+	if (mSwitchedMatrixPrewarmEvents.empty())
+		return;
+
+	// Map the switches addressed by the events to their index in the status bitset
+	std::vector<Base::Ph1::Switch*> switchesPh1;
+	std::vector<Base::Ph3::Switch*> switchesPh3;
+	for (auto sw : mSwitches) {
+		switchesPh1.push_back(dynamic_cast<Base::Ph1::Switch*>(sw.get()));
+		switchesPh3.push_back(dynamic_cast<Base::Ph3::Switch*>(sw.get()));
+	}
+
+	// Replay the events in time order starting from the initial switch
+	// status and collect the configurations that will become active
+	std::vector< std::bitset<SWITCH_NUM> > configurations;
+	std::bitset<SWITCH_NUM> status;
+	for (UInt i = 0; i < mSwitches.size(); ++i)
+		status.set(i, mSwitches[i]->mnaIsClosed());
+	configurations.push_back(status);
+
+	for (UInt e = 0; e < mSwitchedMatrixPrewarmEvents.size(); ++e) {
+		auto event = mSwitchedMatrixPrewarmEvents[e];
+		for (UInt i = 0; i < mSwitches.size(); ++i) {
+			auto swEvent = std::dynamic_pointer_cast<SwitchEvent>(event);
+			if (swEvent && switchesPh1[i] && swEvent->target().get() == switchesPh1[i])
+				status.set(i, swEvent->newState());
+
+			auto swEvent3Ph = std::dynamic_pointer_cast<SwitchEvent3Ph>(event);
+			if (swEvent3Ph && switchesPh3[i] && swEvent3Ph->target().get() == switchesPh3[i])
+				status.set(i, swEvent3Ph->newState());
+		}
+
+		// Events at the same time only result in a single configuration
+		Bool lastAtThisTime = e + 1 == mSwitchedMatrixPrewarmEvents.size()
+			|| mSwitchedMatrixPrewarmEvents[e + 1]->time() != event->time();
+		if (lastAtThisTime && std::find(configurations.begin(), configurations.end(), status) == configurations.end())
+			configurations.push_back(status);
+	}
+
+	// Factorize in reverse so that the earliest configurations end up
+	// most recently used, drop the latest ones if the cache is too small
+	if (mSwitchedMatrixCacheSize > 0 && configurations.size() > mSwitchedMatrixCacheSize)
+		configurations.resize(mSwitchedMatrixCacheSize);
+	for (auto it = configurations.rbegin(); it != configurations.rend(); ++it)
+		requestSwitchedMatrix(*it);
+
+	mSLog->info("Pre-warmed {:d} switch configurations from {:d} events",
+		configurations.size(), mSwitchedMatrixPrewarmEvents.size());
 }
 
 template <typename VarType>
@@ -282,10 +444,149 @@ void MnaSolver<VarType>::identifyTopologyObjects() {
 	}
 }
 
+template <typename VarType>
+std::vector<UInt> MnaSolver<VarType>::orderMatrixNodes() {
+	UInt numNodes = static_cast<UInt>(mNodes.size());
+	std::unordered_map<SimNode<VarType>*, UInt> nodeIdx;
+	for (UInt idx = 0; idx < numNodes; ++idx)
+		nodeIdx[mNodes[idx].get()] = idx;
+
+	// A component can couple all of its terminal and virtual nodes
+	std::vector<std::vector<UInt>> adjacency(numNodes);
+	for (auto comp : mSystem.mComponents) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)	continue;
+
+		std::vector<UInt> compNodes;
+		auto addNode = [&](const typename SimNode<VarType>::Ptr& node) {
+			auto it = node ? nodeIdx.find(node.get()) : nodeIdx.end();
+			if (it != nodeIdx.end())
+				compNodes.push_back(it->second);
+		};
+		for (auto terminal : pComp->terminals())
+			addNode(terminal->node());
+		for (auto node : pComp->virtualNodes())
+			addNode(node);
+		for (auto pSubComp : pComp->subComponents()) {
+			for (auto node : pSubComp->virtualNodes())
+				addNode(node);
+		}
+
+		for (auto node1 : compNodes) {
+			for (auto node2 : compNodes) {
+				if (node1 != node2)
+					adjacency[node1].push_back(node2);
+			}
+		}
+	}
+	for (auto& neighbours : adjacency) {
+		std::sort(neighbours.begin(), neighbours.end());
+		neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+	}
+
+	std::vector<UInt> order(numNodes);
+	std::iota(order.begin(), order.end(), 0);
+
+	if (mNodeOrdering == MnaNodeOrdering::RCM) {
+		// Breadth-first search from a peripheral node of each connected
+		// component, visiting the neighbours by increasing degree
+		auto byDegree = [&](UInt a, UInt b) { return adjacency[a].size() < adjacency[b].size(); };
+		std::vector<UInt> roots = order;
+		std::stable_sort(roots.begin(), roots.end(), byDegree);
+
+		order.clear();
+		std::vector<Bool> visited(numNodes, false);
+		std::vector<Int> level(numNodes, -1);
+		for (auto root : roots) {
+			if (visited[root])
+				continue;
+
+			// Lowest degree node on the last level of a search from the root
+			std::vector<UInt> component = { root };
+			level[root] = 0;
+			for (UInt pos = 0; pos < component.size(); ++pos) {
+				for (auto neighbour : adjacency[component[pos]]) {
+					if (level[neighbour] < 0) {
+						level[neighbour] = level[component[pos]] + 1;
+						component.push_back(neighbour);
+					}
+				}
+			}
+			UInt start = component.back();
+			for (auto node : component) {
+				if (level[node] == level[component.back()] && adjacency[node].size() < adjacency[start].size())
+					start = node;
+			}
+
+			UInt first = static_cast<UInt>(order.size());
+			order.push_back(start);
+			visited[start] = true;
+			for (UInt pos = first; pos < order.size(); ++pos) {
+				std::vector<UInt> next;
+				for (auto neighbour : adjacency[order[pos]]) {
+					if (!visited[neighbour]) {
+						visited[neighbour] = true;
+						next.push_back(neighbour);
+					}
+				}
+				std::stable_sort(next.begin(), next.end(), byDegree);
+				order.insert(order.end(), next.begin(), next.end());
+			}
+		}
+		std::reverse(order.begin(), order.end());
+	}
+	else if (mNodeOrdering == MnaNodeOrdering::AMD || mNodeOrdering == MnaNodeOrdering::COLAMD) {
+		std::vector<Eigen::Triplet<Real>> triplets;
+		for (UInt idx = 0; idx < numNodes; ++idx) {
+			triplets.push_back(Eigen::Triplet<Real>(idx, idx, 1));
+			for (auto neighbour : adjacency[idx])
+				triplets.push_back(Eigen::Triplet<Real>(neighbour, idx, 1));
+		}
+		Eigen::SparseMatrix<Real, Eigen::ColMajor, int> pattern(numNodes, numNodes);
+		pattern.setFromTriplets(triplets.begin(), triplets.end());
+		pattern.makeCompressed();
+
+		Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> perm;
+		if (mNodeOrdering == MnaNodeOrdering::AMD)
+			Eigen::AMDOrdering<int>()(pattern, perm);
+		else
+			Eigen::COLAMDOrdering<int>()(pattern, perm);
+
+		// AMD yields the node at each position, COLAMD the position of each node
+		for (UInt idx = 0; idx < numNodes; ++idx) {
+			if (mNodeOrdering == MnaNodeOrdering::AMD)
+				order[idx] = perm.indices()[idx];
+			else
+				order[perm.indices()[idx]] = idx;
+		}
+	}
+
+	// Bandwidth of the node coupling with and without the ordering
+	std::vector<UInt> position(numNodes);
+	for (UInt pos = 0; pos < numNodes; ++pos)
+		position[order[pos]] = pos;
+	Int naturalBandwidth = 0;
+	mNodeBandwidth = 0;
+	for (UInt idx = 0; idx < numNodes; ++idx) {
+		for (auto neighbour : adjacency[idx]) {
+			naturalBandwidth = std::max(naturalBandwidth, static_cast<Int>(neighbour) - static_cast<Int>(idx));
+			mNodeBandwidth = std::max(mNodeBandwidth, static_cast<Int>(position[neighbour]) - static_cast<Int>(position[idx]));
+		}
+	}
+	mSLog->info("Node bandwidth {:d} with ordering {:d} (natural order {:d})",
+		mNodeBandwidth, static_cast<Int>(mNodeOrdering), naturalBandwidth);
+
+	return order;
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::assignMatrixNodeIndices() {
+	std::vector<UInt> order = orderMatrixNodes();
+
 	UInt matrixNodeIndexIdx = 0;
-	for (UInt idx = 0; idx < mNodes.size(); ++idx) {
+	mNumNetMatrixNodeIndices = 0;
+	for (auto idx : order) {
+		UInt first = matrixNodeIndexIdx;
 		mNodes[idx]->setMatrixNodeIndex(0, matrixNodeIndexIdx);
 		mSLog->info("Assigned index {} to phase A of node {}", matrixNodeIndexIdx, idx);
 		++matrixNodeIndexIdx;
@@ -297,7 +598,7 @@ void MnaSolver<VarType>::assignMatrixNodeIndices() {
 			mSLog->info("Assigned index {} to phase B of node {}", matrixNodeIndexIdx, idx);
 			++matrixNodeIndexIdx;
 		}
-		if (idx == mNumNetNodes-1) mNumNetMatrixNodeIndices = matrixNodeIndexIdx;
+		if (idx < mNumNetNodes) mNumNetMatrixNodeIndices += matrixNodeIndexIdx - first;
 	}
 	// Total number of network nodes is matrixNodeIndexIdx + 1
 	mNumMatrixNodeIndices = matrixNodeIndexIdx;
@@ -310,6 +611,16 @@ void MnaSolver<VarType>::assignMatrixNodeIndices() {
 	mSLog->info("Number of harmonic simulation nodes: {:d}", mNumHarmMatrixNodeIndices);
 }
 
+template<>
+Bool MnaSolver<Real>::useComplexNativeSystem() const {
+	return false;
+}
+
+template<>
+Bool MnaSolver<Complex>::useComplexNativeSystem() const {
+	return mComplexNativeSystem && !mFrequencyParallel && mNumHarmMatrixNodeIndices == 0;
+}
+
 template<>
 void MnaSolver<Real>::createEmptyVectors() {
 	mRightSideVector = Matrix::Zero(mNumMatrixNodeIndices, 1);
@@ -328,6 +639,17 @@ void MnaSolver<Complex>::createEmptyVectors() {
 		mRightSideVector = Matrix::Zero(2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 1);
 		mLeftSideVector = Matrix::Zero(2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 1);
 	}
+	if (useComplexNativeSystem()) {
+		mComplexRightSideVector = MatrixComp::Zero(mNumMatrixNodeIndices, 1);
+		mComplexLeftSideVector = MatrixComp::Zero(mNumMatrixNodeIndices, 1);
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::rejectComplexNativeSystem() {
+	mSLog->warn("System matrix is not the expansion of a complex matrix, "
+		"factorize the real system matrices instead");
+	mComplexNativeSystem = false;
 }
 
 template <typename VarType>
@@ -369,9 +691,32 @@ void MnaSolver<VarType>::collectVirtualNodes() {
 	mSLog->info("Number of network and virtual nodes: {:d}", mNumNodes);
 }
 
+template <typename VarType>
+std::uint64_t MnaSolver<VarType>::collectStateLocations(std::vector<Real*>& locations) {
+	std::stringstream structure;
+	std::vector<Real> values;
+	CheckpointVectorWriter writer(structure, values);
+	for (auto node : mSystem.mNodes)
+		writer.writeObject(*node);
+	for (auto comp : mSystem.mComponents)
+		writer.writeObject(*comp);
+	writer.write(mLeftSideVector);
+
+	// Reading the same values back leaves the states unchanged
+	locations.clear();
+	CheckpointVectorReader reader(structure, values, &locations);
+	for (auto node : mSystem.mNodes)
+		reader.readObject(*node);
+	for (auto comp : mSystem.mComponents)
+		reader.readObject(*comp);
+	reader.read(mLeftSideVector);
+	return writer.hash();
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::steadyStateInitialization() {
 	mSLog->info("--- Run steady-state initialization ---");
+	auto start = std::chrono::steady_clock::now();
 
 	DataLogger initLeftVectorLog(mName + "_InitLeftVector", mLogLevel != CPS::Logger::Level::off);
 	DataLogger initRightVectorLog(mName + "_InitRightVector", mLogLevel != CPS::Logger::Level::off);
@@ -386,8 +731,7 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	Real time = 0;
 	Real maxDiff = 1.0;
 	Real max = 1.0;
-	Matrix diff = Matrix::Zero(2 * mNumNodes, 1);
-	Matrix prevLeftSideVector = Matrix::Zero(2 * mNumNodes, 1);
+	Matrix prevLeftSideVector = Matrix::Zero(mLeftSideVector.rows(), 1);
 
 	mSLog->info("Time step is {:f}s for steady-state initialization", initTimeStep);
 
@@ -402,8 +746,10 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	initializeSystem();
 	logSystemMatrices();
 
-	// Use sequential scheduler
-	SequentialScheduler sched;
+	// Use the scheduler of the simulation if there is one
+	std::shared_ptr<Scheduler> sched = mSteadStIniScheduler;
+	if (!sched)
+		sched = std::make_shared<SequentialScheduler>();
 	CPS::Task::List tasks;
 	Scheduler::Edges inEdges, outEdges;
 
@@ -424,14 +770,35 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 	}
 	tasks.push_back(createSolveTask());
 
-	sched.resolveDeps(tasks, inEdges, outEdges);
-	sched.createSchedule(tasks, inEdges, outEdges);
+	sched->resolveDeps(tasks, inEdges, outEdges);
+	sched->createSchedule(tasks, inEdges, outEdges);
+
+	// In the phasor domains the steady state is a fixed point of the step,
+	// which is approached by combining the states of the previous steps.
+	// EMT states keep oscillating with the system frequency.
+	Bool accelerate = mSteadStIniAccelerationDepth > 0
+		&& mDomain != CPS::Domain::EMT && !mFrequencyParallel;
+	AndersonAcceleration acceleration(mSteadStIniAccelerationDepth);
+	std::vector<Real*> stateLocations;
+	std::uint64_t stateHash = 0;
+	Matrix state, image;
+	if (accelerate) {
+		stateHash = collectStateLocations(stateLocations);
+		state.resize(stateLocations.size(), 1);
+		image.resize(stateLocations.size(), 1);
+		for (std::size_t i = 0; i < stateLocations.size(); ++i)
+			state(i, 0) = *stateLocations[i];
+		acceleration.reset(static_cast<UInt>(stateLocations.size()));
+	}
 
 	while (time < mSteadStIniTimeLimit) {
 		// Reset source vector
 		mRightSideVector.setZero();
+		// The solution of the current iterate, which differs from the one
+		// of the previous step if the state was combined
+		prevLeftSideVector = mLeftSideVector;
 
-		sched.step(time, timeStepCount);
+		sched->step(time, timeStepCount);
 
 		if (mDomain == CPS::Domain::EMT) {
 			initLeftVectorLog.logEMTNodeValues(time, leftSideVector());
@@ -447,16 +814,41 @@ void MnaSolver<VarType>::steadyStateInitialization() {
 		++timeStepCount;
 
 		// Calculate difference
-		diff = prevLeftSideVector - mLeftSideVector;
-		prevLeftSideVector = mLeftSideVector;
-		maxDiff = diff.lpNorm<Eigen::Infinity>();
+		maxDiff = (prevLeftSideVector - mLeftSideVector).lpNorm<Eigen::Infinity>();
 		max = mLeftSideVector.lpNorm<Eigen::Infinity>();
 		// If difference is smaller than some epsilon, break
 		if ((maxDiff / max) < mSteadStIniAccLimit)
 			break;
+
+		if (accelerate && timeStepCount == 1) {
+			// Integer states like indices of delay buffers cannot be combined
+			std::vector<Real*> locations;
+			if (collectStateLocations(locations) != stateHash || locations != stateLocations) {
+				mSLog->info("Disabled acceleration because of changing integer states");
+				accelerate = false;
+			}
+		}
+		if (accelerate) {
+			for (std::size_t i = 0; i < stateLocations.size(); ++i)
+				image(i, 0) = *stateLocations[i];
+			acceleration.next(state, image, state);
+			for (std::size_t i = 0; i < stateLocations.size(); ++i)
+				*stateLocations[i] = state(i, 0);
+		}
+	}
+
+	if (mSteadStIniScheduler) {
+		// The initialization tasks are freed after this, and their times
+		// do not belong into the measurement file of the simulation
+		sched->clearMeasurements();
+		sched->stop();
 	}
 
+	mSteadStIniSteps = timeStepCount;
+	mSteadStIniWallTime = std::chrono::duration<Real>(std::chrono::steady_clock::now() - start).count();
 	mSLog->info("Max difference: {:f} or {:f}% at time {:f}", maxDiff, maxDiff / max, time);
+	mSLog->info("Steady-state initialization took {:d} steps ({:d} restarts of the acceleration) and {:f}s",
+		mSteadStIniSteps, acceleration.restarts(), mSteadStIniWallTime);
 
 	// Reset system for actual simulation
 	mRightSideVector.setZero();
@@ -499,6 +891,31 @@ Task::List MnaSolver<VarType>::getTasks() {
 }
 
 
+template <typename VarType>
+void MnaSolver<VarType>::writeCheckpoint(CPS::CheckpointWriter& writer) {
+	writer.write(mLeftSideVector);
+	writer.write(mRightSideVector);
+	writer.write(mLeftSideVectorHarm);
+	writer.write(mRightSideVectorHarm);
+	writer.write(mCurrentSwitchStatus.to_string());
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::readCheckpoint(CPS::CheckpointReader& reader, Real time) {
+	// The vectors keep their memory, which the components refer to
+	reader.read(mLeftSideVector);
+	reader.read(mRightSideVector);
+	reader.read(mLeftSideVectorHarm);
+	reader.read(mRightSideVectorHarm);
+	mCurrentSwitchStatus = std::bitset<SWITCH_NUM>(reader.read<String>());
+
+	// The switches are restored with the components, the status only
+	// has to match them
+	if (!mFrequencyParallel)
+		updateSwitchStatus();
+	mSLog->info("Restored checkpoint at {:f} with switch status {:s}", time, mCurrentSwitchStatus.to_string());
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::log(Real time, Int timeStepCount) {
 	if (mLogLevel == Logger::Level::off)
@@ -0,0 +1,319 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <deque>
+#include <unordered_set>
+
+#include <dpsim/MNASolverBatched.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace DPsim {
+
+template <typename VarType>
+MnaSolverBatched<VarType>::MnaSolverBatched(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :
+	MnaSolverEigenSparse<VarType>(name, domain, logLevel) {
+	this->template addAttribute<Matrix>("right_vector", &mRightSideVector, Flags::read);
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::addScenario(const SystemTopology& system) {
+	auto scenario = std::make_shared<MnaSolverBatched<VarType>>(
+		this->mName + "_Scenario" + std::to_string(numScenarios()), this->mDomain, this->mLogLevel);
+	scenario->mIsScenario = true;
+	scenario->setSystem(system);
+	mScenarios.push_back(scenario);
+}
+
+template <typename VarType>
+MnaSolver<VarType>& MnaSolverBatched<VarType>::scenario(UInt index) {
+	if (index >= numScenarios())
+		throw SystemError("Scenario index out of range.");
+	if (index == 0)
+		return *this;
+	return *mScenarios[index - 1];
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::setAsyncLogging(UInt capacity, DataLogger::OverflowPolicy policy) {
+	MnaSolverEigenSparse<VarType>::setAsyncLogging(capacity, policy);
+	for (auto scenario : mScenarios)
+		scenario->setAsyncLogging(capacity, policy);
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::writeCheckpoint(CPS::CheckpointWriter& writer) {
+	MnaSolverEigenSparse<VarType>::writeCheckpoint(writer);
+	for (auto scenario : mScenarios)
+		scenario->writeCheckpoint(writer);
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::readCheckpoint(CPS::CheckpointReader& reader, Real time) {
+	MnaSolverEigenSparse<VarType>::readCheckpoint(reader, time);
+	for (auto scenario : mScenarios)
+		scenario->readCheckpoint(reader, time);
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) {
+	if (!mIsScenario) {
+		MnaSolverEigenSparse<VarType>::switchedMatrixStamp(index, comp);
+		return;
+	}
+
+	auto& sys = mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)];
+	for (auto comp : comp)
+		comp->mnaApplySystemMatrixStamp(sys);
+	sys.makeCompressed();
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::initialize() {
+	if (mIsScenario) {
+		MnaSolverEigenSparse<VarType>::initialize();
+		return;
+	}
+
+	// All scenarios share one factorization, so their matrices must not change
+	if (mFrequencyParallel)
+		throw SystemError("Batched scenarios do not support frequency parallelization.");
+	if (mSteadyStateInit)
+		throw SystemError("Batched scenarios do not support steady-state initialization.");
+
+	MnaSolverEigenSparse<VarType>::initialize();
+
+	for (UInt k = 0; k < numScenarios(); ++k) {
+		MnaSolverBatched<VarType>& scenario = k == 0 ? *this : *mScenarios[k - 1];
+		if (k > 0) {
+			scenario.setTimeStep(this->mTimeStep);
+			scenario.setNodeOrdering(this->mNodeOrdering);
+			scenario.doInitFromNodesAndTerminals(this->mInitFromNodesAndTerminals);
+			scenario.initialize();
+		}
+		if (scenario.mSwitches.size() > 0 || scenario.mMNAIntfVariableComps.size() > 0)
+			throw SystemError("Batched scenarios do not support switches or variable components.");
+	}
+
+	// Every scenario has to lead to the same system matrix as the first one
+	const SparseMatrix& sys = mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	Real scale = sys.nonZeros() > 0 ? sys.coeffs().cwiseAbs().maxCoeff() : 1;
+	for (UInt k = 1; k < numScenarios(); ++k) {
+		auto& scenarioSys = mScenarios[k - 1]->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+		if (scenarioSys.rows() != sys.rows())
+			throw SystemError("Scenario " + std::to_string(k) + " has a different number of matrix nodes.");
+		SparseMatrix diff = scenarioSys - sys;
+		if (diff.nonZeros() > 0 && diff.coeffs().cwiseAbs().maxCoeff() > 1e-12 * scale)
+			throw SystemError("Scenario " + std::to_string(k) + " has a different system matrix.");
+		// The matrix is only needed for the comparison
+		mScenarios[k - 1]->mSwitchedMatrices.clear();
+	}
+
+	mRightSideVectors = MatrixRow::Zero(mRightSideVector.rows(), numScenarios());
+	mLeftSideVectors = MatrixRow::Zero(mLeftSideVector.rows(), numScenarios());
+	mSLog->info("Batched {:d} scenarios with {:d} matrix rows", numScenarios(), mLeftSideVector.rows());
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::appendComponentTasks(Task::List& tasks) {
+	for (auto comp : this->mMNAComponents) {
+		for (auto task : comp->mnaTasks())
+			tasks.push_back(task);
+	}
+	for (auto node : mNodes) {
+		for (auto task : node->mnaTasks())
+			tasks.push_back(task);
+	}
+	for (auto comp : this->mSimSignalComps) {
+		for (auto task : comp->getTasks())
+			tasks.push_back(task);
+	}
+}
+
+/// Sorts tasks such that every task follows the tasks whose attributes it
+/// depends on in the same step
+static void sortTasks(Task::List& tasks) {
+	std::unordered_map<AttributeBase::Ptr, std::vector<UInt>> writers;
+	for (UInt t = 0; t < tasks.size(); ++t) {
+		for (auto attr : tasks[t]->getModifiedAttributes())
+			writers[attr].push_back(t);
+	}
+
+	std::vector<std::vector<UInt>> successors(tasks.size());
+	std::vector<UInt> inDegree(tasks.size(), 0);
+	for (UInt t = 0; t < tasks.size(); ++t) {
+		for (auto attr : tasks[t]->getAttributeDependencies()) {
+			auto writer = writers.find(AttributeBase::getRefAttribute(attr));
+			if (writer == writers.end())
+				continue;
+			for (auto from : writer->second) {
+				if (from == t)
+					continue;
+				successors[from].push_back(t);
+				++inDegree[t];
+			}
+		}
+	}
+
+	std::deque<UInt> ready;
+	for (UInt t = 0; t < tasks.size(); ++t) {
+		if (inDegree[t] == 0)
+			ready.push_back(t);
+	}
+	Task::List sorted;
+	while (!ready.empty()) {
+		UInt t = ready.front();
+		ready.pop_front();
+		sorted.push_back(tasks[t]);
+		for (auto to : successors[t]) {
+			if (--inDegree[to] == 0)
+				ready.push_back(to);
+		}
+	}
+	if (sorted.size() != tasks.size())
+		throw SystemError("Cyclic dependency in the component tasks of a scenario.");
+	tasks.swap(sorted);
+}
+
+template <typename VarType>
+std::vector<AttributeBase::Ptr> MnaSolverBatched<VarType>::solvedAttributes() {
+	std::vector<AttributeBase::Ptr> attrs;
+	attrs.push_back(this->attribute("left_vector"));
+	for (auto node : mNodes)
+		attrs.push_back(node->attribute("v"));
+	return attrs;
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::partitionComponentTasks() {
+	Task::List tasks;
+	appendComponentTasks(tasks);
+
+	// Tasks that depend on the solution of the step, directly or through
+	// other tasks, run after the solve
+	auto solvedAttrs = solvedAttributes();
+	std::unordered_set<AttributeBase::Ptr> solved(solvedAttrs.begin(), solvedAttrs.end());
+
+	std::vector<Bool> post(tasks.size(), false);
+	Bool changed = true;
+	while (changed) {
+		changed = false;
+		for (UInt t = 0; t < tasks.size(); ++t) {
+			if (post[t])
+				continue;
+			for (auto attr : tasks[t]->getAttributeDependencies()) {
+				if (solved.count(AttributeBase::getRefAttribute(attr))) {
+					post[t] = true;
+					break;
+				}
+			}
+			if (post[t]) {
+				for (auto attr : tasks[t]->getModifiedAttributes())
+					solved.insert(attr);
+				changed = true;
+			}
+		}
+	}
+
+	mPreSolveTasks.clear();
+	mPostSolveTasks.clear();
+	for (UInt t = 0; t < tasks.size(); ++t)
+		(post[t] ? mPostSolveTasks : mPreSolveTasks).push_back(tasks[t]);
+	sortTasks(mPreSolveTasks);
+	sortTasks(mPostSolveTasks);
+}
+
+template <typename VarType>
+MnaSolverBatched<VarType>::ScenarioTask::ScenarioTask(MnaSolverBatched<VarType>& solver, UInt index, Bool postSolve) :
+	Task(solver.batchedScenario(index).mName + (postSolve ? ".PostSolve" : ".PreSolve")),
+	mSolver(solver), mIndex(index), mPostSolve(postSolve) {
+	auto& scenario = solver.batchedScenario(index);
+	const Task::List& tasks = postSolve ? scenario.mPostSolveTasks : scenario.mPreSolveTasks;
+
+	// Attributes written within the group are no dependencies. The node
+	// voltages are updated from the solution before the tasks after the solve.
+	std::unordered_set<AttributeBase::Ptr> modified, dependencies, prevStepDependencies;
+	if (postSolve) {
+		for (auto node : scenario.mNodes)
+			modified.insert(node->attribute("v"));
+		dependencies.insert(scenario.attribute("left_vector"));
+		mAttributeDependencies.push_back(scenario.attribute("left_vector"));
+	}
+	else
+		modified.insert(scenario.attribute("right_vector"));
+	for (auto task : tasks) {
+		for (auto attr : task->getModifiedAttributes())
+			modified.insert(attr);
+	}
+	mModifiedAttributes.assign(modified.begin(), modified.end());
+
+	for (auto task : tasks) {
+		for (auto attr : task->getAttributeDependencies()) {
+			if (!modified.count(AttributeBase::getRefAttribute(attr)) && dependencies.insert(attr).second)
+				mAttributeDependencies.push_back(attr);
+		}
+		for (auto attr : task->getPrevStepDependencies()) {
+			if (prevStepDependencies.insert(attr).second)
+				mPrevStepDependencies.push_back(attr);
+		}
+	}
+}
+
+template <typename VarType>
+Task::List MnaSolverBatched<VarType>::getTasks() {
+	Task::List tasks;
+	for (UInt k = 0; k < numScenarios(); ++k) {
+		batchedScenario(k).partitionComponentTasks();
+		tasks.push_back(std::make_shared<ScenarioTask>(*this, k, false));
+		tasks.push_back(std::make_shared<ScenarioTask>(*this, k, true));
+	}
+	tasks.push_back(std::make_shared<SolveTask>(*this));
+	tasks.push_back(std::make_shared<LogTask>(*this));
+	return tasks;
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::preSolveScenario(UInt index, Real time, Int timeStepCount) {
+	auto& scenario = batchedScenario(index);
+	for (auto& task : scenario.mPreSolveTasks)
+		task->execute(time, timeStepCount);
+	scenario.assembleRightSideVector();
+	mRightSideVectors.col(index) = scenario.mRightSideVector;
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::postSolveScenario(UInt index, Real time, Int timeStepCount) {
+	auto& scenario = batchedScenario(index);
+	for (UInt nodeIdx = 0; nodeIdx < scenario.mNumNetNodes; ++nodeIdx)
+		scenario.mNodes[nodeIdx]->mnaUpdateVoltage(scenario.mLeftSideVector);
+	for (auto& task : scenario.mPostSolveTasks)
+		task->execute(time, timeStepCount);
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::solve(Real time, Int timeStepCount) {
+	// The factorization is read once for all scenarios
+	this->solveSwitchedMatrix(mCurrentSwitchStatus, mRightSideVectors, mLeftSideVectors);
+
+	// The components of a scenario read its own left vector
+	for (UInt k = 0; k < numScenarios(); ++k)
+		batchedScenario(k).mLeftSideVector = mLeftSideVectors.col(k);
+}
+
+template <typename VarType>
+void MnaSolverBatched<VarType>::log(Real time, Int timeStepCount) {
+	MnaSolverEigenSparse<VarType>::log(time, timeStepCount);
+	for (auto scenario : mScenarios)
+		scenario->MnaSolverEigenSparse<VarType>::log(time, timeStepCount);
+}
+
+}
+
+template class DPsim::MnaSolverBatched<Real>;
+template class DPsim::MnaSolverBatched<Complex>;
@@ -24,7 +24,19 @@ MnaSolverEigenDense<VarType>::MnaSolverEigenDense(String name, CPS::Domain domai
 template <typename VarType>
 void MnaSolverEigenDense<VarType>::switchedMatrixEmpty(std::size_t index)
 {
-	mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)].setZero();
+	// The matrix is allocated when it is stamped, because it is not kept
+	// if it is factorized as a complex matrix
+	auto& sys = mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)];
+	if (sys.size() != 0)
+		sys.setZero();
+}
+
+template <typename VarType>
+void MnaSolverEigenDense<VarType>::switchedMatrixErase(std::size_t index)
+{
+	mSwitchedMatrices.erase(std::bitset<SWITCH_NUM>(index));
+	mLuFactorizations.erase(std::bitset<SWITCH_NUM>(index));
+	mComplexLuFactorizations.erase(std::bitset<SWITCH_NUM>(index));
 }
 
 template <typename VarType>
@@ -32,13 +44,37 @@ void MnaSolverEigenDense<VarType>::switchedMatrixStamp(std::size_t index, std::v
 {
 	auto bit = std::bitset<SWITCH_NUM>(index);
 	auto& sys = mSwitchedMatrices[bit];
+	// Components stamp into a sparse matrix, which is converted to the
+	// dense system matrix in a single pass
+	SparseMatrix sparseSys(mSystemSize, mSystemSize);
 	for (auto comp : comp) {
-		comp->mnaApplySystemMatrixStamp(sys);
+		comp->mnaApplySystemMatrixStamp(sparseSys);
 	}
 	for (UInt i = 0; i < mSwitches.size(); ++i)
-		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sys, bit[i]);
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sparseSys, bit[i]);
+
+	// The complex matrix has half the size of its real expansion, so its
+	// LU factorization needs half the memory. Neither the real matrix nor
+	// its factorization is kept then.
+	if (this->useComplexNativeSystem()) {
+		SparseMatrixCompRow complexSys;
+		sparseSys.makeCompressed();
+		if (Math::complexFromRealExpansion(sparseSys, complexSys)) {
+			mComplexLuFactorizations[bit] = LUFactorizedComp(MatrixComp(complexSys));
+			mLuFactorizations.erase(bit);
+			sys.resize(0, 0);
+			return;
+		}
+		this->rejectComplexNativeSystem();
+	}
+	if (sys.size() == 0)
+		sys = Matrix(sparseSys);
+	else
+		sys += Matrix(sparseSys);
+
 	// Compute LU-factorization for system matrix
 	mLuFactorizations[bit] = Eigen::PartialPivLU<Matrix>(sys);
+	mComplexLuFactorizations.erase(bit);
 }
 
 template <>
@@ -46,10 +82,13 @@ void MnaSolverEigenDense<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
-		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)] = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	// Matrices of lazily stamped switch configurations are created on first use
+	if (!mLazySwitchedMatrices) {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)] = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	}
 
-	mBaseSystemMatrix = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	mSystemSize = mNumMatrixNodeIndices;
 }
 
 template <>
@@ -65,12 +104,13 @@ void MnaSolverEigenDense<Complex>::createEmptySystemMatrix() {
 			}
 		}
 	}
-	else {
+	// Real matrices are not preallocated if they are factorized as complex matrices
+	else if (!mLazySwitchedMatrices && !this->useComplexNativeSystem()) {
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
 			mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)] = Matrix::Zero(2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices));
 		}
 	}
-	mBaseSystemMatrix = Matrix::Zero(2 * (mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 2 * (mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices));
+	mSystemSize = 2 * (mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices);
 }
 
 template <typename VarType>
@@ -93,20 +133,31 @@ std::shared_ptr<CPS::Task> MnaSolverEigenDense<VarType>::createLogTask()
 
 template <typename VarType>
 void MnaSolverEigenDense<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
-
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
-
-	if (mSwitchedMatrices.size() > 0)
-		mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus].solve(mRightSideVector);
+	MnaSolver<VarType>::assembleRightSideVector();
+
+	Bool complexSolution = false;
+	if (mSwitchedMatrices.size() > 0) {
+		auto complexLu = mComplexLuFactorizations.find(mCurrentSwitchStatus);
+		if (complexLu != mComplexLuFactorizations.end()) {
+			// The components read the real expansion of the solution
+			Math::complexFromRealExpansion(mRightSideVector, mComplexRightSideVector);
+			mComplexLeftSideVector = complexLu->second.solve(mComplexRightSideVector);
+			Math::realExpansionFromComplex(mComplexLeftSideVector, mLeftSideVector);
+			complexSolution = true;
+		}
+		else
+			mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus].solve(mRightSideVector);
+	}
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx) {
+		if (complexSolution)
+			mNodes[nodeIdx]->mnaUpdateVoltage(mComplexLeftSideVector);
+		else
+			mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+	}
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
@@ -141,7 +192,10 @@ void MnaSolverEigenDense<VarType>::logSystemMatrices() {
 
 	}
 	else {
-		if (mSwitches.size() < 1) {
+		if (mComplexLuFactorizations.size() > 0) {
+			mSLog->info("System matrices are factorized as complex matrices and not kept");
+		}
+		else if (mSwitches.size() < 1) {
 			mSLog->info("System matrix: \n{}", mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 			//mSLog->info("LU decomposition: \n{}",	mLuFactorizations[std::bitset<SWITCH_NUM>(0)].matrixLU());
 		}
@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <type_traits>
 
 #include <dpsim/MNASolverEigenSparse.h>
 #include <dpsim/SequentialScheduler.h>
@@ -13,18 +15,40 @@
 using namespace DPsim;
 using namespace CPS;
 
+// The supernodal forward substitution reads the factor L through the
+// member of Eigen's SparseLU return type, which is not part of the public
+// API. It is used only for the Eigen versions it was checked against.
+#if EIGEN_WORLD_VERSION == 3 && (EIGEN_MAJOR_VERSION == 3 || EIGEN_MAJOR_VERSION == 4)
+#define DPSIM_SPARSELU_SUPERNODAL_ACCESS
+#endif
+
 namespace DPsim {
 
 
 template <typename VarType>
 MnaSolverEigenSparse<VarType>::MnaSolverEigenSparse(String name, CPS::Domain domain, CPS::Logger::Level logLevel) :	MnaSolver<VarType>(name, domain, logLevel) {
+	this->template addAttribute<Int>("lu_nonzeros", &mFactorNonZeros, Flags::read);
 }
 
 
 template <typename VarType>
 void MnaSolverEigenSparse<VarType>::switchedMatrixEmpty(std::size_t index)
 {
-	mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)].setZero();
+	// Lazily created matrices are not preallocated
+	auto& sys = mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)];
+	if (sys.size() == 0)
+		sys.resize(mBaseSystemMatrix.rows(), mBaseSystemMatrix.cols());
+	else
+		sys.setZero();
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::switchedMatrixErase(std::size_t index)
+{
+	mSwitchedMatrices.erase(std::bitset<SWITCH_NUM>(index));
+	mLuFactorizations.erase(std::bitset<SWITCH_NUM>(index));
+	mCircuitLuFactorizations.erase(std::bitset<SWITCH_NUM>(index));
+	mComplexLuFactorizations.erase(std::bitset<SWITCH_NUM>(index));
 }
 
 template <typename VarType>
@@ -37,9 +61,127 @@ void MnaSolverEigenSparse<VarType>::switchedMatrixStamp(std::size_t index, std::
 	}
 	for (UInt i = 0; i < mSwitches.size(); ++i)
 		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(sys, bit[i]);
+	sys.makeCompressed();
 	// Compute LU-factorization for system matrix
-	mLuFactorizations[bit].analyzePattern(sys);
-	mLuFactorizations[bit].factorize(sys);
+	factorizeSwitchedMatrix(bit, true);
+	logFactorizationStatistics(bit, sys);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::factorizeSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, Bool analyzePattern) {
+	auto& sys = mSwitchedMatrices[status];
+	if (mCircuitLU) {
+		auto& lu = mCircuitLuFactorizations[status];
+		if (analyzePattern) {
+			lu.analyzePattern(sys);
+			lu.factorize(sys);
+		}
+		else if (!lu.refactorize(sys)) {
+			mSLog->debug("Pivot too small for refactorization, factorize with pivot search");
+			lu.factorize(sys);
+		}
+		return;
+	}
+
+	if (this->useComplexNativeSystem()) {
+		SparseMatrixCompRow complexSys;
+		if (Math::complexFromRealExpansion(sys, complexSys)) {
+			mComplexSystemMatrix = complexSys;
+			auto& lu = mComplexLuFactorizations[status];
+			if (analyzePattern)
+				lu.analyzePattern(mComplexSystemMatrix);
+			lu.factorize(mComplexSystemMatrix);
+			mLuFactorizations.erase(status);
+			return;
+		}
+		this->rejectComplexNativeSystem();
+	}
+
+	// The real factorization has not been analyzed if the complex one was used before
+	auto& lu = mLuFactorizations[status];
+	if (analyzePattern || mComplexLuFactorizations.erase(status) > 0)
+		lu.analyzePattern(sys);
+	lu.factorize(sys);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::solveSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, const Matrix& rhs, Matrix& x) {
+	if (mCircuitLU) {
+		mCircuitLuFactorizations[status].solve(rhs, x);
+		return;
+	}
+
+	auto complexLu = mComplexLuFactorizations.find(status);
+	if (complexLu != mComplexLuFactorizations.end()) {
+		// Keeps the allocation if the number of right sides does not change
+		mComplexRightSideVector.resize(rhs.rows() / 2, rhs.cols());
+		mComplexLeftSideVector.resize(rhs.rows() / 2, rhs.cols());
+		Math::complexFromRealExpansion(rhs, mComplexRightSideVector);
+		solveInPlace(complexLu->second, mComplexRightSideVector, mComplexLeftSideVector, mComplexSolveWorkspace);
+		Math::realExpansionFromComplex(mComplexLeftSideVector, x);
+	}
+	else
+		solveInPlace(mLuFactorizations[status], rhs, x, mSolveWorkspace);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::solveSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, const MatrixRow& rhs, MatrixRow& x) {
+	auto lu = mLuFactorizations.find(status);
+	if (lu != mLuFactorizations.end()) {
+		solveInPlace(lu->second, rhs, x, mSolveWorkspaceRows);
+		return;
+	}
+
+	// CircuitLU solves column by column and the complex system is solved
+	// after the conversion of the column-major real expansion
+	mRightSideColumns = rhs;
+	mLeftSideColumns.resize(rhs.rows(), rhs.cols());
+	solveSwitchedMatrix(status, mRightSideColumns, mLeftSideColumns);
+	x = mLeftSideColumns;
+}
+
+template <typename VarType>
+Matrix MnaSolverEigenSparse<VarType>::solveSwitchedMatrix(const std::bitset<SWITCH_NUM>& status, const Matrix& rhs) {
+	if (mCircuitLU)
+		return mCircuitLuFactorizations[status].solve(rhs);
+
+	auto complexLu = mComplexLuFactorizations.find(status);
+	if (complexLu != mComplexLuFactorizations.end()) {
+		MatrixComp complexRhs(rhs.rows() / 2, rhs.cols());
+		Math::complexFromRealExpansion(rhs, complexRhs);
+		MatrixComp complexX = complexLu->second.solve(complexRhs);
+		Matrix x(rhs.rows(), rhs.cols());
+		Math::realExpansionFromComplex(complexX, x);
+		return x;
+	}
+	return mLuFactorizations[status].solve(rhs);
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::logFactorizationStatistics(const std::bitset<SWITCH_NUM>& status,
+	const SparseMatrix& systemMatrix) {
+	Int bandwidth = 0;
+	for (Eigen::Index row = 0; row < systemMatrix.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(systemMatrix, row); it; ++it)
+			bandwidth = std::max(bandwidth, static_cast<Int>(std::abs(it.col() - row)));
+	}
+	// The diagonal is stored in both factors
+	if (mCircuitLU) {
+		auto& lu = mCircuitLuFactorizations[status];
+		mFactorNonZeros = lu.nnzL() + lu.nnzU() - static_cast<Int>(systemMatrix.rows());
+	}
+	else if (mComplexLuFactorizations.count(status) > 0) {
+		// Non-zeros of the complex factors, each stands for a 2x2 real block
+		auto& lu = mComplexLuFactorizations[status];
+		mFactorNonZeros = static_cast<Int>(lu.nnzL() + lu.nnzU() - mComplexSystemMatrix.rows());
+	}
+	else {
+		auto& lu = mLuFactorizations[status];
+		mFactorNonZeros = static_cast<Int>(lu.nnzL() + lu.nnzU() - systemMatrix.rows());
+	}
+	mSLog->info("Factorized system matrix for switch status {:s}: {:d} non-zeros, bandwidth {:d}, "
+		"{:d} non-zeros in L+U, fill-in {:d}", status.to_string(), systemMatrix.nonZeros(), bandwidth,
+		mFactorNonZeros, mFactorNonZeros - static_cast<Int>(systemMatrix.nonZeros()));
 }
 
 template <>
@@ -47,10 +189,14 @@ void MnaSolverEigenSparse<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
-		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	// Matrices of lazily stamped switch configurations are created on first use
+	if (!mLazySwitchedMatrices) {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	}
 
 	mBaseSystemMatrix.resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+	mSolveWorkspace = Matrix::Zero(mNumMatrixNodeIndices, 1);
 }
 
 template <>
@@ -66,12 +212,15 @@ void MnaSolverEigenSparse<Complex>::createEmptySystemMatrix() {
 			}
 		}
 	}
-	else {
+	else if (!mLazySwitchedMatrices) {
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
 			mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].resize(2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 2*(mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices));
 		}
 	}
 	mBaseSystemMatrix.resize(2 * (mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 2 * (mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices));
+	mSolveWorkspace = Matrix::Zero(2 * (mNumMatrixNodeIndices + mNumHarmMatrixNodeIndices), 1);
+	if (useComplexNativeSystem())
+		mComplexSolveWorkspace = MatrixComp::Zero(mNumMatrixNodeIndices, 1);
 }
 
 template <typename VarType>
@@ -93,21 +242,128 @@ std::shared_ptr<CPS::Task> MnaSolverEigenSparse<VarType>::createLogTask()
 }
 
 template <typename VarType>
-void MnaSolverEigenSparse<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
+template <typename Scalar, typename Dense>
+void MnaSolverEigenSparse<VarType>::solveInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>& lu,
+	const Dense& rhs, Dense& x, Dense& workspace) {
+	// Same steps as Eigen::SparseLU::solve, but the supernodal forward
+	// substitution and the final permutation use the preallocated workspace
+	// instead of allocating temporaries in every step. All columns of the
+	// right side are solved together.
+	x = lu.rowsPermutation() * rhs;
+	workspace.resize(x.rows(), x.cols());
+
+#ifdef DPSIM_SPARSELU_SUPERNODAL_ACCESS
+	// Forward substitution with the unit lower triangular supernodal factor L
+	const auto& L = lu.matrixL().m_mapL;
+	typedef typename std::decay<decltype(L)>::type SupernodalMatrix;
+	const Scalar* values = L.valuePtr();
+	for (Eigen::Index k = 0; k <= L.nsuper(); ++k) {
+		Eigen::Index fsupc = L.supToCol()[k];
+		Eigen::Index istart = L.rowIndexPtr()[fsupc];
+		Eigen::Index nsupr = L.rowIndexPtr()[fsupc + 1] - istart;
+		Eigen::Index nsupc = L.supToCol()[k + 1] - fsupc;
+		Eigen::Index nrow = nsupr - nsupc;
+
+		if (nsupc == 1) {
+			typename SupernodalMatrix::InnerIterator it(L, fsupc);
+			// Skip the diagonal element
+			++it;
+			for (; it; ++it)
+				x.row(it.row()) -= it.value() * x.row(fsupc);
+		}
+		else {
+			Eigen::Index luptr = L.colIndexPtr()[fsupc];
+			Eigen::Index lda = L.colIndexPtr()[fsupc + 1] - luptr;
+
+			Eigen::Map<const MatrixVar<Scalar>, 0, Eigen::OuterStride<>> diag(&values[luptr], nsupc, nsupc, Eigen::OuterStride<>(lda));
+			auto xBlock = x.middleRows(fsupc, nsupc);
+			diag.template triangularView<Eigen::UnitLower>().solveInPlace(xBlock);
+
+			Eigen::Map<const MatrixVar<Scalar>, 0, Eigen::OuterStride<>> offDiag(&values[luptr + nsupc], nrow, nsupc, Eigen::OuterStride<>(lda));
+			workspace.topRows(nrow).noalias() = offDiag * xBlock;
+
+			Eigen::Index iptr = istart + nsupc;
+			for (Eigen::Index i = 0; i < nrow; ++i, ++iptr)
+				x.row(L.rowIndex()[iptr]) -= workspace.row(i);
+		}
+	}
+#else
+	// Public API, which allocates a temporary in the forward substitution
+	lu.matrixL().solveInPlace(x);
+#endif
+
+	solveUpperInPlace(lu, x);
+
+	workspace = lu.colsPermutation().inverse() * x;
+	x = workspace;
+}
 
+template <typename VarType>
+template <typename Scalar>
+void MnaSolverEigenSparse<VarType>::solveUpperInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>& lu,
+	MatrixVar<Scalar>& x) {
+	// Backward substitution with U works in place
+	lu.matrixU().solveInPlace(x);
+}
+
+template <typename VarType>
+template <typename Scalar>
+void MnaSolverEigenSparse<VarType>::solveUpperInPlace(const Eigen::SparseLU<Eigen::SparseMatrix<Scalar>>& lu,
+	Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>& x) {
+#ifdef DPSIM_SPARSELU_SUPERNODAL_ACCESS
+	// Same steps as Eigen's backward substitution, but row by row. The
+	// diagonal blocks of the supernodes are stored with L, the other
+	// entries of U in a sparse matrix.
+	const auto& L = lu.matrixU().m_mapL;
+	const auto& U = lu.matrixU().m_mapU;
+	typedef typename std::decay<decltype(U)>::type UpperMatrix;
+	const Scalar* values = L.valuePtr();
+	for (Eigen::Index k = L.nsuper(); k >= 0; --k) {
+		Eigen::Index fsupc = L.supToCol()[k];
+		Eigen::Index nsupc = L.supToCol()[k + 1] - fsupc;
+		Eigen::Index luptr = L.colIndexPtr()[fsupc];
+		Eigen::Index lda = L.colIndexPtr()[fsupc + 1] - luptr;
+
+		if (nsupc == 1)
+			x.row(fsupc) /= values[luptr];
+		else {
+			Eigen::Map<const MatrixVar<Scalar>, 0, Eigen::OuterStride<>> diag(&values[luptr], nsupc, nsupc, Eigen::OuterStride<>(lda));
+			auto xBlock = x.middleRows(fsupc, nsupc);
+			diag.template triangularView<Eigen::Upper>().solveInPlace(xBlock);
+		}
+
+		for (Eigen::Index col = fsupc; col < fsupc + nsupc; ++col) {
+			for (typename UpperMatrix::InnerIterator it(U, col); it; ++it)
+				x.row(it.index()) -= it.value() * x.row(col);
+		}
+	}
+#else
+	MatrixVar<Scalar> columns = x;
+	lu.matrixU().solveInPlace(columns);
+	x = columns;
+#endif
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::solve(Real time, Int timeStepCount) {
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	MnaSolver<VarType>::assembleRightSideVector();
 
 	if (mSwitchedMatrices.size() > 0)
-		mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus].solve(mRightSideVector);
+		solveSwitchedMatrix(mCurrentSwitchStatus, mRightSideVector, mLeftSideVector);
+
+	// Nodes read the complex solution if the system is solved as a complex
+	// matrix, the components read its real expansion
+	Bool complexSolution = !mCircuitLU && mComplexLuFactorizations.count(mCurrentSwitchStatus) > 0;
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
-	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
-		mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx) {
+		if (complexSolution)
+			mNodes[nodeIdx]->mnaUpdateVoltage(mComplexLeftSideVector);
+		else
+			mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+	}
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
@@ -44,6 +44,9 @@ MnaSolverGpuDense<VarType>::~MnaSolverGpuDense() {
 
 template <typename VarType>
 void MnaSolverGpuDense<VarType>::initialize() {
+    // The device factorizes the real system matrix, which is not kept
+    // if it is factorized as a complex matrix
+    this->mComplexNativeSystem = false;
     MnaSolver<VarType>::initialize();
 
     mDeviceCopy.size = this->mRightSideVector.rows();
@@ -154,13 +157,9 @@ Task::List MnaSolverGpuDense<VarType>::getTasks() {
 
 template <typename VarType>
 void MnaSolverGpuDense<VarType>::solve(Real time, Int timeStepCount) {
-    // Reset source vector
-	this->mRightSideVector.setZero();
-
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->assembleRightSideVector();
 
     //Copy right vector to device
     CUDA_ERROR_HANDLER(cudaMemcpy(mDeviceCopy.vector, &this->mRightSideVector(0), mDeviceCopy.size * sizeof(Real), cudaMemcpyHostToDevice))
@@ -9,6 +9,8 @@
 
 #include <dpsim/MNASolverSysRecomp.h>
 
+#include <algorithm>
+
 using namespace DPsim;
 using namespace CPS;
 
@@ -17,7 +19,11 @@ namespace DPsim {
 template <typename VarType>
 MnaSolverSysRecomp<VarType>::MnaSolverSysRecomp(String name,
 	CPS::Domain domain, CPS::Logger::Level logLevel) :
-    MnaSolverEigenSparse<VarType>(name, domain, logLevel) { }
+    MnaSolverEigenSparse<VarType>(name, domain, logLevel) {
+	this->template addAttribute<Int>("recomp_analyses", &mNumSymbolicAnalyses, Flags::read);
+	this->template addAttribute<Int>("recomp_factorizations", &mNumFactorizations, Flags::read);
+	this->template addAttribute<Int>("recomp_lowrank_updates", &mNumLowRankUpdates, Flags::read);
+}
 
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::initializeSystem() {
@@ -40,6 +46,7 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 
 	// Save base matrix with only static elements
 	this->mSLog->info("Save base matrix");
+	this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].makeCompressed();
 	this->mBaseSystemMatrix = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
 
 	// Now stamp variable elements
@@ -47,8 +54,8 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 	for (auto varElem : this->mMNAIntfVariableComps) {
 		varElem->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
 	}
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].makeCompressed();
+	factorizeSystemMatrix(true);
 	// Initialize source vector for debugging
 	for (auto comp : this->mMNAComponents) {
 		comp->mnaApplyRightSideVectorStamp(this->mRightSideVector);
@@ -81,24 +88,130 @@ void MnaSolverSysRecomp<VarType>::updateSystemMatrix(Real time) {
 		this->mSLog->debug("Updating {:s} {:s} in system matrix (variabel component)",
 			idObj->type(), idObj->name());
 	}
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)].factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)]);
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+	sys.makeCompressed();
+
+	switch (mRecomputationMode) {
+	case MnaRecomputationMode::Full:
+		factorizeSystemMatrix(true);
+		break;
+	case MnaRecomputationMode::ReuseSymbolic:
+		factorizeSystemMatrix(false);
+		break;
+	case MnaRecomputationMode::LowRankUpdate:
+		if (!updateLowRank(sys))
+			factorizeSystemMatrix(false);
+		break;
+	}
 	mUpdateSysMatrix = false;
 }
 
+template <typename VarType>
+Bool MnaSolverSysRecomp<VarType>::patternChanged(const SparseMatrix& systemMatrix) {
+	if (mAnalyzedOuterIndices.size() != static_cast<std::size_t>(systemMatrix.outerSize() + 1)
+		|| mAnalyzedInnerIndices.size() != static_cast<std::size_t>(systemMatrix.nonZeros()))
+		return true;
+
+	return !std::equal(mAnalyzedOuterIndices.begin(), mAnalyzedOuterIndices.end(), systemMatrix.outerIndexPtr())
+		|| !std::equal(mAnalyzedInnerIndices.begin(), mAnalyzedInnerIndices.end(), systemMatrix.innerIndexPtr());
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::factorizeSystemMatrix(Bool analyzePattern) {
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)];
+
+	// The symbolic analysis only depends on the sparsity pattern, which
+	// does not change as long as all components stamp the same entries
+	analyzePattern = analyzePattern || patternChanged(sys);
+	this->factorizeSwitchedMatrix(std::bitset<SWITCH_NUM>(0), analyzePattern);
+	if (analyzePattern) {
+		mAnalyzedOuterIndices.assign(sys.outerIndexPtr(), sys.outerIndexPtr() + sys.outerSize() + 1);
+		mAnalyzedInnerIndices.assign(sys.innerIndexPtr(), sys.innerIndexPtr() + sys.nonZeros());
+		++mNumSymbolicAnalyses;
+		this->mSLog->debug("Analyzed pattern of system matrix with {:d} non-zeros", sys.nonZeros());
+	}
+	++mNumFactorizations;
+	if (mNumFactorizations == 1)
+		this->logFactorizationStatistics(std::bitset<SWITCH_NUM>(0), sys);
+
+	if (mRecomputationMode == MnaRecomputationMode::LowRankUpdate)
+		mFactorizedSystemMatrix = sys;
+	mLowRankActive = false;
+}
+
+template <typename VarType>
+Bool MnaSolverSysRecomp<VarType>::updateLowRank(const SparseMatrix& systemMatrix) {
+	// Change dA = A - A0 with respect to the factorized matrix
+	SparseMatrix delta = systemMatrix - mFactorizedSystemMatrix;
+	delta.prune([](const SparseMatrix::Index&, const SparseMatrix::Index&, const Real& value) {
+		return value != 0.;
+	});
+
+	std::vector<UInt> columns;
+	for (Int row = 0; row < delta.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(delta, row); it; ++it)
+			columns.push_back(static_cast<UInt>(it.col()));
+	}
+	std::sort(columns.begin(), columns.end());
+	columns.erase(std::unique(columns.begin(), columns.end()), columns.end());
+
+	if (columns.size() > mLowRankMaxRank) {
+		this->mSLog->debug("Change of rank {:d} exceeds low-rank limit, refactorize", columns.size());
+		return false;
+	}
+
+	mLowRankColumns = columns;
+	mLowRankActive = !columns.empty();
+	if (!mLowRankActive)
+		return true;
+
+	// dA = U * E_c^T, where U holds the non-zero columns of dA
+	std::unordered_map<UInt, Eigen::Index> position;
+	for (UInt i = 0; i < columns.size(); ++i)
+		position[columns[i]] = i;
+
+	Matrix U = Matrix::Zero(delta.rows(), columns.size());
+	for (Int row = 0; row < delta.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(delta, row); it; ++it)
+			U(row, position[static_cast<UInt>(it.col())]) = it.value();
+	}
+
+	// Sherman-Morrison-Woodbury: (A0 + U E_c^T)^-1 b = y - Z (I + E_c^T Z)^-1 E_c^T y
+	// with y = A0^-1 b and Z = A0^-1 U
+	mLowRankZ = this->solveSwitchedMatrix(std::bitset<SWITCH_NUM>(0), U);
+	Matrix capacitance = Matrix::Identity(columns.size(), columns.size());
+	for (UInt i = 0; i < columns.size(); ++i)
+		capacitance.row(i) += mLowRankZ.row(columns[i]);
+	mLowRankCapacitance.compute(capacitance);
+	mLowRankSelection = Matrix::Zero(columns.size(), 1);
+	mLowRankCoefficients = Matrix::Zero(columns.size(), 1);
+
+	++mNumLowRankUpdates;
+	this->mSLog->debug("Applied low-rank update of rank {:d}", columns.size());
+	return true;
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::applyLowRankCorrection() {
+	for (UInt i = 0; i < mLowRankColumns.size(); ++i)
+		mLowRankSelection(i, 0) = this->mLeftSideVector(mLowRankColumns[i], 0);
+	mLowRankCoefficients = mLowRankCapacitance.solve(mLowRankSelection);
+	this->mLeftSideVector.noalias() -= mLowRankZ * mLowRankCoefficients;
+}
+
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	this->mRightSideVector.setZero();
 	mUpdateSysMatrix = false;
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->assembleRightSideVector();
 
-	if (this->mSwitchedMatrices.size() > 0)
-		this->mLeftSideVector = this->mLuFactorizations[this->mCurrentSwitchStatus].solve(this->mRightSideVector);
+	if (this->mSwitchedMatrices.size() > 0) {
+		this->solveSwitchedMatrix(this->mCurrentSwitchStatus, this->mRightSideVector, this->mLeftSideVector);
+		if (mLowRankActive)
+			applyLowRankCorrection();
+	}
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
 	for (UInt nodeIdx = 0; nodeIdx < this->mNumNetNodes; ++nodeIdx)
@@ -113,6 +226,13 @@ void MnaSolverSysRecomp<VarType>::solve(Real time, Int timeStepCount) {
 	// Components' states will be updated by the post-step tasks
 }
 
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::readCheckpoint(CPS::CheckpointReader& reader, Real time) {
+	MnaSolverEigenSparse<VarType>::readCheckpoint(reader, time);
+	if (this->mMNAIntfVariableComps.size() > 0)
+		updateSystemMatrix(time);
+}
+
 template <typename VarType>
 Task::List MnaSolverSysRecomp<VarType>::getTasks() {
 	Task::List l;
@@ -6,54 +6,83 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
-#include <dpsim/ODEintSolver.h>
+#include <algorithm>
 
+#include <dpsim/ODEintSolver.h>
 
 using namespace DPsim;
 
-ODEintSolver::ODEintSolver(String name, CPS::ODEintInterface::Ptr comp, Real dt, Real t0) :
-        mComponent(comp), mTimestep(dt){
-        times.push_back(t0);
-        self = this; // sets static pointer to current object
-        ProbDim = comp->num_states();
-
-        curSolution.resize(ProbDim);
-
-        //register all system functions
-        system.push_back(
-                [comp](const double y[],  double ydot[],  const double t){
-                    comp->odeint(y, ydot, t);
-                });
-
+ODEintSolver::ODEintSolver(String name, Real timeStep, CPS::Logger::Level logLevel) :
+	Solver(name, logLevel) {
+	mTimeStep = timeStep;
+	mOffsets.push_back(0);
 }
 
+ODEintSolver::ODEintSolver(String name, CPS::ODEintInterface::Ptr comp, Real timeStep, CPS::Logger::Level logLevel) :
+	ODEintSolver(name, timeStep, logLevel) {
+	addComponent(comp);
+	initialize();
+}
 
+void ODEintSolver::addComponent(CPS::ODEintInterface::Ptr comp) {
+	mComponents.push_back(comp);
+	mOffsets.push_back(mOffsets.back() + static_cast<UInt>(comp->num_states()));
+}
 
-Real ODEintSolver::step(Real time) {
-
-    mComponent->pre_step(); ///write inital values into the mState Vector
-    curSolution.assign(mComponent->state_vector(), mComponent->state_vector()+ProbDim);
-    Real NextTime = time + mTimestep;
+void ODEintSolver::setHistoryLength(UInt length) {
+	mHistoryLength = length;
+	if (mHistoryLength > 0)
+		mHistory.reset(new LogRingBuffer(mHistoryLength, mOffsets.back() + 1));
+	else
+		mHistory.reset();
+}
 
-    std::cout<<"Current Time "<<NextTime<<std::endl;
+void ODEintSolver::initialize() {
+	mStates.assign(mOffsets.back(), 0);
+	for (UInt i = 0; i < mComponents.size(); ++i) {
+		const Real* initial = mComponents[i]->state_vector();
+		std::copy(initial, initial + (mOffsets[i + 1] - mOffsets[i]), mStates.begin() + mOffsets[i]);
+	}
 
-    stepper.do_step(&ODEintSolver::StateSpaceWrapper,curSolution, time, mTimestep); ///solve ODE for time + mTimestep TODO: implement sysfunc
-    mComponent->set_state_vector(curSolution);///Writes the current solution back into the component
-    solution.push_back(curSolution); /// Logs current solution
-    times.push_back(time); ///Logs current time
+	// The rows of the history depend on the number of states
+	setHistoryLength(mHistoryLength);
 
-    // TODO: add proper logging
-    mComponent->post_step();
-    return NextTime;
+	mSLog->info("Integrating {:d} states of {:d} components", mOffsets.back(), mComponents.size());
 }
 
-void ODEintSolver::StateSpaceWrapper( const std::vector<double> &y, std::vector<double> ydot, double t){
-
-        for(auto comp : self->system){ // call system functions of the components with the state vector
-                comp(y.data(), ydot.data(), t);
-        }
+Real ODEintSolver::step(Real time) {
+	// Gather the initial values of the step
+	for (UInt i = 0; i < mComponents.size(); ++i) {
+		mComponents[i]->pre_step();
+		const Real* initial = mComponents[i]->state_vector();
+		std::copy(initial, initial + (mOffsets[i + 1] - mOffsets[i]), mStates.begin() + mOffsets[i]);
+	}
+
+	Real nextTime = time + mTimeStep;
+	mStepper.do_step(System{*this}, mStates, time, mTimeStep);
+
+	for (UInt i = 0; i < mComponents.size(); ++i) {
+		mComponents[i]->set_state_vector(mStates.data() + mOffsets[i]);
+		mComponents[i]->post_step();
+	}
+
+	if (mHistory) {
+		Real* row = mHistory->reserve();
+		if (!row) {
+			mHistory->dropOldest();
+			row = mHistory->reserve();
+		}
+		row[0] = nextTime;
+		std::copy(mStates.begin(), mStates.end(), row + 1);
+		mHistory->commit();
+	}
+
+	mSLog->debug("Integrated to {:f}", nextTime);
+	return nextTime;
 }
 
-ODEintSolver::~ODEintSolver() {
+void ODEintSolver::System::operator()(const std::vector<Real>& y, std::vector<Real>& ydot, Real t) const {
+	auto& offsets = mSolver.mOffsets;
+	for (UInt i = 0; i < mSolver.mComponents.size(); ++i)
+		mSolver.mComponents[i]->odeint(y.data() + offsets[i], ydot.data() + offsets[i], t);
 }
-
@@ -47,7 +47,8 @@ void PFSolver::initialize(){
     determinePFBusType();
     composeAdmittanceMatrix();
 
-	mJ.setZero(mNumUnknowns,mNumUnknowns);
+	initializeJacobian();
+	mJLU.analyzePattern(mJ);
 	mX.setZero(mNumUnknowns);
 	mF.setZero(mNumUnknowns);
 }
@@ -266,6 +267,7 @@ void PFSolver::composeAdmittanceMatrix() {
 		for(auto shunt : mShunts) {
 			shunt->pfApplyAdmittanceMatrixStamp(mY);
 		}
+		mY.makeCompressed();
 	}
 	if(mLines.empty() && mTransformers.empty()) {
 		throw std::invalid_argument("There are no bus");
@@ -300,12 +302,10 @@ Bool PFSolver::solvePowerflow() {
     for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
         calculateJacobian();
-		auto sparseJ = mJ.sparseView();
 
 		// Solve system mJ*mX = mF
-        Eigen::SparseLU<SparseMatrix>lu(sparseJ);
-
-		mX = lu.solve(mF);	/* code */
+		mJLU.factorize(mJ);
+		mX = mJLU.solve(mF);
 
 		// Calculate new solution based on mX increments obtained from equation system
 		updateSolution();
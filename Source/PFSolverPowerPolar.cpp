@@ -8,6 +8,8 @@
 
 #include <dpsim/PFSolverPowerPolar.h>
 
+#include <algorithm>
+
 using namespace DPsim;
 using namespace CPS;
 
@@ -139,103 +141,114 @@ void PFSolverPowerPolar::calculateMismatch() {
     }
 }
 
-void PFSolverPowerPolar::calculateJacobian() {
+void PFSolverPowerPolar::initializeJacobian() {
     UInt npqpv = mNumPQBuses + mNumPVBuses;
-    double val;
-    UInt k, j;
-    UInt da, db;
 
-    mJ.setZero();
-
-    //J1
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        mJ.coeffRef(a, a) = -Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                mJ.coeffRef(a, b) = val;
-            }
+    // Position of each bus in the vector of unknowns, -1 for VD buses
+    std::vector<Int> busPosition(mSystem.mNodes.size(), -1);
+    for (UInt a = 0; a < npqpv; ++a)
+        busPosition[mPQPVBusIndices[a]] = a;
+
+    // The Jacobian has an entry in the blocks of two buses only if they
+    // are connected in the admittance matrix. The diagonal is always
+    // part of the pattern.
+    std::vector<Eigen::Triplet<Real>> pattern;
+    mJacobianDiagonal.clear();
+    mJacobianOffDiagonal.clear();
+    for (UInt a = 0; a < npqpv; ++a) {
+        UInt k = mPQPVBusIndices[a];
+        mJacobianDiagonal.push_back({ k, k, -1, -1, -1, -1, -1 });
+        pattern.emplace_back(a, a, 0.);
+        if (a < mNumPQBuses) {
+            pattern.emplace_back(a, a + npqpv, 0.);
+            pattern.emplace_back(a + npqpv, a, 0.);
+            pattern.emplace_back(a + npqpv, a + npqpv, 0.);
         }
-    }
-
-    //J2
-    da = 0;
-    db = npqpv;
-    for (UInt a = 0; a < npqpv; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J2D:" << (a + da) << "," << (a + db) << std::endl;
-        if (a < mNumPQBuses)
-            mJ.coeffRef(a + da, a + db) = P(k) + G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J2ij:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = val;
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            if (static_cast<UInt>(it.col()) == k) {
+                mJacobianDiagonal.back().y = static_cast<Int>(&it.valueRef() - mY.valuePtr());
+                continue;
             }
+            Int b = busPosition[it.col()];
+            if (b < 0)
+                continue;
+            mJacobianOffDiagonal.push_back({ k, static_cast<UInt>(it.col()),
+                static_cast<Int>(&it.valueRef() - mY.valuePtr()), -1, -1, -1, -1 });
+            pattern.emplace_back(a, b, 0.);
+            if (static_cast<UInt>(b) < mNumPQBuses)
+                pattern.emplace_back(a, b + npqpv, 0.);
+            if (a < mNumPQBuses)
+                pattern.emplace_back(a + npqpv, b, 0.);
+            if (a < mNumPQBuses && static_cast<UInt>(b) < mNumPQBuses)
+                pattern.emplace_back(a + npqpv, b + npqpv, 0.);
         }
     }
+    mJ.resize(mNumUnknowns, mNumUnknowns);
+    mJ.setFromTriplets(pattern.begin(), pattern.end());
+    mJ.makeCompressed();
+
+    // Look up the position of (row, col) in the value array of mJ
+    auto position = [this](UInt row, UInt col) {
+        const SparseMatrix::StorageIndex* begin = mJ.innerIndexPtr() + mJ.outerIndexPtr()[col];
+        const SparseMatrix::StorageIndex* end = mJ.innerIndexPtr() + mJ.outerIndexPtr()[col+1];
+        return static_cast<Int>(std::lower_bound(begin, end, static_cast<SparseMatrix::StorageIndex>(row)) - mJ.innerIndexPtr());
+    };
+    auto assignPositions = [&](JacobianEntry& entry) {
+        UInt a = busPosition[entry.k];
+        UInt b = busPosition[entry.j];
+        entry.pd = position(a, b);
+        if (b < mNumPQBuses)
+            entry.pv = position(a, b + npqpv);
+        if (a < mNumPQBuses)
+            entry.qd = position(a + npqpv, b);
+        if (a < mNumPQBuses && b < mNumPQBuses)
+            entry.qv = position(a + npqpv, b + npqpv);
+    };
+    for (auto& entry : mJacobianDiagonal)
+        assignPositions(entry);
+    for (auto& entry : mJacobianOffDiagonal)
+        assignPositions(entry);
+
+    mSLog->info("Jacobian: {} unknowns, {} non-zeros", mNumUnknowns, mJ.nonZeros());
+}
 
-
-    //J3
-    da = npqpv;
-    db = 0;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J3:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = P(k) - G(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < npqpv; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                        + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
-                //if (val != 0.0)
-                //std::cout << "J3:" << (a + da) << "," << (b + db) << std::endl;
-                mJ.coeffRef(a + da, b + db) = -val;
-            }
-        }
+void PFSolverPowerPolar::calculateJacobian() {
+    Real* J = mJ.valuePtr();
+    const Complex* Y = mY.valuePtr();
+    std::fill(J, J + mJ.nonZeros(), 0.);
+
+    for (auto& entry : mJacobianDiagonal) {
+        UInt k = entry.k;
+        Complex y = entry.y >= 0 ? Y[entry.y] : Complex(0., 0.);
+        Real vk2 = sol_V.coeff(k) * sol_V.coeff(k);
+        Real p = P(k);
+        Real q = Q(k);
+        J[entry.pd] = -q - y.imag() * vk2;
+        if (entry.pv >= 0)
+            J[entry.pv] = p + y.real() * vk2;
+        if (entry.qd >= 0)
+            J[entry.qd] = p - y.real() * vk2;
+        if (entry.qv >= 0)
+            J[entry.qv] = q - y.imag() * vk2;
     }
 
-    //J4
-    da = npqpv;
-    db = npqpv;
-    for (UInt a = 0; a < mNumPQBuses; ++a) { //rows
-        k = mPQPVBusIndices[a];
-        //diagonal
-        //std::cout << "J4:" << (a + da) << "," << (a + db) << std::endl;
-        mJ.coeffRef(a + da, a + db) = Q(k) - B(k, k) * sol_V.coeff(k) * sol_V.coeff(k);
-
-        //non diagonal elements
-        for (UInt b = 0; b < mNumPQBuses; ++b) {
-            if (b != a) {
-                j = mPQPVBusIndices[b];
-                val = sol_V.coeff(k) * sol_V.coeff(j)
-                        *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                        - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
-                if (val != 0.0) {
-                    //std::cout << "J4:" << (a + da) << "," << (b + db) << std::endl;
-                    mJ.coeffRef(a + da, b + db) = val;
-                }
-            }
-        }
+    for (auto& entry : mJacobianOffDiagonal) {
+        UInt k = entry.k;
+        UInt j = entry.j;
+        Real g = Y[entry.y].real();
+        Real b = Y[entry.y].imag();
+        Real vkvj = sol_V.coeff(k) * sol_V.coeff(j);
+        Real sinD = sin(sol_D.coeff(k) - sol_D.coeff(j));
+        Real cosD = cos(sol_D.coeff(k) - sol_D.coeff(j));
+        Real dD = vkvj * (g * sinD - b * cosD);
+        Real dV = vkvj * (g * cosD + b * sinD);
+        J[entry.pd] = dD;
+        if (entry.pv >= 0)
+            J[entry.pv] = dV;
+        if (entry.qd >= 0)
+            J[entry.qd] = -dV;
+        if (entry.qv >= 0)
+            J[entry.qv] = dD;
     }
 }
 
@@ -362,20 +375,22 @@ void PFSolverPowerPolar::calculateNodalInjection() {
 
 Real PFSolverPowerPolar::P(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                + it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                - it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
@@ -383,8 +398,8 @@ Real PFSolverPowerPolar::Q(UInt k) {
 void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
     for (auto k: mVDBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
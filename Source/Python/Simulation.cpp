@@ -19,6 +19,7 @@
 #include <dpsim/SequentialScheduler.h>
 #include <dpsim/ThreadLevelScheduler.h>
 #include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
 #include <cps/DP/DP_Ph1_Switch.h>
 
 #ifdef WITH_OPENMP
@@ -604,6 +605,10 @@ PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyO
 		if (threads <= 0)
 			threads = 1;
 		self->sim->setScheduler(std::make_shared<ThreadListScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable));
+	} else if (!strcmp(schedName, "work_stealing")) {
+		if (threads <= 0)
+			threads = 1;
+		self->sim->setScheduler(std::make_shared<WorkStealingScheduler>(threads, outMeasurementFile));
 	} else {
 		PyErr_SetString(PyExc_ValueError, "invalid scheduler");
 		return nullptr;
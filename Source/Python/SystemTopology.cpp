@@ -175,6 +175,7 @@ PyObject* Python::SystemTopology::autoDecouple(SystemTopology* self, PyObject* a
 		++it;
 	}
 
+	self->sys->rebuildIndices();
 	self->sys->addComponents(newComponents);
 	self->updateDicts();
 	Py_RETURN_NONE;
@@ -190,13 +191,9 @@ PyObject* Python::SystemTopology::removeComponent(SystemTopology *self, PyObject
 	if (!PyArg_ParseTuple(args, "s", &name))
 		return nullptr;
 
-	for (auto it = self->sys->mComponents.begin(); it != self->sys->mComponents.end(); ++it) {
-		if ((*it)->name() == name) {
-			self->sys->mComponents.erase(it);
-
-			PyDict_DelItemString(self->pyComponentDict, name);
-			Py_RETURN_NONE;
-		}
+	if (self->sys->removeComponent(name)) {
+		PyDict_DelItemString(self->pyComponentDict, name);
+		Py_RETURN_NONE;
 	}
 
 	PyErr_SetString(PyExc_AttributeError, "No component with that name");
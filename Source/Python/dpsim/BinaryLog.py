@@ -0,0 +1,73 @@
+"""Reader for logs written by the BinaryLogger.
+
+The rows are mapped directly into numpy arrays, no parsing is involved.
+"""
+
+import struct
+
+import numpy as np
+
+MAGIC = b'DPSIMBIN'
+VERSION = 1
+
+REAL = 0
+COMPLEX = 1
+
+
+def read_header(filename):
+    """Returns the column names, column types and the size of the header in bytes."""
+    with open(filename, 'rb') as f:
+        if f.read(8) != MAGIC:
+            raise ValueError('{} is not a binary DPsim log'.format(filename))
+
+        version, count = struct.unpack('<II', f.read(8))
+        if version != VERSION:
+            raise ValueError('Unsupported binary log version {}'.format(version))
+
+        names = []
+        types = []
+        for _ in range(count):
+            type, length = struct.unpack('<BI', f.read(5))
+            names.append(f.read(length).decode())
+            types.append(type)
+
+        return names, types, f.tell()
+
+
+def read(filename, mmap=True):
+    """Returns the time vector and a dict mapping column names to numpy arrays.
+
+    Complex columns are returned as complex128 arrays. With mmap=True, the
+    real columns are views into a memory-mapped file.
+    """
+    names, types, offset = read_header(filename)
+
+    fields = [('time', '<f8')]
+    for name, type in zip(names, types):
+        fields.append((name, '<c16' if type == COMPLEX else '<f8'))
+    dtype = np.dtype(fields)
+
+    if mmap:
+        rows = np.memmap(filename, dtype=dtype, mode='r', offset=offset)
+    else:
+        rows = np.fromfile(filename, dtype=dtype, offset=offset)
+
+    return rows['time'], { name: rows[name] for name in names }
+
+
+def to_csv(filename, csv_filename):
+    """Writes the log in the CSV format of the text logger."""
+    time, columns = read(filename, mmap=False)
+
+    header = [ 'time' ]
+    data = [ time ]
+    for name, values in columns.items():
+        if np.iscomplexobj(values):
+            header += [ name + '.re', name + '.im' ]
+            data += [ values.real, values.imag ]
+        else:
+            header.append(name)
+            data.append(values)
+
+    np.savetxt(csv_filename, np.column_stack(data), fmt='%14e',
+               delimiter=',', header=','.join(header), comments='')
@@ -19,6 +19,8 @@ using namespace DPsim;
 CPS::AttributeBase::Ptr Scheduler::external;
 
 void Scheduler::initMeasurements(const Task::List& tasks) {
+	// The tasks of a previous schedule may not exist anymore
+	mMeasurements.clear();
 	// Fill map here already since it's not protected by a mutex
 	for (auto task : tasks) {
 		mMeasurements[task.get()] = std::vector<TaskTime>();
@@ -30,6 +32,9 @@ void Scheduler::updateMeasurement(Task* ptr, TaskTime time) {
 }
 
 void Scheduler::writeMeasurements(String filename) {
+	if (mMeasurements.empty())
+		return;
+
 	std::ofstream os(filename);
 	std::unordered_map<String, TaskTime> averages;
 	for (auto& pair : mMeasurements) {
@@ -7,6 +7,8 @@
  *********************************************************************************/
 
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iomanip>
 #include <algorithm>
 #include <typeindex>
@@ -18,9 +20,12 @@
 #include <dpsim/MNASolverFactory.h>
 #ifdef WITH_SPARSE
 #include <dpsim/MNASolverSysRecomp.h>
+#include <dpsim/MNASolverBatched.h>
 #endif
 #include <dpsim/PFSolverPowerPolar.h>
 #include <dpsim/DiakopticsSolver.h>
+#include <dpsim/TopologyPartitioner.h>
+#include <dpsim/AllocationGuard.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -34,6 +39,10 @@
   #include <dpsim/ODESolver.h>
 #endif
 
+#ifdef WITH_ODEINT
+  #include <dpsim/ODEintSolver.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
@@ -120,11 +129,29 @@ void Simulation::initialize() {
 		break;
 	}
 
+	if (mAsyncLogCapacity > 0) {
+		for (auto solver : mSolvers)
+			solver->setAsyncLogging(mAsyncLogCapacity, mAsyncLogPolicy);
+		for (auto logger : mLoggers) {
+			if (!logger->isAsync())
+				logger->setAsync(mAsyncLogCapacity, mAsyncLogPolicy);
+		}
+	}
+
 	mTime = 0;
 	mTimeStepCount = 0;
 
 	schedule();
 
+	if (mCheckStepAllocations) {
+#ifdef WITH_ALLOCATION_GUARD
+		// Storing the step times must not allocate during the run
+		mStepTimes.reserve(mStepTimes.size() + static_cast<std::size_t>(std::ceil(mFinalTime / mTimeStep)) + 1);
+#else
+		throw SystemError("Checking step allocations requires WITH_ALLOCATION_GUARD.");
+#endif
+	}
+
 	mInitialized = true;
 }
 
@@ -164,12 +191,73 @@ void Simulation::createSolvers() {
 		}
 	}
 #endif /* WITH_SUNDIALS */
+
+	// All ODEint components share one solver, which integrates their stacked states
+#ifdef WITH_ODEINT
+	// The solver is only created if there are such components, since it
+	// opens its log file
+	std::vector<ODEintInterface::Ptr> odeintComps;
+	for (auto comp : mSystem.mComponents) {
+		auto odeintComp = std::dynamic_pointer_cast<ODEintInterface>(comp);
+		if (odeintComp)
+			odeintComps.push_back(odeintComp);
+	}
+	if (!odeintComps.empty()) {
+		auto odeintSolver = std::make_shared<ODEintSolver>(mName + "_ODEint", mTimeStep, mLogLevel);
+		for (auto odeintComp : odeintComps)
+			odeintSolver->addComponent(odeintComp);
+		odeintSolver->initialize();
+		mSolvers.push_back(odeintSolver);
+	}
+#endif /* WITH_ODEINT */
 }
 
 template <typename VarType>
 void Simulation::createMNASolver() {
 	Solver::Ptr solver;
 	std::vector<SystemTopology> subnets;
+
+	if (mTearingParts > 1 && mTearComponents.size() == 0) {
+		TopologyPartitioner partitioner(mTearingParts, mLogLevel);
+		if (!mTearingCostFile.empty())
+			partitioner.readComponentCosts(mTearingCostFile);
+		auto partition = partitioner.partition<VarType>(mSystem);
+		mTearComponents = partition.tearComponents;
+		mLog->info("Selected {} tear components for {} parts, imbalance {:.3f}, predicted speedup {:.2f}",
+			mTearComponents.size(), mTearingParts, partition.imbalance, partition.predictedSpeedup);
+	}
+
+	if (mScenarios.size() > 0) {
+#ifdef WITH_SPARSE
+		// All scenarios share one factorization of the whole system matrix
+		if (mTearComponents.size() > 0)
+			throw SystemError("Batched scenarios do not support tear components.");
+		if (mSplitSubnets) {
+			mSystem.splitSubnets<VarType>(subnets);
+			if (subnets.size() > 1)
+				throw SystemError("Batched scenarios do not support a system of several subnets, "
+					"disable subnet splitting to solve them as one system.");
+		}
+
+		// All scenarios are solved together with the system
+		auto batchedSolver = std::make_shared<MnaSolverBatched<VarType>>(mName, mDomain, mLogLevel);
+		for (auto& scenario : mScenarios)
+			batchedSolver->addScenario(scenario);
+		batchedSolver->setNodeOrdering(mNodeOrdering);
+		batchedSolver->doComplexNativeSystem(mComplexNativeSystem);
+		batchedSolver->doCircuitLU(mMnaImpl == MnaSolverFactory::CircuitSparse);
+		batchedSolver->setTimeStep(mTimeStep);
+		batchedSolver->doSteadyStateInit(mSteadyStateInit);
+		batchedSolver->doFrequencyParallelization(mFreqParallel);
+		batchedSolver->setSystem(mSystem);
+		batchedSolver->initialize();
+		mSolvers.push_back(batchedSolver);
+		return;
+#else
+		throw SystemError("Batched scenarios require WITH_SPARSE to be set.");
+#endif
+	}
+
 	// The Diakoptics solver splits the system at a later point.
 	// That is why the system is not split here if tear components exist.
 	if (mSplitSubnets && mTearComponents.size() == 0)
@@ -192,12 +280,19 @@ void Simulation::createMNASolver() {
 		else if (mSystemMatrixRecomputation) {
 #ifdef WITH_SPARSE
 			// Recompute system matrix if switches or other components change
-			solver = std::make_shared<MnaSolverSysRecomp<VarType>>(
+			auto sysRecompSolver = std::make_shared<MnaSolverSysRecomp<VarType>>(
 				mName + copySuffix, mDomain, mLogLevel);
+			sysRecompSolver->setRecomputationMode(mRecomputationMode);
+			sysRecompSolver->setNodeOrdering(mNodeOrdering);
+			sysRecompSolver->doComplexNativeSystem(mComplexNativeSystem);
+			sysRecompSolver->doCircuitLU(mMnaImpl == MnaSolverFactory::CircuitSparse);
+			solver = sysRecompSolver;
 			solver->setTimeStep(mTimeStep);
 			solver->doSteadyStateInit(mSteadyStateInit);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->setSteadStIniAccelerationDepth(mSteadStIniAccelerationDepth);
+			solver->setSteadStIniScheduler(mScheduler);
 			solver->setSystem(subnets[net]);
 			solver->initialize();
 #else
@@ -206,16 +301,29 @@ void Simulation::createMNASolver() {
 		}
 		else {
 			// Default case with precomputed system matrices for different configurations
-			solver = MnaSolverFactory::factory<VarType>(mName + copySuffix, mDomain,
+			auto mnaSolver = MnaSolverFactory::factory<VarType>(mName + copySuffix, mDomain,
 												 mLogLevel, mMnaImpl);
+			mnaSolver->doLazySwitchedMatrices(mLazySwitchedMatrices);
+			mnaSolver->setSwitchedMatrixCacheSize(mSwitchedMatrixCacheSize);
+			mnaSolver->setNodeOrdering(mNodeOrdering);
+			mnaSolver->doComplexNativeSystem(mComplexNativeSystem);
+			if (mLazySwitchedMatrices)
+				mnaSolver->setSwitchedMatrixPrewarmEvents(mEvents.events());
+			solver = mnaSolver;
 			solver->setTimeStep(mTimeStep);
 			solver->doSteadyStateInit(mSteadyStateInit);
 			solver->doFrequencyParallelization(mFreqParallel);
 			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
 			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			solver->setSteadStIniAccelerationDepth(mSteadStIniAccelerationDepth);
+			solver->setSteadStIniScheduler(mScheduler);
 			solver->setSystem(subnets[net]);
 			solver->initialize();
 		}
+		if (mSteadyStateInit && solver->steadStIniSteps() > 0)
+			mLog->info("Steady-state initialization of {} took {} steps and {:f}s",
+				subnets.size() > 1 ? "subnet " + std::to_string(net) : "the system",
+				solver->steadStIniSteps(), solver->steadStIniWallTime());
 		mSolvers.push_back(solver);
 	}
 }
@@ -440,10 +548,23 @@ void Simulation::run() {
 
 Real Simulation::step() {
 	auto start = std::chrono::steady_clock::now();
+#ifdef WITH_ALLOCATION_GUARD
+	if (mCheckStepAllocations)
+		AllocationGuard::arm();
+#endif
 	mEvents.handleEvents(mTime);
 
 	mScheduler->step(mTime, mTimeStepCount);
 
+#ifdef WITH_ALLOCATION_GUARD
+	if (mCheckStepAllocations) {
+		std::size_t allocations = AllocationGuard::disarm();
+		if (allocations > 0)
+			throw SystemError(fmt::format("{} heap allocation(s) in step {} (first: {} bytes)",
+				allocations, mTimeStepCount, AllocationGuard::firstAllocationSize()));
+	}
+#endif
+
 	mTime += mTimeStep;
 	++mTimeStepCount;
 
@@ -465,6 +586,98 @@ void Simulation::reset() {
 	mInitialized = false;
 }
 
+namespace {
+	const char checkpointMagic[] = "DPSIMCKP";
+	const UInt checkpointVersion = 1;
+}
+
+void Simulation::writeCheckpoint(std::ostream& out) {
+	if (!mInitialized)
+		initialize();
+
+	out.write(checkpointMagic, sizeof(checkpointMagic) - 1);
+	CheckpointWriter writer(out);
+	writer.write(checkpointVersion);
+	writer.write(mTime);
+	writer.write(mTimeStepCount);
+
+	writer.write(static_cast<UInt>(mScenarios.size() + 1));
+	for (UInt k = 0; k <= mScenarios.size(); ++k) {
+		auto& system = k == 0 ? mSystem : mScenarios[k - 1];
+		writer.write(static_cast<UInt>(system.mNodes.size()));
+		for (auto node : system.mNodes)
+			writer.writeObject(*node);
+		writer.write(static_cast<UInt>(system.mComponents.size()));
+		for (auto comp : system.mComponents)
+			writer.writeObject(*comp);
+	}
+
+	writer.write(static_cast<UInt>(mSolvers.size()));
+	for (auto solver : mSolvers)
+		solver->writeCheckpoint(writer);
+
+	if (!out)
+		throw SystemError("Failed to write checkpoint");
+	mLog->info("Wrote checkpoint at time {:f}", mTime);
+}
+
+void Simulation::writeCheckpoint(const String& filename) {
+	std::ofstream out(filename, std::ios::binary);
+	if (!out)
+		throw SystemError("Cannot open checkpoint file " + filename);
+	writeCheckpoint(out);
+}
+
+void Simulation::readCheckpoint(std::istream& in) {
+	if (!mInitialized) {
+		// The checkpoint replaces the initial states
+		Bool steadyStateInit = mSteadyStateInit;
+		mSteadyStateInit = false;
+		initialize();
+		mSteadyStateInit = steadyStateInit;
+	}
+
+	char magic[sizeof(checkpointMagic) - 1];
+	in.read(magic, sizeof(magic));
+	if (!in || !std::equal(magic, magic + sizeof(magic), checkpointMagic))
+		throw SystemError("Not a simulation checkpoint");
+	CheckpointReader reader(in);
+	if (reader.read<UInt>() != checkpointVersion)
+		throw SystemError("Unsupported checkpoint version");
+	auto time = reader.read<Real>();
+	auto timeStepCount = reader.read<Int>();
+
+	if (reader.read<UInt>() != mScenarios.size() + 1)
+		throw SystemError("Number of scenarios does not match the checkpoint");
+	for (UInt k = 0; k <= mScenarios.size(); ++k) {
+		auto& system = k == 0 ? mSystem : mScenarios[k - 1];
+		if (reader.read<UInt>() != system.mNodes.size())
+			throw SystemError("Number of nodes does not match the checkpoint");
+		for (auto node : system.mNodes)
+			reader.readObject(*node);
+		if (reader.read<UInt>() != system.mComponents.size())
+			throw SystemError("Number of components does not match the checkpoint");
+		for (auto comp : system.mComponents)
+			reader.readObject(*comp);
+	}
+
+	if (reader.read<UInt>() != mSolvers.size())
+		throw SystemError("Number of solvers does not match the checkpoint");
+	for (auto solver : mSolvers)
+		solver->readCheckpoint(reader, time);
+
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+	mLog->info("Restored checkpoint at time {:f}", mTime);
+}
+
+void Simulation::readCheckpoint(const String& filename) {
+	std::ifstream in(filename, std::ios::binary);
+	if (!in)
+		throw SystemError("Cannot open checkpoint file " + filename);
+	readCheckpoint(in);
+}
+
 void Simulation::logStepTimes(String logName) {
 	auto stepTimeLog = Logger::get(logName, Logger::Level::info);
 	Logger::setLogPattern(stepTimeLog, "%v");
@@ -504,9 +717,16 @@ void Simulation::setIdObjAttr(const String &comp, const String &attr, Complex va
 		mLog->error("Component not found");
 }
 
-Real Simulation::getRealIdObjAttr(const String &comp, const String &attr, UInt row, UInt col) {
-	IdentifiedObject::Ptr compObj = mSystem.component<IdentifiedObject>(comp);
-	if (!compObj) compObj = mSystem.node<IdentifiedObject>(comp);
+CPS::SystemTopology& Simulation::scenarioSystem(UInt scenario) {
+	if (scenario > mScenarios.size())
+		throw SystemError("Scenario index out of range.");
+	return scenario == 0 ? mSystem : mScenarios[scenario - 1];
+}
+
+Real Simulation::getRealIdObjAttr(const String &comp, const String &attr, UInt row, UInt col, UInt scenario) {
+	SystemTopology& system = scenarioSystem(scenario);
+	IdentifiedObject::Ptr compObj = system.component<IdentifiedObject>(comp);
+	if (!compObj) compObj = system.node<IdentifiedObject>(comp);
 
 	if (compObj) {
 		try {
@@ -526,9 +746,10 @@ Real Simulation::getRealIdObjAttr(const String &comp, const String &attr, UInt r
 	return 0;
 }
 
-Complex Simulation::getComplexIdObjAttr(const String &comp, const String &attr, UInt row, UInt col) {
-	IdentifiedObject::Ptr compObj = mSystem.component<IdentifiedObject>(comp);
-	if (!compObj) compObj = mSystem.node<IdentifiedObject>(comp);
+Complex Simulation::getComplexIdObjAttr(const String &comp, const String &attr, UInt row, UInt col, UInt scenario) {
+	SystemTopology& system = scenarioSystem(scenario);
+	IdentifiedObject::Ptr compObj = system.component<IdentifiedObject>(comp);
+	if (!compObj) compObj = system.node<IdentifiedObject>(comp);
 
 	if (compObj) {
 		try {
@@ -642,13 +863,16 @@ void Simulation::importIdObjAttr(const String &comp, const String &attr, UInt id
 }
 
 
-void Simulation::logIdObjAttr(const String &comp, const String &attr) {
-	IdentifiedObject::Ptr compObj = mSystem.component<IdentifiedObject>(comp);
-	IdentifiedObject::Ptr nodeObj = mSystem.node<TopologicalNode>(comp);
+void Simulation::logIdObjAttr(const String &comp, const String &attr, UInt scenario) {
+	SystemTopology& system = scenarioSystem(scenario);
+	IdentifiedObject::Ptr compObj = system.component<IdentifiedObject>(comp);
+	IdentifiedObject::Ptr nodeObj = system.node<TopologicalNode>(comp);
+	// The scenarios have the same component names
+	String prefix = scenario == 0 ? "" : "scenario" + std::to_string(scenario) + ".";
 
 	if (compObj) {
 		try {
-			auto name = compObj->name() + "." + attr;
+			auto name = prefix + compObj->name() + "." + attr;
 			auto v = compObj->attribute(attr);
 			mLoggers[0]->addAttribute(name, v);
 
@@ -657,7 +881,7 @@ void Simulation::logIdObjAttr(const String &comp, const String &attr) {
 		}
 	} else if (nodeObj) {
 		try {
-			auto name = nodeObj->name() + "." + attr;
+			auto name = prefix + nodeObj->name() + "." + attr;
 			auto v = nodeObj->attribute(attr);
 			mLoggers[0]->addAttribute(name, v);
 
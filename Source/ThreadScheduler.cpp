@@ -18,12 +18,9 @@ ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool us
 	if (threads < 1)
 		throw SchedulingException();
 	mTempSchedules.resize(threads);
-	mSchedules.resize(threads, nullptr);
 }
 
 ThreadScheduler::~ThreadScheduler() {
-	for (int i = 0; i < mNumThreads; i++)
-		delete[] mSchedules[i];
 }
 
 void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
@@ -31,32 +28,21 @@ void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
 }
 
 void ThreadScheduler::finishSchedule(const Edges& inEdges) {
-	std::map<CPS::Task::Ptr, Counter*> counters;
-	for (int thread = 0; thread < mNumThreads; thread++) {
-	//	std::cout << "Thread " << thread << std::endl;
-	//	for (auto& entry : mSchedules[thread]) {
-	//		Task* t = entry.task.get();
-	//		char *refpos = reinterpret_cast<char*>(reinterpret_cast<void*>(t)) + sizeof(Task);
-	//		void *ref = *(reinterpret_cast<void**>(refpos));
-	//		std::cout << entry.task->toString() << " " << ref << std::endl;
-	//	}
-		mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
-		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
-			auto& task = mTempSchedules[thread][i];
-			mSchedules[thread][i].task = task.get();
-			counters[task] = &mSchedules[thread][i].endCounter;
-		}
-	}
+	// The scheduler may be reused for another task graph, e.g. after the
+	// steady-state initialization
+	joinThreads();
+
+	Task::List tasks;
+	mThreadOffsets.assign(1, 0);
 	for (int thread = 0; thread < mNumThreads; thread++) {
-		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
-			auto& task = mTempSchedules[thread][i];
-			if (inEdges.find(task) != inEdges.end()) {
-				for (auto req : inEdges.at(task)) {
-					mSchedules[thread][i].reqCounters.push_back(counters[req]);
-				}
-			}
-		}
+		tasks.insert(tasks.end(), mTempSchedules[thread].begin(), mTempSchedules[thread].end());
+		mThreadOffsets.push_back(static_cast<Int>(tasks.size()));
 	}
+	mSchedule.compile(tasks, inEdges);
+	mStepCount = 0;
+	for (auto& schedule : mTempSchedules)
+		schedule.clear();
+
 	for (int i = 1; i < mNumThreads; i++) {
 		mThreads.emplace_back(threadFunction, this, i);
 	}
@@ -70,19 +56,27 @@ void ThreadScheduler::step(Real time, Int timeStepCount) {
 	// since we don't have a final BarrierTask, wait for all threads to finish
 	// their last task explicitly
 	for (int thread = 1; thread < mNumThreads; thread++) {
-		if (mTempSchedules[thread].size() != 0)
-			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1);
+		if (mThreadOffsets[thread+1] != mThreadOffsets[thread])
+			waitForCounter(mThreadOffsets[thread+1]-1);
 	}
+	++mStepCount;
 }
 
-void ThreadScheduler::stop() {
-	if (!mThreads.empty()) {
-		mJoining = true;
-		mStartBarrier.wait();
-		for (size_t thread = 0; thread < mThreads.size(); thread++) {
-			mThreads[thread].join();
-		}
+void ThreadScheduler::joinThreads() {
+	if (mThreads.empty())
+		return;
+
+	mJoining = true;
+	mStartBarrier.wait();
+	for (size_t thread = 0; thread < mThreads.size(); thread++) {
+		mThreads[thread].join();
 	}
+	mThreads.clear();
+	mJoining = false;
+}
+
+void ThreadScheduler::stop() {
+	joinThreads();
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
@@ -98,25 +92,30 @@ void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
 	}
 }
 
+void ThreadScheduler::waitForCounter(Int idx) {
+	std::atomic<Int>& counter = mSchedule.counter(idx);
+	while (counter.load(std::memory_order_acquire) != mStepCount+1);
+}
+
 void ThreadScheduler::doStep(Int thread) {
-	if (mOutMeasurementFile.empty()) {
-		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
-			ScheduleEntry* entry = &mSchedules[thread][i];
-			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
-			entry->task->execute(mTime, mTimeStepCount);
-			entry->endCounter.inc();
+	Int begin = mThreadOffsets[thread];
+	Int end = mThreadOffsets[thread+1];
+	for (Int i = begin; i != end; i++) {
+		// Predecessors that were executed earlier by the same thread
+		// are finished already
+		for (const Int* req = mSchedule.predecessorsBegin(i); req != mSchedule.predecessorsEnd(i); ++req) {
+			if (*req < begin || *req >= i)
+				waitForCounter(*req);
 		}
-	} else {
-		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
-			ScheduleEntry* entry = &mSchedules[thread][i];
-			for (Counter* counter : entry->reqCounters)
-				counter->wait(mTimeStepCount+1);
+		Task* task = mSchedule.task(i);
+		if (mOutMeasurementFile.empty()) {
+			task->execute(mTime, mTimeStepCount);
+		} else {
 			auto start = std::chrono::steady_clock::now();
-			entry->task->execute(mTime, mTimeStepCount);
+			task->execute(mTime, mTimeStepCount);
 			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(entry->task, end-start);
-			entry->endCounter.inc();
+			updateMeasurement(task, end-start);
 		}
+		mSchedule.counter(i).fetch_add(1, std::memory_order_release);
 	}
 }
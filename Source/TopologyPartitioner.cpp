@@ -0,0 +1,387 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/TopologyPartitioner.h>
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+#include <cps/Solver/MNATearInterface.h>
+#include <dpsim/Scheduler.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+TopologyPartitioner::TopologyPartitioner(UInt parts, Logger::Level logLevel) :
+	mParts(std::max<UInt>(parts, 1)) {
+	mSLog = Logger::get("TopologyPartitioner", logLevel);
+}
+
+void TopologyPartitioner::readComponentCosts(const String& measurementFile) {
+	std::unordered_map<String, Scheduler::TaskTime::rep> measurements;
+	Scheduler::readMeasurements(measurementFile, measurements);
+
+	// Tasks are named <component>.<task>
+	mCosts.clear();
+	for (auto& measurement : measurements) {
+		auto idx = measurement.first.rfind('.');
+		if (idx == String::npos)
+			continue;
+		mCosts[measurement.first.substr(0, idx)] += static_cast<Real>(measurement.second);
+	}
+}
+
+template <typename VarType>
+TopologyPartitioner::Partition TopologyPartitioner::partition(SystemTopology& system) {
+	// Index the network nodes
+	std::unordered_map<typename SimNode<VarType>::Ptr, UInt> nodeIndices;
+	for (auto topoNode : system.mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(topoNode);
+		if (!node || node->isGround())
+			continue;
+		UInt idx = static_cast<UInt>(nodeIndices.size());
+		nodeIndices.emplace(node, idx);
+	}
+	UInt numNodes = static_cast<UInt>(nodeIndices.size());
+
+	// Merge the nodes of components which cannot be torn
+	std::vector<UInt> parent(numNodes);
+	std::iota(parent.begin(), parent.end(), 0);
+	auto root = [&parent](UInt node) {
+		while (parent[node] != node)
+			node = parent[node] = parent[parent[node]];
+		return node;
+	};
+
+	std::vector<typename SimPowerComp<VarType>::Ptr> candidates;
+	std::vector<std::pair<UInt, UInt>> candidateNodes;
+	system.forEachConnectedNodePair<VarType>([&](typename SimNode<VarType>::Ptr node1,
+		typename SimNode<VarType>::Ptr node2, typename SimPowerComp<VarType>::Ptr comp) {
+		UInt idx1 = nodeIndices.at(node1), idx2 = nodeIndices.at(node2);
+		if (std::dynamic_pointer_cast<MNATearInterface>(comp) && comp->terminalNumber() == 2) {
+			candidates.push_back(comp);
+			candidateNodes.push_back(std::make_pair(idx1, idx2));
+		} else {
+			parent[root(idx1)] = root(idx2);
+		}
+	});
+
+	// Costs of the components are split among their nodes
+	Real defaultCost = 1;
+	if (!mCosts.empty()) {
+		Real sum = 0;
+		for (auto& cost : mCosts)
+			sum += cost.second;
+		defaultCost = sum / mCosts.size();
+	}
+	std::vector<Real> nodeCosts(numNodes, 0);
+	for (auto comp : system.mComponents) {
+		auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pComp)
+			continue;
+
+		std::vector<UInt> nodes;
+		for (UInt term = 0; term < pComp->terminalNumberConnected(); ++term) {
+			if (!pComp->node(term)->isGround())
+				nodes.push_back(nodeIndices.at(pComp->node(term)));
+		}
+		auto cost = mCosts.find(pComp->name());
+		for (auto node : nodes)
+			nodeCosts[node] += (cost != mCosts.end() ? cost->second : defaultCost) / nodes.size();
+	}
+
+	// Build the graph of the merged nodes
+	Graph graph;
+	std::vector<UInt> vertexOf(numNodes);
+	std::unordered_map<UInt, UInt> rootVertex;
+	for (UInt node = 0; node < numNodes; ++node) {
+		auto inserted = rootVertex.emplace(root(node), static_cast<UInt>(graph.weights.size()));
+		if (inserted.second)
+			graph.weights.push_back(0);
+		vertexOf[node] = inserted.first->second;
+		graph.weights[vertexOf[node]] += nodeCosts[node];
+	}
+	graph.edges.resize(graph.weights.size());
+	for (UInt cand = 0; cand < candidates.size(); ++cand) {
+		UInt v1 = vertexOf[candidateNodes[cand].first], v2 = vertexOf[candidateNodes[cand].second];
+		if (v1 == v2)
+			continue;
+		graph.edges[v1].push_back(std::make_pair(v2, cand));
+		graph.edges[v2].push_back(std::make_pair(v1, cand));
+	}
+	mSLog->info("Partitioning {} nodes merged into {} vertices with {} tear candidates into {} parts",
+		numNodes, graph.weights.size(), candidates.size(), mParts);
+
+	std::vector<UInt> vertices(graph.weights.size());
+	std::iota(vertices.begin(), vertices.end(), 0);
+	std::vector<UInt> partOf(graph.weights.size(), 0);
+	mSide.assign(graph.weights.size(), -1);
+	bisect(graph, vertices, mParts, 0, partOf);
+
+	// Tear all candidates between different parts
+	Partition result;
+	for (UInt cand = 0; cand < candidates.size(); ++cand) {
+		UInt v1 = vertexOf[candidateNodes[cand].first], v2 = vertexOf[candidateNodes[cand].second];
+		if (partOf[v1] != partOf[v2])
+			result.tearComponents.push_back(candidates[cand]);
+	}
+	for (auto comp : result.tearComponents) {
+		system.mComponents.erase(std::find(system.mComponents.begin(), system.mComponents.end(), comp));
+		system.mTearComponents.push_back(comp);
+	}
+	if (!result.tearComponents.empty())
+		system.rebuildIndices();
+
+	result.partCosts.assign(mParts, 0);
+	for (UInt vertex = 0; vertex < graph.weights.size(); ++vertex)
+		result.partCosts[partOf[vertex]] += graph.weights[vertex];
+
+	Real totalCost = std::accumulate(result.partCosts.begin(), result.partCosts.end(), 0.);
+	Real maxCost = *std::max_element(result.partCosts.begin(), result.partCosts.end());
+	if (maxCost > 0) {
+		result.imbalance = maxCost * mParts / totalCost;
+		result.predictedSpeedup = totalCost / maxCost;
+	}
+
+	mSLog->info("Tearing {} components", result.tearComponents.size());
+	for (UInt part = 0; part < mParts; ++part)
+		mSLog->info("Part {} cost: {}", part, result.partCosts[part]);
+	mSLog->info("Imbalance: {:.3f}, predicted speedup of the subnet solves: {:.2f}",
+		result.imbalance, result.predictedSpeedup);
+
+	return result;
+}
+
+void TopologyPartitioner::bisect(const Graph& graph, const std::vector<UInt>& vertices,
+	UInt parts, UInt firstPart, std::vector<UInt>& partOf) {
+
+	if (parts == 1 || vertices.size() <= 1) {
+		for (auto vertex : vertices)
+			partOf[vertex] = firstPart;
+		return;
+	}
+
+	UInt parts0 = parts / 2;
+	Real total = 0;
+	for (auto vertex : vertices) {
+		total += graph.weights[vertex];
+		mSide[vertex] = 1;
+	}
+	Real target = total * parts0 / parts;
+
+	// Grow from both ends of a pseudo-diameter and from two inner
+	// vertices, and keep the bisection with the smallest cut
+	std::unordered_map<UInt, UInt> distance;
+	UInt end0 = distances(graph, vertices[0], distance);
+	UInt end1 = distances(graph, end0, distance);
+	std::vector<UInt> starts = { end0, end1, vertices[vertices.size() / 3], vertices[2 * vertices.size() / 3] };
+
+	std::vector<Int> bestSides;
+	UInt bestCut = 0;
+	for (auto start : starts) {
+		for (auto vertex : vertices)
+			mSide[vertex] = 1;
+		Real weight0 = grow(graph, vertices, start, target);
+		refine(graph, vertices, target, weight0);
+
+		UInt cut = 0;
+		for (auto vertex : vertices) {
+			for (auto& edge : graph.edges[vertex]) {
+				if (mSide[edge.first] >= 0 && mSide[edge.first] != mSide[vertex])
+					++cut;
+			}
+		}
+		if (bestSides.empty() || cut < bestCut) {
+			bestCut = cut;
+			bestSides.clear();
+			for (auto vertex : vertices)
+				bestSides.push_back(mSide[vertex]);
+		}
+	}
+
+	std::vector<UInt> vertices0, vertices1;
+	for (UInt idx = 0; idx < vertices.size(); ++idx) {
+		(bestSides[idx] == 0 ? vertices0 : vertices1).push_back(vertices[idx]);
+		mSide[vertices[idx]] = -1;
+	}
+	bisect(graph, vertices0, parts0, firstPart, partOf);
+	bisect(graph, vertices1, parts - parts0, firstPart + parts0, partOf);
+}
+
+UInt TopologyPartitioner::distances(const Graph& graph, UInt start, std::unordered_map<UInt, UInt>& distance) {
+	distance.clear();
+	std::list<UInt> queue{start};
+	distance[start] = 0;
+	UInt last = start;
+	while (!queue.empty()) {
+		last = queue.front();
+		queue.pop_front();
+		for (auto& edge : graph.edges[last]) {
+			if (mSide[edge.first] < 0 || distance.count(edge.first))
+				continue;
+			distance[edge.first] = distance[last] + 1;
+			queue.push_back(edge.first);
+		}
+	}
+	return last;
+}
+
+Real TopologyPartitioner::grow(const Graph& graph, const std::vector<UInt>& vertices, UInt start, Real target) {
+	// Gain of moving a vertex from side 1 to side 0, i.e. its edges to
+	// side 0 minus its edges to side 1
+	std::unordered_map<UInt, Int> gain;
+	for (auto vertex : vertices) {
+		for (auto& edge : graph.edges[vertex]) {
+			if (mSide[edge.first] >= 0)
+				--gain[vertex];
+		}
+	}
+
+	// Vertices closer to the start are preferred at equal gain, which
+	// keeps the grown region compact
+	std::unordered_map<UInt, UInt> distance;
+	distances(graph, start, distance);
+
+	// Max-heap of gains, entries are stale if the gain has changed since
+	std::priority_queue<std::tuple<Int, Int, UInt>> frontier;
+	Real weight0 = 0;
+	auto move = [&](UInt vertex) {
+		mSide[vertex] = 0;
+		weight0 += graph.weights[vertex];
+		for (auto& edge : graph.edges[vertex]) {
+			if (mSide[edge.first] != 1)
+				continue;
+			gain[edge.first] += 2;
+			frontier.push(std::make_tuple(gain[edge.first], -static_cast<Int>(distance[edge.first]), edge.first));
+		}
+	};
+
+	move(start);
+
+	UInt next = 0;
+	while (weight0 < target) {
+		Int vertex = -1;
+		while (!frontier.empty()) {
+			auto top = frontier.top();
+			frontier.pop();
+			if (mSide[std::get<2>(top)] == 1 && gain[std::get<2>(top)] == std::get<0>(top)) {
+				vertex = std::get<2>(top);
+				break;
+			}
+		}
+		// Continue with another connected component of the graph
+		if (vertex < 0) {
+			while (next < vertices.size() && mSide[vertices[next]] != 1)
+				++next;
+			if (next == vertices.size())
+				break;
+			vertex = vertices[next];
+		}
+		// Stop if the vertex overshoots the target more than leaving it out
+		if (weight0 + graph.weights[vertex] - target > target - weight0)
+			break;
+		move(vertex);
+	}
+	return weight0;
+}
+
+void TopologyPartitioner::refine(const Graph& graph, const std::vector<UInt>& vertices,
+	Real target, Real weight0) {
+
+	Real total = 0, maxWeight = 0;
+	UInt count0 = 0;
+	for (auto vertex : vertices) {
+		total += graph.weights[vertex];
+		maxWeight = std::max(maxWeight, graph.weights[vertex]);
+		if (mSide[vertex] == 0)
+			++count0;
+	}
+	Real tolerance = std::max(mTolerance * total, maxWeight);
+
+	// Fiduccia-Mattheyses passes: move the vertex with the highest gain
+	// even if the gain is negative, lock it, and roll back to the best
+	// intermediate state at the end of the pass.
+	for (UInt pass = 0; pass < 10; ++pass) {
+		std::unordered_map<UInt, Int> gain;
+		std::unordered_map<UInt, Bool> locked;
+		std::priority_queue<std::pair<Int, UInt>> heap;
+		for (auto vertex : vertices) {
+			Int g = 0;
+			for (auto& edge : graph.edges[vertex]) {
+				if (mSide[edge.first] >= 0)
+					g += mSide[edge.first] == mSide[vertex] ? -1 : 1;
+			}
+			gain[vertex] = g;
+			heap.push(std::make_pair(g, vertex));
+		}
+
+		std::vector<UInt> moves;
+		Int cutReduction = 0, bestReduction = 0;
+		UInt bestMoves = 0;
+		Real bestDeviation = std::abs(weight0 - target);
+		Real bestWeight0 = weight0;
+		UInt bestCount0 = count0;
+
+		while (!heap.empty() && moves.size() < bestMoves + 64) {
+			auto top = heap.top();
+			heap.pop();
+			UInt vertex = top.second;
+			if (locked[vertex] || gain[vertex] != top.first)
+				continue;
+
+			Int side = mSide[vertex];
+			Real newWeight0 = side == 0 ? weight0 - graph.weights[vertex] : weight0 + graph.weights[vertex];
+			Real newDeviation = std::abs(newWeight0 - target);
+			UInt newCount0 = side == 0 ? count0 - 1 : count0 + 1;
+
+			// Keep both sides non-empty and within the balance tolerance
+			if (newCount0 == 0 || newCount0 == vertices.size())
+				continue;
+			if (newDeviation > tolerance && newDeviation >= std::abs(weight0 - target))
+				continue;
+
+			mSide[vertex] = 1 - side;
+			locked[vertex] = true;
+			weight0 = newWeight0;
+			count0 = newCount0;
+			cutReduction += top.first;
+			moves.push_back(vertex);
+
+			for (auto& edge : graph.edges[vertex]) {
+				UInt neighbour = edge.first;
+				if (mSide[neighbour] < 0 || locked[neighbour])
+					continue;
+				gain[neighbour] += mSide[neighbour] == side ? 2 : -2;
+				heap.push(std::make_pair(gain[neighbour], neighbour));
+			}
+
+			if (cutReduction > bestReduction ||
+				(cutReduction == bestReduction && newDeviation < bestDeviation)) {
+				bestReduction = cutReduction;
+				bestDeviation = newDeviation;
+				bestMoves = static_cast<UInt>(moves.size());
+				bestWeight0 = weight0;
+				bestCount0 = count0;
+			}
+		}
+
+		for (UInt move = bestMoves; move < moves.size(); ++move)
+			mSide[moves[move]] = 1 - mSide[moves[move]];
+		weight0 = bestWeight0;
+		count0 = bestCount0;
+
+		if (bestMoves == 0)
+			break;
+	}
+}
+
+template TopologyPartitioner::Partition TopologyPartitioner::partition<Real>(SystemTopology& system);
+template TopologyPartitioner::Partition TopologyPartitioner::partition<Complex>(SystemTopology& system);
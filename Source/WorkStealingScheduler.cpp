@@ -0,0 +1,199 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile, Int spinCount) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mSpinCount(spinCount),
+	mQueues(threads > 0 ? threads : 1), mRemaining(0), mGeneration(0), mParked(0), mJoining(false) {
+	if (threads < 1)
+		throw SchedulingException();
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+	// threads have to be joined before they are destroyed
+	if (!mThreads.empty())
+		stop();
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	// The scheduler may be reused for another task graph, e.g. after the
+	// steady-state initialization
+	joinThreads();
+
+	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+	if (!mOutMeasurementFile.empty())
+		Scheduler::initMeasurements(ordered);
+
+	mSchedule.compile(ordered, inEdges);
+	mSourceTasks.clear();
+	for (Int i = 0; i < mSchedule.size(); i++) {
+		mSchedule.counter(i).store(mSchedule.inDegree(i), std::memory_order_relaxed);
+		if (mSchedule.inDegree(i) == 0)
+			mSourceTasks.push_back(i);
+	}
+
+	for (auto& queue : mQueues) {
+		queue.tasks.resize(mSchedule.size());
+		queue.top = 0;
+		queue.bottom = 0;
+	}
+
+	for (Int i = 1; i < mNumThreads; i++) {
+		mThreads.emplace_back(threadFunction, this, i);
+	}
+}
+
+void WorkStealingScheduler::push(Int thread, Int task) {
+	WorkerQueue& queue = mQueues[thread];
+	std::lock_guard<std::mutex> lk(queue.mutex);
+	queue.tasks[queue.bottom++] = task;
+}
+
+Bool WorkStealingScheduler::pop(Int thread, Int& task) {
+	WorkerQueue& queue = mQueues[thread];
+	std::lock_guard<std::mutex> lk(queue.mutex);
+	if (queue.bottom == queue.top)
+		return false;
+	task = queue.tasks[--queue.bottom];
+	return true;
+}
+
+Bool WorkStealingScheduler::steal(Int thread, Int& task) {
+	for (Int i = 1; i < mNumThreads; i++) {
+		WorkerQueue& queue = mQueues[(thread + i) % mNumThreads];
+		std::lock_guard<std::mutex> lk(queue.mutex);
+		if (queue.bottom != queue.top) {
+			task = queue.tasks[queue.top++];
+			return true;
+		}
+	}
+	return false;
+}
+
+Int WorkStealingScheduler::execute(Int thread, Int idx) {
+	Task* task = mSchedule.task(idx);
+	if (mOutMeasurementFile.empty()) {
+		task->execute(mTime, mTimeStepCount);
+	} else {
+		auto start = std::chrono::steady_clock::now();
+		task->execute(mTime, mTimeStepCount);
+		auto end = std::chrono::steady_clock::now();
+		updateMeasurement(task, end-start);
+	}
+
+	// The last finishing predecessor releases the successor. The first
+	// released successor is executed next by this thread without going
+	// through the deque, the others are pushed to the own deque so that
+	// the data of the chain stays in this thread's cache.
+	Int next = -1;
+	for (const Int* after = mSchedule.successorsBegin(idx); after != mSchedule.successorsEnd(idx); ++after) {
+		if (mSchedule.counter(*after).fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			if (next < 0)
+				next = *after;
+			else
+				push(thread, *after);
+		}
+	}
+	mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+	return next;
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+	Int task = -1;
+	while (mRemaining.load(std::memory_order_acquire) > 0) {
+		if (task >= 0 || pop(thread, task) || steal(thread, task))
+			task = execute(thread, task);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	// No task is running here since the previous step only returned after
+	// every task finished, so the counters and deques can be reset safely
+	for (Int i = 0; i < mSchedule.size(); i++)
+		mSchedule.counter(i).store(mSchedule.inDegree(i), std::memory_order_relaxed);
+	for (auto& queue : mQueues) {
+		std::lock_guard<std::mutex> lk(queue.mutex);
+		queue.top = 0;
+		queue.bottom = 0;
+	}
+	// A worker that is still leaving the previous step may already pick up
+	// a source task, so the task counter has to be set before the first push
+	mRemaining.store(mSchedule.size(), std::memory_order_release);
+	for (size_t i = 0; i < mSourceTasks.size(); i++)
+		push(static_cast<Int>(i % mNumThreads), mSourceTasks[i]);
+
+	// Wake up the workers. Both the generation update and the read of the
+	// parked counter are sequentially consistent, so either a worker sees
+	// the new generation before it parks or we see it parked and notify it.
+	mGeneration.fetch_add(1);
+	if (mParked.load() > 0) {
+		std::lock_guard<std::mutex> lk(mParkMutex);
+		mCondition.notify_all();
+	}
+
+	doStep(0);
+}
+
+void WorkStealingScheduler::joinThreads() {
+	if (mThreads.empty())
+		return;
+
+	mJoining = true;
+	mGeneration.fetch_add(1);
+	{
+		std::lock_guard<std::mutex> lk(mParkMutex);
+		mCondition.notify_all();
+	}
+	for (size_t thread = 0; thread < mThreads.size(); thread++) {
+		mThreads[thread].join();
+	}
+	mThreads.clear();
+	mJoining = false;
+}
+
+void WorkStealingScheduler::stop() {
+	joinThreads();
+	if (!mOutMeasurementFile.empty()) {
+		writeMeasurements(mOutMeasurementFile);
+	}
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler* sched, Int idx) {
+	Int generation = sched->mGeneration.load(std::memory_order_acquire);
+	while (true) {
+		// Spin for a while as the next step usually starts soon,
+		// then park until the main thread starts a step
+		Int spins = 0;
+		while (sched->mGeneration.load(std::memory_order_acquire) == generation && spins < sched->mSpinCount) {
+			spins++;
+		}
+		if (sched->mGeneration.load() == generation) {
+			std::unique_lock<std::mutex> lk(sched->mParkMutex);
+			sched->mParked.fetch_add(1);
+			while (sched->mGeneration.load() == generation)
+				sched->mCondition.wait(lk);
+			sched->mParked.fetch_sub(1);
+		}
+		generation = sched->mGeneration.load(std::memory_order_acquire);
+
+		if (sched->mJoining)
+			return;
+
+		sched->doStep(idx);
+	}
+}
@@ -38,6 +38,17 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.value("critical", CPS::Logger::Level::critical)
 		.value("off", CPS::Logger::Level::off);		
 
+	py::enum_<DPsim::DataLogger::OverflowPolicy>(m, "OverflowPolicy")
+		.value("block", DPsim::DataLogger::OverflowPolicy::block)
+		.value("drop_oldest", DPsim::DataLogger::OverflowPolicy::dropOldest)
+		.value("downsample", DPsim::DataLogger::OverflowPolicy::downsample);
+
+	py::enum_<DPsim::MnaNodeOrdering>(m, "NodeOrdering")
+		.value("natural", DPsim::MnaNodeOrdering::Natural)
+		.value("rcm", DPsim::MnaNodeOrdering::RCM)
+		.value("amd", DPsim::MnaNodeOrdering::AMD)
+		.value("colamd", DPsim::MnaNodeOrdering::COLAMD);
+
     py::class_<DPsim::Simulation>(m, "Simulation")
 	    .def(py::init<std::string, CPS::Logger::Level>(), py::arg("name"), py::arg("loglevel") = CPS::Logger::Level::off)
 		.def("name", &DPsim::Simulation::name)
@@ -52,12 +63,20 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("next", &DPsim::Simulation::next)
 		.def("set_idobj_attr", static_cast<void (DPsim::Simulation::*)(const std::string&, const std::string&, CPS::Real)>(&DPsim::Simulation::setIdObjAttr))
 		.def("set_idobj_attr", static_cast<void (DPsim::Simulation::*)(const std::string&, const std::string&, CPS::Complex)>(&DPsim::Simulation::setIdObjAttr))
-		.def("get_real_idobj_attr", &DPsim::Simulation::getRealIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0)
-		.def("get_comp_idobj_attr", &DPsim::Simulation::getComplexIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0)
+		.def("get_real_idobj_attr", &DPsim::Simulation::getRealIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0, py::arg("scenario") = 0)
+		.def("get_comp_idobj_attr", &DPsim::Simulation::getComplexIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0, py::arg("scenario") = 0)
 		.def("add_interface", &DPsim::Simulation::addInterface, py::arg("interface"), py::arg("syncStart") = false)
 		.def("export_attr", &DPsim::Simulation::exportIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("idx"), py::arg("modifier"), py::arg("row") = 0, py::arg("col") = 0)
 		.def("import_attr", &DPsim::Simulation::importIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("idx"))
-		.def("log_attr", &DPsim::Simulation::logIdObjAttr);
+		.def("log_attr", &DPsim::Simulation::logIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("scenario") = 0)
+		.def("set_async_logging", &DPsim::Simulation::setAsyncLogging, py::arg("capacity") = 1024, py::arg("policy") = DPsim::DataLogger::OverflowPolicy::block)
+		.def("set_auto_tearing", &DPsim::Simulation::setAutoTearing, py::arg("parts"), py::arg("measurement_file") = "")
+		.def("set_node_ordering", &DPsim::Simulation::setNodeOrdering)
+		.def("do_complex_native_system", &DPsim::Simulation::doComplexNativeSystem)
+		.def("add_scenario", &DPsim::Simulation::addScenario)
+		.def("num_scenarios", &DPsim::Simulation::numScenarios)
+		.def("write_checkpoint", static_cast<void (DPsim::Simulation::*)(const CPS::String&)>(&DPsim::Simulation::writeCheckpoint))
+		.def("read_checkpoint", static_cast<void (DPsim::Simulation::*)(const CPS::String&)>(&DPsim::Simulation::readCheckpoint));
 
 	py::class_<DPsim::RealTimeSimulation, DPsim::Simulation>(m, "RealTimeSimulation")
 		.def(py::init<std::string, CPS::Logger::Level>(), py::arg("name"), py::arg("loglevel") = CPS::Logger::Level::info)
@@ -71,11 +90,11 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("set_domain", &DPsim::RealTimeSimulation::setDomain)
 		.def("set_idobj_attr", static_cast<void (DPsim::RealTimeSimulation::*)(const std::string&, const std::string&, CPS::Real)>(&DPsim::Simulation::setIdObjAttr))
 		.def("set_idobj_attr", static_cast<void (DPsim::RealTimeSimulation::*)(const std::string&, const std::string&, CPS::Complex)>(&DPsim::Simulation::setIdObjAttr))
-		.def("get_real_idobj_attr", &DPsim::RealTimeSimulation::getRealIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0)
-		.def("get_comp_idobj_attr", &DPsim::RealTimeSimulation::getComplexIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0)
+		.def("get_real_idobj_attr", &DPsim::RealTimeSimulation::getRealIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0, py::arg("scenario") = 0)
+		.def("get_comp_idobj_attr", &DPsim::RealTimeSimulation::getComplexIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("row") = 0, py::arg("col") = 0, py::arg("scenario") = 0)
 		.def("add_interface", &DPsim::RealTimeSimulation::addInterface, py::arg("interface"), py::arg("syncStart") = false)
 		.def("export_attr", &DPsim::RealTimeSimulation::exportIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("idx"), py::arg("modifier"), py::arg("row") = 0, py::arg("col") = 0)
-		.def("log_attr", &DPsim::RealTimeSimulation::logIdObjAttr);
+		.def("log_attr", &DPsim::RealTimeSimulation::logIdObjAttr, py::arg("obj"), py::arg("attr"), py::arg("scenario") = 0);
 
 
 	py::class_<CPS::SystemTopology, std::shared_ptr<CPS::SystemTopology>>(m, "SystemTopology")
@@ -91,7 +110,16 @@ PYBIND11_MODULE(dpsimpy, m) {
 
 	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
         .def(py::init<std::string>())
-		.def("log_attribute", (void (DPsim::DataLogger::*)(const CPS::String &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute);
+		.def("log_attribute", (void (DPsim::DataLogger::*)(const CPS::String &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute)
+		.def("set_async", &DPsim::DataLogger::setAsync, py::arg("capacity") = 1024, py::arg("policy") = DPsim::DataLogger::OverflowPolicy::block)
+		.def_property_readonly("overflows", [](DPsim::DataLogger &logger) { return logger.attribute<CPS::Int>("overflows")->get(); })
+		.def_property_readonly("dropped_rows", [](DPsim::DataLogger &logger) { return logger.attribute<CPS::Int>("dropped_rows")->get(); });
+
+	py::class_<DPsim::BinaryDataLogger, DPsim::DataLogger, std::shared_ptr<DPsim::BinaryDataLogger>>(m, "BinaryLogger")
+		.def(py::init<std::string>())
+		.def_static("convert_to_csv", [](const std::string &binFilename, const std::string &csvFilename) {
+			DPsim::BinaryDataLogger::convertToCsv(binFilename, csvFilename);
+		});
 
 	py::class_<CPS::IdentifiedObject, std::shared_ptr<CPS::IdentifiedObject>>(m, "IdentifiedObject")
 		.def("name", &CPS::IdentifiedObject::name);
@@ -135,7 +163,8 @@ PYBIND11_MODULE(dpsimpy, m) {
 
 	py::class_<CPS::CSVReader>(m, "CSVReader")
 		.def(py::init<std::string, const std::string &, std::map<std::string, std::string> &, CPS::Logger::Level>())
-		.def("assignLoadProfile", &CPS::CSVReader::assignLoadProfile);
+		.def("assignLoadProfile", &CPS::CSVReader::assignLoadProfile)
+		.def("setProfileWindow", &CPS::CSVReader::setProfileWindow);
 
 	py::class_<CPS::TopologicalPowerComp, std::shared_ptr<CPS::TopologicalPowerComp>, CPS::IdentifiedObject>(m, "TopologicalPowerComp");
 	py::class_<CPS::SimPowerComp<CPS::Complex>, std::shared_ptr<CPS::SimPowerComp<CPS::Complex>>, CPS::TopologicalPowerComp>(m, "SimPowerCompComplex");
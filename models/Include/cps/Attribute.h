@@ -213,6 +213,13 @@ namespace Flags {
 			return *mValue;
 		}
 
+		/// Stored value regardless of the access flags, only used to restore checkpoints
+		T& storedValue() {
+			if (mFlags & Flags::getter)
+				throw AccessException();
+			return *mValue;
+		}
+
 		/// @brief User-defined assignment operator
 		///
 		/// Real v = 1.2;
@@ -321,9 +328,14 @@ namespace Flags {
 	public:
 		typedef std::shared_ptr<MatrixAttribute> Ptr;
 
+		/// Reads a coefficient without copying the matrix unless it is computed by a getter
+		T coeffValue(Index row, Index col) const {
+			return (mFlags & Flags::getter) ? this->getByValue()(row, col) : this->get()(row, col);
+		}
+
 		typename Attribute<T>::Ptr coeff(Index row, Index col) {
 			typename Attribute<T>::Getter get = [this, row, col]() -> T {
-				return this->getByValue()(row, col);
+				return this->coeffValue(row, col);
 			};
 			//typename Attribute<T>::Setter set = [](T n) -> void {
 			//	MatrixVar<T> &mat = this->getByValue();
@@ -345,9 +357,14 @@ namespace Flags {
 	public:
 		typedef std::shared_ptr<MatrixRealAttribute> Ptr;
 
+		/// Reads a coefficient without copying the matrix unless it is computed by a getter
+		Real coeffValue(Index row, Index col) const {
+			return (mFlags & Flags::getter) ? this->getByValue()(row, col) : this->get()(row, col);
+		}
+
 		typename Attribute<Real>::Ptr coeff(Index row, Index col) {
 			typename Attribute<Real>::Getter get = [this, row, col]() -> Real {
-				return this->getByValue()(row, col);
+				return this->coeffValue(row, col);
 			};
 			//typename Attribute<T>::Setter set = [](T n) -> void {
 			//	Matrix &mat = this->get();
@@ -369,9 +386,14 @@ namespace Flags {
 	public:
 		typedef std::shared_ptr<MatrixCompAttribute> Ptr;
 
+		/// Reads a coefficient without copying the matrix unless it is computed by a getter
+		Complex coeffValue(Index row, Index col) const {
+			return (mFlags & Flags::getter) ? this->getByValue()(row, col) : this->get()(row, col);
+		}
+
 		ComplexAttribute::Ptr coeff(Index row, Index col) {
 			ComplexAttribute::Getter get = [this, row, col]() -> Complex {
-				return this->getByValue()(row, col);
+				return this->coeffValue(row, col);
 			};
 			return std::make_shared<ComplexAttribute>(get, mFlags, shared_from_this());
 			//Complex *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
@@ -380,7 +402,7 @@ namespace Flags {
 
 		Attribute<Real>::Ptr coeffReal(Index row, Index col) {
 			Attribute<Real>::Getter get = [this, row, col]() -> Real {
-				return this->getByValue()(row,col).real();
+				return this->coeffValue(row, col).real();
 			};
 			return Attribute<Real>::make(get, mFlags, shared_from_this());
 			//Complex *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
@@ -390,7 +412,7 @@ namespace Flags {
 
 		Attribute<Real>::Ptr coeffImag(Index row, Index col) {
 			Attribute<Real>::Getter get = [this, row, col]() -> Real {
-				return this->getByValue()(row,col).imag();;
+				return this->coeffValue(row, col).imag();
 			};
 			return Attribute<Real>::make(get, mFlags, shared_from_this());
 		}
@@ -10,6 +10,7 @@
 
 #include <map>
 #include <list>
+#include <memory>
 #include <experimental/filesystem>
 
 #include <cps/Definitions.h>
@@ -19,6 +20,7 @@
 #include <cps/SimTerminal.h>
 #include <cps/Logger.h>
 #include <cps/SystemTopology.h>
+#include <cps/TopologyCache.h>
 
 /* ====== WARNING =======
  *
@@ -87,6 +89,15 @@ namespace CIM {
 		std::map<String, TopologicalTerminal::Ptr> mPowerflowTerminals;
 		///
 		Bool mUseProtectionSwitches = false;
+		/// Lookup tables of the parsed model, see buildIndex
+		struct Index;
+		std::unique_ptr<Index> mIndex;
+		/// Number of threads mapping the equipment
+		UInt mNumThreads;
+		/// Descriptions of the mapped components for the topology cache
+		TopologyCache mTopologyCache;
+		/// Directory of the topology cache, empty if disabled
+		std::experimental::filesystem::path mCacheDir;
 
 		// #### shunt component settings ####
 		/// activates global shunt capacitor setting
@@ -105,9 +116,12 @@ namespace CIM {
 		void processSvVoltage(CIMPP::SvVoltage* volt);
 		///
 		void processSvPowerFlow(CIMPP::SvPowerFlow* flow);
-		///
+		/// Creates the simulation node and the terminals of a topological node
 		template<typename VarType>
 		void processTopologicalNode(CIMPP::TopologicalNode* topNode);
+		/// Connects the terminals of a topological node to the mapped equipment
+		template<typename VarType>
+		void connectTopologicalNode(CIMPP::TopologicalNode* topNode);
 		///
 		void addFiles(const std::experimental::filesystem::path &filename);
 		/// Adds CIM files to list of files to be parsed.
@@ -116,33 +130,45 @@ namespace CIM {
 		/// Since all nodes have references to the equipment connected to them (via Terminals), but not
 		/// the other way around (which we need for instantiating the components), we collect that information here as well.
 		void parseFiles();
+		/// Sorts the objects of the model by class and resolves the references
+		/// needed by the mapping functions in one pass, so that these do not
+		/// have to scan the whole model for every component.
+		void buildIndex();
 		/// Returns list of components and nodes.
 		SystemTopology systemTopology();
+		/// Key of the topology cache for the files and the import settings
+		std::uint64_t cacheKey(const std::list<std::experimental::filesystem::path> &filenames);
+		/// Parses the files or reads the topology from the cache
+		SystemTopology loadCached(const std::list<std::experimental::filesystem::path> &filenames);
 
 		// #### Mapping Functions ####
 		/// Returns simulation node index which belongs to mRID.
 		Matrix::Index mapTopologicalNode(String mrid);
-		/// Maps CIM components to CPowerSystem components.
-		TopologicalPowerComp::Ptr mapComponent(BaseClass* obj);
+		/// Maps CIM components to descriptions of CPowerSystem components,
+		/// which are empty if the object is not mapped.
+		TopologyCache::Component mapComponent(BaseClass* obj);
+		/// Maps all equipment of the model to descriptions in parallel chunks
+		/// and creates the components in the order of the model
+		void mapEquipment();
 		/// Returns an RX-Line.
 		/// The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce different models such as PI and wave model.
-		TopologicalPowerComp::Ptr mapACLineSegment(CIMPP::ACLineSegment* line);
+		TopologyCache::Component mapACLineSegment(CIMPP::ACLineSegment* line);
 		/// Returns a transformer, either ideal or with RL elements to model losses.
-		TopologicalPowerComp::Ptr mapPowerTransformer(CIMPP::PowerTransformer *trans);
+		TopologyCache::Component mapPowerTransformer(CIMPP::PowerTransformer *trans);
 		/// Returns an IdealVoltageSource with voltage setting according to load flow data
 		/// at machine terminals. The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce real synchronous generator models here.
-		TopologicalPowerComp::Ptr mapSynchronousMachine(CIMPP::SynchronousMachine* machine);
+		TopologyCache::Component mapSynchronousMachine(CIMPP::SynchronousMachine* machine);
 		/// Returns an PQload with voltage setting according to load flow data.
 		/// Currently the only option is to create an RL-load.
 		/// The voltage should be given in kV and the angle in degree.
 		/// TODO: Introduce real PQload model here.
-		TopologicalPowerComp::Ptr mapEnergyConsumer(CIMPP::EnergyConsumer* consumer);
+		TopologyCache::Component mapEnergyConsumer(CIMPP::EnergyConsumer* consumer);
 		/// Returns an external grid injection.
-		TopologicalPowerComp::Ptr mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet);
+		TopologyCache::Component mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet);
 		/// Returns a shunt
-		TopologicalPowerComp::Ptr mapEquivalentShunt(CIMPP::EquivalentShunt *shunt);
+		TopologyCache::Component mapEquivalentShunt(CIMPP::EquivalentShunt *shunt);
 
 		// #### Helper Functions ####
 		/// Determine base voltage associated with object
@@ -191,6 +217,15 @@ namespace CIM {
 
 		/// If set, some components like loads include protection switches
 		void useProtectionSwitches(Bool value = true) { mUseProtectionSwitches = value; }
+		/// Sets the number of threads mapping the equipment, 0 uses all hardware threads
+		void setNumThreads(UInt numThreads);
+		/// \brief Enables the binary topology cache in the given directory.
+		///
+		/// loadCIM then stores the imported topology under a hash of the
+		/// contents of the files and the import settings and reads it from
+		/// there instead of parsing the files again. An empty path disables
+		/// the cache. The default is the environment variable CPS_CIM_CACHE_DIR.
+		void setCacheDirectory(const std::experimental::filesystem::path &dir) { mCacheDir = dir; }
 	};
 }
 }
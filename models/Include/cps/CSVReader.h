@@ -17,6 +17,7 @@
 #include <experimental/filesystem>
 #include <cps/Logger.h>
 #include <cps/SystemTopology.h>
+#include <cps/LoadProfile.h>
 #include <cps/SP/SP_Ph1_Load.h>
 #include <cps/DP/DP_Ph1_PQLoadCS.h>
 #include <cps/DP/DP_Ph1_AvVoltageSourceInverterDQ.h>
@@ -36,19 +37,16 @@ namespace CPS {
 		std::map <String, String> mAssignPattern;
 		/// Skip first row if it has no digits at beginning
 		Bool mSkipFirstRow = true;
+		/// Number of time steps of each assigned load profile kept in memory
+		UInt mProfileWindow = 0;
 
 	public:
 		/// set load profile assigning pattern. AUTO for assigning load profile name (csv file name) to load object with the same name (mName)
 		/// MANUAL for providing an assign pattern manually. see power flow example: CIM/CIGRE_MV_PowerFlowTest_LoadProfiles.cpp
 		enum class Mode { AUTO, MANUAL };
 
-		/*
-		 Time Stamp Format.
-         HHMMSS:  Hours : Minutes : Seconds, it be casted to the corresponding SECONDS.
-         SECONDS: profiles recorded with total seconds.
-         PVGEN: format comply with https://www.fein-aachen.org/projects/PVgenerator/
-		*/
-		enum class DataFormat { HHMMSS, SECONDS, HOURS, MINUTES };
+		/// Time stamp format, see LoadProfile::DataFormat
+		typedef LoadProfile::DataFormat DataFormat;
 
 		///
 		CSVReader(String name, std::list<std::experimental::filesystem::path> path, Logger::Level logLevel);
@@ -64,6 +62,9 @@ namespace CPS {
 		Real time_format_convert(const String& time);
 		/// Skip first row if it has no digits at beginning
 		void doSkipFirstRow(Bool value = true) { mSkipFirstRow = value; }
+		/// Number of time steps of each assigned load profile kept in memory.
+		/// Zero resamples the whole profile when it is assigned.
+		void setProfileWindow(UInt steps) { mProfileWindow = steps; }
 		///
 		MatrixRow csv2Eigen(const String& path);
 
@@ -86,8 +87,9 @@ namespace CPS {
 			CSVReader::Mode mode = CSVReader::Mode::AUTO,
 			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
 
-		/// TODO : deprecate in the future
 		/// read in load profile with time stamp format specified
+		/// \deprecated Not used by assignLoadProfile anymore, use LoadProfile,
+		/// which resamples the profile onto the time grid without a map lookup.
 		PowerProfile readLoadProfile(std::experimental::filesystem::path file,
 			Real start_time = -1, Real time_step = 1, Real end_time = -1,
 			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
@@ -95,7 +97,8 @@ namespace CPS {
 		std::vector<Real> readPQData (std::experimental::filesystem::path file,
 			Real start_time = -1, Real time_step = 1, Real end_time = -1,
 			CSVReader::DataFormat format = CSVReader::DataFormat::SECONDS);
-		/// assign load profile to corresponding load object
+		/// assign load profile to corresponding load object. The profile is
+		/// resampled onto the time grid of the simulation, see LoadProfile.
 		void assignLoadProfile(SystemTopology& sys,
 			Real start_time = -1, Real time_step = 1, Real end_time = -1,
 			CSVReader::Mode mode = CSVReader::Mode::AUTO,
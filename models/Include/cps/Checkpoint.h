@@ -0,0 +1,160 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include <cps/Definitions.h>
+#include <cps/IdentifiedObject.h>
+
+namespace CPS {
+	/// Writes simulation states as little-endian binary values to a stream.
+	class CheckpointWriter {
+	protected:
+		std::ostream& mOut;
+
+		virtual void writeBytes(const void* data, std::size_t size);
+
+	public:
+		CheckpointWriter(std::ostream& out) : mOut(out) { }
+		virtual ~CheckpointWriter() { }
+
+		void write(Bool value);
+		void write(Int value);
+		void write(UInt value);
+		virtual void write(Real value);
+		void write(Complex value);
+		void write(const String& value);
+		void write(const Matrix& value);
+		void write(const MatrixComp& value);
+		///
+		template<typename T>
+		void write(const std::vector<T>& values) {
+			write(static_cast<UInt>(values.size()));
+			for (auto& value : values)
+				write(value);
+		}
+
+		/// Writes all attributes of numeric type which store their value,
+		/// i.e. which are not computed by a getter
+		void writeAttributes(AttributeList& object);
+		/// Writes the attributes of an object and its subcomponents and the
+		/// internal states of objects implementing CheckpointInterface
+		void writeObject(IdentifiedObject& object);
+		/// Writes a subcomponent which is not created in every configuration
+		void writeSubObject(const IdentifiedObject::Ptr& object);
+	};
+
+	/// Reads simulation states written by CheckpointWriter.
+	/// Matrices keep their memory if their size does not change.
+	class CheckpointReader {
+	protected:
+		std::istream& mIn;
+
+		void readBytes(void* data, std::size_t size);
+
+	public:
+		CheckpointReader(std::istream& in) : mIn(in) { }
+		virtual ~CheckpointReader() { }
+
+		void read(Bool& value);
+		void read(Int& value);
+		void read(UInt& value);
+		virtual void read(Real& value);
+		void read(Complex& value);
+		void read(String& value);
+		void read(Matrix& value);
+		void read(MatrixComp& value);
+		///
+		template<typename T>
+		void read(std::vector<T>& values) {
+			UInt size;
+			read(size);
+			values.resize(size);
+			for (auto& value : values)
+				read(value);
+		}
+		///
+		template<typename T>
+		T read() {
+			T value;
+			read(value);
+			return value;
+		}
+
+		/// Restores the attributes written by CheckpointWriter::writeAttributes
+		void readAttributes(AttributeList& object);
+		/// Restores the states written by CheckpointWriter::writeObject.
+		/// The object must have the name and structure of the written one.
+		void readObject(IdentifiedObject& object);
+		/// Restores a subcomponent written by CheckpointWriter::writeSubObject
+		void readSubObject(const IdentifiedObject::Ptr& object);
+	};
+
+	/// Writes the real values of a checkpoint, which includes all complex
+	/// values and matrices, to a vector instead of the stream, so that the
+	/// states of several steps can be combined numerically. Everything else,
+	/// i.e. names, sizes and integer values, is still written to the stream.
+	class CheckpointVectorWriter : public CheckpointWriter {
+	protected:
+		std::vector<Real>& mValues;
+		/// FNV-1a hash of all values written to the stream
+		std::uint64_t mHash = 14695981039346656037ULL;
+
+		void writeBytes(const void* data, std::size_t size);
+
+	public:
+		/// The values are appended to the vector
+		CheckpointVectorWriter(std::ostream& out, std::vector<Real>& values) :
+			CheckpointWriter(out), mValues(values) { }
+
+		using CheckpointWriter::write;
+		void write(Real value) { mValues.push_back(value); }
+		/// Hash of the values that were not written to the vector. States
+		/// with the same hash have the same structure and integer values.
+		std::uint64_t hash() const { return mHash; }
+	};
+
+	/// Reads a checkpoint written by CheckpointVectorWriter and optionally
+	/// records where the real values are stored, so that the states can be
+	/// gathered and scattered later without traversing the objects again.
+	/// For this, CheckpointInterface implementations have to read real
+	/// values in place and must not copy them from local variables.
+	class CheckpointVectorReader : public CheckpointReader {
+	protected:
+		const std::vector<Real>& mValues;
+		std::size_t mPosition = 0;
+		std::vector<Real*>* mLocations;
+
+	public:
+		CheckpointVectorReader(std::istream& in, const std::vector<Real>& values,
+			std::vector<Real*>* locations = nullptr) :
+			CheckpointReader(in), mValues(values), mLocations(locations) { }
+
+		using CheckpointReader::read;
+		void read(Real& value);
+	};
+
+	/// Interface of components with internal states that are not stored in
+	/// attributes, like histories of previous values, or with subcomponents
+	/// that are not in the list of subcomponents.
+	class CheckpointInterface {
+	public:
+		typedef std::shared_ptr<CheckpointInterface> Ptr;
+
+		virtual ~CheckpointInterface() { }
+
+		/// Writes the internal states to a checkpoint
+		virtual void writeCheckpoint(CheckpointWriter& writer) = 0;
+		/// Restores the internal states in the order they were written
+		virtual void readCheckpoint(CheckpointReader& reader) = 0;
+	};
+}
@@ -32,6 +32,8 @@ namespace Ph1 {
 		// #### solver ####
 		/// Vector to collect subcomponent right vector stamps
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Rows the right side vector contributions can be non-zero in
+		std::vector<UInt> mRightVectorRows;
 
 	public:
 		/// Defines UID, name and logging level
@@ -55,7 +57,7 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Returns current through the component
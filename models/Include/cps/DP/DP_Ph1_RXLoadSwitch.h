@@ -28,6 +28,8 @@ namespace Ph1 {
 		Real mSwitchTimeOffset = 1.0;
 		/// Right side vectors of subcomponents
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Rows the right side vector contributions can be non-zero in
+		std::vector<UInt> mRightVectorRows;
 
 	public:
 		/// Defines UID, name and logging level
@@ -50,7 +52,7 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface current from MNA system result
@@ -73,7 +75,7 @@ namespace Ph1 {
 		/// Check if switch is closed
 		Bool mnaIsClosed() { return mSubSwitch->isClosed(); }
 		/// Stamps system matrix considering the defined switch position
-		void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed);
+		void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed);
 
 		class MnaPreStep : public Task {
 		public:
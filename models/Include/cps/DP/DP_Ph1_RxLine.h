@@ -13,6 +13,7 @@
 #include <cps/Base/Base_Ph1_PiLine.h>
 #include <cps/DP/DP_Ph1_Inductor.h>
 #include <cps/DP/DP_Ph1_Resistor.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace DP {
@@ -22,6 +23,7 @@ namespace Ph1 {
 		public SimPowerComp<Complex>,
 		public MNAInterface,
 		public Base::Ph1::PiLine,
+		public CheckpointInterface,
 		public SharedFactory<RxLine> {
 	protected:
 		/// Voltage across the component [V]
@@ -48,13 +50,19 @@ namespace Ph1 {
 		/// Initializes component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency);
 
+		// #### Checkpoint section ####
+		/// Writes the states of the subcomponents
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the states of the subcomponents
+		void readCheckpoint(CheckpointReader& reader);
+
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps system matrix
-		void mnaApplyInitialSystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplyInitialSystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		void mnaUpdateVoltage(const Matrix& leftVector);
@@ -13,6 +13,7 @@
 #include <cps/Base/Base_SynchronGenerator.h>
 #include <cps/DP/DP_Ph1_VoltageSource.h>
 #include <cps/DP/DP_Ph1_Inductor.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace DP {
@@ -24,6 +25,7 @@ namespace Ph1 {
 		public Base::SynchronGenerator,
 		public MNAInterface,
 		public SimPowerComp<Complex>,
+		public CheckpointInterface,
 		public SharedFactory<SynchronGeneratorTrStab> {
 	protected:
 		// #### Model specific variables ####
@@ -70,6 +72,12 @@ namespace Ph1 {
 		///
 		void initializeFromNodesAndTerminals(Real frequency);
 
+		// #### Checkpoint section ####
+		/// Writes the states of the subcomponents
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the states of the subcomponents
+		void readCheckpoint(CheckpointReader& reader);
+
 		// #### MNA Functions ####
 		/// Initializes variables of component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
@@ -79,7 +87,7 @@ namespace Ph1 {
 		///
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		///
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Retrieves calculated voltage from simulation for next step
 		void mnaPostStep(Matrix& rightVector, Matrix& leftVector, Real time);
 		///
@@ -44,7 +44,7 @@ namespace Ph3 {
 		///
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Update interface voltage from MNA system result
 		void mnaUpdateVoltage(const Matrix& leftVector);
 		/// Update interface current from MNA system result
@@ -54,7 +54,7 @@ namespace Ph3 {
 		/// Check if switch is closed
 		Bool mnaIsClosed() { return mIsClosed; }
 		/// Stamps system matrix considering the defined switch position
-		void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed);
+		void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed);
 
 		class MnaPostStep : public Task {
 		public:
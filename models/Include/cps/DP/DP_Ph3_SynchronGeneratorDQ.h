@@ -38,6 +38,10 @@ namespace Ph3 {
 		///
 		/// Balanced case because the zero sequence variable is ignored
 		MatrixComp dq0ToAbcTransform(Real theta, Matrix& dq0);
+		/// Park transform into a preallocated 3x1 vector
+		void abcToDq0Transform(Real theta, const MatrixComp& abc, Matrix& dq0);
+		/// Inverse Park transform into a preallocated 3x1 vector
+		void dq0ToAbcTransform(Real theta, const Matrix& dq0, MatrixComp& abc);
 
 		// #### Deprecated ###
 		/// calculate flux states using trapezoidal rule - depcrecated
@@ -80,7 +84,7 @@ namespace Ph3 {
 		///
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		///
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 
 		/// Retrieves calculated voltage from simulation for next step
 		virtual void mnaUpdateVoltage(const Matrix& leftVector);
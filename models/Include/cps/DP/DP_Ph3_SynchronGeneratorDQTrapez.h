@@ -46,6 +46,12 @@ namespace Ph3 {
 		Int mMultisamplingRate = 1;
 
 		// #### Trapezoidal Section ####
+		/// Flux state matrix at the current speed
+		Matrix mFluxStateMat;
+		/// Voltages scaled to the flux derivatives
+		Matrix mFluxInput;
+		/// Preallocated matrices of the flux integration
+		Math::StateSpaceWorkspace mStateSpaceWorkspace;
 
 		/// Performs an Euler forward step with the state space model of a synchronous generator
 		/// to calculate the flux and current from the voltage vector in per unit.
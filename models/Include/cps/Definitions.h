@@ -80,8 +80,12 @@ namespace CPS {
 	///
 	typedef Eigen::PartialPivLU<Matrix> LUFactorized;
 	///
+	typedef Eigen::PartialPivLU<MatrixComp> LUFactorizedComp;
+	///
 	typedef Eigen::SparseLU<SparseMatrix> LUFactorizedSparse;
 	///
+	typedef Eigen::SparseLU<SparseMatrixComp> LUFactorizedSparseComp;
+	///
 	typedef Eigen::Matrix<Real, Eigen::Dynamic, 1> Vector;
 	///
 	template<typename VarType>
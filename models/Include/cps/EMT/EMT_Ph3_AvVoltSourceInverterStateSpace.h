@@ -95,6 +95,11 @@ namespace Ph3 {
 		Matrix mD;
 		// park transform matrix
 		Matrix mParkTransform;
+		/// States and inputs of the next step
+		Matrix mNewStates = Matrix::Zero(14, 1);
+		Matrix mNewU = Matrix::Zero(6, 1);
+		/// Preallocated matrices of the integration
+		Math::StateSpaceWorkspace mStateSpaceWorkspace;
 
 	public:
 		AvVoltSourceInverterStateSpace(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -128,8 +133,8 @@ namespace Ph3 {
 		//update Ig_abc in matrix B
 		void updateLinearizedCoeffs();
 
-		Matrix getParkTransformMatrix(Real theta);
-		Matrix getInverseParkTransformMatrix(Real theta);
+		Eigen::Matrix<Real, 2, 3> getParkTransformMatrix(Real theta);
+		Eigen::Matrix<Real, 3, 2> getInverseParkTransformMatrix(Real theta);
 		Matrix parkTransform(Real theta, Real fa, Real fb, Real fc);
 		Matrix inverseParkTransform(Real theta, Real fd, Real fq, Real zero = 0.);
 
@@ -137,7 +142,7 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
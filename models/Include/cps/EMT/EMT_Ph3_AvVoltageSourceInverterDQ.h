@@ -86,6 +86,8 @@ namespace Ph3 {
 		// #### solver ####
 		///
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Rows the right side vector contributions can be non-zero in
+		std::vector<UInt> mRightVectorRows;
 
 	public:
 		/// Defines name amd logging level
@@ -124,7 +126,7 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Updates current through the component
@@ -14,6 +14,7 @@
 #include <cps/EMT/EMT_Ph3_Resistor.h>
 #include <cps/EMT/EMT_Ph3_Inductor.h>
 #include <cps/EMT/EMT_Ph3_Capacitor.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace EMT {
@@ -26,6 +27,7 @@ namespace Ph3 {
 		public SimPowerComp<Real>,
 		public MNAInterface,
 		public Base::Ph3::PiLine,
+		public CheckpointInterface,
 		public SharedFactory<PiLine> {
 	protected:
 		/// Series Inductance submodel
@@ -42,6 +44,8 @@ namespace Ph3 {
 		std::shared_ptr<Capacitor> mSubParallelCapacitor1;
 		/// solver
 		std::vector<const Matrix*> mRightVectorStamps;
+		/// Rows the right side vector contributions can be non-zero in
+		std::vector<UInt> mRightVectorRows;
 	public:
 		/// Defines UID, name and logging level
 		PiLine(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -55,11 +59,17 @@ namespace Ph3 {
 		/// Initializes component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency);
 
+		// #### Checkpoint section ####
+		/// Writes the states of the subcomponents
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the states of the subcomponents
+		void readCheckpoint(CheckpointReader& reader);
+
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Updates internal current variable of the component
@@ -13,6 +13,7 @@
 #include <cps/Base/Base_Ph3_PiLine.h>
 #include <cps/EMT/EMT_Ph3_Inductor.h>
 #include <cps/EMT/EMT_Ph3_Resistor.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace EMT {
@@ -22,6 +23,7 @@ namespace Ph3 {
 		public SimPowerComp<Real>,
 		public MNAInterface,
 		public Base::Ph3::PiLine,
+		public CheckpointInterface,
 		public SharedFactory<RxLine> {
 	protected:
 		/// Voltage across the component [V]
@@ -48,13 +50,19 @@ namespace Ph3 {
 		/// Initializes component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency);
 
+		// #### Checkpoint section ####
+		/// Writes the states of the subcomponents
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the states of the subcomponents
+		void readCheckpoint(CheckpointReader& reader);
+
 		// #### MNA section ####
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps system matrix
-		void mnaApplyInitialSystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplyInitialSystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		void mnaUpdateVoltage(const Matrix& leftVector);
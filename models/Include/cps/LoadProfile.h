@@ -0,0 +1,129 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <experimental/filesystem>
+
+#include <cps/Definitions.h>
+#include <cps/PowerProfile.h>
+
+namespace CPS {
+	/// Load profile of a csv file, which is resampled onto an equidistant
+	/// time grid by linear interpolation.
+	///
+	/// The rows of the file are either time,P,Q with P and Q in kW and kvar
+	/// or time,weighting factor, with increasing times. The resampled values
+	/// are accessed by the index of the grid step. Only a window of steps is
+	/// kept in memory. When a step outside of the window is accessed, the
+	/// next window is resampled from the file, which is read sequentially and
+	/// only rewound if an earlier step is accessed.
+	class LoadProfile {
+	public:
+		typedef std::shared_ptr<LoadProfile> Ptr;
+
+		/*
+		 Time Stamp Format.
+		 HHMMSS:  Hours : Minutes : Seconds, it be casted to the corresponding SECONDS.
+		 SECONDS: profiles recorded with total seconds.
+		 HOURS, MINUTES: profiles recorded with total hours or minutes.
+		*/
+		enum class DataFormat { HHMMSS, SECONDS, HOURS, MINUTES };
+
+		/// Opens the profile and resamples the first window onto the grid
+		/// startTime + k * timeStep up to endTime. A negative start or end
+		/// time is replaced by the first or last time of the file. A window
+		/// of zero steps resamples the whole grid at once and closes the file.
+		LoadProfile(const std::experimental::filesystem::path& file,
+			Real startTime, Real timeStep, Real endTime,
+			DataFormat format = DataFormat::SECONDS, UInt window = 0,
+			Bool skipFirstRow = true, Real scaleFactor = 1);
+
+		/// Rows with a weighting factor instead of P and Q
+		Bool hasWeightingFactors() const { return mWeightingFactors; }
+		/// Number of steps of the time grid
+		UInt numSteps() const { return mNumSteps; }
+		/// Number of steps kept in memory
+		UInt window() const { return mWindow; }
+		/// Number of windows resampled from the file so far
+		UInt numLoads() const { return mNumLoads; }
+		Real startTime() const { return mStartTime; }
+		Real timeStep() const { return mTimeStep; }
+
+		/// Index of the grid step nearest to the time, limited to the grid
+		UInt step(Real time) const;
+		/// Active and reactive power [W, var] at a grid step
+		PQData pq(UInt step) {
+			UInt pos = position(step);
+			return { mFirstValues[pos], mSecondValues[pos] };
+		}
+		/// Weighting factor at a grid step
+		Real weightingFactor(UInt step) {
+			return mFirstValues[position(step)];
+		}
+
+	private:
+		/// Row of the file after unit conversion
+		struct Sample {
+			Real time;
+			Real first;
+			Real second;
+		};
+
+		std::experimental::filesystem::path mFile;
+		std::ifstream mStream;
+		/// Position of the first data row
+		std::streampos mDataStart;
+		/// Line buffer, reused for all rows
+		String mLine;
+		UInt mLineNumber = 0;
+		UInt mDataLine = 0;
+		DataFormat mFormat;
+		Real mScaleFactor;
+		Bool mWeightingFactors = false;
+
+		Real mStartTime;
+		Real mTimeStep;
+		UInt mNumSteps;
+		UInt mWindow;
+		UInt mNumLoads = 0;
+
+		/// Last sample at or before the last resampled time and the sample
+		/// after it. Resampling only moves them forward.
+		Sample mPrev, mNext;
+		Bool mHavePrev = false, mHaveNext = false;
+
+		/// First grid step of the window
+		UInt mFirstStep = 0;
+		/// Number of resampled steps of the window
+		UInt mLoadedSteps = 0;
+		/// Resampled P or weighting factors and Q of the window
+		std::vector<Real> mFirstValues;
+		std::vector<Real> mSecondValues;
+
+		/// Position of a step in the window, which is loaded if necessary
+		UInt position(UInt step) {
+			if (step >= mNumSteps)
+				step = mNumSteps - 1;
+			if (step < mFirstStep || step >= mFirstStep + mLoadedSteps)
+				loadWindow(step);
+			return step - mFirstStep;
+		}
+		/// Resamples the window starting at the given step
+		void loadWindow(UInt first);
+		/// Parses the next data row of the file. Returns false at its end.
+		Bool readSample(Sample& sample);
+		/// Restarts reading at the first data row
+		void rewind();
+		/// Converts a time stamp to seconds
+		Real parseTime(const char* begin, char** end) const;
+	};
+}
@@ -167,21 +167,138 @@ namespace CPS {
 					addToMatrixElement(mat, rows[phase], columns[phase], value);
 		}
 
+		// #### Sparse matrix stamping ####
+		// Components stamp directly into the (row major) sparse system matrix.
+		// Entries are inserted on first access, so the sparsity pattern is
+		// built while stamping without a dense intermediate.
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) = value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) = value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) = - value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) = value.imag();
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) += value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) -= value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) += value.imag();
+		}
+
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) = value;
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value) {
+			for (UInt phase = 0; phase < rows.size(); phase++)
+					addToMatrixElement(mat, rows[phase], columns[phase], value);
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) += value;
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value) {
+			for (UInt phase = 0; phase < rows.size(); phase++)
+					addToMatrixElement(mat, rows[phase], columns[phase], value);
+		}
+
+		// #### Complex system conversion ####
+		// A complex system of size n is expanded to a real system of size 2n
+		// with the real parts in the upper and the imaginary parts in the
+		// lower half of the vectors (see setMatrixElement).
+
+		/// Complex vector of the expanded real vector
+		static void complexFromRealExpansion(const Matrix& vec, MatrixComp& comp) {
+			Eigen::Index size = vec.rows() / 2;
+			for (Eigen::Index col = 0; col < vec.cols(); ++col) {
+				for (Eigen::Index row = 0; row < size; ++row)
+					comp(row, col) = Complex(vec(row, col), vec(row + size, col));
+			}
+		}
+
+		/// Expanded real vector of the complex vector
+		static void realExpansionFromComplex(const MatrixComp& comp, Matrix& vec) {
+			Eigen::Index size = comp.rows();
+			for (Eigen::Index col = 0; col < comp.cols(); ++col) {
+				for (Eigen::Index row = 0; row < size; ++row) {
+					vec(row, col) = comp(row, col).real();
+					vec(row + size, col) = comp(row, col).imag();
+				}
+			}
+		}
+
+		/// Complex matrix of the expanded real matrix. Returns false if the
+		/// real matrix is not the expansion of a complex matrix, e.g. if a
+		/// component stamps real values into only one of the quadrants.
+		static Bool complexFromRealExpansion(const SparseMatrixRow& mat, SparseMatrixCompRow& comp);
+
 		// #### Integration Methods ####
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix input, Real dt);
+		/// Matrices of a state space integration which are reused from step
+		/// to step, so that the overloads writing into newStates do not
+		/// allocate once the workspace is sized.
+		struct StateSpaceWorkspace {
+			Matrix F1;
+			Matrix F2;
+			Matrix rhs;
+			Eigen::PartialPivLU<Matrix> lu;
+
+			/// Preallocates the matrices for a system with n states
+			void resize(Matrix::Index n) {
+				F1.resize(n, n);
+				F2.resize(n, n);
+				rhs.resize(n, 1);
+				lu = Eigen::PartialPivLU<Matrix>(n);
+			}
+		};
+
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u_new, const Matrix& u_old);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u_new, const Matrix& u_old);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& input, Real dt);
 		static Real StateSpaceTrapezoidal(Real states, Real A, Real B, Real C, Real dt, Real u);
 		static Real StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u);
 
-		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix B, Real dt, Matrix u);
-		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u);
-		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix input, Real dt);
+		static Matrix StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u);
+		static Matrix StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u);
+		static Matrix StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& input, Real dt);
 		static Real StateSpaceEuler(Real states, Real A, Real B, Real dt, Real u);
 		static Real StateSpaceEuler(Real states, Real A, Real B, Real C, Real dt, Real u);
 
+		// The results of these overloads are written into newStates, which
+		// may be the same matrix as states. F2 = I - dt/2 A is factorized
+		// instead of inverted.
+		static void StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u_new, const Matrix& u_old,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+		static void StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u_new, const Matrix& u_old,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+		static void StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+		static void StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+		static void StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& input, Real dt,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+
+		static void StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+		static void StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+		static void StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& input, Real dt,
+			Matrix& newStates, StateSpaceWorkspace& ws);
+
 		static void FFT(std::vector<Complex>& samples);
 
 		static Complex rotatingFrame2to1(Complex f2, Real theta1, Real theta2);
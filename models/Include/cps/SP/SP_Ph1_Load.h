@@ -17,7 +17,7 @@
 #include <cps/SP/SP_Ph1_Capacitor.h>
 #include <cps/SP/SP_Ph1_Inductor.h>
 #include <cps/SP/SP_Ph1_Resistor.h>
-#include <cps/PowerProfile.h>
+#include <cps/LoadProfile.h>
 
 namespace CPS {
 namespace SP { namespace Ph1 {
@@ -82,8 +82,8 @@ namespace SP { namespace Ph1 {
 		// #### General ####
 		/// Initializes component from power flow data
 		void initializeFromNodesAndTerminals(Real frequency) override;
-		/// Load profile data
-		PowerProfile mLoadProfile;
+		/// Load profile data on the time grid of the simulation
+		LoadProfile::Ptr mLoadProfile;
 		/// Use the assigned load profile
 		bool use_profile = false;
 		/// Update PQ for this load for power flow calculation at next time step
@@ -99,7 +99,7 @@ namespace SP { namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) override;
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix) override;
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) override;
 		/// Updates internal current variable of the component
 		void mnaUpdateCurrent(const Matrix& leftVector) override;
 		/// Updates internal voltage variable of the component
@@ -43,7 +43,7 @@ namespace Ph1 {
 		// #### General MNA section ####
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
@@ -74,7 +74,7 @@ namespace Ph1 {
 		/// Check if switch is closed
 		Bool mnaIsClosed() { return isClosed(); }
 		/// Stamps system matrix considering the defined switch position
-		void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed);
+		void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed);
 	};
 }
 }
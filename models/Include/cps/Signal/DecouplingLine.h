@@ -15,11 +15,13 @@
 #include <cps/SimPowerComp.h>
 #include <cps/SimSignalComp.h>
 #include <cps/Task.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace Signal {
 	class DecouplingLine :
 		public SimSignalComp,
+		public CheckpointInterface,
 		public SharedFactory<DecouplingLine> {
 	protected:
 		Real mDelay;
@@ -57,6 +59,10 @@ namespace Signal {
 		void step(Real time, Int timeStepCount);
 		void postStep();
 		Task::List getTasks();
+		/// Writes the ring buffers of previous values
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the ring buffers of previous values
+		void readCheckpoint(CheckpointReader& reader);
 		IdentifiedObject::List getLineComponents();
 
 		class PreStep : public Task {
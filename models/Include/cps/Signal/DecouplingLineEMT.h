@@ -14,11 +14,13 @@
 #include <cps/EMT/EMT_Ph1_Resistor.h>
 #include <cps/SimSignalComp.h>
 #include <cps/Task.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace Signal {
 	class DecouplingLineEMT :
 		public SimSignalComp,
+		public CheckpointInterface,
 		public SharedFactory<DecouplingLineEMT> {
 	protected:
 		Real mDelay;
@@ -55,6 +57,10 @@ namespace Signal {
 		void step(Real time, Int timeStepCount);
 		void postStep();
 		Task::List getTasks();
+		/// Writes the ring buffers of previous values
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the ring buffers of previous values
+		void readCheckpoint(CheckpointReader& reader);
 		IdentifiedObject::List getLineComponents();
 
 		class PreStep : public Task {
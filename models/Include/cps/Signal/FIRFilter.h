@@ -13,11 +13,13 @@
 #include <cps/SimPowerComp.h>
 #include <cps/SimSignalComp.h>
 #include <cps/Task.h>
+#include <cps/Checkpoint.h>
 
 namespace CPS {
 namespace Signal {
 	class FIRFilter :
 		public SimSignalComp,
+		public CheckpointInterface,
 		public SharedFactory<FIRFilter> {
 	protected:
 		std::vector<Real> mSignal;
@@ -38,6 +40,10 @@ namespace Signal {
 		void step(Real time);
 		void setInput(Attribute<Real>::Ptr input);
 		Task::List getTasks();
+		/// Writes the buffer of previous input samples
+		void writeCheckpoint(CheckpointWriter& writer);
+		/// Restores the buffer of previous input samples
+		void readCheckpoint(CheckpointReader& reader);
 
 		class Step : public Task {
 		public:
@@ -52,6 +52,8 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 2);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 2);
+		/// Preallocated matrices of the integration
+		Math::StateSpaceWorkspace mStateSpaceWorkspace;
 		
 	public:
 		PLL(String name, Logger::Level logLevel = Logger::Level::off);
@@ -72,6 +72,8 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 6);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 6);
+		/// Preallocated matrices of the integration
+		Math::StateSpaceWorkspace mStateSpaceWorkspace;
 
 	public:
 		PowerControllerVSI(String name, Logger::Level logLevel = Logger::Level::off);
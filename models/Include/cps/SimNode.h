@@ -98,6 +98,9 @@ namespace CPS {
 		// #### MNA Section ####
 		///
 		void mnaUpdateVoltage(const Matrix& leftVector);
+		/// Update the voltage from the solution of a system that is solved
+		/// as a complex matrix instead of its real expansion
+		void mnaUpdateVoltage(const MatrixComp& leftVector);
 		///
 		void mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVector);
 		///
@@ -142,6 +145,12 @@ namespace CPS {
 	template<>
 	void SimNode<Complex>::mnaUpdateVoltage(const Matrix& leftVector);
 
+	template<>
+	void SimNode<Real>::mnaUpdateVoltage(const MatrixComp& leftVector);
+
+	template<>
+	void SimNode<Complex>::mnaUpdateVoltage(const MatrixComp& leftVector);
+
 	template<>
 	void SimNode<Complex>::mnaInitializeHarm(std::vector<Attribute<Matrix>::Ptr> leftVector);
 
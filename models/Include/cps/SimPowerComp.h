@@ -149,5 +149,10 @@ namespace CPS {
 		virtual void initialize(Matrix frequencies);
 		/// Initializes Component variables according to power flow data stored in Nodes.
 		virtual void initializeFromNodesAndTerminals(Real frequency) { }
+		/// Sorted rows of a right side vector with the given number of rows
+		/// this component and its subcomponents can stamp into. These are the
+		/// rows of their nodes and virtual nodes. For complex variables, the
+		/// rows of the real and imaginary parts of all frequencies are included.
+		std::vector<UInt> rightVectorRows(UInt vectorRows, UInt numFreqs = 1);
 	};
 }
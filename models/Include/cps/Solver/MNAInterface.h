@@ -28,14 +28,9 @@ namespace CPS {
 		virtual void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			mnaInitialize(omega, timeStep);
 		}
-		/// Stamps system matrix
-		virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix) { }
-		/// Stamps (sparse) system matrix
-		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
-			Matrix mat = Matrix(systemMatrix);
-			mnaApplySystemMatrixStamp(mat);
-			systemMatrix = mat.sparseView();
-		}
+		/// Stamps system matrix. Components insert their entries directly into
+		/// the sparse matrix, dense solvers convert the assembled matrix once.
+		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) { }
 		/// Stamps right side (source) vector
 		virtual void mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
 		/// Update interface voltage from MNA system result
@@ -66,6 +61,19 @@ namespace CPS {
 			return mMnaTasks;
 		}
 	protected:
+		/// Sums the right side vector contributions of subcomponents into the
+		/// given rows of rightVector. Other rows are not written, because the
+		/// contributions are zero there.
+		static void mnaSumRightVectorStamps(Matrix& rightVector,
+			const std::vector<const Matrix*>& stamps, const std::vector<UInt>& rows) {
+			for (auto row : rows) {
+				Real sum = 0;
+				for (auto stamp : stamps)
+					sum += (*stamp)(row, 0);
+				rightVector(row, 0) = sum;
+			}
+		}
+
 		/// Every MNA component modifies its source vector attribute.
 		MNAInterface() {
 			addAttribute<Matrix>("right_vector", &mRightVector, Flags::read);
@@ -74,7 +82,13 @@ namespace CPS {
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
 		Task::List mMnaTasks;
 		/// This component's contribution ("stamp") to the right-side vector.
-		/// TODO performance improvements from a sparse representation, at least during copying / summation?
+		/// Only the rows of the nodes the component (or one of its subcomponents)
+		/// is connected to may be non-zero, the MNA solver skips all other rows.
+		/// The vector has the full system size, since the stamps address
+		/// global matrix node indices and derive the offset of imaginary parts
+		/// and harmonics from the vector size. Only the assembly by the solver
+		/// depends on the number of non-zero rows, the memory per component
+		/// still grows with the system size.
 		Matrix mRightVector;
 	};
 }
@@ -23,12 +23,6 @@ namespace CPS {
 		/// Check if switch is closed
 		virtual Bool mnaIsClosed() = 0;
 		/// Stamps system matrix considering the defined switch position
-		virtual void mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) { }
-		/// Stamps (sparse) system matrix considering the defined switch position
-		virtual void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
-			Matrix mat = Matrix(systemMatrix);
-			mnaApplySwitchSystemMatrixStamp(mat, closed);
-			systemMatrix = mat.sparseView();
-		}
+		virtual void mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) { }
 	};
 }
@@ -9,10 +9,11 @@
 #pragma once
 
 #include<vector>
+#include <cps/AttributeList.h>
 #include <cps/Definitions.h>
 
 namespace CPS {
-	class ODEintInterface {
+	class ODEintInterface : virtual public AttributeList {
 	public:
 		typedef std::shared_ptr<ODEintInterface> Ptr;
         using stateFnc = std::function<void(const double *,  double *,  const double )>;
@@ -20,7 +21,8 @@ namespace CPS {
 		// #### ODE Section ####
 		/// Returns number of differential variables
 		virtual int num_states() const=0;
-		/// Sets up ODE system in ydot
+		/// Sets up ODE system in ydot. The ODEintSolver stacks the states of
+		/// all its components, y and ydot only hold the states of this one.
 		virtual void odeint(const double y[], double ydot[], double t) = 0;
 
 		/// Needed for computations which have to be carried out before the numerical approximation step
@@ -29,7 +31,15 @@ namespace CPS {
 		virtual void post_step()=0;
 		///Returns Pointer to state Vector of the componente
 		virtual double* state_vector() = 0;
-		///Writes the computed solution to the component
-		virtual void set_state_vector(std::vector<double> y) = 0;
+		///Writes the computed solution with num_states() values to the component
+		virtual void set_state_vector(const double y[]) = 0;
+
+	protected:
+		ODEintInterface() {
+			addAttribute<Matrix>("ode_pre_state", &mOdePreState, Flags::read);
+			addAttribute<Matrix>("ode_post_state", &mOdePostState, Flags::read | Flags::write);
+		}
+
+		Matrix mOdePreState, mOdePostState;
 	};
 }
@@ -10,6 +10,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <unordered_map>
 
 #include <cps/TopologicalPowerComp.h>
 #include <cps/SimPowerComp.h>
@@ -35,7 +37,7 @@ namespace CPS {
 		/// by a solver to split the network into subnetworks
 		IdentifiedObject::List mTearComponents;
 		/// Map of network components connected to network nodes
-		std::map<TopologicalNode::Ptr, TopologicalPowerComp::List> mComponentsAtNode;
+		std::unordered_map<TopologicalNode::Ptr, TopologicalPowerComp::List> mComponentsAtNode;
 
 		// #### Deprecated ####
 		// Better use mFrequencies
@@ -65,6 +67,7 @@ namespace CPS {
 		SystemTopology(Real frequency, IdentifiedObject::List components)
 		: SystemTopology(frequency) {
 			mComponents = components;
+			updateComponentIndex();
 		}
 
 		/// Standard constructor for single frequency simulations
@@ -99,21 +102,11 @@ namespace CPS {
 			if (nodeReal) nodeReal->initialize(mFrequencies);
 
 			mNodes.push_back(topNode);
+			updateNodeIndex();
 		}
 
 		/// Adds node at specified position and initializes frequencies
-		void addNodeAt(TopologicalNode::Ptr topNode, UInt index) {
-			auto node = std::dynamic_pointer_cast<SimNode<Complex>>(topNode);
-			if (node) node->initialize(mFrequencies);
-
-			auto nodeReal = std::dynamic_pointer_cast<SimNode<Real>>(topNode);
-			if (nodeReal) nodeReal->initialize(mFrequencies);
-
-			if (index > mNodes.capacity())
-				mNodes.resize(index+1);
-
-			mNodes[index] = topNode;
-		}
+		void addNodeAt(TopologicalNode::Ptr topNode, UInt index);
 
 		/// Add multiple nodes
 		void addNodes(TopologicalNode::List topNodes) {
@@ -130,6 +123,7 @@ namespace CPS {
 			if (powerCompReal) powerCompReal->initialize(mFrequencies);
 
 			mComponents.push_back(component);
+			updateComponentIndex();
 		}
 
 		/// Connect component to simNodes
@@ -190,33 +184,36 @@ namespace CPS {
 		/// Returns TopologicalNode by name
 		template<typename Type>
 		typename std::shared_ptr<Type> node(const String &name) {
-			for (auto topoNode : mNodes) {
-				if (topoNode->name() == name) {
-					auto node = std::dynamic_pointer_cast<Type>(topoNode);
-					if (node)
-						return node;
-					else
-						return nullptr;
-				}
-			}
-			return nullptr;
+			return std::dynamic_pointer_cast<Type>(findNode(name, false));
+		}
+
+		/// Returns TopologicalNode by UID
+		template<typename Type>
+		typename std::shared_ptr<Type> nodeByUID(const String &uid) {
+			return std::dynamic_pointer_cast<Type>(findNode(uid, true));
 		}
 
 		/// Returns Component by name
 		template<typename Type>
 		typename std::shared_ptr<Type> component(const String &name) {
-			for (auto comp : mComponents) {
-				if (comp->name() == name) {
-					auto comp2 = std::dynamic_pointer_cast<Type>(comp);
-					if (comp2)
-						return comp2;
-					else
-						return nullptr;
-				}
-			}
-			return nullptr;
+			return std::dynamic_pointer_cast<Type>(findComponent(name, false));
+		}
+
+		/// Returns Component by UID
+		template<typename Type>
+		typename std::shared_ptr<Type> componentByUID(const String &uid) {
+			return std::dynamic_pointer_cast<Type>(findComponent(uid, true));
 		}
 
+		/// Removes the first component with the given name. Returns false
+		/// if there is no such component.
+		Bool removeComponent(const String &name);
+
+		/// Rebuilds the name and UID lookup indices. Has to be called after
+		/// nodes or components were removed from or reordered in the lists
+		/// directly instead of by the functions of the topology.
+		void rebuildIndices();
+
 		std::map<String, String> listIdObjects() {
 			std::map<String, String> objTypeMap;
 
@@ -234,6 +231,11 @@ namespace CPS {
 		/// Copy the whole topology the given number of times and add the resulting components and nodes to the topology.
 		void multiply(Int numberCopies);
 
+		/// Calls func for every pair of non-ground nodes connected by a power component
+		template <typename VarType>
+		void forEachConnectedNodePair(const std::function<void(typename CPS::SimNode<VarType>::Ptr,
+			typename CPS::SimNode<VarType>::Ptr, typename CPS::SimPowerComp<VarType>::Ptr)>& func);
+
 		///
 		template <typename VarType>
 		int checkTopologySubnets(std::unordered_map<typename CPS::SimNode<VarType>::Ptr, int>& subnet);
@@ -251,5 +253,29 @@ namespace CPS {
 	private:
 		template<typename VarType>
 		void multiplyPowerComps(Int numberCopies);
+
+		// #### Lookup indices ####
+		// The indices map names and UIDs to positions in the lists. They
+		// are updated by the add and remove functions. The lookups extend
+		// them by entries appended to the lists directly and rebuild them
+		// once if an entry does not match its key anymore.
+		// If several objects have the same name, the first one is found.
+
+		std::unordered_map<String, std::size_t> mNodeNames;
+		std::unordered_map<String, std::size_t> mNodeUIDs;
+		std::unordered_map<String, std::size_t> mComponentNames;
+		std::unordered_map<String, std::size_t> mComponentUIDs;
+		/// Number of list entries covered by the indices
+		std::size_t mIndexedNodes = 0;
+		std::size_t mIndexedComponents = 0;
+
+		/// Extends the indices by the entries not covered yet
+		void updateNodeIndex();
+		void updateComponentIndex();
+
+		/// Returns the first node with the given name or UID
+		TopologicalNode::Ptr findNode(const String &key, Bool byUID);
+		/// Returns the first component with the given name or UID
+		IdentifiedObject::Ptr findComponent(const String &key, Bool byUID);
 	};
 }
@@ -0,0 +1,72 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <experimental/filesystem>
+
+#include <cps/Definitions.h>
+#include <cps/Logger.h>
+#include <cps/SystemTopology.h>
+
+namespace CPS {
+	/// Compact binary description of an imported system topology, from
+	/// which the topology is rebuilt without importing it again.
+	///
+	/// Not all parameters of the components are accessible as attributes.
+	/// Therefore, components are stored as the arguments of the constructor
+	/// and the setters they were created with, see Component. Nodes are
+	/// stored with their matrix indices and initial voltages and terminals
+	/// with their nodes and powers.
+	class TopologyCache {
+	public:
+		/// Version of the binary format, to be increased on every change of
+		/// the format or of the meaning of the parameters of a component type
+		static const UInt version = 1;
+
+		/// Description of a component, from which createComponent creates it
+		struct Component {
+			/// Name of the component class, e.g. SP::Ph1::PiLine
+			String type;
+			String uid;
+			String name;
+			/// Arguments of the setters in the order createComponent uses them
+			std::vector<Real> parameters;
+		};
+
+		/// Creates a component from its description. The supported types and
+		/// parameters are the ones needed by the CIM reader.
+		static TopologicalPowerComp::Ptr createComponent(const Component& desc, Logger::Level logLevel);
+
+		/// FNV-1a hash of the contents of the files, which is combined with
+		/// the given hash of the import settings
+		static std::uint64_t hashFiles(const std::list<std::experimental::filesystem::path>& filenames, std::uint64_t seed);
+
+		/// Adds the description of a component of the topology to be written
+		void addComponent(const Component& desc) { mComponents[desc.uid] = desc; }
+		/// Removes all component descriptions
+		void clear() { mComponents.clear(); }
+
+		/// Writes the topology together with the key of its input. All
+		/// components must have been described with addComponent.
+		void write(std::ostream& out, std::uint64_t key, SystemTopology& system) const;
+		/// Rebuilds a topology written by write and adds the descriptions of
+		/// its components. Returns false without changing the system if the
+		/// file has another version or key.
+		Bool read(std::istream& in, std::uint64_t key, SystemTopology& system, Logger::Level logLevel);
+
+	private:
+		/// Descriptions of the components by UID
+		std::unordered_map<String, Component> mComponents;
+	};
+}
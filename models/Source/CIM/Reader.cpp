@@ -9,7 +9,20 @@
 #include <CIMModel.hpp>
 #include <IEC61970.hpp>
 #include <CIMExceptions.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
 #include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <spdlog/details/null_mutex.h>
+#include <spdlog/sinks/base_sink.h>
 
 #define READER_CPP
 #include <cps/CIM/Reader.h>
@@ -20,12 +33,64 @@ using CIMPP::UnitMultiplier;
 
 namespace fs = std::experimental::filesystem;
 
+/// Collects the messages of the mapping functions per mapped object, see
+/// Reader::mapEquipment. Each thread only adds to the list of the object it
+/// maps, so the sink needs no lock.
+class MapLogSink : public spdlog::sinks::base_sink<spdlog::details::null_mutex> {
+public:
+	/// Index of the object the calling thread maps
+	static thread_local std::size_t object;
+	/// Level and text of the messages of each object
+	std::vector<std::vector<std::pair<Logger::Level, String>>> messages;
+
+	MapLogSink(std::size_t objects) : messages(objects) { }
+
+protected:
+	void sink_it_(const spdlog::details::log_msg &msg) override {
+		messages[object].emplace_back(msg.level, String(msg.payload.data(), msg.payload.size()));
+	}
+	void flush_() override { }
+};
+
+thread_local std::size_t MapLogSink::object = 0;
+
+/// Lookup tables of the parsed model. Where several objects match, the
+/// tables keep the one the former scans over the model used, i.e. the first
+/// one for machines and the last one for tap steps and base voltages.
+struct Reader::Index {
+	std::vector<CIMPP::TopologicalNode*> topologicalNodes;
+	std::vector<CIMPP::SvVoltage*> svVoltages;
+	std::vector<CIMPP::SvPowerFlow*> svPowerFlows;
+	/// All other identified objects, which may be mapped to components
+	std::vector<CIMPP::IdentifiedObject*> equipment;
+	/// State of the tap changers
+	std::unordered_map<const CIMPP::TapChanger*, CIMPP::SvTapStep*> tapSteps;
+	/// Base voltages by name of the equipment
+	std::unordered_map<String, CIMPP::BaseVoltage*> baseVoltages;
+	/// Base voltages of the topological nodes by name of the connected equipment
+	std::unordered_map<String, CIMPP::BaseVoltage*> nodeBaseVoltages;
+	/// Generating units by mRID of their machines
+	std::unordered_map<String, CIMPP::GeneratingUnit*> generatingUnits;
+	/// Dynamic parameters by mRID of their machines
+	std::unordered_map<String, CIMPP::SynchronousMachineTimeConstantReactance*> machineDynamics;
+};
+
 Reader::Reader(String name, Logger::Level logLevel, Logger::Level componentLogLevel) {
 	mSLog = Logger::get(name + "_CIM", logLevel);
 
 	mModel = new CIMModel();
 	mModel->setDependencyCheckOff();
 	mComponentLogLevel = componentLogLevel;
+	setNumThreads(0);
+
+	if (char* dir = std::getenv("CPS_CIM_CACHE_DIR"))
+		mCacheDir = dir;
+}
+
+void Reader::setNumThreads(UInt numThreads) {
+	mNumThreads = numThreads > 0 ? numThreads : std::thread::hardware_concurrency();
+	if (mNumThreads == 0)
+		mNumThreads = 1;
 }
 
 Reader::~Reader() {
@@ -70,7 +135,7 @@ Real Reader::unitValue(Real value, CIMPP::UnitMultiplier mult) {
 	return value;
 }
 
-TopologicalPowerComp::Ptr Reader::mapComponent(BaseClass* obj) {
+TopologyCache::Component Reader::mapComponent(BaseClass* obj) {
 	if (CIMPP::ACLineSegment *line = dynamic_cast<CIMPP::ACLineSegment*>(obj))
 		return mapACLineSegment(line);
 	if (CIMPP::EnergyConsumer *consumer = dynamic_cast<CIMPP::EnergyConsumer*>(obj))
@@ -83,7 +148,7 @@ TopologicalPowerComp::Ptr Reader::mapComponent(BaseClass* obj) {
 		return mapExternalNetworkInjection(extnet);
 	if (CIMPP::EquivalentShunt *shunt = dynamic_cast<CIMPP::EquivalentShunt*>(obj))
 		return mapEquivalentShunt(shunt);
-	return nullptr;
+	return TopologyCache::Component();
 }
 
 void Reader::addFiles(const fs::path &filename) {
@@ -105,50 +170,35 @@ void Reader::parseFiles() {
 		return;
 	}
 
-	mSLog->info("#### List of TopologicalNodes, associated Terminals and Equipment");
-	for (auto obj : mModel->Objects) {
-		if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
-			if (mDomain == Domain::EMT)
-				processTopologicalNode<Real>(topNode);
-			else
-				processTopologicalNode<Complex>(topNode);
-		}
-	}
+	buildIndex();
 
-	// Collect voltage state variables associated to nodes that are used
-	// for various components.
-	mSLog->info("#### List of Node voltages and Terminal power flow data");
-	for (auto obj : mModel->Objects) {
-		// Check if object is of class SvVoltage
-		if (CIMPP::SvVoltage* volt = dynamic_cast<CIMPP::SvVoltage*>(obj)) {
-			processSvVoltage(volt);
-		}
-		// Check if object is of class SvPowerFlow
-		else if (CIMPP::SvPowerFlow* flow = dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
-			processSvPowerFlow(flow);
-		}
+	mSLog->info("#### List of TopologicalNodes and associated Terminals");
+	for (auto topNode : mIndex->topologicalNodes) {
+		if (mDomain == Domain::EMT)
+			processTopologicalNode<Real>(topNode);
+		else
+			processTopologicalNode<Complex>(topNode);
 	}
 
-	mSLog->info("#### Create other components");
-	for (auto obj : mModel->Objects) {
-
-		// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-		if (!dynamic_cast<CIMPP::TopologicalNode*>(obj)
-			&& !dynamic_cast<CIMPP::SvVoltage*>(obj)
-			&& !dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
-
-			if (CIMPP::IdentifiedObject* idObj = dynamic_cast<CIMPP::IdentifiedObject*>(obj)) {
+	mSLog->info("#### Create components");
+	mapEquipment();
 
-				// Check if object is already in equipment list
-				if (mPowerflowEquipment.find(idObj->mRID) == mPowerflowEquipment.end()) {
-					TopologicalPowerComp::Ptr comp = mapComponent(obj);
-					if (comp)
-						mPowerflowEquipment.insert(std::make_pair(comp->uid(), comp));
-				}
-			}
-		}
+	mSLog->info("#### Connect components to Terminals");
+	for (auto topNode : mIndex->topologicalNodes) {
+		if (mDomain == Domain::EMT)
+			connectTopologicalNode<Real>(topNode);
+		else
+			connectTopologicalNode<Complex>(topNode);
 	}
 
+	// Collect voltage state variables associated to nodes that are used
+	// for various components.
+	mSLog->info("#### List of Node voltages and Terminal power flow data");
+	for (auto volt : mIndex->svVoltages)
+		processSvVoltage(volt);
+	for (auto flow : mIndex->svPowerFlows)
+		processSvPowerFlow(flow);
+
 	mSLog->info("#### Check topology for unconnected components");
 	for (auto pfe : mPowerflowEquipment) {
 		auto c = pfe.second;
@@ -168,14 +218,134 @@ void Reader::parseFiles() {
 	}
 }
 
+void Reader::mapEquipment() {
+	// The equipment connected to the topological nodes comes first, as the
+	// nodes used to map it while creating their terminals
+	std::vector<CIMPP::IdentifiedObject*> objects;
+	std::unordered_set<String> listed;
+	for (auto topNode : mIndex->topologicalNodes) {
+		for (auto term : topNode->Terminal) {
+			CIMPP::ConductingEquipment* equipment = term->ConductingEquipment;
+			if (equipment && mPowerflowEquipment.find(equipment->mRID) == mPowerflowEquipment.end()
+				&& listed.insert(equipment->mRID).second)
+				objects.push_back(equipment);
+		}
+	}
+	for (auto idObj : mIndex->equipment) {
+		if (mPowerflowEquipment.find(idObj->mRID) == mPowerflowEquipment.end()
+			&& listed.insert(idObj->mRID).second)
+			objects.push_back(idObj);
+	}
+
+	// The objects are mapped independently of each other. Exceptions must not
+	// leave the threads, so the one of the first object is rethrown afterwards.
+	// The messages of the mapping functions are collected per object and the
+	// components are created afterwards, so that neither the log nor the
+	// component constructors depend on the order in which threads run.
+	std::vector<TopologyCache::Component> descs(objects.size());
+	std::vector<std::exception_ptr> errors(objects.size());
+	auto sink = std::make_shared<MapLogSink>(objects.size());
+	Logger::Log log = mSLog;
+	mSLog = std::make_shared<spdlog::logger>(log->name(), sink);
+	mSLog->set_level(log->level());
+
+	const std::size_t chunkSize = 64;
+	std::atomic<std::size_t> nextChunk(0);
+	auto mapChunks = [&]() {
+		for (std::size_t begin = nextChunk.fetch_add(chunkSize); begin < objects.size();
+			begin = nextChunk.fetch_add(chunkSize)) {
+			std::size_t end = std::min(begin + chunkSize, objects.size());
+			for (std::size_t i = begin; i < end; ++i) {
+				MapLogSink::object = i;
+				try {
+					descs[i] = mapComponent(objects[i]);
+				} catch (...) {
+					errors[i] = std::current_exception();
+				}
+			}
+		}
+	};
+
+	std::size_t numThreads = std::min<std::size_t>(mNumThreads, (objects.size() + chunkSize - 1) / chunkSize);
+	std::vector<std::thread> threads;
+	for (std::size_t t = 1; t < numThreads; ++t)
+		threads.emplace_back(mapChunks);
+	mapChunks();
+	for (auto& thread : threads)
+		thread.join();
+
+	mSLog = log;
+	for (std::size_t i = 0; i < objects.size(); ++i) {
+		for (auto& message : sink->messages[i])
+			mSLog->log(message.first, "{}", message.second);
+		if (errors[i])
+			std::rethrow_exception(errors[i]);
+	}
+
+	for (std::size_t i = 0; i < objects.size(); ++i) {
+		if (descs[i].type.empty())
+			continue;
+		mPowerflowEquipment.insert(std::make_pair(objects[i]->mRID,
+			TopologyCache::createComponent(descs[i], mComponentLogLevel)));
+		mTopologyCache.addComponent(descs[i]);
+	}
+	mSLog->info("Mapped {} of {} objects with {} threads", mPowerflowEquipment.size(), objects.size(), std::max<std::size_t>(numThreads, 1));
+}
+
+void Reader::buildIndex() {
+	mIndex.reset(new Index());
+
+	for (auto obj : mModel->Objects) {
+		if (auto topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
+			mIndex->topologicalNodes.push_back(topNode);
+			if (!topNode->BaseVoltage)
+				continue;
+			for (auto term : topNode->Terminal) {
+				if (term->ConductingEquipment)
+					mIndex->nodeBaseVoltages[term->ConductingEquipment->name] = topNode->BaseVoltage;
+			}
+			continue;
+		}
+		if (auto volt = dynamic_cast<CIMPP::SvVoltage*>(obj)) {
+			mIndex->svVoltages.push_back(volt);
+			continue;
+		}
+		if (auto flow = dynamic_cast<CIMPP::SvPowerFlow*>(obj)) {
+			mIndex->svPowerFlows.push_back(flow);
+			continue;
+		}
+
+		if (auto tapStep = dynamic_cast<CIMPP::SvTapStep*>(obj)) {
+			if (tapStep->TapChanger)
+				mIndex->tapSteps[tapStep->TapChanger] = tapStep;
+		}
+		else if (auto baseVolt = dynamic_cast<CIMPP::BaseVoltage*>(obj)) {
+			for (auto comp : baseVolt->ConductingEquipment)
+				mIndex->baseVoltages[comp->name] = baseVolt;
+		}
+		else if (auto genUnit = dynamic_cast<CIMPP::GeneratingUnit*>(obj)) {
+			for (auto machine : genUnit->RotatingMachine)
+				mIndex->generatingUnits.emplace(machine->mRID, genUnit);
+		}
+		else if (auto genDyn = dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance*>(obj)) {
+			if (genDyn->SynchronousMachine)
+				mIndex->machineDynamics.emplace(genDyn->SynchronousMachine->mRID, genDyn);
+		}
+
+		if (auto idObj = dynamic_cast<CIMPP::IdentifiedObject*>(obj))
+			mIndex->equipment.push_back(idObj);
+	}
+
+	mSLog->info("Indexed {} objects: {} topological nodes, {} other identified objects",
+		mModel->Objects.size(), mIndex->topologicalNodes.size(), mIndex->equipment.size());
+}
+
 SystemTopology Reader::loadCIM(Real systemFrequency, const fs::path &filename, Domain domain, PhaseType phase) {
 	mFrequency = systemFrequency;
 	mOmega = 2 * PI*mFrequency;
 	mDomain = domain;
 	mPhase = phase;
-	addFiles(filename);
-	parseFiles();
-	return systemTopology();
+	return loadCached({ filename });
 }
 
 SystemTopology Reader::loadCIM(Real systemFrequency, const std::list<fs::path> &filenames, Domain domain, PhaseType phase) {
@@ -183,9 +353,83 @@ SystemTopology Reader::loadCIM(Real systemFrequency, const std::list<fs::path> &
 	mOmega = 2 * PI*mFrequency;
 	mDomain = domain;
 	mPhase = phase;
+	return loadCached(filenames);
+}
+
+std::uint64_t Reader::cacheKey(const std::list<fs::path> &filenames) {
+	// All settings which change the mapping are part of the key
+	std::ostringstream settings;
+	settings << std::setprecision(17) << mFrequency << ' ' << static_cast<int>(mDomain) << ' '
+		<< static_cast<int>(mPhase) << ' ' << mGeneratorType << ' ' << mUseProtectionSwitches << ' '
+		<< mSetShuntCapacitor << ' ' << mShuntCapacitorValue << ' '
+		<< mSetShuntConductance << ' ' << mShuntConductanceValue;
+
+	std::uint64_t seed = 14695981039346656037ULL;
+	for (unsigned char c : settings.str()) {
+		seed ^= c;
+		seed *= 1099511628211ULL;
+	}
+	return TopologyCache::hashFiles(filenames, seed);
+}
+
+SystemTopology Reader::loadCached(const std::list<fs::path> &filenames) {
+	fs::path cacheFile;
+	std::uint64_t key = 0;
+	if (!mCacheDir.empty()) {
+		key = cacheKey(filenames);
+		std::ostringstream name;
+		name << std::hex << std::setw(16) << std::setfill('0') << key << ".topology";
+		cacheFile = mCacheDir / name.str();
+
+		std::ifstream in(cacheFile, std::ios::binary);
+		if (in) {
+			try {
+				SystemTopology system;
+				if (mTopologyCache.read(in, key, system, mComponentLogLevel)) {
+					mSLog->info("Read topology from cache {}", cacheFile.string());
+					return system;
+				}
+				mSLog->info("Ignoring outdated cache {}", cacheFile.string());
+			}
+			catch (SystemError& e) {
+				mSLog->warn("Ignoring invalid cache {}: {}", cacheFile.string(), e.descr());
+			}
+		}
+	}
+
 	addFiles(filenames);
 	parseFiles();
-	return systemTopology();
+	SystemTopology system = systemTopology();
+
+	if (!cacheFile.empty()) {
+		// Written to a temporary file first, so that concurrent imports
+		// never read a partially written cache
+		fs::path tmpFile = cacheFile;
+		tmpFile += "." + std::to_string(std::random_device()()) + ".tmp";
+		String error;
+		try {
+			fs::create_directories(mCacheDir);
+			{
+				std::ofstream out(tmpFile, std::ios::binary);
+				mTopologyCache.write(out, key, system);
+			}
+			fs::rename(tmpFile, cacheFile);
+			mSLog->info("Wrote topology to cache {}", cacheFile.string());
+		}
+		catch (SystemError& e) {
+			error = e.descr();
+		}
+		catch (std::exception& e) {
+			error = e.what();
+		}
+		if (!error.empty()) {
+			mSLog->warn("Failed to write topology cache {}: {}", cacheFile.string(), error);
+			std::error_code ec;
+			fs::remove(tmpFile, ec);
+		}
+	}
+
+	return system;
 }
 
 void Reader::processSvVoltage(CIMPP::SvVoltage* volt) {
@@ -207,7 +451,7 @@ void Reader::processSvVoltage(CIMPP::SvVoltage* volt) {
 		mSLog->info("    Angle={}", (float)volt->angle.value);
 	}catch(ReadingUninitializedField* e ){
 		volt->angle.value = 0;
-		std::cerr<< "Uninitialized Angle for SVVoltage at " << volt->TopologicalNode->name << ".Setting default value of " << volt->angle.value << std::endl;
+		mSLog->warn("Uninitialized Angle for SVVoltage at {}. Setting default value of {}", volt->TopologicalNode->name, volt->angle.value);
 	}
 	Real voltagePhase = volt->angle.value * PI / 180;
 	mPowerflowNodes[node->mRID]->setInitialVoltage(std::polar<Real>(voltageAbs, voltagePhase));
@@ -274,20 +518,19 @@ Matrix::Index Reader::mapTopologicalNode(String mrid) {
 	return search->second->matrixNodeIndex();
 }
 
-TopologicalPowerComp::Ptr Reader::mapEnergyConsumer(CIMPP::EnergyConsumer* consumer) {
+TopologyCache::Component Reader::mapEnergyConsumer(CIMPP::EnergyConsumer* consumer) {
 	mSLog->info("    Found EnergyConsumer {}", consumer->name);
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
-			return std::make_shared<EMT::Ph3::RXLoad>(consumer->mRID, consumer->name, mComponentLogLevel);
+			return { "EMT::Ph3::RXLoad", consumer->mRID, consumer->name, {} };
 		}
 		else
 		{
 		mSLog->info("    RXLoad for EMT not implemented yet");
-		return std::make_shared<DP::Ph1::RXLoad>(consumer->mRID, consumer->name, mComponentLogLevel);
+		return { "DP::Ph1::RXLoad", consumer->mRID, consumer->name, {} };
 		}
 	}
 	else if (mDomain == Domain::SP) {
-		auto load = std::make_shared<SP::Ph1::Load>(consumer->mRID, consumer->name, mComponentLogLevel);
 
 		// TODO: Use EnergyConsumer.P and EnergyConsumer.Q if available, overwrite if existent SvPowerFlow data
 		/*
@@ -300,20 +543,19 @@ TopologicalPowerComp::Ptr Reader::mapEnergyConsumer(CIMPP::EnergyConsumer* consu
 			q = unitValue(consumer->q.value,UnitMultiplier::M);
 		}*/
 
-		// P and Q values will be set according to SvPowerFlow data
-		load->setParameters(0, 0, 0);
-		load->modifyPowerFlowBusType(PowerflowBusType::PQ); // for powerflow solver set as PQ component as default
-		return load;
+		// P and Q values will be set according to SvPowerFlow data and the
+		// load is a PQ component for the powerflow solver by default
+		return { "SP::Ph1::Load", consumer->mRID, consumer->name, {} };
 	}
 	else {
 		if (mUseProtectionSwitches)
-			return std::make_shared<DP::Ph1::RXLoadSwitch>(consumer->mRID, consumer->name, mComponentLogLevel);
+			return { "DP::Ph1::RXLoadSwitch", consumer->mRID, consumer->name, {} };
 		else
-			return std::make_shared<DP::Ph1::RXLoad>(consumer->mRID, consumer->name, mComponentLogLevel);
+			return { "DP::Ph1::RXLoad", consumer->mRID, consumer->name, {} };
 	}
 }
 
-TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment* line) {
+TopologyCache::Component Reader::mapACLineSegment(CIMPP::ACLineSegment* line) {
 	mSLog->info("    Found ACLineSegment {} r={} x={} bch={} gch={}", line->name,
 		(float) line->r.value,
 		(float) line->x.value,
@@ -338,40 +580,31 @@ TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment* line) {
 
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
-			Matrix res_3ph = CPS::Math::singlePhaseParameterToThreePhase(resistance);
-			Matrix ind_3ph = CPS::Math::singlePhaseParameterToThreePhase(inductance);
-			Matrix cap_3ph = CPS::Math::singlePhaseParameterToThreePhase(capacitance);
-			Matrix cond_3ph = CPS::Math::singlePhaseParameterToThreePhase(conductance);
-
-			auto cpsLine = std::make_shared<EMT::Ph3::PiLine>(line->mRID, line->name, mComponentLogLevel);
-			cpsLine->setParameters(res_3ph, ind_3ph, cap_3ph, cond_3ph);
-			return cpsLine;
+			// The parameters are expanded to three phases on creation
+			return { "EMT::Ph3::PiLine", line->mRID, line->name,
+				{ resistance, inductance, capacitance, conductance } };
 		}
 		else {
 			mSLog->info("    PiLine for EMT not implemented yet");
-			auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line->mRID, line->name, mComponentLogLevel);
-			cpsLine->setParameters(resistance, inductance, capacitance, conductance);
-			return cpsLine;
+			return { "DP::Ph1::PiLine", line->mRID, line->name,
+				{ resistance, inductance, capacitance, conductance } };
 		}
 	}
 	else if (mDomain == Domain::SP) {
-		auto cpsLine = std::make_shared<SP::Ph1::PiLine>(line->mRID, line->name, mComponentLogLevel);
-		cpsLine->setParameters(resistance, inductance, capacitance, conductance);
-		cpsLine->setBaseVoltage(baseVoltage);
-		return cpsLine;
+		return { "SP::Ph1::PiLine", line->mRID, line->name,
+			{ resistance, inductance, capacitance, conductance, baseVoltage } };
 	}
 	else {
-		auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line->mRID, line->name, mComponentLogLevel);
-		cpsLine->setParameters(resistance, inductance, capacitance, conductance);
-		return cpsLine;
+		return { "DP::Ph1::PiLine", line->mRID, line->name,
+			{ resistance, inductance, capacitance, conductance } };
 	}
 
 }
 
-TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* trans) {
+TopologyCache::Component Reader::mapPowerTransformer(CIMPP::PowerTransformer* trans) {
 	if (trans->PowerTransformerEnd.size() != 2) {
 		mSLog->warn("PowerTransformer {} does not have exactly two windings, ignoring", trans->name);
-		return nullptr;
+		return TopologyCache::Component();
 	}
 	mSLog->info("Found PowerTransformer {}", trans->name);
 
@@ -380,7 +613,7 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 	for (auto end : trans->PowerTransformerEnd) {
 		if (end->Terminal->sequenceNumber == 1) end1 = end;
 		else if (end->Terminal->sequenceNumber == 2) end2 = end;
-		else return nullptr;
+		else return TopologyCache::Component();
 	}
 
 	// setting default values for non-set resistances and reactances
@@ -430,12 +663,9 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 
 	// if corresponding SvTapStep available, use instead tap position from there
 	if (end1->RatioTapChanger) {
-		for (auto obj : mModel->Objects) {
-			auto tapStep = dynamic_cast<CIMPP::SvTapStep*>(obj);
-			if (tapStep && tapStep->TapChanger == end1->RatioTapChanger) {
-				ratioAbs = voltageNode1 / voltageNode2 * (1 + (tapStep->position - end1->RatioTapChanger->neutralStep) * end1->RatioTapChanger->stepVoltageIncrement.value / 100);
-			}
-		}
+		auto tapStep = mIndex->tapSteps.find(end1->RatioTapChanger);
+		if (tapStep != mIndex->tapSteps.end())
+			ratioAbs = voltageNode1 / voltageNode2 * (1 + (tapStep->second->position - end1->RatioTapChanger->neutralStep) * end1->RatioTapChanger->stepVoltageIncrement.value / 100);
 	}
 
 	// TODO: To be extracted from cim class
@@ -460,37 +690,30 @@ TopologicalPowerComp::Ptr Reader::mapPowerTransformer(CIMPP::PowerTransformer* t
 		resistance = end1->r.value / std::pow(ratioAbsNominal, 2);
 	}
 
+	// The transformers have resistive losses if the resistance is positive
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
-			Matrix resistance_3ph = CPS::Math::singlePhaseParameterToThreePhase(resistance);
-			Matrix inductance_3ph = CPS::Math::singlePhaseParameterToThreePhase(inductance);
-			Bool withResistiveLosses = resistance > 0;
-			auto transformer = std::make_shared<EMT::Ph3::Transformer>(trans->mRID, trans->name, mComponentLogLevel, withResistiveLosses);
-			transformer->setParameters(voltageNode1, voltageNode2, ratioAbs, ratioPhase, resistance_3ph, inductance_3ph);
-			return transformer;
+			return { "EMT::Ph3::Transformer", trans->mRID, trans->name,
+				{ voltageNode1, voltageNode2, ratioAbs, ratioPhase, resistance, inductance } };
 		}
 		else
 		{
 			mSLog->info("    Transformer for EMT not implemented yet");
-			return nullptr;
+			return TopologyCache::Component();
 		}
 	}
 	else if (mDomain == Domain::SP) {
-		auto transformer = std::make_shared<SP::Ph1::Transformer>(trans->mRID, trans->name, mComponentLogLevel);
-		transformer->setParameters(voltageNode1, voltageNode2, ratedPower, ratioAbs, ratioPhase, resistance, inductance);
 		Real baseVolt = voltageNode1 >= voltageNode2 ? voltageNode1 : voltageNode2;
-		transformer->setBaseVoltage(baseVolt);
-		return transformer;
+		return { "SP::Ph1::Transformer", trans->mRID, trans->name,
+			{ voltageNode1, voltageNode2, ratedPower, ratioAbs, ratioPhase, resistance, inductance, baseVolt } };
 	}
 	else {
-		Bool withResistiveLosses = resistance > 0;
-		auto transformer = std::make_shared<DP::Ph1::Transformer>(trans->mRID, trans->name, mComponentLogLevel, withResistiveLosses);
-		transformer->setParameters(voltageNode1, voltageNode2, ratioAbs, ratioPhase, resistance, inductance);
-		return transformer;
+		return { "DP::Ph1::Transformer", trans->mRID, trans->name,
+			{ voltageNode1, voltageNode2, ratioAbs, ratioPhase, resistance, inductance } };
 	}
 }
 
-TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachine* machine) {
+TopologyCache::Component Reader::mapSynchronousMachine(CIMPP::SynchronousMachine* machine) {
 	mSLog->info("    Found  Synchronous machine {}", machine->name);
 
 	if (mGeneratorType == GeneratorType::Transient) {
@@ -499,137 +722,113 @@ TopologicalPowerComp::Ptr Reader::mapSynchronousMachine(CIMPP::SynchronousMachin
 		Real ratedPower;
 		Real ratedVoltage;
 
-		for (auto obj : mModel->Objects) {
-			// Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-			if (CIMPP::SynchronousMachineTimeConstantReactance* genDyn =
-				dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance*>(obj)) {
-				if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-					directTransientReactance = genDyn->xDirectTrans.value;
-					inertiaCoefficient = genDyn->inertia.value;
-
-					ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-
-					ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-					auto gen = DP::Ph1::SynchronGeneratorTrStab::make(machine->mRID, machine->name, mComponentLogLevel);
-					gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency,
-						directTransientReactance, inertiaCoefficient);
-					return gen;
-				}
-			}
+		auto dyn = mIndex->machineDynamics.find(machine->mRID);
+		if (dyn != mIndex->machineDynamics.end()) {
+			CIMPP::SynchronousMachineTimeConstantReactance* genDyn = dyn->second;
+			directTransientReactance = genDyn->xDirectTrans.value;
+			inertiaCoefficient = genDyn->inertia.value;
+
+			ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
+
+			ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
+			return { "DP::Ph1::SynchronGeneratorTrStab", machine->mRID, machine->name,
+				{ ratedPower, ratedVoltage, mFrequency, directTransientReactance, inertiaCoefficient } };
 		}
 	}
 
 	if (mDomain == Domain::SP) {
-		for (auto obj : mModel->Objects) {
-			if (CIMPP::GeneratingUnit* genUnit
-				= dynamic_cast<CIMPP::GeneratingUnit*>(obj))
-			{
-
-				for (auto syncGen : genUnit->RotatingMachine)
-				{
-                    if (syncGen->mRID == machine->mRID){
-
-						// Check whether relevant input data are set, otherwise set default values
-						Real setPointActivePower = 0;
-						Real setPointVoltage = 0;
-						Real maximumReactivePower = 1e12;
-						try{
-							setPointActivePower = unitValue(genUnit->initialP.value, UnitMultiplier::M);
-							mSLog->info("    setPointActivePower={}", setPointActivePower);
-						}catch(ReadingUninitializedField* e){
-							std::cerr << "Uninitalized setPointActivePower for GeneratingUnit " << machine->name << ". Using default value of " << setPointActivePower << std::endl;
-						}
-						if (machine->RegulatingControl) {
-							setPointVoltage = unitValue(machine->RegulatingControl->targetValue.value, UnitMultiplier::k);
-							mSLog->info("    setPointVoltage={}", setPointVoltage);
-						} else {
-							std::cerr << "Uninitalized setPointVoltage for GeneratingUnit " <<  machine->name << ". Using default value of " << setPointVoltage << std::endl;
-						}
-						try{
-							maximumReactivePower = unitValue(machine->maxQ.value, UnitMultiplier::M);
-							mSLog->info("    maximumReactivePower={}", maximumReactivePower);
-						}catch(ReadingUninitializedField* e){
-							std::cerr << "Uninitalized maximumReactivePower for GeneratingUnit " <<  machine->name << ". Using default value of " << maximumReactivePower << std::endl;
-						}
-
-						auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(machine->mRID, machine->name, mComponentLogLevel);
-							gen->setParameters(unitValue(machine->ratedS.value, UnitMultiplier::M),
-									unitValue(machine->ratedU.value, UnitMultiplier::k),
-									setPointActivePower,
-									setPointVoltage,
-									PowerflowBusType::PV);
-							gen->setBaseVoltage(unitValue(machine->ratedU.value, UnitMultiplier::k));
-						return gen;
-					}
-				}
-
+		auto unit = mIndex->generatingUnits.find(machine->mRID);
+		if (unit != mIndex->generatingUnits.end()) {
+			CIMPP::GeneratingUnit* genUnit = unit->second;
+
+			// Check whether relevant input data are set, otherwise set default values
+			Real setPointActivePower = 0;
+			Real setPointVoltage = 0;
+			Real maximumReactivePower = 1e12;
+			try{
+				setPointActivePower = unitValue(genUnit->initialP.value, UnitMultiplier::M);
+				mSLog->info("    setPointActivePower={}", setPointActivePower);
+			}catch(ReadingUninitializedField* e){
+				mSLog->warn("Uninitalized setPointActivePower for GeneratingUnit {}. Using default value of {}", machine->name, setPointActivePower);
+			}
+			if (machine->RegulatingControl) {
+				setPointVoltage = unitValue(machine->RegulatingControl->targetValue.value, UnitMultiplier::k);
+				mSLog->info("    setPointVoltage={}", setPointVoltage);
+			} else {
+				mSLog->warn("Uninitalized setPointVoltage for GeneratingUnit {}. Using default value of {}", machine->name, setPointVoltage);
+			}
+			try{
+				maximumReactivePower = unitValue(machine->maxQ.value, UnitMultiplier::M);
+				mSLog->info("    maximumReactivePower={}", maximumReactivePower);
+			}catch(ReadingUninitializedField* e){
+				mSLog->warn("Uninitalized maximumReactivePower for GeneratingUnit {}. Using default value of {}", machine->name, maximumReactivePower);
 			}
 
+			// PV component with the rated voltage as base voltage
+			return { "SP::Ph1::SynchronGenerator", machine->mRID, machine->name,
+				{ unitValue(machine->ratedS.value, UnitMultiplier::M),
+				  unitValue(machine->ratedU.value, UnitMultiplier::k),
+				  setPointActivePower,
+				  setPointVoltage } };
 		}
 		mSLog->info("no corresponding initial power for {}", machine->name);
-		return std::make_shared<SP::Ph1::SynchronGenerator>(machine->mRID, machine->name, mComponentLogLevel);
+		return { "SP::Ph1::SynchronGenerator", machine->mRID, machine->name, {} };
 	}
     else {
-        return std::make_shared<DP::Ph1::SynchronGeneratorIdeal>(machine->mRID, machine->name, mComponentLogLevel);
+        return { "DP::Ph1::SynchronGeneratorIdeal", machine->mRID, machine->name, {} };
     }
 }
 
-TopologicalPowerComp::Ptr Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet) {
+TopologyCache::Component Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection* extnet) {
 	mSLog->info("Found External Network Injection {}", extnet->name);
 
 	Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(extnet);
 
 	if (mDomain == Domain::EMT) {
 		if (mPhase == PhaseType::ABC) {
-			return std::make_shared<EMT::Ph3::NetworkInjection>(extnet->mRID, extnet->name, mComponentLogLevel);
+			return { "EMT::Ph3::NetworkInjection", extnet->mRID, extnet->name, {} };
 		}
 		else {
 			throw SystemError("Mapping of ExternalNetworkInjection for EMT::Ph1 not existent!");
-			return nullptr;
 		}
 	} else if(mDomain == Domain::SP) {
 		if (mPhase == PhaseType::Single) {
-			auto cpsextnet = std::make_shared<SP::Ph1::NetworkInjection>(extnet->mRID, extnet->name, mComponentLogLevel);
-			cpsextnet->modifyPowerFlowBusType(PowerflowBusType::VD); // for powerflow solver set as VD component as default
-			cpsextnet->setBaseVoltage(baseVoltage);
+			// VD component for the powerflow solver by default
+			TopologyCache::Component cpsextnet = { "SP::Ph1::NetworkInjection", extnet->mRID, extnet->name, { baseVoltage } };
 
 			try {
 				if(extnet->RegulatingControl){
 					mSLog->info("       Voltage set-point={}", (float) extnet->RegulatingControl->targetValue);
-					cpsextnet->setParameters(extnet->RegulatingControl->targetValue*baseVoltage); // assumes that value is specified in CIM data in per unit
+					cpsextnet.parameters.push_back(extnet->RegulatingControl->targetValue*baseVoltage); // assumes that value is specified in CIM data in per unit
 				} else {
 					mSLog->info("       No voltage set-point defined. Using 1 per unit.");
-					cpsextnet->setParameters(1.*baseVoltage);
+					cpsextnet.parameters.push_back(1.*baseVoltage);
 				}
 			} catch (ReadingUninitializedField* e ) {
-				std::cerr << "Ignore incomplete RegulatingControl" << std::endl;
+				mSLog->warn("Ignore incomplete RegulatingControl");
 			}
 
 			return cpsextnet;
 		}
 		else {
 			throw SystemError("Mapping of ExternalNetworkInjection for SP::Ph3 not existent!");
-			return nullptr;
 		}
 	} else {
 		if (mPhase == PhaseType::Single) {
-			return std::make_shared<DP::Ph1::NetworkInjection>(extnet->mRID, extnet->name, mComponentLogLevel);
+			return { "DP::Ph1::NetworkInjection", extnet->mRID, extnet->name, {} };
 		} else {
 			throw SystemError("Mapping of ExternalNetworkInjection for DP::Ph3 not existent!");
-			return nullptr;
 		}
 	}
 }
 
-TopologicalPowerComp::Ptr Reader::mapEquivalentShunt(CIMPP::EquivalentShunt* shunt){
+TopologyCache::Component Reader::mapEquivalentShunt(CIMPP::EquivalentShunt* shunt){
 	mSLog->info("Found shunt {}", shunt->name);
 
 	Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(shunt);
 
-	auto cpsShunt = std::make_shared<SP::Ph1::Shunt>(shunt->mRID, shunt->name, mComponentLogLevel);
-	cpsShunt->setParameters(shunt->g.value, shunt->b.value);
-	cpsShunt->setBaseVoltage(baseVoltage);
-	return cpsShunt;
+	return { "SP::Ph1::Shunt", shunt->mRID, shunt->name,
+		{ shunt->g.value, shunt->b.value, baseVoltage } };
 }
 
 void Reader::initDynamicSystemTopologyWithPowerflow(SystemTopology& systemPF, SystemTopology& system) {
@@ -646,28 +845,17 @@ void Reader::initDynamicSystemTopologyWithPowerflow(SystemTopology& systemPF, Sy
 Real Reader::determineBaseVoltageAssociatedWithEquipment(CIMPP::ConductingEquipment* equipment){
 	Real baseVoltage = 0;
 
-    // first look for baseVolt object to determine baseVoltage
-    for (auto obj : mModel->Objects) {
-        if (CIMPP::BaseVoltage* baseVolt = dynamic_cast<CIMPP::BaseVoltage*>(obj)) {
-            for (auto comp : baseVolt->ConductingEquipment) {
-                if (comp->name == equipment->name) {
-                    baseVoltage = unitValue(baseVolt->nominalVoltage.value,UnitMultiplier::k);
-                }
-            }
-        }
-    }
-    // as second option take baseVoltage of topologicalNode where equipment is connected to
-    if(baseVoltage == 0){
-        for (auto obj : mModel->Objects) {
-			if (CIMPP::TopologicalNode* topNode = dynamic_cast<CIMPP::TopologicalNode*>(obj)) {
-                for (auto term : topNode->Terminal) {
-					if (term->ConductingEquipment->name == equipment->name) {
-                        baseVoltage = unitValue(topNode->BaseVoltage->nominalVoltage.value,UnitMultiplier::k);
-					}
-				}
-			}
-		}
-    }
+	// first look for baseVolt object to determine baseVoltage
+	auto baseVolt = mIndex->baseVoltages.find(equipment->name);
+	if (baseVolt != mIndex->baseVoltages.end())
+		baseVoltage = unitValue(baseVolt->second->nominalVoltage.value,UnitMultiplier::k);
+
+	// as second option take baseVoltage of topologicalNode where equipment is connected to
+	if (baseVoltage == 0) {
+		auto nodeBaseVolt = mIndex->nodeBaseVoltages.find(equipment->name);
+		if (nodeBaseVolt != mIndex->nodeBaseVoltages.end())
+			baseVoltage = unitValue(nodeBaseVolt->second->nominalVoltage.value,UnitMultiplier::k);
+	}
 
 	return baseVoltage;
 }
@@ -699,33 +887,33 @@ void Reader::processTopologicalNode(CIMPP::TopologicalNode* topNode) {
 			term->sequenceNumber = 1;
 
 		mSLog->info("    Terminal {}, sequenceNumber {}", term->mRID, (int) term->sequenceNumber);
+	}
+}
 
+template<typename VarType>
+void Reader::connectTopologicalNode(CIMPP::TopologicalNode* topNode) {
+	for (auto term : topNode->Terminal) {
 		// Try to process Equipment connected to Terminal.
 		CIMPP::ConductingEquipment *equipment = term->ConductingEquipment;
 		if (!equipment) {
 			mSLog->warn("Terminal {} has no Equipment, ignoring!", term->mRID);
+			continue;
 		}
-		else {
-			// Insert Equipment if it does not exist in the map and add reference to Terminal.
-			// This could be optimized because the Equipment is searched twice.
-			if (mPowerflowEquipment.find(equipment->mRID) == mPowerflowEquipment.end()) {
-				TopologicalPowerComp::Ptr comp = mapComponent(equipment);
-				if (comp) {
-					mPowerflowEquipment.insert(std::make_pair(equipment->mRID, comp));
-				} else {
-					mSLog->warn("Could not map equipment {}", equipment->mRID);
-					continue;
-				}
-			}
 
-			auto pfEquipment = mPowerflowEquipment.at(equipment->mRID);
-			std::dynamic_pointer_cast<SimPowerComp<VarType>>(pfEquipment)->setTerminalAt(
-				std::dynamic_pointer_cast<SimTerminal<VarType>>(mPowerflowTerminals[term->mRID]), term->sequenceNumber-1);
-
-			mSLog->info("        Added Terminal {} to Equipment {}", term->mRID, equipment->mRID);
+		auto pfEquipment = mPowerflowEquipment.find(equipment->mRID);
+		if (pfEquipment == mPowerflowEquipment.end()) {
+			mSLog->warn("Could not map equipment {}", equipment->mRID);
+			continue;
 		}
+
+		std::dynamic_pointer_cast<SimPowerComp<VarType>>(pfEquipment->second)->setTerminalAt(
+			std::dynamic_pointer_cast<SimTerminal<VarType>>(mPowerflowTerminals[term->mRID]), term->sequenceNumber-1);
+
+		mSLog->info("        Added Terminal {} to Equipment {}", term->mRID, equipment->mRID);
 	}
 }
 
 template void Reader::processTopologicalNode<Real>(CIMPP::TopologicalNode* topNode);
 template void Reader::processTopologicalNode<Complex>(CIMPP::TopologicalNode* topNode);
+template void Reader::connectTopologicalNode<Real>(CIMPP::TopologicalNode* topNode);
+template void Reader::connectTopologicalNode<Complex>(CIMPP::TopologicalNode* topNode);
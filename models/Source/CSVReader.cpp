@@ -379,27 +379,21 @@ PowerProfile CSVReader::readLoadProfile(std::experimental::filesystem::path file
 	}
 
 	/*
-	 loop over rows of the csv file to find the entry point to read in.
-	 and determine data type prior to read in. (assuming only time,p,q or time,weighting factor)
+	 loop over rows of the csv file and determine the data type of each row
+	 (assuming only time,p,q or time,weighting factor).
+	 of the rows before start_time only the last one is kept as entry point.
 	 if start_time and end_time are negative (as default), it reads in all rows.
+	 the rows are read by a single iterator, because copies of it share the stream.
 	*/
 	for (; loop != CSVReaderIterator(); loop.next()) {
-		CSVReaderIterator nextRow = loop;
-		nextRow.next();
-		CPS::Real nextTime = (need_that_conversion) ? time_format_convert((*nextRow).get(0)) : std::stod((*nextRow).get(0));
-		if ((*nextRow).size() == 2) {
-			data_with_weighting_factor = true;
-		}
-		if ((start_time < 0) | (nextTime >= Int(start_time)))
-		{
-			break;
-		}
-	}
-	/*
-	 reading data after entry point until end_time is reached
-	*/
-	for (; loop != CSVReaderIterator(); loop.next()) {
+		if ((*loop).size() < 2)
+			continue;
 		CPS::Real currentTime = (need_that_conversion) ? time_format_convert((*loop).get(0)) : std::stod((*loop).get(0));
+		data_with_weighting_factor = (*loop).size() == 2;
+		if (start_time >= 0 && currentTime < Int(start_time)) {
+			load_profile.weightingFactors.clear();
+			load_profile.pqData.clear();
+		}
 		if (data_with_weighting_factor) {
 			Real wf = std::stod((*loop).get(1));
 			load_profile.weightingFactors.insert(std::pair<Real, Real>(currentTime, wf));
@@ -421,15 +415,15 @@ PowerProfile CSVReader::readLoadProfile(std::experimental::filesystem::path file
 	}
 
 	for (auto x : times) {
-		if (load_profile.pqData.find(x) == load_profile.pqData.end()) {
-			if (data_with_weighting_factor) {
+		if (data_with_weighting_factor) {
+			if (load_profile.weightingFactors.find(x) == load_profile.weightingFactors.end()) {
 				Real y = interpol_linear(load_profile.weightingFactors, x);
 				load_profile.weightingFactors.insert(std::pair<Real, Real>(x, y));
 			}
-			else {
-				PQData y = interpol_linear(load_profile.pqData, x);
-				load_profile.pqData.insert(std::pair<Real,PQData>(x,y));
-			}
+		}
+		else if (load_profile.pqData.find(x) == load_profile.pqData.end()) {
+			PQData y = interpol_linear(load_profile.pqData, x);
+			load_profile.pqData.insert(std::pair<Real,PQData>(x,y));
 		}
 	}
 
@@ -497,7 +491,8 @@ void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Rea
 						load_name.erase(remove_if(load_name.begin(), load_name.end(), [](char c) { return !isalnum(c); }), load_name.end());
 						file_name.erase(remove_if(file_name.begin(), file_name.end(), [](char c) { return !isalnum(c); }), file_name.end());
 						if (std::string(file_name.begin(), file_name.end() - 3).compare(load_name) == 0) {
-							load->mLoadProfile = readLoadProfile(file, start_time, time_step, end_time, format);
+							load->mLoadProfile = std::make_shared<LoadProfile>(file, start_time, time_step, end_time,
+								format, mProfileWindow, mSkipFirstRow);
 							load->use_profile = true;
 							mSLog->info("Assigned {} to {}", file.filename().string(), load->name());
 						}
@@ -519,7 +514,8 @@ void CSVReader::assignLoadProfile(CPS::SystemTopology& sys, Real start_time, Rea
 						LP_not_assigned_counter++;
 						continue;
 					}
-					load->mLoadProfile = readLoadProfile(std::experimental::filesystem::path(mPath + file->second + ".csv"), start_time, time_step, end_time);
+					load->mLoadProfile = std::make_shared<LoadProfile>(std::experimental::filesystem::path(mPath + file->second + ".csv"),
+						start_time, time_step, end_time, DataFormat::SECONDS, mProfileWindow, mSkipFirstRow);
 					load->use_profile = true;
 					std::cout<<" Assigned "<< file->second<< " to " <<load->name()<<std::endl;
 					mSLog->info("Assigned {}.csv to {}", file->second, load->name());
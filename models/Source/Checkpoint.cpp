@@ -0,0 +1,300 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+
+#include <cps/Checkpoint.h>
+#include <cps/SimPowerComp.h>
+
+using namespace CPS;
+
+namespace {
+	/// Types of the attributes stored in checkpoints
+	enum class AttributeType : std::uint8_t { None, Bool, Int, Real, Complex, Matrix, MatrixComp };
+
+	AttributeType attributeType(const AttributeBase::Ptr& attr) {
+		if (std::dynamic_pointer_cast<Attribute<Bool>>(attr))
+			return AttributeType::Bool;
+		if (std::dynamic_pointer_cast<Attribute<Int>>(attr))
+			return AttributeType::Int;
+		if (std::dynamic_pointer_cast<Attribute<Real>>(attr))
+			return AttributeType::Real;
+		if (std::dynamic_pointer_cast<Attribute<Complex>>(attr))
+			return AttributeType::Complex;
+		if (std::dynamic_pointer_cast<Attribute<Matrix>>(attr))
+			return AttributeType::Matrix;
+		if (std::dynamic_pointer_cast<Attribute<MatrixComp>>(attr))
+			return AttributeType::MatrixComp;
+		return AttributeType::None;
+	}
+
+	Bool isStored(const AttributeBase::Ptr& attr) {
+		return !(attr->flags() & (Flags::getter | Flags::setter))
+			&& attributeType(attr) != AttributeType::None;
+	}
+
+	template<typename T>
+	T& storedValue(const AttributeBase::Ptr& attr) {
+		return std::static_pointer_cast<Attribute<T>>(attr)->storedValue();
+	}
+
+	bool isLittleEndian() {
+		const std::uint16_t probe = 1;
+		return *reinterpret_cast<const char*>(&probe) == 1;
+	}
+
+	/// Subcomponents of simulation power components
+	IdentifiedObject::List subComponents(IdentifiedObject& object) {
+		IdentifiedObject::List subComps;
+		if (auto comp = dynamic_cast<SimPowerComp<Real>*>(&object)) {
+			for (auto sub : comp->subComponents())
+				subComps.push_back(sub);
+		}
+		else if (auto comp = dynamic_cast<SimPowerComp<Complex>*>(&object)) {
+			for (auto sub : comp->subComponents())
+				subComps.push_back(sub);
+		}
+		return subComps;
+	}
+}
+
+void CheckpointWriter::writeBytes(const void* data, std::size_t size) {
+	if (isLittleEndian()) {
+		mOut.write(static_cast<const char*>(data), size);
+		return;
+	}
+	std::vector<char> bytes(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+	std::reverse(bytes.begin(), bytes.end());
+	mOut.write(bytes.data(), size);
+}
+
+void CheckpointWriter::write(Bool value) {
+	std::uint8_t byte = value ? 1 : 0;
+	writeBytes(&byte, sizeof(byte));
+}
+
+void CheckpointWriter::write(Int value) {
+	std::int64_t fixed = value;
+	writeBytes(&fixed, sizeof(fixed));
+}
+
+void CheckpointWriter::write(UInt value) {
+	std::uint64_t fixed = value;
+	writeBytes(&fixed, sizeof(fixed));
+}
+
+void CheckpointWriter::write(Real value) {
+	writeBytes(&value, sizeof(value));
+}
+
+void CheckpointWriter::write(Complex value) {
+	write(value.real());
+	write(value.imag());
+}
+
+void CheckpointWriter::write(const String& value) {
+	write(static_cast<UInt>(value.size()));
+	mOut.write(value.data(), value.size());
+}
+
+void CheckpointWriter::write(const Matrix& value) {
+	write(static_cast<UInt>(value.rows()));
+	write(static_cast<UInt>(value.cols()));
+	for (Eigen::Index i = 0; i < value.size(); ++i)
+		write(value.data()[i]);
+}
+
+void CheckpointWriter::write(const MatrixComp& value) {
+	write(static_cast<UInt>(value.rows()));
+	write(static_cast<UInt>(value.cols()));
+	for (Eigen::Index i = 0; i < value.size(); ++i)
+		write(value.data()[i]);
+}
+
+void CheckpointWriter::writeAttributes(AttributeList& object) {
+	UInt count = 0;
+	for (auto& attr : object.attributes()) {
+		if (isStored(attr.second))
+			++count;
+	}
+	write(count);
+
+	for (auto& attr : object.attributes()) {
+		if (!isStored(attr.second))
+			continue;
+
+		auto type = attributeType(attr.second);
+		write(attr.first);
+		writeBytes(&type, sizeof(type));
+		switch (type) {
+			case AttributeType::Bool: write(storedValue<Bool>(attr.second)); break;
+			case AttributeType::Int: write(storedValue<Int>(attr.second)); break;
+			case AttributeType::Real: write(storedValue<Real>(attr.second)); break;
+			case AttributeType::Complex: write(storedValue<Complex>(attr.second)); break;
+			case AttributeType::Matrix: write(storedValue<Matrix>(attr.second)); break;
+			case AttributeType::MatrixComp: write(storedValue<MatrixComp>(attr.second)); break;
+			case AttributeType::None: break;
+		}
+	}
+}
+
+void CheckpointWriter::writeObject(IdentifiedObject& object) {
+	write(object.name());
+	writeAttributes(object);
+
+	auto subComps = subComponents(object);
+	write(static_cast<UInt>(subComps.size()));
+	for (auto sub : subComps)
+		writeObject(*sub);
+
+	auto checkpointObject = dynamic_cast<CheckpointInterface*>(&object);
+	write(checkpointObject != nullptr);
+	if (checkpointObject)
+		checkpointObject->writeCheckpoint(*this);
+}
+
+void CheckpointWriter::writeSubObject(const IdentifiedObject::Ptr& object) {
+	write(object != nullptr);
+	if (object)
+		writeObject(*object);
+}
+
+void CheckpointVectorWriter::writeBytes(const void* data, std::size_t size) {
+	for (std::size_t i = 0; i < size; ++i) {
+		mHash ^= static_cast<const unsigned char*>(data)[i];
+		mHash *= 1099511628211ULL;
+	}
+	CheckpointWriter::writeBytes(data, size);
+}
+
+void CheckpointReader::readBytes(void* data, std::size_t size) {
+	mIn.read(static_cast<char*>(data), size);
+	if (!mIn)
+		throw SystemError("Truncated checkpoint");
+	if (!isLittleEndian())
+		std::reverse(static_cast<char*>(data), static_cast<char*>(data) + size);
+}
+
+void CheckpointReader::read(Bool& value) {
+	std::uint8_t byte;
+	readBytes(&byte, sizeof(byte));
+	value = byte != 0;
+}
+
+void CheckpointReader::read(Int& value) {
+	std::int64_t fixed;
+	readBytes(&fixed, sizeof(fixed));
+	value = static_cast<Int>(fixed);
+}
+
+void CheckpointReader::read(UInt& value) {
+	std::uint64_t fixed;
+	readBytes(&fixed, sizeof(fixed));
+	value = static_cast<UInt>(fixed);
+}
+
+void CheckpointReader::read(Real& value) {
+	readBytes(&value, sizeof(value));
+}
+
+void CheckpointReader::read(Complex& value) {
+	// Read in place, see CheckpointVectorReader
+	Real* parts = reinterpret_cast<Real*>(&value);
+	read(parts[0]);
+	read(parts[1]);
+}
+
+void CheckpointReader::read(String& value) {
+	UInt size;
+	read(size);
+	value.resize(size);
+	mIn.read(&value[0], size);
+	if (!mIn)
+		throw SystemError("Truncated checkpoint");
+}
+
+void CheckpointReader::read(Matrix& value) {
+	UInt rows, cols;
+	read(rows);
+	read(cols);
+	value.resize(rows, cols);
+	for (Eigen::Index i = 0; i < value.size(); ++i)
+		read(value.data()[i]);
+}
+
+void CheckpointReader::read(MatrixComp& value) {
+	UInt rows, cols;
+	read(rows);
+	read(cols);
+	value.resize(rows, cols);
+	for (Eigen::Index i = 0; i < value.size(); ++i)
+		read(value.data()[i]);
+}
+
+void CheckpointReader::readAttributes(AttributeList& object) {
+	UInt count;
+	read(count);
+
+	for (UInt i = 0; i < count; ++i) {
+		String name;
+		read(name);
+		AttributeType type;
+		readBytes(&type, sizeof(type));
+
+		auto attr = object.attributes().find(name);
+		if (attr == object.attributes().end())
+			throw SystemError("Checkpoint contains unknown attribute " + name);
+		if (!isStored(attr->second) || attributeType(attr->second) != type)
+			throw SystemError("Attribute " + name + " does not match the checkpoint");
+
+		switch (type) {
+			case AttributeType::Bool: read(storedValue<Bool>(attr->second)); break;
+			case AttributeType::Int: read(storedValue<Int>(attr->second)); break;
+			case AttributeType::Real: read(storedValue<Real>(attr->second)); break;
+			case AttributeType::Complex: read(storedValue<Complex>(attr->second)); break;
+			case AttributeType::Matrix: read(storedValue<Matrix>(attr->second)); break;
+			case AttributeType::MatrixComp: read(storedValue<MatrixComp>(attr->second)); break;
+			case AttributeType::None: break;
+		}
+	}
+}
+
+void CheckpointReader::readObject(IdentifiedObject& object) {
+	auto name = read<String>();
+	if (name != object.name())
+		throw SystemError("Checkpoint contains " + name + " instead of " + object.name());
+	readAttributes(object);
+
+	auto subComps = subComponents(object);
+	if (read<UInt>() != subComps.size())
+		throw SystemError("Subcomponents of " + name + " do not match the checkpoint");
+	for (auto sub : subComps)
+		readObject(*sub);
+
+	auto checkpointObject = dynamic_cast<CheckpointInterface*>(&object);
+	if (read<Bool>() != (checkpointObject != nullptr))
+		throw SystemError("Internal states of " + name + " do not match the checkpoint");
+	if (checkpointObject)
+		checkpointObject->readCheckpoint(*this);
+}
+
+void CheckpointReader::readSubObject(const IdentifiedObject::Ptr& object) {
+	if (read<Bool>() != (object != nullptr))
+		throw SystemError("Subcomponents do not match the checkpoint");
+	if (object)
+		readObject(*object);
+}
+
+void CheckpointVectorReader::read(Real& value) {
+	if (mPosition >= mValues.size())
+		throw SystemError("Truncated checkpoint");
+	value = mValues[mPosition++];
+	if (mLocations)
+		mLocations->push_back(&value);
+}
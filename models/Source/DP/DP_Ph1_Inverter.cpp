@@ -130,7 +130,7 @@ void DP::Ph1::Inverter::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 	calculatePhasors();
 }
 
-void DP::Ph1::Inverter::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Inverter::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSLog->info("--- Stamping into system matrix ---");
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
@@ -77,18 +77,17 @@ void DP::Ph1::NetworkInjection::mnaInitialize(Real omega, Real timeStep, Attribu
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVectorRows = rightVectorRows(static_cast<UInt>(mRightVector.rows()), mNumFreqs);
 }
 
-void DP::Ph1::NetworkInjection::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::NetworkInjection::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (auto subcomp: mSubComponents)
 		if (auto mnasubcomp = std::dynamic_pointer_cast<MNAInterface>(subcomp))
 			mnasubcomp->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
 void DP::Ph1::NetworkInjection::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+	mnaSumRightVectorStamps(rightVector, mRightVectorStamps, mRightVectorRows);
 
 	mSLog->debug("Right Side Vector: {:s}",
 				Logger::matrixToString(rightVector));
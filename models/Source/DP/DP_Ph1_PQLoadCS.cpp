@@ -111,7 +111,7 @@ void DP::Ph1::PQLoadCS::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	mSubCurrentSource->mnaApplyRightSideVectorStamp(rightVector);
 }
 
-void DP::Ph1::PQLoadCS::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::PQLoadCS::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubCurrentSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
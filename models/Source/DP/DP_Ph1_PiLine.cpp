@@ -128,9 +128,10 @@ void DP::Ph1::PiLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVectorRows = rightVectorRows(static_cast<UInt>(mRightVector.rows()), mNumFreqs);
 }
 
-void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubSeriesResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSeriesInductor->mnaApplySystemMatrixStamp(systemMatrix);
 
@@ -144,9 +145,7 @@ void DP::Ph1::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 }
 
 void DP::Ph1::PiLine::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+	mnaSumRightVectorStamps(rightVector, mRightVectorStamps, mRightVectorRows);
 }
 
 void DP::Ph1::PiLine::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -253,3 +252,21 @@ void DP::Ph1::PiLine::mnaTearApplyVoltageStamp(Matrix& voltageVector) {
 void DP::Ph1::PiLine::mnaTearPostStep(Complex voltage, Complex current) {
 	mSubSeriesInductor->mnaTearPostStep(voltage - current * mSeriesRes, current);
 }
+
+void DP::Ph1::PiLine::writeCheckpoint(CheckpointWriter& writer) {
+	writer.writeSubObject(mSubSeriesResistor);
+	writer.writeSubObject(mSubSeriesInductor);
+	writer.writeSubObject(mSubParallelResistor0);
+	writer.writeSubObject(mSubParallelCapacitor0);
+	writer.writeSubObject(mSubParallelResistor1);
+	writer.writeSubObject(mSubParallelCapacitor1);
+}
+
+void DP::Ph1::PiLine::readCheckpoint(CheckpointReader& reader) {
+	reader.readSubObject(mSubSeriesResistor);
+	reader.readSubObject(mSubSeriesInductor);
+	reader.readSubObject(mSubParallelResistor0);
+	reader.readSubObject(mSubParallelCapacitor0);
+	reader.readSubObject(mSubParallelResistor1);
+	reader.readSubObject(mSubParallelCapacitor1);
+}
@@ -82,22 +82,21 @@ void DP::Ph1::RXLoadSwitch::mnaInitialize(Real omega, Real timeStep, Attribute<M
 	mRightVectorStamps.push_back(&mSubRXLoad->attribute<Matrix>("right_vector")->get());
 
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVectorRows = rightVectorRows(static_cast<UInt>(mRightVector.rows()), mNumFreqs);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
 void DP::Ph1::RXLoadSwitch::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+	mnaSumRightVectorStamps(rightVector, mRightVectorStamps, mRightVectorRows);
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySwitchSystemMatrixStamp(systemMatrix, closed);
 }
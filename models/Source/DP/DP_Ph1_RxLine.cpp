@@ -82,11 +82,11 @@ void DP::Ph1::RxLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
-void DP::Ph1::RxLine::mnaApplyInitialSystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RxLine::mnaApplyInitialSystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mInitialResistor->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::RxLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RxLine::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 	mInitialResistor->mnaApplySystemMatrixStamp(systemMatrix);
@@ -117,3 +117,13 @@ void DP::Ph1::RxLine::mnaUpdateVoltage(const Matrix& leftVector) {
 void DP::Ph1::RxLine::mnaUpdateCurrent(const Matrix& leftVector) {
 	mIntfCurrent(0, 0) = mSubInductor->intfCurrent()(0,0);
 }
+
+void DP::Ph1::RxLine::writeCheckpoint(CheckpointWriter& writer) {
+	writer.writeSubObject(mSubResistor);
+	writer.writeSubObject(mSubInductor);
+}
+
+void DP::Ph1::RxLine::readCheckpoint(CheckpointReader& reader) {
+	reader.readSubObject(mSubResistor);
+	reader.readSubObject(mSubInductor);
+}
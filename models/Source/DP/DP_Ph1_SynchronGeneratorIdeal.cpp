@@ -64,7 +64,7 @@ void DP::Ph1::SynchronGeneratorIdeal::mnaInitialize(Real omega, Real timeStep, A
 	}
 }
 
-void DP::Ph1::SynchronGeneratorIdeal::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SynchronGeneratorIdeal::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
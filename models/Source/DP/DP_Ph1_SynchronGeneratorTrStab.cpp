@@ -200,7 +200,7 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph1::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 }
@@ -230,3 +230,13 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaUpdateVoltage(const Matrix& leftVector
 	SPDLOG_LOGGER_DEBUG(mSLog, "Read voltage from {:d}", matrixNodeIndex(0));
 	mIntfVoltage(0,0) = Math::complexFromVectorElement(leftVector, matrixNodeIndex(0));
 }
+
+void DP::Ph1::SynchronGeneratorTrStab::writeCheckpoint(CheckpointWriter& writer) {
+	writer.writeSubObject(mSubVoltageSource);
+	writer.writeSubObject(mSubInductor);
+}
+
+void DP::Ph1::SynchronGeneratorTrStab::readCheckpoint(CheckpointReader& reader) {
+	reader.readSubObject(mSubVoltageSource);
+	reader.readSubObject(mSubInductor);
+}
@@ -70,7 +70,7 @@ void DP::Ph1::VoltageSourceRamp::mnaInitialize(Real omega, Real timeStep, Attrib
 	}
 }
 
-void DP::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
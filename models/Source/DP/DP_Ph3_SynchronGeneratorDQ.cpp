@@ -78,7 +78,7 @@ void DP::Ph3::SynchronGeneratorDQ::initialize(Matrix frequencies) {
 	mIntfCurrent = mBase_I * dq0ToAbcTransform(mThetaMech, mIdq0);
 }
 
-void DP::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (!mCompensationOn)
 		return;
 
@@ -142,6 +142,27 @@ Matrix DP::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, MatrixComp& a
 	return dq0Vector;
 }
 
+void DP::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, const MatrixComp& abc, Matrix& dq0) {
+	// Positive sequence component of abcToDq0Transform without temporaries
+	Complex alpha(cos(2. / 3. * PI), sin(2. / 3. * PI));
+	Complex positive = (1. / 3.) * (abc(0, 0) + alpha * abc(1, 0) + alpha * alpha * abc(2, 0))
+		* Complex(cos(-theta), sin(-theta));
+
+	dq0(0, 0) = positive.real();
+	dq0(1, 0) = positive.imag();
+	dq0(2, 0) = 0;
+}
+
+void DP::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, const Matrix& dq0, MatrixComp& abc) {
+	// Positive sequence component of dq0ToAbcTransform without temporaries
+	Complex alpha(cos(2. / 3. * PI), sin(2. / 3. * PI));
+	Complex positive = Complex(dq0(0, 0), dq0(1, 0)) * Complex(cos(theta), sin(theta));
+
+	abc(0, 0) = positive;
+	abc(1, 0) = alpha * alpha * positive;
+	abc(2, 0) = alpha * positive;
+}
+
 MatrixComp DP::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0) {
 	// Balanced case because we do not consider the zero sequence component
 	Complex alpha(cos(2. / 3. * PI), sin(2. / 3. * PI));
@@ -80,6 +80,7 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::initializeStates(Real omega, Real
 	mD = Matrix::Zero(3, 6);
 	mStates = Matrix::Zero(14, 1);
 	mU = Matrix::Zero(6, 1);
+	mStateSpaceWorkspace.resize(14);
 	Matrix initVgabc = Matrix::Zero(3, 1);
 
 
@@ -155,13 +156,13 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::initializeStates(Real omega, Real
 
 void EMT::Ph3::AvVoltSourceInverterStateSpace::updateStates() {
 
-	Matrix newStates = Matrix::Zero(14, 1);
-	Matrix newU = Matrix::Zero(6, 1);
+	Matrix& newStates = mNewStates;
+	Matrix& newU = mNewU;
 
 	newU <<
 		mOmegaN, mPref, mQref, mIntfVoltage;
 
-	newStates = Math::StateSpaceTrapezoidal(mStates, mA, mB, mTimeStep, newU, mU);
+	Math::StateSpaceTrapezoidal(mStates, mA, mB, mTimeStep, newU, mU, newStates, mStateSpaceWorkspace);
 
 	// update states
 	mThetaPLL = newStates(0, 0);
@@ -192,35 +193,40 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::updateStates() {
 
 void EMT::Ph3::AvVoltSourceInverterStateSpace::updateLinearizedCoeffs() {
 
-	Matrix Tabc_dq = getParkTransformMatrix(mThetaPLL);
-	Matrix Td = Tabc_dq.row(0);
-	Matrix Tq = Tabc_dq.row(1);
-	Matrix Tdq_abc = getInverseParkTransformMatrix(mThetaPLL);
-	Matrix Tabc1 = Tdq_abc.col(0);
-	Matrix Tabc2 = Tdq_abc.col(1);
+	// Fixed size matrices are kept on the stack
+	Eigen::Matrix<Real, 2, 3> Tabc_dq = getParkTransformMatrix(mThetaPLL);
+	Eigen::Matrix<Real, 1, 3> Td = Tabc_dq.row(0);
+	Eigen::Matrix<Real, 1, 3> Tq = Tabc_dq.row(1);
+	Eigen::Matrix<Real, 3, 2> Tdq_abc = getInverseParkTransformMatrix(mThetaPLL);
+	Eigen::Matrix<Real, 3, 1> Tabc1 = Tdq_abc.col(0);
+	Eigen::Matrix<Real, 3, 1> Tabc2 = Tdq_abc.col(1);
 
 	mA.block(0, 8, 1, 3) = Tq;
 	mA.block(1, 8, 1, 3) = Tq;
 	mA.block(6, 11, 1, 3) = -Td;
 	mA.block(7, 11, 1, 3) = -Tq;
 
-	Matrix A_bottom = Matrix::Zero(3, 14);
-	A_bottom<<
-		Matrix::Zero(3, 1), Matrix::Zero(3, 1), -Tabc1 * mKpCurrCtrld * mKpPowerCtrld, -Tabc2 * mKpCurrCtrlq * mKpPowerCtrlq,
-		Tabc1* mKpCurrCtrld* mKiPowerCtrld, Tabc2* mKpCurrCtrlq* mKiPowerCtrlq,
-		Tabc1* mKiCurrCtrld, Tabc2* mKiCurrCtrlq, Matrix::Zero(3, 3),
-		-Tabc1 * mKpCurrCtrld * Td - Tabc2 * mKpCurrCtrlq * Tq;
-	mA.block(11, 0, 3, 14) = A_bottom;
-	/*
-	 will it be faster to reconstruct the full B matrix (14x5)
-	 rather than doing three insertions?
-	*/
-	mB.block(2, 2, 1, 3) = 3. / 2. * mOmegaCutoff * (Td * mIg_abc * Td + Tq * mIg_abc * Tq);
-	mB.block(3, 2, 1, 3) = 3. / 2. * mOmegaCutoff * (Tq * mIg_abc * Td - Td * mIg_abc * Tq);
-	Matrix B_bottom = Matrix::Zero(3, 6);
-	B_bottom<<
-		Matrix::Zero(3, 1), Tabc1 * mKpCurrCtrld * mKpPowerCtrld, Tabc2* mKpCurrCtrlq* mKpPowerCtrlq, Matrix::Zero(3, 3);
-	mB.block(11, 0, 3, 6) = B_bottom;
+	mA.block(11, 0, 3, 2).setZero();
+	mA.block(11, 2, 3, 1) = -Tabc1 * mKpCurrCtrld * mKpPowerCtrld;
+	mA.block(11, 3, 3, 1) = -Tabc2 * mKpCurrCtrlq * mKpPowerCtrlq;
+	mA.block(11, 4, 3, 1) = Tabc1 * mKpCurrCtrld * mKiPowerCtrld;
+	mA.block(11, 5, 3, 1) = Tabc2 * mKpCurrCtrlq * mKiPowerCtrlq;
+	mA.block(11, 6, 3, 1) = Tabc1 * mKiCurrCtrld;
+	mA.block(11, 7, 3, 1) = Tabc2 * mKiCurrCtrlq;
+	mA.block(11, 8, 3, 3).setZero();
+	mA.block(11, 11, 3, 3).noalias() = -Tabc1 * mKpCurrCtrld * Td;
+	mA.block(11, 11, 3, 3).noalias() -= Tabc2 * mKpCurrCtrlq * Tq;
+
+	// Projections of the output current on the d and q axes
+	Real igd = Td.dot(mIg_abc.col(0).transpose());
+	Real igq = Tq.dot(mIg_abc.col(0).transpose());
+	mB.block(2, 2, 1, 3) = 3. / 2. * mOmegaCutoff * (igd * Td + igq * Tq);
+	mB.block(3, 2, 1, 3) = 3. / 2. * mOmegaCutoff * (igq * Td - igd * Tq);
+
+	mB.block(11, 0, 3, 1).setZero();
+	mB.block(11, 1, 3, 1) = Tabc1 * mKpCurrCtrld * mKpPowerCtrld;
+	mB.block(11, 2, 3, 1) = Tabc2 * mKpCurrCtrlq * mKpPowerCtrlq;
+	mB.block(11, 3, 3, 3).setZero();
 }
 
 Matrix EMT::Ph3::AvVoltSourceInverterStateSpace::parkTransform(Real theta, Real fa, Real fb, Real fc) {
@@ -239,8 +245,8 @@ Matrix EMT::Ph3::AvVoltSourceInverterStateSpace::parkTransform(Real theta, Real
 
 }
 
-Matrix EMT::Ph3::AvVoltSourceInverterStateSpace::getParkTransformMatrix(Real theta) {
-	Matrix Tdq = Matrix::Zero(2, 3);
+Eigen::Matrix<Real, 2, 3> EMT::Ph3::AvVoltSourceInverterStateSpace::getParkTransformMatrix(Real theta) {
+	Eigen::Matrix<Real, 2, 3> Tdq;
 	Tdq <<
 		2. / 3. * sin(theta), 2. / 3. * sin(theta - 2. * M_PI / 3.), 2. / 3. * sin(theta + 2. * M_PI / 3.),
 		2. / 3. * cos(theta), 2. / 3. * cos(theta - 2. * M_PI / 3.), 2. / 3. * cos(theta + 2. * M_PI / 3.);
@@ -265,8 +271,8 @@ Matrix EMT::Ph3::AvVoltSourceInverterStateSpace::inverseParkTransform(Real theta
 	return abcVector;
 }
 
-Matrix EMT::Ph3::AvVoltSourceInverterStateSpace::getInverseParkTransformMatrix(Real theta) {
-	Matrix Tabc = Matrix::Zero(3, 2);
+Eigen::Matrix<Real, 3, 2> EMT::Ph3::AvVoltSourceInverterStateSpace::getInverseParkTransformMatrix(Real theta) {
+	Eigen::Matrix<Real, 3, 2> Tabc;
 	Tabc <<
 		sin(theta), cos(theta),
 		sin(theta - 2. * M_PI / 3.), cos(theta - 2. * M_PI / 3.),
@@ -288,7 +294,7 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaInitialize(Real omega, Real ti
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
-void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Apply matrix stamp for equivalent resistance
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mYc);
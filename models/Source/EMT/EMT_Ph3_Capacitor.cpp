@@ -65,7 +65,8 @@ void EMT::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Mat
 	updateMatrixNodeIndices();
 	mEquivCond = (2.0 * mCapacitance) / timeStep;
 	// Update internal state
-	mEquivCurrent = - mIntfCurrent + - mEquivCond * mIntfVoltage;
+	mEquivCurrent = -mIntfCurrent;
+	mEquivCurrent.noalias() -= mEquivCond * mIntfVoltage;
 
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
@@ -73,7 +74,7 @@ void EMT::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Mat
 
 }
 
-void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		// set upper left block, 3x3 entries
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -128,7 +129,8 @@ void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 }
 
 void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	mEquivCurrent = -mIntfCurrent + -mEquivCond * mIntfVoltage;
+	mEquivCurrent = -mIntfCurrent;
+	mEquivCurrent.noalias() -= mEquivCond * mIntfVoltage;
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 1), mEquivCurrent(1, 0));
@@ -139,9 +141,10 @@ void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 1), -mEquivCurrent(1, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 2), -mEquivCurrent(2, 0));
 	}
-	mSLog->debug(
-		"\nEquivalent Current: {:s}",
-		Logger::matrixToString(mEquivCurrent));
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nEquivalent Current: {:s}",
+			Logger::matrixToString(mEquivCurrent));
 }
 
 void EMT::Ph3::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -182,10 +185,12 @@ void EMT::Ph3::Capacitor::mnaUpdateVoltage(const Matrix& leftVector) {
 }
 
 void EMT::Ph3::Capacitor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
-	mSLog->debug(
-		"\nCurrent: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
+	mIntfCurrent = mEquivCurrent;
+	mIntfCurrent.noalias() += mEquivCond * mIntfVoltage;
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nCurrent: {:s}",
+			Logger::matrixToString(mIntfCurrent)
+		);
 }
 
@@ -67,7 +67,8 @@ void EMT::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	updateMatrixNodeIndices();
 	mEquivCond = timeStep / 2. * mInductance.inverse();
 	// Update internal state
-	mEquivCurrent = mEquivCond * mIntfVoltage + mIntfCurrent;
+	mEquivCurrent = mIntfCurrent;
+	mEquivCurrent.noalias() += mEquivCond * mIntfVoltage;
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
@@ -85,7 +86,7 @@ void EMT::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	mSLog->flush();
 }
 
-void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		// set upper left block, 3x3 entries
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -141,7 +142,8 @@ void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 
 void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	// Update internal state
-	mEquivCurrent = mEquivCond * mIntfVoltage + mIntfCurrent;
+	mEquivCurrent = mIntfCurrent;
+	mEquivCurrent.noalias() += mEquivCond * mIntfVoltage;
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 1), mEquivCurrent(1, 0));
@@ -152,9 +154,10 @@ void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 1), -mEquivCurrent(1, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 2), -mEquivCurrent(2, 0));
 	}
-	mSLog->debug(
-		"\nEquivalent Current (mnaApplyRightSideVectorStamp): {:s}",
-		Logger::matrixToString(mEquivCurrent));
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nEquivalent Current (mnaApplyRightSideVectorStamp): {:s}",
+			Logger::matrixToString(mEquivCurrent));
 	mSLog->flush();
 }
 
@@ -193,18 +196,21 @@ void EMT::Ph3::Inductor::mnaUpdateVoltage(const Matrix& leftVector) {
 		mIntfVoltage(1, 0) = mIntfVoltage(1, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1));
 		mIntfVoltage(2, 0) = mIntfVoltage(2, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
 	}
-	mSLog->debug(
-		"\nUpdate Voltage: {:s}",
-		Logger::matrixToString(mIntfVoltage)
-	);
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nUpdate Voltage: {:s}",
+			Logger::matrixToString(mIntfVoltage)
+		);
 }
 
 void EMT::Ph3::Inductor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
-	mSLog->debug(
-		"\nUpdate Current: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
+	mIntfCurrent = mEquivCurrent;
+	mIntfCurrent.noalias() += mEquivCond * mIntfVoltage;
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nUpdate Current: {:s}",
+			Logger::matrixToString(mIntfCurrent)
+		);
 	mSLog->flush();
 }
 
@@ -163,9 +163,10 @@ void EMT::Ph3::PiLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mRightVectorRows = rightVectorRows(static_cast<UInt>(mRightVector.rows()), mNumFreqs);
 }
 
-void EMT::Ph3::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::PiLine::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubSeriesResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSeriesInductor->mnaApplySystemMatrixStamp(systemMatrix);
 
@@ -179,9 +180,7 @@ void EMT::Ph3::PiLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 }
 
 void EMT::Ph3::PiLine::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+	mnaSumRightVectorStamps(rightVector, mRightVectorStamps, mRightVectorRows);
 }
 
 void EMT::Ph3::PiLine::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes){
@@ -260,4 +259,22 @@ void EMT::Ph3::PiLine::mnaUpdateVoltage(const Matrix& leftVector) {
 
 void EMT::Ph3::PiLine::mnaUpdateCurrent(const Matrix& leftVector) {
 	mIntfCurrent = mSubSeriesInductor->intfCurrent();
-}
\ No newline at end of file
+}
+
+void EMT::Ph3::PiLine::writeCheckpoint(CheckpointWriter& writer) {
+	writer.writeSubObject(mSubSeriesResistor);
+	writer.writeSubObject(mSubSeriesInductor);
+	writer.writeSubObject(mSubParallelResistor0);
+	writer.writeSubObject(mSubParallelCapacitor0);
+	writer.writeSubObject(mSubParallelResistor1);
+	writer.writeSubObject(mSubParallelCapacitor1);
+}
+
+void EMT::Ph3::PiLine::readCheckpoint(CheckpointReader& reader) {
+	reader.readSubObject(mSubSeriesResistor);
+	reader.readSubObject(mSubSeriesInductor);
+	reader.readSubObject(mSubParallelResistor0);
+	reader.readSubObject(mSubParallelCapacitor0);
+	reader.readSubObject(mSubParallelResistor1);
+	reader.readSubObject(mSubParallelCapacitor1);
+}
@@ -207,7 +207,7 @@ void EMT::Ph3::RXLoad::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		mSubCapacitor->mnaApplyRightSideVectorStamp(rightVector);
 }
 
-void EMT::Ph3::RXLoad::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::RXLoad::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (mSubResistor)
 		mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	if (mSubInductor)
@@ -111,11 +111,11 @@ void EMT::Ph3::RxLine::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
-void EMT::Ph3::RxLine::mnaApplyInitialSystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::RxLine::mnaApplyInitialSystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mInitialResistor->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void EMT::Ph3::RxLine::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::RxLine::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 	mInitialResistor->mnaApplySystemMatrixStamp(systemMatrix);
@@ -153,3 +153,13 @@ void EMT::Ph3::RxLine::mnaUpdateVoltage(const Matrix& leftVector) {
 void EMT::Ph3::RxLine::mnaUpdateCurrent(const Matrix& leftVector) {
 	mIntfCurrent = mSubInductor->intfCurrent();
 }
+
+void EMT::Ph3::RxLine::writeCheckpoint(CheckpointWriter& writer) {
+	writer.writeSubObject(mSubResistor);
+	writer.writeSubObject(mSubInductor);
+}
+
+void EMT::Ph3::RxLine::readCheckpoint(CheckpointReader& reader) {
+	reader.readSubObject(mSubResistor);
+	reader.readSubObject(mSubInductor);
+}
@@ -58,7 +58,7 @@ void EMT::Ph3::SeriesResistor::mnaInitialize(Real omega, Real timeStep, Attribut
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void EMT::Ph3::SeriesResistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::SeriesResistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Real conductance = 1./mResistance;
 
 	// Set diagonal entries
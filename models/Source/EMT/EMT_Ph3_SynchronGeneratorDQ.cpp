@@ -75,7 +75,7 @@ void EMT::Ph3::SynchronGeneratorDQ::initialize(Matrix frequencies) {
 	mIntfCurrent = mBase_I * dq0ToAbcTransform(mThetaMech, mIdq0);
 }
 
-void EMT::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::SynchronGeneratorDQ::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (!mCompensationOn)
 		return;
 
@@ -117,7 +117,19 @@ void EMT::Ph3::SynchronGeneratorDQ::MnaPostStep::execute(Real time, Int timeStep
 
 Matrix EMT::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, Matrix& abcVector) {
 	Matrix dq0Vector(3, 1);
-	Matrix abcToDq0(3, 3);
+	abcToDq0Transform(theta, abcVector, dq0Vector);
+	return dq0Vector;
+}
+
+Matrix EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0Vector) {
+	Matrix abcVector(3, 1);
+	dq0ToAbcTransform(theta, dq0Vector, abcVector);
+	return abcVector;
+}
+
+void EMT::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, const Matrix& abcVector, Matrix& dq0Vector) {
+	// Fixed size to keep the transformation matrix on the stack
+	Eigen::Matrix3d abcToDq0;
 
 	// Park transform according to Kundur
 	abcToDq0 <<
@@ -125,14 +137,12 @@ Matrix EMT::Ph3::SynchronGeneratorDQ::abcToDq0Transform(Real theta, Matrix& abcV
 		-2./3.*sin(theta), -2./3.*sin(theta - 2.*PI/3.), -2./3.*sin(theta + 2.*PI/3.),
 		 1./3., 			1./3., 						  1./3.;
 
-	dq0Vector = abcToDq0 * abcVector;
-
-	return dq0Vector;
+	dq0Vector.noalias() = abcToDq0 * abcVector;
 }
 
-Matrix EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0Vector) {
-	Matrix abcVector(3, 1);
-	Matrix dq0ToAbc(3, 3);
+void EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, const Matrix& dq0Vector, Matrix& abcVector) {
+	// Fixed size to keep the transformation matrix on the stack
+	Eigen::Matrix3d dq0ToAbc;
 
 	// Park transform according to Kundur
 	dq0ToAbc <<
@@ -140,7 +150,5 @@ Matrix EMT::Ph3::SynchronGeneratorDQ::dq0ToAbcTransform(Real theta, Matrix& dq0V
 		cos(theta - 2.*PI/3.), -sin(theta - 2.*PI/3.), 1.,
 		cos(theta + 2.*PI/3.), -sin(theta + 2.*PI/3.), 1.;
 
-	abcVector = dq0ToAbc * dq0Vector;
-
-	return abcVector;
+	abcVector.noalias() = dq0ToAbc * dq0Vector;
 }
@@ -29,6 +29,9 @@ void EMT::Ph3::SynchronGeneratorDQTrapez::mnaInitialize(Real omega, Real timeSte
 	mTimeStep = timeStep;
 
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mFluxStateMat.resize(mFluxStateSpaceMat.rows(), mFluxStateSpaceMat.cols());
+	mFluxInput.resize(mVsr.rows(), 1);
+	mStateSpaceWorkspace.resize(mPsisr.rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
@@ -44,7 +47,8 @@ void EMT::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 
 	// Calculate per unit values and
 	// transform per unit voltages from abc to dq0
-	mVdq0 = abcToDq0Transform(mThetaMech, mIntfVoltage) / mBase_V;
+	abcToDq0Transform(mThetaMech, mIntfVoltage, mVdq0);
+	mVdq0 /= mBase_V;
 	mVsr(0,0) = mVdq0(0,0);
 	mVsr(3,0) = mVdq0(1,0);
 	mVsr(6,0) = mVdq0(2,0);
@@ -71,16 +75,19 @@ void EMT::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 	mOmMech = mOmMech + mTimeStep * (1./(2.*mInertia) * (mMechTorque - mElecTorque));
 
 	// Update of fluxes
+	mFluxStateMat = mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech);
+	mFluxInput = mBase_OmElec*mVsr;
 	if (mNumericalMethod == NumericalMethod::Euler)
-		mPsisr = Math::StateSpaceEuler(mPsisr, mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech), mBase_OmElec*mVsr, mTimeStep);
+		Math::StateSpaceEuler(mPsisr, mFluxStateMat, mFluxInput, mTimeStep, mPsisr, mStateSpaceWorkspace);
 	else
-		mPsisr = Math::StateSpaceTrapezoidal(mPsisr, mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech), mBase_OmElec*mVsr, mTimeStep);
+		Math::StateSpaceTrapezoidal(mPsisr, mFluxStateMat, mFluxInput, mTimeStep, mPsisr, mStateSpaceWorkspace);
 
 	// Calculate new currents from fluxes
-	mIsr = mFluxToCurrentMat * mPsisr;
+	mIsr.noalias() = mFluxToCurrentMat * mPsisr;
 
 	mIdq0(0, 0) = mIsr(0, 0);
 	mIdq0(1, 0) = mIsr(3, 0);
 	mIdq0(2, 0) = mIsr(6, 0);
-	mIntfCurrent = mBase_I * dq0ToAbcTransform(mThetaMech, mIdq0);
+	dq0ToAbcTransform(mThetaMech, mIdq0, mIntfCurrent);
+	mIntfCurrent *= mBase_I;
 }
@@ -78,7 +78,7 @@ void EMT::Ph3::VoltageSource::mnaInitialize(Real omega, Real timeStep, Attribute
 
 }
 
-void EMT::Ph3::VoltageSource::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::VoltageSource::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), mVirtualNodes[0]->matrixNodeIndex(PhaseType::A), -1);
 		Math::addToMatrixElement(systemMatrix, mVirtualNodes[0]->matrixNodeIndex(PhaseType::A), matrixNodeIndex(0, 0), -1);
@@ -118,22 +118,23 @@ void EMT::Ph3::VoltageSource::mnaApplyRightSideVectorStamp(Matrix& rightVector)
 }
 
 void EMT::Ph3::VoltageSource::updateVoltage(Real time) {
-	if (attribute<Real>("f_src")->get() < 0) {
-		mIntfVoltage = RMS3PH_TO_PEAK1PH * attribute<MatrixComp>("V_ref")->get().real();
+	const MatrixComp& vref = attribute<MatrixComp>("V_ref")->get();
+	Real srcFreq = attribute<Real>("f_src")->get();
+	if (srcFreq < 0) {
+		mIntfVoltage = RMS3PH_TO_PEAK1PH * vref.real();
 	}
 	else {
-		mIntfVoltage(0, 0) =
-			RMS3PH_TO_PEAK1PH * Math::abs(attribute<MatrixComp>("V_ref")->get()(0, 0)) * cos(time * 2. * PI * attribute<Real>("f_src")->get() + Math::phase(attribute<MatrixComp>("V_ref")->get())(0, 0));
-		mIntfVoltage(1, 0) =
-			RMS3PH_TO_PEAK1PH * Math::abs(attribute<MatrixComp>("V_ref")->get()(1, 0)) * cos(time * 2. * PI * attribute<Real>("f_src")->get() + Math::phase(attribute<MatrixComp>("V_ref")->get())(1, 0));
-		mIntfVoltage(2, 0) =
-			RMS3PH_TO_PEAK1PH * Math::abs(attribute<MatrixComp>("V_ref")->get()(2, 0)) * cos(time * 2. * PI * attribute<Real>("f_src")->get() + Math::phase(attribute<MatrixComp>("V_ref")->get())(2, 0));
+		// Per element to avoid the temporary matrices of Math::abs and Math::phase
+		for (Int phase = 0; phase < 3; ++phase)
+			mIntfVoltage(phase, 0) =
+				RMS3PH_TO_PEAK1PH * std::abs(vref(phase, 0)) * cos(time * 2. * PI * srcFreq + std::arg(vref(phase, 0)));
 	}
 
-	mSLog->debug(
-		"\nUpdate Voltage: {:s}",
-		Logger::matrixToString(mIntfVoltage)
-	);
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nUpdate Voltage: {:s}",
+			Logger::matrixToString(mIntfVoltage)
+		);
 }
 
 void EMT::Ph3::VoltageSource::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
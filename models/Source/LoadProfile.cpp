@@ -0,0 +1,199 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+#include <cps/LoadProfile.h>
+
+using namespace CPS;
+
+static const char* skipSpaces(const char* p) {
+	while (*p == ' ' || *p == '\t' || *p == '\r')
+		++p;
+	return p;
+}
+
+/// Parses a number following a separator
+static Bool nextNumber(const char*& p, Real& value) {
+	p = skipSpaces(p);
+	if (*p != ',')
+		return false;
+	++p;
+	char* end;
+	value = std::strtod(p, &end);
+	if (end == p)
+		return false;
+	p = end;
+	return true;
+}
+
+LoadProfile::LoadProfile(const std::experimental::filesystem::path& file,
+	Real startTime, Real timeStep, Real endTime,
+	DataFormat format, UInt window, Bool skipFirstRow, Real scaleFactor) :
+	mFile(file), mFormat(format), mScaleFactor(scaleFactor), mTimeStep(timeStep) {
+
+	if (timeStep <= 0)
+		throw SystemError("Time step of load profile " + mFile.string() + " must be positive");
+
+	mStream.open(mFile);
+	if (!mStream)
+		throw SystemError("Cannot open load profile " + mFile.string());
+
+	// Find the first data row, skipping empty rows and the title
+	Bool firstRow = true;
+	while (true) {
+		mDataStart = mStream.tellg();
+		mDataLine = mLineNumber;
+		if (!std::getline(mStream, mLine))
+			throw SystemError("Load profile " + mFile.string() + " has no data");
+		++mLineNumber;
+
+		const char* p = skipSpaces(mLine.c_str());
+		if (*p == '\0')
+			continue;
+		if (firstRow && skipFirstRow && !std::isdigit(static_cast<unsigned char>(*p))) {
+			firstRow = false;
+			continue;
+		}
+		break;
+	}
+
+	// Rows of time and weighting factor have a single separator
+	String row(mLine);
+	row.erase(row.find_last_not_of(" \t\r,") + 1);
+	mWeightingFactors = std::count(row.begin(), row.end(), ',') == 1;
+
+	rewind();
+	if (!mHaveNext)
+		throw SystemError("Load profile " + mFile.string() + " has no data");
+	mStartTime = (startTime < 0) ? mNext.time : startTime;
+
+	if (endTime < 0) {
+		Sample sample;
+		endTime = mNext.time;
+		while (readSample(sample))
+			endTime = sample.time;
+		rewind();
+	}
+	if (endTime < mStartTime)
+		throw SystemError("Load profile " + mFile.string() + " ends before its start time");
+
+	mNumSteps = static_cast<UInt>(std::floor((endTime - mStartTime) / mTimeStep + 1e-9)) + 1;
+	mWindow = (window == 0 || window > mNumSteps) ? mNumSteps : window;
+	mFirstValues.resize(mWindow);
+	mSecondValues.resize(mWindow);
+
+	loadWindow(0);
+	if (mWindow == mNumSteps)
+		mStream.close();
+}
+
+UInt LoadProfile::step(Real time) const {
+	Real step = std::round((time - mStartTime) / mTimeStep);
+	if (step <= 0)
+		return 0;
+	if (step >= mNumSteps - 1)
+		return mNumSteps - 1;
+	return static_cast<UInt>(step);
+}
+
+void LoadProfile::loadWindow(UInt first) {
+	mFirstStep = first;
+	mLoadedSteps = std::min(mWindow, mNumSteps - first);
+	++mNumLoads;
+
+	if (mHavePrev && mStartTime + first * mTimeStep < mPrev.time)
+		rewind();
+
+	for (UInt k = 0; k < mLoadedSteps; ++k) {
+		Real time = mStartTime + (first + k) * mTimeStep;
+		while (mHaveNext && mNext.time <= time) {
+			mPrev = mNext;
+			mHavePrev = true;
+			mHaveNext = readSample(mNext);
+		}
+
+		// Values beyond the first or last row are held constant
+		if (!mHaveNext) {
+			mFirstValues[k] = mPrev.first;
+			mSecondValues[k] = mPrev.second;
+		} else if (!mHavePrev) {
+			mFirstValues[k] = mNext.first;
+			mSecondValues[k] = mNext.second;
+		} else {
+			Real delta = (time - mPrev.time) / (mNext.time - mPrev.time);
+			mFirstValues[k] = delta * mNext.first + (1 - delta) * mPrev.first;
+			mSecondValues[k] = delta * mNext.second + (1 - delta) * mPrev.second;
+		}
+	}
+}
+
+Bool LoadProfile::readSample(Sample& sample) {
+	while (std::getline(mStream, mLine)) {
+		++mLineNumber;
+		const char* p = skipSpaces(mLine.c_str());
+		if (*p == '\0')
+			continue;
+
+		char* end;
+		sample.time = parseTime(p, &end);
+		Bool valid = end != p;
+		p = end;
+		valid = valid && nextNumber(p, sample.first);
+
+		if (mWeightingFactors) {
+			sample.second = 0;
+		} else {
+			valid = valid && nextNumber(p, sample.second);
+			// multiplied by 1000 due to unit conversion (kw to w)
+			sample.first *= 1000 * mScaleFactor;
+			sample.second *= 1000 * mScaleFactor;
+		}
+
+		if (!valid)
+			throw SystemError("Invalid row " + std::to_string(mLineNumber) + " in load profile " + mFile.string());
+		return true;
+	}
+	return false;
+}
+
+void LoadProfile::rewind() {
+	mStream.clear();
+	mStream.seekg(mDataStart);
+	mLineNumber = mDataLine;
+	mHavePrev = false;
+	mHaveNext = readSample(mNext);
+}
+
+Real LoadProfile::parseTime(const char* begin, char** end) const {
+	switch (mFormat) {
+		case DataFormat::HHMMSS: {
+			char* p;
+			long hh = std::strtol(begin, &p, 10);
+			if (p == begin || *p != ':') {
+				*end = const_cast<char*>(begin);
+				return 0;
+			}
+			long mm = std::strtol(p + 1, &p, 10);
+			long ss = 0;
+			if (*p == ':')
+				ss = std::strtol(p + 1, &p, 10);
+			*end = p;
+			return hh * 3600 + mm * 60 + ss;
+		}
+		case DataFormat::HOURS:
+			return std::strtod(begin, end) * 3600;
+		case DataFormat::MINUTES:
+			return std::strtod(begin, end) * 60;
+		default:
+			return std::strtod(begin, end);
+	}
+}
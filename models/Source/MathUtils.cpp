@@ -6,11 +6,14 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <vector>
+
 #include <cps/MathUtils.h>
 
 using namespace CPS;
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u_new, const Matrix& u_old) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
@@ -21,7 +24,7 @@ Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, M
 	return F2inv*F1*states + F2inv*(dt/2.) * B*(u_new + u_old);
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u_new, const Matrix& u_old) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
@@ -32,7 +35,7 @@ Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C,
 	return F2inv*F1*states + F2inv*(dt/2.) * B*(u_new + u_old) + F2inv*dt*C;
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
@@ -51,7 +54,7 @@ Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real C, Real dt, R
 	return F2inv*F1*states + F2inv*dt*B*u + F2inv*dt*C;
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
@@ -62,7 +65,7 @@ Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, M
 	return F2inv * F1*states + F2inv * dt*B*u;
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix input, Real dt) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& input, Real dt) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
@@ -81,7 +84,7 @@ Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u) {
 	return F2inv * F1*states + F2inv * dt*B*u;
 }
 
-Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix B, Real dt, Matrix u) {
+Matrix Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u) {
 	return states + dt * ( A*states + B*u );
 }
 
@@ -89,7 +92,7 @@ Real Math::StateSpaceEuler(Real states, Real A, Real B, Real dt, Real u) {
 	return states + dt * ( A*states + B*u );
 }
 
-Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u) {
+Matrix Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u) {
 	return states + dt * ( A*states + B*u + C );
 }
 
@@ -97,10 +100,86 @@ Real Math::StateSpaceEuler(Real states, Real A, Real B, Real C, Real dt, Real u)
 	return states + dt * ( A*states + B*u + C );
 }
 
-Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix input, Real dt) {
+Matrix Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& input, Real dt) {
 	return states + dt * ( A*states + input );
 }
 
+/// Sets F1 = I + dt/2 A and factorizes F2 = I - dt/2 A
+static void trapezoidalMatrices(const Matrix& A, Real dt, Math::StateSpaceWorkspace& ws) {
+	Matrix::Index n = A.rows();
+	ws.F1.setIdentity(n, n);
+	ws.F1 += (dt/2.) * A;
+	ws.F2.setIdentity(n, n);
+	ws.F2 -= (dt/2.) * A;
+	ws.lu.compute(ws.F2);
+}
+
+void Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u_new, const Matrix& u_old,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	trapezoidalMatrices(A, dt, ws);
+	ws.rhs.noalias() = ws.F1 * states;
+	ws.rhs.noalias() += (dt/2.) * B * u_new;
+	ws.rhs.noalias() += (dt/2.) * B * u_old;
+	newStates = ws.lu.solve(ws.rhs);
+}
+
+void Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u_new, const Matrix& u_old,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	trapezoidalMatrices(A, dt, ws);
+	ws.rhs.noalias() = ws.F1 * states;
+	ws.rhs.noalias() += (dt/2.) * B * u_new;
+	ws.rhs.noalias() += (dt/2.) * B * u_old;
+	ws.rhs += dt * C;
+	newStates = ws.lu.solve(ws.rhs);
+}
+
+void Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	trapezoidalMatrices(A, dt, ws);
+	ws.rhs.noalias() = ws.F1 * states;
+	ws.rhs.noalias() += dt * B * u;
+	newStates = ws.lu.solve(ws.rhs);
+}
+
+void Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	trapezoidalMatrices(A, dt, ws);
+	ws.rhs.noalias() = ws.F1 * states;
+	ws.rhs.noalias() += dt * B * u;
+	ws.rhs += dt * C;
+	newStates = ws.lu.solve(ws.rhs);
+}
+
+void Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& input, Real dt,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	trapezoidalMatrices(A, dt, ws);
+	ws.rhs.noalias() = ws.F1 * states;
+	ws.rhs += dt * input;
+	newStates = ws.lu.solve(ws.rhs);
+}
+
+void Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	ws.rhs.noalias() = A * states;
+	ws.rhs.noalias() += B * u;
+	newStates = states + dt * ws.rhs;
+}
+
+void Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	ws.rhs.noalias() = A * states;
+	ws.rhs.noalias() += B * u;
+	ws.rhs += C;
+	newStates = states + dt * ws.rhs;
+}
+
+void Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& input, Real dt,
+	Matrix& newStates, StateSpaceWorkspace& ws) {
+	ws.rhs.noalias() = A * states;
+	ws.rhs += input;
+	newStates = states + dt * ws.rhs;
+}
+
 void Math::FFT(std::vector<Complex>& samples) {
 	// DFT
 	size_t N = samples.size();
@@ -151,4 +230,40 @@ Complex Math::rotatingFrame2to1(Complex f2, Real theta1, Real theta2) {
 	Real f1_real = f2.real() * cos(delta) - f2.imag() * sin(delta);
 	Real f1_imag = f2.real() * sin(delta) + f2.imag() * cos(delta);
 	return Complex(f1_real, f1_imag);
-}
\ No newline at end of file
+}
+
+Bool Math::complexFromRealExpansion(const SparseMatrixRow& mat, SparseMatrixCompRow& comp) {
+	if (mat.rows() != mat.cols() || mat.rows() % 2 != 0)
+		return false;
+
+	// The upper half holds Re in the left and -Im in the right quadrant,
+	// the lower half Im in the left and Re in the right quadrant
+	Eigen::Index size = mat.rows() / 2;
+	std::vector<Eigen::Triplet<Complex>> upper, lower;
+	for (Eigen::Index row = 0; row < mat.outerSize(); ++row) {
+		for (SparseMatrixRow::InnerIterator it(mat, row); it; ++it) {
+			Bool left = it.col() < size;
+			Eigen::Index col = left ? it.col() : it.col() - size;
+			if (row < size)
+				upper.emplace_back(row, col, left ? Complex(it.value(), 0) : Complex(0, -it.value()));
+			else
+				lower.emplace_back(row - size, col, left ? Complex(0, it.value()) : Complex(it.value(), 0));
+		}
+	}
+
+	comp.resize(size, size);
+	comp.setFromTriplets(upper.begin(), upper.end());
+	SparseMatrixCompRow check(size, size);
+	check.setFromTriplets(lower.begin(), lower.end());
+
+	Real scale = 0;
+	for (Eigen::Index k = 0; k < comp.nonZeros(); ++k)
+		scale = std::max(scale, std::abs(comp.valuePtr()[k]));
+	SparseMatrixCompRow difference = comp - check;
+	for (Eigen::Index k = 0; k < difference.nonZeros(); ++k) {
+		if (std::abs(difference.valuePtr()[k]) > 1e-12 * scale)
+			return false;
+	}
+	comp.makeCompressed();
+	return true;
+}
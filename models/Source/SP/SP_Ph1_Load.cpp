@@ -85,11 +85,13 @@ void SP::Ph1::Load::modifyPowerFlowBusType(PowerflowBusType powerflowBusType) {
 
 
 void SP::Ph1::Load::updatePQ(Real time) {
-	if (mLoadProfile.weightingFactors.empty()) {
-		this->attribute<Real>("P")->set(mLoadProfile.pqData.find(time)->second.p);
-		this->attribute<Real>("Q")->set(mLoadProfile.pqData.find(time)->second.q);
+	UInt step = mLoadProfile->step(time);
+	if (!mLoadProfile->hasWeightingFactors()) {
+		PQData pq = mLoadProfile->pq(step);
+		this->attribute<Real>("P")->set(pq.p);
+		this->attribute<Real>("Q")->set(pq.q);
 	} else {
-		Real wf = mLoadProfile.weightingFactors.find(time)->second;
+		Real wf = mLoadProfile->weightingFactor(step);
 		Real P_new = this->attribute<Real>("P_nom")->get()*wf;
 		Real Q_new = this->attribute<Real>("Q_nom")->get()*wf;
 		this->attribute<Real>("P")->set(P_new);
@@ -184,7 +186,7 @@ void SP::Ph1::Load::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::
 }
 
 
-void SP::Ph1::Load::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph1::Load::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (mSubResistor)
 		mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	if (mSubInductor)
@@ -53,7 +53,7 @@ void SP::Ph1::Switch::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void SP::Ph1::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph1::Switch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Complex conductance = (mIsClosed) ?
 		Complex( 1./mClosedResistance, 0 ) : Complex( 1./mOpenResistance, 0 );
 
@@ -79,7 +79,7 @@ void SP::Ph1::Switch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 	}
 }
 
-void SP::Ph1::Switch::mnaApplySwitchSystemMatrixStamp(Matrix& systemMatrix, Bool closed) {
+void SP::Ph1::Switch::mnaApplySwitchSystemMatrixStamp(SparseMatrixRow& systemMatrix, Bool closed) {
 	Complex conductance = (closed) ?
 		Complex( 1./mClosedResistance, 0 ) :
 		Complex( 1./mOpenResistance, 0 );
@@ -38,7 +38,7 @@ void SP::Ph3::ControlledVoltageSource::mnaInitialize(Real omega, Real timeStep,
 	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 }
 
-void SP::Ph3::ControlledVoltageSource::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph3::ControlledVoltageSource::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), mVirtualNodes[0]->matrixNodeIndex(PhaseType::A), Complex(-1, 0));
 		Math::addToMatrixElement(systemMatrix, mVirtualNodes[0]->matrixNodeIndex(PhaseType::A), matrixNodeIndex(0, 0), Complex(-1, 0));
@@ -170,3 +170,19 @@ Task::List DecouplingLine::getTasks() {
 IdentifiedObject::List DecouplingLine::getLineComponents() {
 	return IdentifiedObject::List({mRes1, mRes2, mSrc1, mSrc2});
 }
+
+void DecouplingLine::writeCheckpoint(CheckpointWriter& writer) {
+	writer.write(mVolt1);
+	writer.write(mVolt2);
+	writer.write(mCur1);
+	writer.write(mCur2);
+	writer.write(mBufIdx);
+}
+
+void DecouplingLine::readCheckpoint(CheckpointReader& reader) {
+	reader.read(mVolt1);
+	reader.read(mVolt2);
+	reader.read(mCur1);
+	reader.read(mCur2);
+	reader.read(mBufIdx);
+}
@@ -132,3 +132,19 @@ Task::List DecouplingLineEMT::getTasks() {
 IdentifiedObject::List DecouplingLineEMT::getLineComponents() {
 	return IdentifiedObject::List({mRes1, mRes2, mSrc1, mSrc2});
 }
+
+void DecouplingLineEMT::writeCheckpoint(CheckpointWriter& writer) {
+	writer.write(mVolt1);
+	writer.write(mVolt2);
+	writer.write(mCur1);
+	writer.write(mCur2);
+	writer.write(mBufIdx);
+}
+
+void DecouplingLineEMT::readCheckpoint(CheckpointReader& reader) {
+	reader.read(mVolt1);
+	reader.read(mVolt2);
+	reader.read(mCur1);
+	reader.read(mCur2);
+	reader.read(mBufIdx);
+}
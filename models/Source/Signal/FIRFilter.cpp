@@ -63,3 +63,13 @@ Int FIRFilter::getIndex(Int index) {
 void FIRFilter::setInput(Attribute<Real>::Ptr input) {
 	mInput = input;
 }
+
+void FIRFilter::writeCheckpoint(CheckpointWriter& writer) {
+	writer.write(mSignal);
+	writer.write(mCurrentIdx);
+}
+
+void FIRFilter::readCheckpoint(CheckpointReader& reader) {
+	reader.read(mSignal);
+	reader.read(mCurrentIdx);
+}
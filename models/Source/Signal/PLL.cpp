@@ -15,6 +15,7 @@ PLL::PLL(String name, Logger::Level logLevel) :
 	SimSignalComp(name, name, logLevel) {
 
     addAttribute<Real>("input_ref", Flags::read | Flags::write);
+	mStateSpaceWorkspace.resize(2);
 
     addAttribute<Matrix>("input_prev", &mInputPrev, Flags::read | Flags::write);
     addAttribute<Matrix>("state_prev", &mStatePrev, Flags::read | Flags::write);
@@ -92,8 +93,9 @@ void PLL::signalStep(Real time, Int timeStepCount) {
     mSLog->info("Time {}:", time);
     mSLog->info("Input values: inputCurr = ({}, {}), inputPrev = ({}, {}), stateCurr = ({}, {}), statePrev = ({}, {})", mInputCurr(0,0), mInputCurr(1,0), mInputPrev(0,0), mInputPrev(1,0), mStateCurr(0,0), mStateCurr(1,0), mStatePrev(0,0), mStatePrev(1,0));
 
-    mStateCurr = Math::StateSpaceTrapezoidal(mStatePrev, mA, mB, mTimeStep, mInputCurr, mInputPrev);
-    mOutputCurr = mC * mStateCurr + mD * mInputCurr;
+    Math::StateSpaceTrapezoidal(mStatePrev, mA, mB, mTimeStep, mInputCurr, mInputPrev, mStateCurr, mStateSpaceWorkspace);
+    mOutputCurr.noalias() = mC * mStateCurr;
+    mOutputCurr.noalias() += mD * mInputCurr;
 
     mSLog->info("State values: stateCurr = ({}, {})", mStateCurr(0,0), mStateCurr(1,0));
     mSLog->info("Output values: outputCurr = ({}, {}):", mOutputCurr(0,0), mOutputCurr(1,0));
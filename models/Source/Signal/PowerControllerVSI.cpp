@@ -15,6 +15,7 @@ PowerControllerVSI::PowerControllerVSI(String name, Logger::Level logLevel) :
 	SimSignalComp(name, name, logLevel) {
 
 	mSLog->info("Create {} {}", type(), name);
+	mStateSpaceWorkspace.resize(6);
 	
 	// attributes of full state space model vectors
 	addAttribute<Matrix>("input_prev", &mInputPrev, Flags::read | Flags::write);
@@ -160,11 +161,12 @@ void PowerControllerVSI::signalStep(Real time, Int timeStepCount) {
     mSLog->debug("Time {}\n: inputCurr = \n{}\n , inputPrev = \n{}\n , statePrev = \n{}", time, mInputCurr, mInputPrev, mStatePrev);
 
 	// calculate new states
-	mStateCurr = Math::StateSpaceTrapezoidal(mStatePrev, mA, mB, mTimeStep, mInputCurr, mInputPrev);
+	Math::StateSpaceTrapezoidal(mStatePrev, mA, mB, mTimeStep, mInputCurr, mInputPrev, mStateCurr, mStateSpaceWorkspace);
 	mSLog->debug("stateCurr = \n {}", mStateCurr);
 
 	// calculate new outputs
-	mOutputCurr = mC * mStateCurr + mD * mInputCurr;
+	mOutputCurr.noalias() = mC * mStateCurr;
+	mOutputCurr.noalias() += mD * mInputCurr;
 	mSLog->debug("Output values: outputCurr = \n{}", mOutputCurr);
 }
 
@@ -78,6 +78,19 @@ void SimNode<Complex>::mnaUpdateVoltage(const Matrix& leftVector) {
 	}
 }
 
+template<>
+void SimNode<Real>::mnaUpdateVoltage(const MatrixComp& leftVector) { }
+
+template<>
+void SimNode<Complex>::mnaUpdateVoltage(const MatrixComp& leftVector) {
+	// Complex systems are only solved without harmonics
+	if (mMatrixNodeIndex[0] >= 0) mVoltage(0,0) = leftVector(mMatrixNodeIndex[0], 0);
+	if (mPhaseType == PhaseType::ABC) {
+		if (mMatrixNodeIndex[1] >= 0) mVoltage(1,0) = leftVector(mMatrixNodeIndex[1], 0);
+		if (mMatrixNodeIndex[2] >= 0) mVoltage(2,0) = leftVector(mMatrixNodeIndex[2], 0);
+	}
+}
+
 template<>
 void SimNode<Real>::mnaUpdateVoltageHarm(const Matrix& leftVector, Int freqIdx) { }
 
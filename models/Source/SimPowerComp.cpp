@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+
 #include <cps/SimPowerComp.h>
 
 using namespace CPS;
@@ -168,6 +170,54 @@ void SimPowerComp<VarType>::initialize(Matrix frequencies) {
 		node->initialize(frequencies);
 }
 
+/// Collects the matrix node indices of all nodes a component and its
+/// subcomponents are connected to, including their virtual nodes.
+template <typename VarType>
+static void collectMatrixNodeIndices(SimPowerComp<VarType>& comp, std::vector<UInt>& indices) {
+	for (auto terminal : comp.terminals()) {
+		auto node = terminal->node();
+		if (node && !node->isGround()) {
+			for (auto idx : node->matrixNodeIndices())
+				indices.push_back(idx);
+		}
+	}
+	for (auto node : comp.virtualNodes()) {
+		for (auto idx : node->matrixNodeIndices())
+			indices.push_back(idx);
+	}
+	for (auto subComp : comp.subComponents())
+		collectMatrixNodeIndices<VarType>(*subComp, indices);
+}
+
+template<typename VarType>
+std::vector<UInt> SimPowerComp<VarType>::rightVectorRows(UInt vectorRows, UInt numFreqs) {
+	std::vector<UInt> indices;
+	collectMatrixNodeIndices<VarType>(*this, indices);
+
+	std::vector<UInt> rows;
+	if (std::is_same<VarType, Complex>::value) {
+		// Real and imaginary parts of every frequency,
+		// see Math::setVectorElement for the layout
+		numFreqs = std::max<UInt>(1, numFreqs);
+		UInt harmonicOffset = vectorRows / numFreqs;
+		UInt complexOffset = harmonicOffset / 2;
+		for (auto idx : indices) {
+			for (UInt freq = 0; freq < numFreqs; ++freq) {
+				rows.push_back(idx + harmonicOffset * freq);
+				rows.push_back(idx + harmonicOffset * freq + complexOffset);
+			}
+		}
+	}
+	else {
+		rows = indices;
+	}
+
+	std::sort(rows.begin(), rows.end());
+	rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+	rows.erase(std::lower_bound(rows.begin(), rows.end(), vectorRows), rows.end());
+	return rows;
+}
+
 // Declare specializations to move definitions to .cpp
 template class CPS::SimPowerComp<Real>;
 template class CPS::SimPowerComp<Complex>;
@@ -77,6 +77,114 @@ void SystemTopology::multiply(Int numCopies) {
 	multiplyPowerComps<Complex>(numCopies);
 }
 
+/// Adds a key to an index unless an object at a lower position has it
+static void indexKey(std::unordered_map<String, std::size_t>& index, const String& key, std::size_t pos) {
+	auto it = index.emplace(key, pos).first;
+	if (it->second > pos)
+		it->second = pos;
+}
+
+/// Extends the name and UID index of a list by its new entries, or
+/// rebuilds it if entries were removed
+template<typename ListType>
+static void updateIndex(const ListType& list, std::size_t& indexed,
+	std::unordered_map<String, std::size_t>& names, std::unordered_map<String, std::size_t>& uids) {
+	if (indexed == 0 || indexed > list.size()) {
+		names.clear();
+		uids.clear();
+		indexed = 0;
+	}
+	for (; indexed < list.size(); ++indexed) {
+		auto& obj = list[indexed];
+		if (!obj)
+			continue;
+		indexKey(names, obj->name(), indexed);
+		indexKey(uids, obj->uid(), indexed);
+	}
+}
+
+/// Looks up a key in the index of a list. Returns the position or the
+/// list size if the key is not found. The index is rebuilt once if the
+/// entry at the indexed position does not match the key anymore.
+template<typename ListType>
+static std::size_t findIndexed(const ListType& list, std::size_t& indexed,
+	std::unordered_map<String, std::size_t>& names, std::unordered_map<String, std::size_t>& uids,
+	const String& key, Bool byUID) {
+	for (int attempt = 0; attempt < 2; ++attempt) {
+		updateIndex(list, indexed, names, uids);
+		auto& index = byUID ? uids : names;
+		auto it = index.find(key);
+		if (it == index.end())
+			return list.size();
+
+		auto& obj = list[it->second];
+		if (obj && (byUID ? obj->uid() : obj->name()) == key)
+			return it->second;
+		indexed = 0;
+	}
+	return list.size();
+}
+
+void SystemTopology::updateNodeIndex() {
+	updateIndex(mNodes, mIndexedNodes, mNodeNames, mNodeUIDs);
+}
+
+void SystemTopology::updateComponentIndex() {
+	updateIndex(mComponents, mIndexedComponents, mComponentNames, mComponentUIDs);
+}
+
+void SystemTopology::rebuildIndices() {
+	mIndexedNodes = 0;
+	mIndexedComponents = 0;
+	updateNodeIndex();
+	updateComponentIndex();
+}
+
+void SystemTopology::addNodeAt(TopologicalNode::Ptr topNode, UInt index) {
+	auto node = std::dynamic_pointer_cast<SimNode<Complex>>(topNode);
+	if (node) node->initialize(mFrequencies);
+
+	auto nodeReal = std::dynamic_pointer_cast<SimNode<Real>>(topNode);
+	if (nodeReal) nodeReal->initialize(mFrequencies);
+
+	if (index >= mNodes.size())
+		mNodes.resize(index + 1);
+	updateNodeIndex();
+
+	// The keys of a replaced node may also belong to nodes at higher
+	// positions, which is why the index is rebuilt in this case
+	Bool replaced = mNodes[index] != nullptr;
+	mNodes[index] = topNode;
+	if (replaced) {
+		mIndexedNodes = 0;
+		updateNodeIndex();
+	} else if (topNode) {
+		indexKey(mNodeNames, topNode->name(), index);
+		indexKey(mNodeUIDs, topNode->uid(), index);
+	}
+}
+
+TopologicalNode::Ptr SystemTopology::findNode(const String &key, Bool byUID) {
+	std::size_t pos = findIndexed(mNodes, mIndexedNodes, mNodeNames, mNodeUIDs, key, byUID);
+	return pos < mNodes.size() ? mNodes[pos] : nullptr;
+}
+
+IdentifiedObject::Ptr SystemTopology::findComponent(const String &key, Bool byUID) {
+	std::size_t pos = findIndexed(mComponents, mIndexedComponents, mComponentNames, mComponentUIDs, key, byUID);
+	return pos < mComponents.size() ? mComponents[pos] : nullptr;
+}
+
+Bool SystemTopology::removeComponent(const String &name) {
+	std::size_t pos = findIndexed(mComponents, mIndexedComponents, mComponentNames, mComponentUIDs, name, false);
+	if (pos == mComponents.size())
+		return false;
+
+	mComponents.erase(mComponents.begin() + pos);
+	mIndexedComponents = 0;
+	updateComponentIndex();
+	return true;
+}
+
 void SystemTopology::reset() {
 	for (auto c : mComponents) {
 		c->reset();
@@ -129,8 +237,8 @@ void SystemTopology::splitSubnets(std::vector<SystemTopology>& splitSystems) {
 }
 
 template <typename VarType>
-int SystemTopology::checkTopologySubnets(std::unordered_map<typename SimNode<VarType>::Ptr, int>& subnet) {
-	std::unordered_map<typename SimNode<VarType>::Ptr, typename SimNode<VarType>::List> neighbours;
+void SystemTopology::forEachConnectedNodePair(const std::function<void(typename SimNode<VarType>::Ptr,
+	typename SimNode<VarType>::Ptr, typename SimPowerComp<VarType>::Ptr)>& func) {
 
 	for (auto comp : mComponents) {
 		auto pcomp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
@@ -144,11 +252,21 @@ int SystemTopology::checkTopologySubnets(std::unordered_map<typename SimNode<Var
 				if (node1->isGround() || node2->isGround())
 					continue;
 
-				neighbours[node1].push_back(node2);
-				neighbours[node2].push_back(node1);
+				func(node1, node2, pcomp);
 			}
 		}
 	}
+}
+
+template <typename VarType>
+int SystemTopology::checkTopologySubnets(std::unordered_map<typename SimNode<VarType>::Ptr, int>& subnet) {
+	std::unordered_map<typename SimNode<VarType>::Ptr, typename SimNode<VarType>::List> neighbours;
+
+	forEachConnectedNodePair<VarType>([&neighbours](typename SimNode<VarType>::Ptr node1,
+		typename SimNode<VarType>::Ptr node2, typename SimPowerComp<VarType>::Ptr comp) {
+		neighbours[node1].push_back(node2);
+		neighbours[node2].push_back(node1);
+	});
 
 	int currentNet = 0;
 	size_t totalNodes = mNodes.size();
@@ -168,18 +286,22 @@ int SystemTopology::checkTopologySubnets(std::unordered_map<typename SimNode<Var
 				continue;
 
 			if (subnet.find(node) == subnet.end()) {
+				subnet[node] = currentNet;
 				nextSet.push_back(node);
 				break;
 			}
 		}
+		// Nodes are assigned when they are queued, so meshed networks
+		// do not queue the same node several times.
 		while (!nextSet.empty()) {
 			auto node = nextSet.front();
 			nextSet.pop_front();
 
-			subnet[node] = currentNet;
 			for (auto neighbour : neighbours[node]) {
-				if (subnet.find(neighbour) == subnet.end())
+				if (subnet.find(neighbour) == subnet.end()) {
+					subnet[neighbour] = currentNet;
 					nextSet.push_back(neighbour);
+				}
 			}
 		}
 		currentNet++;
@@ -301,6 +423,10 @@ void SystemTopology::renderToFile(String filename) {
 #endif
 
 // Explicit instantiation of template functions to be able to keep the definition in the cpp
+template void SystemTopology::forEachConnectedNodePair<Real>(const std::function<void(typename CPS::SimNode<Real>::Ptr,
+	typename CPS::SimNode<Real>::Ptr, typename CPS::SimPowerComp<Real>::Ptr)>& func);
+template void SystemTopology::forEachConnectedNodePair<Complex>(const std::function<void(typename CPS::SimNode<Complex>::Ptr,
+	typename CPS::SimNode<Complex>::Ptr, typename CPS::SimPowerComp<Complex>::Ptr)>& func);
 template int SystemTopology::checkTopologySubnets<Real>(std::unordered_map<typename CPS::SimNode<Real>::Ptr, int>& subnet);
 template int SystemTopology::checkTopologySubnets<Complex>(std::unordered_map<typename CPS::SimNode<Complex>::Ptr, int>& subnet);
 template void SystemTopology::splitSubnets<Real>(std::vector<CPS::SystemTopology>& splitSystems);
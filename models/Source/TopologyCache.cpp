@@ -0,0 +1,402 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <fstream>
+
+#include <cps/TopologyCache.h>
+#include <cps/Checkpoint.h>
+#include <cps/Components.h>
+
+using namespace CPS;
+
+namespace fs = std::experimental::filesystem;
+
+const UInt TopologyCache::version;
+
+namespace {
+	/// Marks the beginning of a cache file
+	const UInt magic = 0x43505354;
+
+	void checkParameters(const TopologyCache::Component& desc, std::size_t count) {
+		if (desc.parameters.size() != count)
+			throw SystemError("Wrong number of parameters for " + desc.type + " " + desc.uid);
+	}
+
+	void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+		for (std::size_t i = 0; i < size; ++i) {
+			hash ^= static_cast<const unsigned char*>(data)[i];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	/// Writes the descriptions and terminals of the components. The nodes
+	/// of the terminals are written as their positions in the node list.
+	template <typename VarType>
+	Bool writeTerminals(CheckpointWriter& writer, IdentifiedObject::Ptr comp,
+		const std::map<TopologicalNode::Ptr, Int>& nodeIndices) {
+
+		auto powerComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!powerComp)
+			return false;
+
+		auto terminals = powerComp->terminals();
+		writer.write(static_cast<UInt>(terminals.size()));
+		for (auto term : terminals) {
+			writer.write(term != nullptr);
+			if (!term)
+				continue;
+
+			Int nodeIndex = -1;
+			if (!term->node()->isGround()) {
+				auto search = nodeIndices.find(term->node());
+				if (search == nodeIndices.end())
+					throw SystemError("Terminal " + term->uid() + " is connected to an unknown node");
+				nodeIndex = search->second;
+			}
+			writer.write(term->uid());
+			writer.write(term->name());
+			writer.write(nodeIndex);
+			writer.write(term->power());
+		}
+		return true;
+	}
+
+	template <typename VarType>
+	void readTerminals(CheckpointReader& reader, typename SimPowerComp<VarType>::Ptr comp,
+		const TopologicalNode::List& nodes) {
+
+		UInt count = reader.read<UInt>();
+		for (UInt i = 0; i < count; ++i) {
+			if (!reader.read<Bool>())
+				continue;
+
+			auto uid = reader.read<String>();
+			auto name = reader.read<String>();
+			Int nodeIndex = reader.read<Int>();
+
+			typename SimNode<VarType>::Ptr node = SimNode<VarType>::GND;
+			if (nodeIndex >= 0) {
+				if (static_cast<std::size_t>(nodeIndex) >= nodes.size())
+					throw SystemError("Terminal " + uid + " refers to a missing node");
+				node = std::dynamic_pointer_cast<SimNode<VarType>>(nodes[nodeIndex]);
+				if (!node)
+					throw SystemError("Terminal " + uid + " refers to a node of another domain");
+			}
+
+			auto term = SimTerminal<VarType>::make(uid, name);
+			term->setNode(node);
+			term->setPower(reader.read<MatrixComp>());
+			comp->setTerminalAt(term, i);
+		}
+	}
+
+	void writeComponents(CheckpointWriter& writer, const IdentifiedObject::List& comps,
+		const std::unordered_map<String, TopologyCache::Component>& descs,
+		const std::map<TopologicalNode::Ptr, Int>& nodeIndices) {
+
+		writer.write(static_cast<UInt>(comps.size()));
+		for (auto comp : comps) {
+			auto desc = descs.find(comp->uid());
+			if (desc == descs.end())
+				throw SystemError("Missing description of component " + comp->uid());
+
+			writer.write(desc->second.type);
+			writer.write(desc->second.uid);
+			writer.write(desc->second.name);
+			writer.write(desc->second.parameters);
+			if (!writeTerminals<Complex>(writer, comp, nodeIndices)
+				&& !writeTerminals<Real>(writer, comp, nodeIndices))
+				throw SystemError("Component " + comp->uid() + " is no simulation power component");
+		}
+	}
+
+	IdentifiedObject::List readComponents(CheckpointReader& reader, const TopologicalNode::List& nodes,
+		std::vector<TopologyCache::Component>& descs, Logger::Level logLevel) {
+
+		IdentifiedObject::List comps;
+		UInt count = reader.read<UInt>();
+		for (UInt i = 0; i < count; ++i) {
+			TopologyCache::Component desc;
+			reader.read(desc.type);
+			reader.read(desc.uid);
+			reader.read(desc.name);
+			reader.read(desc.parameters);
+
+			auto comp = TopologyCache::createComponent(desc, logLevel);
+			if (auto compComplex = std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp))
+				readTerminals<Complex>(reader, compComplex, nodes);
+			else
+				readTerminals<Real>(reader, std::dynamic_pointer_cast<SimPowerComp<Real>>(comp), nodes);
+			comps.push_back(comp);
+			descs.push_back(desc);
+		}
+		return comps;
+	}
+}
+
+TopologicalPowerComp::Ptr TopologyCache::createComponent(const Component& desc, Logger::Level logLevel) {
+	auto& p = desc.parameters;
+
+	// #### SP ####
+	if (desc.type == "SP::Ph1::PiLine") {
+		checkParameters(desc, 5);
+		auto line = std::make_shared<SP::Ph1::PiLine>(desc.uid, desc.name, logLevel);
+		line->setParameters(p[0], p[1], p[2], p[3]);
+		line->setBaseVoltage(p[4]);
+		return line;
+	}
+	if (desc.type == "SP::Ph1::Load") {
+		checkParameters(desc, 0);
+		auto load = std::make_shared<SP::Ph1::Load>(desc.uid, desc.name, logLevel);
+		load->setParameters(0, 0, 0);
+		load->modifyPowerFlowBusType(PowerflowBusType::PQ);
+		return load;
+	}
+	if (desc.type == "SP::Ph1::Transformer") {
+		checkParameters(desc, 8);
+		auto transformer = std::make_shared<SP::Ph1::Transformer>(desc.uid, desc.name, logLevel);
+		transformer->setParameters(p[0], p[1], p[2], p[3], p[4], p[5], p[6]);
+		transformer->setBaseVoltage(p[7]);
+		return transformer;
+	}
+	if (desc.type == "SP::Ph1::SynchronGenerator") {
+		auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(desc.uid, desc.name, logLevel);
+		// Generators without generating unit have no parameters
+		if (!p.empty()) {
+			checkParameters(desc, 4);
+			gen->setParameters(p[0], p[1], p[2], p[3], PowerflowBusType::PV);
+			gen->setBaseVoltage(p[1]);
+		}
+		return gen;
+	}
+	if (desc.type == "SP::Ph1::NetworkInjection") {
+		// Injections without voltage set-point only have a base voltage
+		if (p.size() != 1)
+			checkParameters(desc, 2);
+		auto extnet = std::make_shared<SP::Ph1::NetworkInjection>(desc.uid, desc.name, logLevel);
+		extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+		extnet->setBaseVoltage(p[0]);
+		if (p.size() == 2)
+			extnet->setParameters(p[1]);
+		return extnet;
+	}
+	if (desc.type == "SP::Ph1::Shunt") {
+		checkParameters(desc, 3);
+		auto shunt = std::make_shared<SP::Ph1::Shunt>(desc.uid, desc.name, logLevel);
+		shunt->setParameters(p[0], p[1]);
+		shunt->setBaseVoltage(p[2]);
+		return shunt;
+	}
+
+	// #### DP ####
+	if (desc.type == "DP::Ph1::PiLine") {
+		checkParameters(desc, 4);
+		auto line = std::make_shared<DP::Ph1::PiLine>(desc.uid, desc.name, logLevel);
+		line->setParameters(p[0], p[1], p[2], p[3]);
+		return line;
+	}
+	if (desc.type == "DP::Ph1::RXLoad") {
+		checkParameters(desc, 0);
+		return std::make_shared<DP::Ph1::RXLoad>(desc.uid, desc.name, logLevel);
+	}
+	if (desc.type == "DP::Ph1::RXLoadSwitch") {
+		checkParameters(desc, 0);
+		return std::make_shared<DP::Ph1::RXLoadSwitch>(desc.uid, desc.name, logLevel);
+	}
+	if (desc.type == "DP::Ph1::Transformer") {
+		checkParameters(desc, 6);
+		auto transformer = std::make_shared<DP::Ph1::Transformer>(desc.uid, desc.name, logLevel, p[4] > 0);
+		transformer->setParameters(p[0], p[1], p[2], p[3], p[4], p[5]);
+		return transformer;
+	}
+	if (desc.type == "DP::Ph1::SynchronGeneratorTrStab") {
+		checkParameters(desc, 5);
+		auto gen = DP::Ph1::SynchronGeneratorTrStab::make(desc.uid, desc.name, logLevel);
+		gen->setStandardParametersPU(p[0], p[1], p[2], p[3], p[4]);
+		return gen;
+	}
+	if (desc.type == "DP::Ph1::SynchronGeneratorIdeal") {
+		checkParameters(desc, 0);
+		return std::make_shared<DP::Ph1::SynchronGeneratorIdeal>(desc.uid, desc.name, logLevel);
+	}
+	if (desc.type == "DP::Ph1::NetworkInjection") {
+		checkParameters(desc, 0);
+		return std::make_shared<DP::Ph1::NetworkInjection>(desc.uid, desc.name, logLevel);
+	}
+
+	// #### EMT ####
+	if (desc.type == "EMT::Ph3::PiLine") {
+		checkParameters(desc, 4);
+		auto line = std::make_shared<EMT::Ph3::PiLine>(desc.uid, desc.name, logLevel);
+		line->setParameters(
+			Math::singlePhaseParameterToThreePhase(p[0]),
+			Math::singlePhaseParameterToThreePhase(p[1]),
+			Math::singlePhaseParameterToThreePhase(p[2]),
+			Math::singlePhaseParameterToThreePhase(p[3]));
+		return line;
+	}
+	if (desc.type == "EMT::Ph3::RXLoad") {
+		checkParameters(desc, 0);
+		return std::make_shared<EMT::Ph3::RXLoad>(desc.uid, desc.name, logLevel);
+	}
+	if (desc.type == "EMT::Ph3::Transformer") {
+		checkParameters(desc, 6);
+		auto transformer = std::make_shared<EMT::Ph3::Transformer>(desc.uid, desc.name, logLevel, p[4] > 0);
+		transformer->setParameters(p[0], p[1], p[2], p[3],
+			Math::singlePhaseParameterToThreePhase(p[4]),
+			Math::singlePhaseParameterToThreePhase(p[5]));
+		return transformer;
+	}
+	if (desc.type == "EMT::Ph3::NetworkInjection") {
+		checkParameters(desc, 0);
+		return std::make_shared<EMT::Ph3::NetworkInjection>(desc.uid, desc.name, logLevel);
+	}
+
+	throw SystemError("Unsupported component type " + desc.type);
+}
+
+std::uint64_t TopologyCache::hashFiles(const std::list<fs::path>& filenames, std::uint64_t seed) {
+	std::uint64_t hash = 14695981039346656037ULL;
+	hashBytes(hash, &seed, sizeof(seed));
+
+	std::vector<char> buffer(1 << 16);
+	for (auto filename : filenames) {
+		std::ifstream in(filename, std::ios::binary);
+		if (!in)
+			throw SystemError("Cannot read " + filename.string());
+
+		std::uint64_t size = 0;
+		while (in) {
+			in.read(buffer.data(), buffer.size());
+			hashBytes(hash, buffer.data(), static_cast<std::size_t>(in.gcount()));
+			size += static_cast<std::uint64_t>(in.gcount());
+		}
+		// Separates the files, so that moving bytes between them changes the hash
+		hashBytes(hash, &size, sizeof(size));
+	}
+	return hash;
+}
+
+void TopologyCache::write(std::ostream& out, std::uint64_t key, SystemTopology& system) const {
+	CheckpointWriter writer(out);
+	writer.write(magic);
+	writer.write(version);
+	writer.write(static_cast<UInt>(key >> 32));
+	writer.write(static_cast<UInt>(key & 0xffffffff));
+	writer.write(system.mSystemFrequency);
+	writer.write(system.mFrequencies);
+
+	// The terminals refer to the nodes by their position in the list
+	std::map<TopologicalNode::Ptr, Int> nodeIndices;
+	writer.write(static_cast<UInt>(system.mNodes.size()));
+	for (std::size_t i = 0; i < system.mNodes.size(); ++i) {
+		auto node = system.mNodes[i];
+		if (!node)
+			throw SystemError("Cannot cache a topology with gaps in the node list");
+
+		writer.write(std::dynamic_pointer_cast<SimNode<Complex>>(node) != nullptr);
+		writer.write(node->uid());
+		writer.write(node->name());
+		writer.write(static_cast<Int>(node->phaseType()));
+		writer.write(node->matrixNodeIndices());
+		writer.write(node->initialVoltage());
+		nodeIndices[node] = static_cast<Int>(i);
+	}
+
+	writeComponents(writer, system.mComponents, mComponents, nodeIndices);
+	writeComponents(writer, system.mTearComponents, mComponents, nodeIndices);
+
+	// The map of components at nodes is written as it is, since importers
+	// like the CIM reader do not necessarily list all connections. Entries
+	// of nodes which are not in the node list, like ground, are dropped.
+	std::map<IdentifiedObject::Ptr, Int> compIndices;
+	for (std::size_t i = 0; i < system.mComponents.size(); ++i)
+		compIndices[system.mComponents[i]] = static_cast<Int>(i);
+
+	// In the order of the nodes, so that the file does not depend on addresses
+	std::vector<std::pair<Int, std::vector<Int>>> entries;
+	for (std::size_t i = 0; i < system.mNodes.size(); ++i) {
+		auto entry = system.mComponentsAtNode.find(system.mNodes[i]);
+		if (entry == system.mComponentsAtNode.end())
+			continue;
+
+		std::vector<Int> comps;
+		for (auto comp : entry->second) {
+			auto search = compIndices.find(comp);
+			if (search == compIndices.end())
+				throw SystemError("Component " + comp->uid() + " at node " + entry->first->uid() + " is not in the topology");
+			comps.push_back(search->second);
+		}
+		entries.emplace_back(static_cast<Int>(i), comps);
+	}
+
+	writer.write(static_cast<UInt>(entries.size()));
+	for (auto& entry : entries) {
+		writer.write(entry.first);
+		writer.write(entry.second);
+	}
+
+	if (!out)
+		throw SystemError("Failed to write topology cache");
+}
+
+Bool TopologyCache::read(std::istream& in, std::uint64_t key, SystemTopology& system, Logger::Level logLevel) {
+	CheckpointReader reader(in);
+	if (reader.read<UInt>() != magic || reader.read<UInt>() != version)
+		return false;
+	std::uint64_t fileKey = static_cast<std::uint64_t>(reader.read<UInt>()) << 32;
+	fileKey |= reader.read<UInt>();
+	if (fileKey != key)
+		return false;
+
+	SystemTopology result(reader.read<Real>());
+	reader.read(result.mFrequencies);
+
+	UInt numNodes = reader.read<UInt>();
+	for (UInt i = 0; i < numNodes; ++i) {
+		Bool complex = reader.read<Bool>();
+		auto uid = reader.read<String>();
+		auto name = reader.read<String>();
+		auto phaseType = static_cast<PhaseType>(reader.read<Int>());
+		auto indices = reader.read<std::vector<UInt>>();
+		indices.resize(3, 0);
+		std::vector<Complex> zero = { 0, 0, 0 };
+
+		TopologicalNode::Ptr node;
+		if (complex)
+			node = SimNode<Complex>::make(uid, name, indices, phaseType, zero);
+		else
+			node = SimNode<Real>::make(uid, name, indices, phaseType, zero);
+		node->setInitialVoltage(reader.read<MatrixComp>());
+		result.addNode(node);
+	}
+
+	std::vector<Component> descs;
+	result.addComponents(readComponents(reader, result.mNodes, descs, logLevel));
+	result.addTearComponents(readComponents(reader, result.mNodes, descs, logLevel));
+
+	UInt numEntries = reader.read<UInt>();
+	for (UInt i = 0; i < numEntries; ++i) {
+		Int nodeIndex = reader.read<Int>();
+		auto comps = reader.read<std::vector<Int>>();
+		if (nodeIndex < 0 || static_cast<UInt>(nodeIndex) >= numNodes)
+			throw SystemError("Topology cache refers to a missing node");
+
+		auto& list = result.mComponentsAtNode[result.mNodes[nodeIndex]];
+		for (Int comp : comps) {
+			if (comp < 0 || static_cast<std::size_t>(comp) >= result.mComponents.size())
+				throw SystemError("Topology cache refers to a missing component");
+			list.push_back(std::dynamic_pointer_cast<TopologicalPowerComp>(result.mComponents[comp]));
+		}
+	}
+
+	system = result;
+	for (auto& desc : descs)
+		addComponent(desc);
+	return true;
+}